@@ -0,0 +1,65 @@
+#include "Binding.h"
+#include "Slider.h"
+#include "Checkbox.h"
+#include "Label.h"
+#include "TextInput.h"
+
+namespace {
+    // Model => widget observer plus the widget => model callback (if given), undone together
+    template<typename T, typename W, typename Apply, typename Detach>
+    Binding BindWidget(Observable<T>& model, const std::shared_ptr<W>& widget, Apply apply, Detach detach) {
+        if(!widget) return Binding();
+        apply(*widget, model.Get());
+
+        std::weak_ptr<W> weak = widget;
+        auto id = model.Subscribe([weak, apply](const T& value) {
+            if(auto w = weak.lock()) apply(*w, value);
+        });
+
+        Observable<T>* m = &model;
+        return Binding([m, id, weak, detach] {
+            m->Unsubscribe(id);
+            if(auto w = weak.lock()) detach(*w);
+        });
+    }
+}
+
+Binding Bind::Value(Observable<float>& model, const std::shared_ptr<Slider>& slider) {
+    if(slider) {
+        // Set back from the widget - the echo of a model update is an equal value, so it stops here
+        slider->SetOnValueChanged([&model](float value) { model.Set(value); });
+    }
+    return BindWidget(model, slider,
+        [](Slider& s, float value) { s.SetValue(value); },
+        [](Slider& s) { s.SetOnValueChanged(nullptr); }
+    );
+}
+
+Binding Bind::Checked(Observable<bool>& model, const std::shared_ptr<Checkbox>& checkbox) {
+    if(checkbox) {
+        checkbox->SetOnToggle([&model](bool checked) { model.Set(checked); });
+    }
+    return BindWidget(model, checkbox,
+        [](Checkbox& c, bool checked) { c.SetChecked(checked); },
+        [](Checkbox& c) { c.SetOnToggle(nullptr); }
+    );
+}
+
+Binding Bind::Text(Observable<std::wstring>& model, const std::shared_ptr<Label>& label) {
+    return BindWidget(model, label,
+        [](Label& l, const std::wstring& text) { l.SetText(text); },
+        [](Label&) {}
+    );
+}
+
+Binding Bind::Text(Observable<std::wstring>& model, const std::shared_ptr<TextInput>& input) {
+    if(input) {
+        // Raw pointer - the callback is owned by the input itself
+        TextInput* raw = input.get();
+        input->SetOnChange([&model, raw] { model.Set(raw->GetText()); });
+    }
+    return BindWidget(model, input,
+        [](TextInput& t, const std::wstring& text) { t.SetText(text); },
+        [](TextInput& t) { t.SetOnChange(nullptr); }
+    );
+}
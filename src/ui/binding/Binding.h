@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "Observable.h"
+#include "InlineFunction.h"
+
+class Slider;
+class Checkbox;
+class Label;
+class TextInput;
+
+// Link between an Observable and a widget (UI thread) - unbinds when destroyed
+// Keep it next to the model; the model must outlive it. Widgets are held weakly (a dead widget is skipped).
+class Binding {
+    public:
+        Binding() = default;
+        explicit Binding(InlineFunction<void()> unbind) : unbind(std::move(unbind)) {}
+        ~Binding() { Unbind(); }
+
+        Binding(Binding&& other) noexcept : unbind(std::move(other.unbind)) { other.unbind = nullptr; }
+        Binding& operator=(Binding&& other) noexcept {
+            if(this != &other) {
+                Unbind();
+                unbind = std::move(other.unbind);
+                other.unbind = nullptr;
+            }
+            return *this;
+        }
+
+        void Unbind() {
+            if(!unbind) return;
+            InlineFunction<void()> fn = std::move(unbind);
+            unbind = nullptr;
+            fn();
+        }
+        bool IsBound() const { return static_cast<bool>(unbind); }
+
+    private:
+        InlineFunction<void()> unbind;
+};
+
+// Model => widget updates go through the widget setters (which short-circuit on equal values), so with a
+// batched model every widget is updated at most once per frame. Widget => model updates (two-way bindings)
+// set the model from the widget's change callback, which the binding takes over until unbound.
+// The widget takes the model value when bound.
+namespace Bind {
+    // One-way, to any setter
+    template<typename T>
+    Binding To(Observable<T>& model, InlineFunction<void(const T&)> apply) {
+        apply(model.Get());
+        auto id = model.Subscribe(std::move(apply));
+        Observable<T>* m = &model;
+        return Binding([m, id] { m->Unsubscribe(id); });
+    }
+
+    Binding Value(Observable<float>& model, const std::shared_ptr<Slider>& slider);           // Two-way
+    Binding Checked(Observable<bool>& model, const std::shared_ptr<Checkbox>& checkbox);      // Two-way
+    Binding Text(Observable<std::wstring>& model, const std::shared_ptr<Label>& label);       // One-way
+    Binding Text(Observable<std::wstring>& model, const std::shared_ptr<TextInput>& input);   // Two-way (per edit)
+}
@@ -1,6 +1,7 @@
+#include <cmath>
+
 #include "Menu.h"
 #include "FlexLayout.h"
-#include "ScopedGDI.h"
 
 Menu::Menu(const std::wstring &t) :
     title(t)
@@ -23,12 +24,11 @@ RECT Menu::ResizeHandleRect() const {
         EffectiveBottom()
     };
 }
-void Menu::RenderResizeHandle(HDC hdc) const { // Classic triangle-like diagonal lines
+void Menu::RenderResizeHandle(Painter& painter) const { // Classic triangle-like diagonal lines
     const int lineCount = 3;
     const int spacing = 3;
     const int cornerPadding = 2; // Distance from the corner
-
-    ScopedOwnedPen pen(hdc, PS_SOLID, 1, RGB(180,180,180));
+    const Color lineColor = Color::FromRGB(180, 180, 180);
 
     // RECT for the diagonal lines (going from top-left to bottom-right)
     // Subtract cornerPadding only in y1 and x1 so as to preserve the hitbox
@@ -47,8 +47,7 @@ void Menu::RenderResizeHandle(HDC hdc) const { // Classic triangle-like diagonal
         int endY    = std::min(y0 + offset, EffectiveBottom());
 
         // Have to subtract 1 from Y because of MoveToEx/LineTo shenanigans
-        MoveToEx(hdc, startX, startY - 1, nullptr);
-        LineTo(hdc, endX, endY - 1);
+        painter.DrawLine(startX, startY - 1, endX, endY - 1, lineColor);
     }
 }
 
@@ -138,6 +137,20 @@ void Menu::SetPosSize(int x, int y, int w, int h) {
     Container::SetPosSize(x, y, std::max(w, 50), std::max(h, titleBarHeight + resizeHandleSize));
 }
 
+bool Menu::ApplyProperty(PropertyID property, const PropertyValue& value) {
+    switch(property) {
+        case PropertyID::Width:
+            if(auto* v = std::get_if<float>(&value)) { SetSize(static_cast<int>(std::lround(*v)), height); return true; }
+            break;
+        case PropertyID::Height:
+            if(auto* v = std::get_if<float>(&value)) { SetSize(width, static_cast<int>(std::lround(*v))); return true; }
+            break;
+        default:
+            break;
+    }
+    return Container::ApplyProperty(property, value);
+}
+
 void Menu::SetCollapsed(bool collapsed) {
     isCollapsed = collapsed;
     bodyContainer->SetDisplayed(!collapsed);
@@ -166,12 +179,12 @@ void Menu::SetShowTitleBar(bool show) {
     }
 }
 
-void Menu::Render(HDC hdc) {    
+void Menu::Render(Painter& painter) {    
     // Render children in order
-    Container::Render(hdc);
+    Container::Render(painter);
 
     if(!isCollapsed) {
         // Draw resize handle
-        RenderResizeHandle(hdc);
+        RenderResizeHandle(painter);
     }
 }
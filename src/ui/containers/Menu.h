@@ -28,6 +28,9 @@ class Menu : public Container {
         void SetPosSize(int x, int y, int w, int h);
 
         void SetTitle(const std::wstring &t);
+
+        // Generic properties (Width/Height go through the clamping SetSize)
+        bool ApplyProperty(PropertyID property, const PropertyValue& value) override;
         std::wstring GetTitle() const { return title; }
         void SetShowTitleBar(bool show);
 
@@ -58,12 +61,12 @@ class Menu : public Container {
         }
 
         // --- Rendering ---------------------------------------------------------
-        void Render(HDC hdc) override;
+        void Render(Painter& painter) override;
 
     private:
         // Resize handle in the bottom-right of the menu
         RECT ResizeHandleRect() const;
-        void RenderResizeHandle(HDC hdc) const;
+        void RenderResizeHandle(Painter& painter) const;
 
         // Header (title bar)
         ContainerPtr headerContainer;
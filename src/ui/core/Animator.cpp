@@ -0,0 +1,240 @@
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "Animator.h"
+#include "Widget.h"
+
+namespace {
+    BYTE ToChannel(float v) {
+        return static_cast<BYTE>(std::min(std::max(v, 0.0f), 255.0f) + 0.5f);
+    }
+}
+
+bool Animator::Animate(const std::shared_ptr<Widget>& target, PropertyID property, float from, float to, float duration,
+                       Easing easing, InlineFunction<void()> onComplete) {
+    if(!target) return false;
+    if(property != PropertyID::Value && property != PropertyID::Width && property != PropertyID::Height) return false;
+
+    float start[Channels] = {from, 0.0f, 0.0f, 0.0f};
+    float end[Channels] = {to, 0.0f, 0.0f, 0.0f};
+    Start(target, property, start, end, duration, easing, std::move(onComplete));
+    return true;
+}
+
+bool Animator::Animate(const std::shared_ptr<Widget>& target, PropertyID property, Color from, Color to, float duration,
+                       Easing easing, InlineFunction<void()> onComplete) {
+    if(!target) return false;
+    if(property != PropertyID::BackgroundColor && property != PropertyID::TextColor) return false;
+
+    float start[Channels] = {float(from.a), float(from.r), float(from.g), float(from.b)};
+    float end[Channels] = {float(to.a), float(to.r), float(to.g), float(to.b)};
+    Start(target, property, start, end, duration, easing, std::move(onComplete));
+    return true;
+}
+
+void Animator::Start(const std::shared_ptr<Widget>& target, PropertyID property, const float* start, const float* end,
+                     float duration, Easing easing, InlineFunction<void()> onComplete) {
+    TweenKey key{target.get(), property};
+
+    // Replace a running tween in place, or append a new one
+    size_t i;
+    auto it = index.find(key);
+    if(it != index.end()) {
+        i = it->second;
+    }
+    else {
+        i = keys.size();
+        index.emplace(key, i);
+
+        keys.push_back(key);
+        targets.emplace_back();
+        elapsed.push_back(0.0f);
+        durations.push_back(0.0f);
+        easeA.push_back(0.0f);
+        easeB.push_back(0.0f);
+        easeC.push_back(0.0f);
+        for(int ch = 0; ch < Channels; ch++) {
+            from[ch].push_back(0.0f);
+            to[ch].push_back(0.0f);
+        }
+        applied.push_back(0);
+        started.push_back(0);
+        onCompletes.emplace_back();
+    }
+
+    targets[i] = target;
+    elapsed[i] = 0.0f;
+    durations[i] = std::max(duration, 0.0f);
+    for(int ch = 0; ch < Channels; ch++) {
+        from[ch][i] = start[ch];
+        to[ch][i] = end[ch];
+    }
+    started[i] = 0;
+    onCompletes[i] = std::move(onComplete);
+
+    // Every easing as a*t + b*t^2 + c*t^3 (all give 1 at t = 1)
+    float a = 0.0f, b = 0.0f, c = 0.0f;
+    switch(easing) {
+        case Easing::Linear:        a = 1.0f; break;
+        case Easing::EaseIn:        b = 1.0f; break;
+        case Easing::EaseOut:       a = 2.0f; b = -1.0f; break;
+        case Easing::EaseInOut:     b = 3.0f; c = -2.0f; break;
+        case Easing::EaseOutCubic:  a = 3.0f; b = -3.0f; c = 1.0f; break;
+    }
+    easeA[i] = a;
+    easeB[i] = b;
+    easeC[i] = c;
+}
+
+void Animator::Stop(const Widget* target, PropertyID property) {
+    auto it = index.find({target, property});
+    if(it != index.end()) RemoveAt(it->second);
+}
+
+void Animator::StopAll(const Widget* target) {
+    for(size_t i = keys.size(); i-- > 0;) {
+        if(keys[i].widget == target) RemoveAt(i);
+    }
+}
+
+bool Animator::IsAnimating(const Widget* target, PropertyID property) const {
+    return index.find({target, property}) != index.end();
+}
+
+// --- Ticking ---------------------------------------------------------
+size_t Animator::Tick(float deltaSeconds) {
+    size_t count = keys.size();
+    if(count == 0) return 0;
+
+    float step = std::min(std::max(deltaSeconds, 0.0f), maxStep);
+
+    // Batch pass - progress, easing and interpolation of all tweens in flat, branch-free loops
+    eased.resize(count);
+    for(size_t i = 0; i < count; i++) {
+        elapsed[i] += step;
+    }
+    for(size_t i = 0; i < count; i++) {
+        float t = durations[i] > 0.0f ? std::min(elapsed[i] / durations[i], 1.0f) : 1.0f;
+        eased[i] = t * (easeA[i] + t * (easeB[i] + t * easeC[i]));
+    }
+    for(int ch = 0; ch < Channels; ch++) {
+        values[ch].resize(count);
+        const float* f = from[ch].data();
+        const float* e = to[ch].data();
+        float* v = values[ch].data();
+        for(size_t i = 0; i < count; i++) {
+            v[i] = f[i] * (1.0f - eased[i]) + e[i] * eased[i]; // Exactly the end value at 1
+        }
+    }
+
+    // Apply pass - only the widgets whose rounded value changed
+    finished.assign(count, 0);
+    for(size_t i = 0; i < count; i++) {
+        bool alive = Apply(i);
+        finished[i] = !alive || elapsed[i] >= durations[i];
+    }
+
+    // Remove finished tweens (back to front - the swapped-in last tween was already processed)
+    completed.clear();
+    for(size_t i = count; i-- > 0;) {
+        if(!finished[i]) continue;
+        if(onCompletes[i]) completed.push_back(std::move(onCompletes[i]));
+        RemoveAt(i);
+    }
+
+    // Callbacks last - they may start new tweens
+    for(auto it = completed.rbegin(); it != completed.rend(); ++it) {
+        (*it)();
+    }
+    completed.clear();
+
+    return keys.size();
+}
+
+bool Animator::Apply(size_t i) {
+    std::shared_ptr<Widget> target = targets[i].lock();
+    if(!target) return false;
+
+    PropertyID property = keys[i].property;
+    PropertyValue value;
+    uint32_t rounded;
+    bool paint = true;
+    switch(property) {
+        case PropertyID::BackgroundColor:
+        case PropertyID::TextColor: {
+            Color c = Color::FromARGB(ToChannel(values[0][i]), ToChannel(values[1][i]), ToChannel(values[2][i]), ToChannel(values[3][i]));
+            rounded = (uint32_t(c.a) << 24) | (uint32_t(c.r) << 16) | (uint32_t(c.g) << 8) | uint32_t(c.b);
+            value = c;
+            break;
+        }
+        case PropertyID::Width:
+        case PropertyID::Height: {
+            long px = std::lround(values[0][i]);
+            rounded = static_cast<uint32_t>(px);
+            value = static_cast<float>(px);
+            paint = false; // SetSize relays out
+            break;
+        }
+        default: {
+            float v = values[0][i];
+            std::memcpy(&rounded, &v, sizeof(rounded));
+            value = v;
+            break;
+        }
+    }
+
+    if(started[i] && rounded == applied[i]) return true;
+    started[i] = 1;
+    applied[i] = rounded;
+
+    if(target->ApplyProperty(property, value) && paint) {
+        target->InvalidatePaint();
+    }
+    return true;
+}
+
+// --- Storage ---------------------------------------------------------
+void Animator::RemoveAt(size_t i) {
+    size_t last = keys.size() - 1;
+    index.erase(keys[i]);
+    if(i != last) {
+        MoveTween(i, last);
+        index[keys[i]] = i;
+    }
+    PopTween();
+}
+
+void Animator::MoveTween(size_t dst, size_t src) {
+    keys[dst] = keys[src];
+    targets[dst] = std::move(targets[src]);
+    elapsed[dst] = elapsed[src];
+    durations[dst] = durations[src];
+    easeA[dst] = easeA[src];
+    easeB[dst] = easeB[src];
+    easeC[dst] = easeC[src];
+    for(int ch = 0; ch < Channels; ch++) {
+        from[ch][dst] = from[ch][src];
+        to[ch][dst] = to[ch][src];
+    }
+    applied[dst] = applied[src];
+    started[dst] = started[src];
+    onCompletes[dst] = std::move(onCompletes[src]);
+}
+
+void Animator::PopTween() {
+    keys.pop_back();
+    targets.pop_back();
+    elapsed.pop_back();
+    durations.pop_back();
+    easeA.pop_back();
+    easeB.pop_back();
+    easeC.pop_back();
+    for(int ch = 0; ch < Channels; ch++) {
+        from[ch].pop_back();
+        to[ch].pop_back();
+    }
+    applied.pop_back();
+    started.pop_back();
+    onCompletes.pop_back();
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Color.h"
+#include "Property.h"
+#include "InlineFunction.h"
+
+class Widget;
+
+// Using uint8_t instead of int for optimization
+enum class Easing : uint8_t {
+    Linear,
+    EaseIn,         // Quadratic
+    EaseOut,        // Quadratic
+    EaseInOut,      // Smoothstep
+    EaseOutCubic
+};
+
+// Property tweens of one Root, advanced once per frame
+// Tweens are stored as structure of arrays; a tick first computes every tween's value in flat loops over
+// the arrays (every easing is a cubic polynomial, so there is no per-tween branching), then applies
+// the values through Widget::ApplyProperty. Values that don't change after rounding (color bytes,
+// pixel sizes) aren't applied again. Only the animated widgets are invalidated: appearance properties
+// repaint the widget, Width/Height go through SetSize (relayout).
+// Float tweens: Value, Width, Height. Color tweens: BackgroundColor, TextColor (kept per widget, outside the style,
+// so intermediate colors don't intern styles).
+class Animator {
+    public:
+        // Starting a tween on a (widget, property) that is already animating replaces the running one
+        // Returns false if the property can't be animated with the given value type
+        bool Animate(const std::shared_ptr<Widget>& target, PropertyID property, float from, float to, float duration,
+                     Easing easing = Easing::EaseOut, InlineFunction<void()> onComplete = nullptr);
+        bool Animate(const std::shared_ptr<Widget>& target, PropertyID property, Color from, Color to, float duration,
+                     Easing easing = Easing::EaseOut, InlineFunction<void()> onComplete = nullptr);
+
+        void Stop(const Widget* target, PropertyID property); // Leaves the current value; onComplete isn't called
+        void StopAll(const Widget* target);
+        bool IsAnimating(const Widget* target, PropertyID property) const;
+
+        // UI thread, once per frame - returns the number of tweens still running
+        // A long frame advances the tweens by at most the max step (no jumps after a hitch)
+        size_t Tick(float deltaSeconds);
+        void SetMaxStep(float seconds) { maxStep = seconds; }
+
+        size_t GetCount() const { return keys.size(); }
+        bool IsIdle() const { return keys.empty(); }
+
+    private:
+        struct TweenKey {
+            const Widget* widget;
+            PropertyID property;
+            bool operator==(const TweenKey& o) const { return widget == o.widget && property == o.property; }
+        };
+        struct TweenKeyHash {
+            size_t operator()(const TweenKey& k) const {
+                return std::hash<const Widget*>()(k.widget) ^ (static_cast<size_t>(k.property) * 0x9E3779B9u);
+            }
+        };
+        static const int Channels = 4; // Colors use a, r, g, b; floats only the first one
+
+        // --- Tweens (structure of arrays, one entry per tween) ---
+        std::vector<TweenKey> keys;
+        std::vector<std::weak_ptr<Widget>> targets;     // Widgets may die while animated
+        std::vector<float> elapsed;
+        std::vector<float> durations;
+        std::vector<float> easeA, easeB, easeC;         // eased(t) = a*t + b*t^2 + c*t^3
+        std::vector<float> from[Channels];
+        std::vector<float> to[Channels];
+        std::vector<float> values[Channels];            // Tick scratch
+        std::vector<uint32_t> applied;                  // Last applied value, rounded (skips no-op updates)
+        std::vector<uint8_t> started;                   // Applied at least once
+        std::vector<InlineFunction<void()>> onCompletes;
+
+        std::unordered_map<TweenKey, size_t, TweenKeyHash> index; // Key => tween index
+        float maxStep = 0.1f;
+
+        // Tick scratch (reused between frames)
+        std::vector<float> eased;
+        std::vector<uint8_t> finished;
+        std::vector<InlineFunction<void()>> completed;
+
+        void Start(const std::shared_ptr<Widget>& target, PropertyID property, const float* start, const float* end,
+                   float duration, Easing easing, InlineFunction<void()> onComplete);
+        bool Apply(size_t i);   // Returns false if the target is gone
+        void RemoveAt(size_t i);
+        void MoveTween(size_t dst, size_t src);
+        void PopTween();
+};
@@ -7,4 +7,9 @@ struct Color {
     COLORREF toCOLORREF() const { return RGB(r, g, b); }
     static Color FromRGB(BYTE r, BYTE g, BYTE b) { return {255, r, g, b}; }
     static Color FromARGB(BYTE a, BYTE r, BYTE g, BYTE b) { return {a, r, g, b}; }
+
+    bool operator==(const Color& other) const {
+        return a == other.a && r == other.r && g == other.g && b == other.b;
+    }
+    bool operator!=(const Color& other) const { return !(*this == other); }
 };
\ No newline at end of file
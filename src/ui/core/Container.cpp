@@ -1,6 +1,10 @@
+#include <typeinfo>
 #include <algorithm>
 
 #include "Container.h"
+#include "Root.h"
+#include "LayoutScheduler.h"
+#include "LayoutSnapshot.h"
 
 Container::Container() {
     // default container behavior
@@ -10,9 +14,35 @@ void Container::AddChild(const WidgetPtr& child) {
     if(!child) return;
     child->SetParent(this);
     children.push_back(child);
+    AdjustSubtreeSize(static_cast<long long>(child->GetSubtreeSize()));
     InvalidateLayout();
 }
 
+void Container::InsertChild(const WidgetPtr& child, size_t index) {
+    if(!child) return;
+    child->SetParent(this);
+    children.insert(children.begin() + static_cast<std::ptrdiff_t>(std::min(index, children.size())), child);
+    AdjustSubtreeSize(static_cast<long long>(child->GetSubtreeSize()));
+    InvalidateLayout();
+}
+
+bool Container::MoveChild(const Widget* child, size_t index) {
+    auto it = std::find_if(children.begin(), children.end(), [child](const WidgetPtr& c) { return c.get() == child; });
+    if(it == children.end()) return false;
+
+    size_t from = static_cast<size_t>(it - children.begin());
+    index = std::min(index, children.size() - 1);
+    if(from == index) return true;
+
+    // Rotate instead of erase + insert - no shared_ptr copies
+    if(from < index) std::rotate(it, it + 1, children.begin() + static_cast<std::ptrdiff_t>(index) + 1);
+    else std::rotate(children.begin() + static_cast<std::ptrdiff_t>(index), it, it + 1);
+
+    if(Root* root = GetRoot()) root->GetFocusManager().InvalidateTabOrder(); // The tab order follows the tree
+    InvalidateLayout();
+    return true;
+}
+
 void Container::RemoveChild(const WidgetPtr& child) {
     if(!child) return;
 
@@ -20,8 +50,10 @@ void Container::RemoveChild(const WidgetPtr& child) {
 
     // Only remove the widget if it's actually a child
     if(it != children.end()) {
+        if(layout) layout->OnChildRemoved(*child);
         child->SetParent(nullptr);
         children.erase(it, children.end());
+        AdjustSubtreeSize(-static_cast<long long>(child->GetSubtreeSize()));
     }
     
     InvalidateLayout();
@@ -29,9 +61,11 @@ void Container::RemoveChild(const WidgetPtr& child) {
 
 void Container::RemoveAllChildren() {
     for(auto& child : children) {
+        if(layout) layout->OnChildRemoved(*child);
         child->SetParent(nullptr);
     }
     children.clear();
+    AdjustSubtreeSize(1 - static_cast<long long>(subtreeSize));
     InvalidateLayout();
 }
 
@@ -63,11 +97,8 @@ void Container::UpdateInternalLayout() {
         RECT inner = ComputeInnerRect();
         layout->Apply(inner);
         
-        for(auto& child : children) {
-            if(!child) continue;
-
-            child->UpdateInternalLayout();
-        }
+        // Children are sized now - their subtrees only depend on their own rects
+        UpdateChildrenInternalLayout();
     }
     else {
         // If no layout (absolute positioning), position the children manually
@@ -80,6 +111,32 @@ void Container::UpdateInternalLayout() {
     // Give derived classes a chance to react
     OnInternalLayoutUpdated();
 }
+void Container::UpdateChildrenInternalLayout() {
+    LayoutScheduler& scheduler = LayoutScheduler::Get();
+    size_t threshold = scheduler.GetSubtreeThreshold();
+
+    // Not worth forking (or disabled): plain serial pass
+    if(!scheduler.IsEnabled() || children.size() < 2 || subtreeSize < 2 * threshold) {
+        for(auto& child : children) {
+            if(!child) continue;
+
+            child->UpdateInternalLayout();
+        }
+        return;
+    }
+
+    // Big subtrees become stealable tasks, small ones run inline
+    scheduler.ForkJoin(
+        children.size(),
+        [this, threshold](size_t i) {
+            return children[i] && children[i]->GetSubtreeSize() >= threshold;
+        },
+        [this](size_t i) {
+            if(children[i]) children[i]->UpdateInternalLayout();
+        }
+    );
+}
+
 void Container::UpdateEffectiveGeometry() {
     Widget::UpdateEffectiveGeometry();
     if(layout) {
@@ -92,6 +149,20 @@ void Container::UpdateEffectiveGeometry() {
     }
 }
 
+// Children are hashed by the snapshot walk itself
+void Container::HashLayoutInputs(LayoutHash& hash) const {
+    Widget::HashLayoutInputs(hash);
+    hash.Add(static_cast<int>(children.size()));
+
+    if(!layout) {
+        hash.Add(false);
+        return;
+    }
+    hash.Add(true);
+    hash.AddType(typeid(*layout));
+    if(!layout->HashInputs(hash)) hash.MarkUncacheable();
+}
+
 void Container::UpdateEffectiveDisplay() {
     Widget::UpdateEffectiveDisplay();
 
@@ -103,10 +174,10 @@ void Container::UpdateEffectiveDisplay() {
     }
 }
 
-void Container::Render(HDC hdc) {
+void Container::Render(Painter& painter) {
     // Render children in order
     for(auto &c : children) {
-        if(c) c->InitRender(hdc);
+        if(c) c->InitRender(painter);
     }
 }
 
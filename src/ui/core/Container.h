@@ -19,8 +19,11 @@ class Container : public Widget {
 
         // Child management
         void AddChild(const WidgetPtr& child);
+        void InsertChild(const WidgetPtr& child, size_t index);     // Index past the end appends
+        bool MoveChild(const Widget* child, size_t index);          // Reorders an existing child; false if not a child
         void RemoveChild(const WidgetPtr& child);
         void RemoveAllChildren();
+        void ReserveChildren(size_t count) { children.reserve(count); } // Pre-size for bulk building
         const std::vector<WidgetPtr>& Children() const { return children; }
 
         // --- Geometry & Layout ---
@@ -31,16 +34,20 @@ class Container : public Widget {
         void SetLayout(std::unique_ptr<Layout> newLayout);
         void UpdateInternalLayout() override;
         void UpdateEffectiveGeometry() override;
+        void HashLayoutInputs(LayoutHash& hash) const override;
 
         // --- Display & Visibility ---
         void UpdateEffectiveDisplay() override;
 
         // Rendering
-        void Render(HDC hdc) override;
+        void Render(Painter& painter) override;
 
         bool FeedMouseEvent(const MouseEvent& e) override;
 
     protected:
         std::unique_ptr<Layout> layout;
         std::vector<WidgetPtr> children;
+
+        // Updates children internal layout, in parallel for big independent subtrees if enabled
+        void UpdateChildrenInternalLayout();
     };
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "FocusManager.h"
+#include "Container.h"
+
+bool FocusManager::CanFocus(const Widget& w) {
+    return w.focusable && w.enabled && w.visible && w.effectiveDisplayed;
+}
+
+bool FocusManager::SetFocus(Widget* widget) {
+    if(widget == focused) return true;
+    if(widget && (!CanFocus(*widget) || widget->GetMainContainer() != &root)) return false;
+
+    Widget* previous = focused;
+    focused = widget;
+    if(previous) {
+        previous->focused = false;
+        previous->OnFocusChanged(false);
+    }
+    if(widget) {
+        widget->focused = true;
+        widget->OnFocusChanged(true);
+    }
+    return true;
+}
+
+// --- Tab order -------------------------------------------------------
+bool FocusManager::FocusNext() {
+    return MoveFocus(1);
+}
+
+bool FocusManager::FocusPrevious() {
+    return MoveFocus(-1);
+}
+
+bool FocusManager::MoveFocus(int step) {
+    if(tabOrderDirty) RebuildTabOrder();
+
+    size_t count = tabOrder.size();
+    if(count == 0) return false;
+
+    // Without a focused widget in the order (none, or e.g. one in an overlay), the first step lands on the first/last widget
+    size_t pos = step > 0 ? count - 1 : 0;
+    if(focused && focused->tabPosition < count && tabOrder[focused->tabPosition] == focused) {
+        pos = focused->tabPosition;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        pos = (pos + count + step) % count;
+        if(CanFocus(*tabOrder[pos])) return SetFocus(tabOrder[pos]);
+    }
+    return false;
+}
+
+void FocusManager::RebuildTabOrder() {
+    tabOrderDirty = false;
+    tabOrder.clear();
+    CollectTabOrder(root);
+}
+
+void FocusManager::CollectTabOrder(Widget& w) {
+    // Hidden/disabled widgets stay in the order (checked when stepping), so those changes don't need a rebuild
+    if(w.focusable) {
+        w.tabPosition = tabOrder.size();
+        tabOrder.push_back(&w);
+    }
+
+    if(auto* container = dynamic_cast<Container*>(&w)) {
+        for(const auto& child : container->Children()) {
+            if(child) CollectTabOrder(*child);
+        }
+    }
+}
+
+// --- Dispatch --------------------------------------------------------
+bool FocusManager::DispatchKey(const KeyEvent& e) {
+    if(focused && !CanFocus(*focused)) SetFocus(nullptr);
+
+    for(Widget* w = focused ? focused : &root; w; w = w->parent) {
+        if(!w->enabled) continue;
+        if(w->OnKeyEvent(e)) return true;
+        if(w->onKey && w->onKey(e)) return true;
+    }
+
+    if(e.type == KeyEventType::Down && e.key == VK_TAB &&
+        !HasModifier(e.modifiers, KeyModifiers::Control | KeyModifiers::Alt)) {
+        return HasModifier(e.modifiers, KeyModifiers::Shift) ? FocusPrevious() : FocusNext();
+    }
+    return false;
+}
+
+bool FocusManager::DispatchChar(const CharEvent& e) {
+    if(focused && !CanFocus(*focused)) SetFocus(nullptr);
+
+    for(Widget* w = focused ? focused : &root; w; w = w->parent) {
+        if(!w->enabled) continue;
+        if(w->OnCharEvent(e)) return true;
+        if(w->onChar && w->onChar(e)) return true;
+    }
+    return false;
+}
+
+// --- Tree changes ----------------------------------------------------
+void FocusManager::OnSubtreeDetached(Widget& subtree) {
+    tabOrderDirty = true;
+
+    for(Widget* w = focused; w; w = w->parent) {
+        if(w == &subtree) {
+            SetFocus(nullptr);
+            break;
+        }
+    }
+}
+
+void FocusManager::OnMouseDown(POINT p) {
+    if(focused && !focused->MouseInRect(p)) SetFocus(nullptr);
+}
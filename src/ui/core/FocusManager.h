@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <windows.h>
+
+#include "Widget.h"
+
+// Keyboard focus of one Root
+// Key/char events go straight to the focused widget and bubble up its ancestors (no tree broadcast).
+// The Tab order (focusable widgets in tree order) is rebuilt lazily after tree changes; every widget keeps
+// its position in it, so Tab/Shift+Tab is O(1) - only widgets that are currently hidden/disabled are skipped.
+class FocusManager {
+    public:
+        explicit FocusManager(Widget& root) : root(root) {}
+
+        FocusManager(const FocusManager&) = delete;
+        FocusManager& operator=(const FocusManager&) = delete;
+
+        Widget* GetFocused() const { return focused; }
+        bool SetFocus(Widget* widget); // nullptr clears the focus; returns false if the widget can't take focus
+        bool FocusNext();
+        bool FocusPrevious();
+
+        // Dispatch (UI thread) - unhandled Tab/Shift+Tab moves the focus
+        bool DispatchKey(const KeyEvent& e);
+        bool DispatchChar(const CharEvent& e);
+
+        // Tree change notifications
+        void InvalidateTabOrder() { tabOrderDirty = true; }
+        void OnSubtreeDetached(Widget& subtree);    // Drops the focus if it's inside the subtree
+        void OnMouseDown(POINT p);                  // A click outside of the focused widget clears the focus
+
+        static bool CanFocus(const Widget& w);
+
+    private:
+        Widget& root;
+        Widget* focused = nullptr;
+
+        std::vector<Widget*> tabOrder;
+        bool tabOrderDirty = true;
+
+        void RebuildTabOrder();
+        void CollectTabOrder(Widget& w);
+        bool MoveFocus(int step);
+};
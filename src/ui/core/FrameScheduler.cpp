@@ -0,0 +1,82 @@
+#include <chrono>
+#include <algorithm>
+
+#include "FrameScheduler.h"
+#include "Root.h"
+
+FrameScheduler::FrameScheduler(Root& root) :
+    root(root),
+    clock([] {
+        using namespace std::chrono;
+        return duration<double>(steady_clock::now().time_since_epoch()).count();
+    })
+{
+}
+
+// --- Pending work ----------------------------------------------------
+bool FrameScheduler::NeedsFrame() const {
+    return root.HasPendingInput()
+        || root.HasPendingPropertyUpdates()
+        || root.HasPendingObservableChanges()
+        || std::any_of(pollers.begin(), pollers.end(), [](const Poller& p) { return p.hasPending(); })
+        || root.IsAnimating()
+        || root.IsPaintDirty()
+        || !idleTasks.empty();
+}
+
+double FrameScheduler::NextDeadline() const {
+    if(!NeedsFrame()) return Never;
+
+    // One frame per interval at most - after an idle period the deadline is already due
+    return lastFrameStart + frameInterval;
+}
+
+size_t FrameScheduler::AddPoller(InlineFunction<bool()> hasPending, InlineFunction<void()> poll) {
+    pollers.push_back({nextPollerId, std::move(hasPending), std::move(poll)});
+    return nextPollerId++;
+}
+
+void FrameScheduler::RemovePoller(size_t id) {
+    auto it = std::find_if(pollers.begin(), pollers.end(), [id](const Poller& p) { return p.id == id; });
+    if(it != pollers.end()) pollers.erase(it);
+}
+
+// --- Frame -----------------------------------------------------------
+bool FrameScheduler::RunFrame(const RenderCallback& render) {
+    double frameStart = Now();
+    double delta = animatedLastFrame ? frameStart - lastFrameStart : 0.0; // A starting animation begins at its start value
+    lastFrameStart = frameStart;
+
+    root.DispatchInput();
+    root.FlushPropertyUpdates();
+    root.FlushObservableChanges(); // After input - bound widgets may have changed their models
+    for(size_t i = 0; i < pollers.size(); i++) {
+        pollers[i].poll();
+    }
+    root.TickAnimations(static_cast<float>(delta));
+    animatedLastFrame = root.IsAnimating();
+
+    bool rendered = false;
+    if(root.IsPaintDirty()) {
+        RECT damage = root.TakeDamage();
+        if(render) render(root, damage);
+        rendered = true;
+    }
+    root.MarkFrame();
+
+    RunIdleTasks(frameStart, rendered);
+    return rendered;
+}
+
+void FrameScheduler::RunIdleTasks(double frameStart, bool rendered) {
+    // Tasks may post further tasks - those wait for the next frame
+    size_t available = idleTasks.size();
+    bool runOne = !rendered;
+    while(available > 0 && (runOne || Now() < frameStart + frameInterval)) {
+        InlineFunction<void()> task = std::move(idleTasks.front());
+        idleTasks.pop_front();
+        available--;
+        runOne = false;
+        task();
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <deque>
+#include <limits>
+#include <vector>
+#include <functional>
+#include <windows.h>
+
+#include "InlineFunction.h"
+
+class Root;
+
+// Decides when a Root needs a frame, so the host only renders when something changed
+// Pending work = queued input/property updates, changed observables, data waiting for a poller, running animations,
+// dirty paint (widgets invalidate on state, geometry and content changes) and idle tasks. Without any, NextDeadline
+// is Never and the host can block on its message queue - an idle tree (incl. shown overlays) costs no CPU.
+// Frames are paced to the frame interval; idle tasks run in what's left of the interval after a frame.
+//
+// Host loop sketch:
+//     double wait = scheduler.NextDeadline() - scheduler.Now();    // Never => wait for messages only
+//     MsgWaitForMultipleObjects(..., wait == Never ? INFINITE : ms(wait), QS_ALLINPUT);
+//     ...pump messages (Root::PostMouseEvent/PostKeyEvent...)...
+//     if(scheduler.IsFrameDue()) scheduler.RunFrame(render);
+class FrameScheduler {
+    public:
+        static constexpr double Never = std::numeric_limits<double>::infinity();
+
+        // Must render the tree before returning (it clears the dirty flags) - e.g. InitRender into the back buffer
+        // and blit the damaged area, or Root::SubmitFrame when rendering is threaded
+        using RenderCallback = std::function<void(Root& root, const RECT& damage)>;
+
+        explicit FrameScheduler(Root& root);
+
+        // Time source in seconds (steady clock by default); replace with a fake clock for headless tests
+        void SetClock(std::function<double()> clock) { this->clock = std::move(clock); }
+        double Now() const { return clock(); }
+
+        void SetFrameInterval(double seconds) { frameInterval = seconds; }
+        double GetFrameInterval() const { return frameInterval; }
+
+        // --- Pending work ---
+        bool NeedsFrame() const;
+        double NextDeadline() const;    // Time the next frame should start (Never if nothing is pending)
+        bool IsFrameDue() const { return Now() >= NextDeadline(); }
+
+        // Deferred work (lazy popup construction, cache warming...) - runs after frames, within the frame interval
+        // At least one task runs per frame that had nothing to render, so tasks never starve
+        void PostIdleTask(InlineFunction<void()> task) { idleTasks.push_back(std::move(task)); }
+        size_t GetIdleTaskCount() const { return idleTasks.size(); }
+
+        // Data produced off the UI thread outside the Root's queues (e.g. Plot sample feeds)
+        // NeedsFrame asks hasPending (while producers run); poll moves the data in at the start of every frame
+        // Returns an id for RemovePoller - remove the poller before anything it captures dies
+        size_t AddPoller(InlineFunction<bool()> hasPending, InlineFunction<void()> poll);
+        void RemovePoller(size_t id);
+
+        // --- Frame ---
+        // Input, property updates, observable changes, pollers, animations, rendering (only if something is dirty),
+        // then idle tasks
+        // Returns true if the frame rendered
+        bool RunFrame(const RenderCallback& render);
+
+    private:
+        Root& root;
+        std::function<double()> clock;
+        double frameInterval = 1.0 / 60.0;
+
+        double lastFrameStart = -Never;
+        bool animatedLastFrame = false; // Animations advance by real frame time only while running
+        std::deque<InlineFunction<void()>> idleTasks;
+
+        struct Poller {
+            size_t id;
+            InlineFunction<bool()> hasPending;
+            InlineFunction<void()> poll;
+        };
+        std::vector<Poller> pollers;
+        size_t nextPollerId = 1;
+
+        void RunIdleTasks(double frameStart, bool rendered);
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+// Sequence with a movable hole at the last edit position
+// Edits at (or near) the previous edit only move the few items between them; the storage doubles when
+// the hole runs out, so typing is O(1) amortized regardless of the content size
+template<typename T>
+class GapBuffer {
+    public:
+        size_t Size() const { return data.size() - GapLength(); }
+        bool Empty() const { return Size() == 0; }
+
+        T operator[](size_t i) const { return i < gapStart ? data[i] : data[i + GapLength()]; }
+
+        void Insert(size_t pos, const T* items, size_t count) {
+            if(count == 0) return;
+            if(count > GapLength()) Grow(count);
+
+            MoveGap(std::min(pos, Size()));
+            std::copy(items, items + count, data.begin() + gapStart);
+            gapStart += count;
+        }
+
+        void Erase(size_t pos, size_t count) {
+            if(pos >= Size()) return;
+            count = std::min(count, Size() - pos);
+
+            MoveGap(pos);
+            gapEnd += count; // Erased items just become part of the hole
+        }
+
+        void Assign(const T* items, size_t count) {
+            data.assign(items, items + count);
+            data.resize(count + MinGap);
+            gapStart = count;
+            gapEnd = data.size();
+        }
+
+        void Clear() {
+            gapStart = 0;
+            gapEnd = data.size();
+        }
+
+        // Copies [pos, pos + count) to out (the range may span the hole)
+        void CopyTo(size_t pos, size_t count, T* out) const {
+            size_t end = std::min(pos + count, Size());
+            for(; pos < end && pos < gapStart; pos++) *out++ = data[pos];
+            if(pos < end) {
+                out = std::copy(data.begin() + pos + GapLength(), data.begin() + end + GapLength(), out);
+            }
+        }
+
+    private:
+        static constexpr size_t MinGap = 64;
+
+        std::vector<T> data;
+        size_t gapStart = 0;
+        size_t gapEnd = 0;
+
+        size_t GapLength() const { return gapEnd - gapStart; }
+
+        void MoveGap(size_t pos) {
+            if(pos < gapStart) {
+                // Items [pos, gapStart) move behind the hole
+                size_t count = gapStart - pos;
+                std::move_backward(data.begin() + pos, data.begin() + gapStart, data.begin() + gapEnd);
+                gapStart = pos;
+                gapEnd -= count;
+            }
+            else if(pos > gapStart) {
+                // Items right after the hole move before it
+                size_t count = pos - gapStart;
+                std::move(data.begin() + gapEnd, data.begin() + gapEnd + count, data.begin() + gapStart);
+                gapStart = pos;
+                gapEnd += count;
+            }
+        }
+
+        void Grow(size_t needed) {
+            size_t size = Size();
+            size_t capacity = std::max(data.size() * 2, size + needed + MinGap);
+
+            std::vector<T> grown(capacity);
+            std::move(data.begin(), data.begin() + gapStart, grown.begin());
+            size_t tail = data.size() - gapEnd;
+            std::move(data.begin() + gapEnd, data.end(), grown.end() - tail);
+
+            gapEnd = capacity - tail;
+            data.swap(grown);
+        }
+};
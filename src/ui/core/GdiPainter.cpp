@@ -0,0 +1,41 @@
+#include "GdiPainter.h"
+#include "ScopedGDI.h"
+
+GdiPainter::~GdiPainter() {
+    // Restore the DC if clips were left pushed
+    if(!savedStates.empty()) {
+        RestoreDC(hdc, savedStates.front());
+    }
+}
+
+void GdiPainter::FillRect(const RECT& r, const Color& color) {
+    ScopedOwnedBrush brush(hdc, color.toCOLORREF());
+    ::FillRect(hdc, &r, brush.get());
+}
+
+void GdiPainter::DrawString(const wchar_t* text, int length, const RECT& r, UINT format, HFONT font, const Color& color) {
+    if(!text) return;
+
+    RECT textRect = r; // DrawTextW takes a non-const rect
+    SetBkMode(hdc, TRANSPARENT);
+    ::SetTextColor(hdc, color.toCOLORREF());
+    ScopedSelectFont selFont(hdc, font ? font : (HFONT)GetStockObject(DEFAULT_GUI_FONT));
+    DrawTextW(hdc, text, length, &textRect, format);
+}
+
+void GdiPainter::DrawLine(int x0, int y0, int x1, int y1, const Color& color) {
+    ScopedOwnedPen pen(hdc, PS_SOLID, 1, color.toCOLORREF());
+    MoveToEx(hdc, x0, y0, nullptr);
+    LineTo(hdc, x1, y1);
+}
+
+void GdiPainter::PushClip(const RECT& r) {
+    savedStates.push_back(SaveDC(hdc));
+    IntersectClipRect(hdc, r.left, r.top, r.right, r.bottom);
+}
+
+void GdiPainter::PopClip() {
+    if(savedStates.empty()) return;
+    RestoreDC(hdc, savedStates.back());
+    savedStates.pop_back();
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <vector>
+#include <windows.h>
+
+#include "Painter.h"
+
+// Immediate GDI drawing into a DC
+class GdiPainter : public Painter {
+    public:
+        explicit GdiPainter(HDC hdc) : hdc(hdc) {}
+        ~GdiPainter();
+
+        GdiPainter(const GdiPainter&) = delete;
+        GdiPainter& operator=(const GdiPainter&) = delete;
+
+        HDC GetHDC() const { return hdc; }
+
+        void FillRect(const RECT& r, const Color& color) override;
+        void DrawString(const wchar_t* text, int length, const RECT& r, UINT format, HFONT font, const Color& color) override;
+        void DrawLine(int x0, int y0, int x1, int y1, const Color& color) override;
+
+        void PushClip(const RECT& r) override;
+        void PopClip() override;
+
+    private:
+        HDC hdc{};
+        std::vector<int> savedStates; // SaveDC ids of pushed clips
+};
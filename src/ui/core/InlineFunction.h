@@ -0,0 +1,115 @@
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+template<typename Signature, size_t Capacity = 32>
+class InlineFunction;
+
+// Move-only std::function replacement with small buffer storage
+// Callables up to Capacity bytes (e.g. lambdas capturing `this` and a few values) are stored inline - no heap allocation
+// Bigger callables still work, but fall back to the heap
+template<typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+    public:
+        InlineFunction() = default;
+        InlineFunction(std::nullptr_t) {}
+
+        template<typename F, typename Fn = std::decay_t<F>,
+                 typename = std::enable_if_t<!std::is_same<Fn, InlineFunction>::value>>
+        InlineFunction(F&& f) {
+            // Like std::function, a null function pointer makes an empty function (not one that crashes when called)
+            if constexpr(std::is_pointer<std::remove_reference_t<F>>::value) {
+                if(f == nullptr) return;
+            }
+
+            if constexpr(FitsInline<Fn>()) {
+                new (storage) Fn(std::forward<F>(f));
+                ops = &InlineOps<Fn>::table;
+            }
+            else {
+                new (storage) Fn*(new Fn(std::forward<F>(f)));
+                ops = &HeapOps<Fn>::table;
+            }
+        }
+
+        InlineFunction(InlineFunction&& other) noexcept { MoveFrom(other); }
+        InlineFunction& operator=(InlineFunction&& other) noexcept {
+            if(this != &other) {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+        InlineFunction& operator=(std::nullptr_t) {
+            Reset();
+            return *this;
+        }
+
+        InlineFunction(const InlineFunction&) = delete;
+        InlineFunction& operator=(const InlineFunction&) = delete;
+
+        ~InlineFunction() { Reset(); }
+
+        R operator()(Args... args) const {
+            return ops->invoke(const_cast<unsigned char*>(storage), std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const { return ops != nullptr; }
+        bool IsInline() const { return ops && ops->isInline; }
+
+        void Reset() {
+            if(!ops) return;
+            ops->destroy(storage);
+            ops = nullptr;
+        }
+
+    private:
+        struct Ops {
+            R (*invoke)(void* storage, Args&&... args);
+            void (*move)(void* dst, void* src);     // Move constructs into dst and destroys src
+            void (*destroy)(void* storage);
+            bool isInline;
+        };
+
+        template<typename Fn>
+        static constexpr bool FitsInline() {
+            return sizeof(Fn) <= Capacity
+                && alignof(Fn) <= alignof(std::max_align_t)
+                && std::is_nothrow_move_constructible<Fn>::value;
+        }
+
+        template<typename Fn>
+        struct InlineOps {
+            static R Invoke(void* s, Args&&... args) { return (*static_cast<Fn*>(s))(std::forward<Args>(args)...); }
+            static void Move(void* dst, void* src) {
+                new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+                static_cast<Fn*>(src)->~Fn();
+            }
+            static void Destroy(void* s) { static_cast<Fn*>(s)->~Fn(); }
+            static constexpr Ops table = {&Invoke, &Move, &Destroy, true};
+        };
+
+        template<typename Fn>
+        struct HeapOps {
+            static Fn*& Ptr(void* s) { return *static_cast<Fn**>(s); }
+            static R Invoke(void* s, Args&&... args) { return (*Ptr(s))(std::forward<Args>(args)...); }
+            static void Move(void* dst, void* src) { new (dst) Fn*(Ptr(src)); } // Just steal the pointer
+            static void Destroy(void* s) { delete Ptr(s); }
+            static constexpr Ops table = {&Invoke, &Move, &Destroy, false};
+        };
+
+        static_assert(Capacity >= sizeof(void*), "Capacity must fit at least a pointer (heap fallback)");
+
+        alignas(std::max_align_t) unsigned char storage[Capacity];
+        const Ops* ops = nullptr;
+
+        void MoveFrom(InlineFunction& other) {
+            if(!other.ops) return;
+            other.ops->move(storage, other.storage);
+            ops = other.ops;
+            other.ops = nullptr;
+        }
+};
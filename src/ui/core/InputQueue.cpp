@@ -0,0 +1,40 @@
+#include "InputQueue.h"
+
+size_t InputQueue::Dispatch(const Dispatcher& dispatch) {
+    batch.clear();
+
+    InputEvent e;
+    while(queue.Pop(e)) {
+        batch.push_back(e);
+    }
+
+    size_t dispatched = 0;
+    for(size_t i = 0; i < batch.size(); i++) {
+        if(!IsMove(batch[i])) {
+            moveHistory.clear();
+            dispatch(batch[i]);
+            dispatched++;
+            continue;
+        }
+
+        // Collapse the run of consecutive moves into its last position
+        moveHistory.clear();
+        size_t last = i;
+        while(true) {
+            if(keepMoveHistory) {
+                moveHistory.push_back(batch[last].mouse.pos);
+            }
+            if(last + 1 >= batch.size() || !IsMove(batch[last + 1])) {
+                break;
+            }
+            last++;
+        }
+
+        dispatch(batch[last]);
+        dispatched++;
+        i = last;
+    }
+
+    moveHistory.clear();
+    return dispatched;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include "Widget.h"
+#include "MpscQueue.h"
+
+// Using uint8_t instead of int for optimization
+enum class InputEventKind : uint8_t { Mouse, Key, Char };
+
+struct InputEvent {
+    InputEventKind kind = InputEventKind::Mouse;
+    MouseEvent mouse{};     // Mouse only
+    KeyEvent key{};         // Key only
+    CharEvent character{};  // Char only
+};
+
+// Raw input buffered between frames
+// Any thread (window procedure, input thread, replay...) may post; the UI thread dispatches once per frame
+// Consecutive Move events are coalesced into the last one; everything else (incl. keyboard) keeps its relative order
+class InputQueue {
+    public:
+        using Dispatcher = std::function<void(const InputEvent&)>;
+
+        // Any thread
+        void Post(const MouseEvent& e) { InputEvent ie; ie.mouse = e; queue.Push(ie); }
+        void Post(const KeyEvent& e) { InputEvent ie; ie.kind = InputEventKind::Key; ie.key = e; queue.Push(ie); }
+        void Post(const CharEvent& e) { InputEvent ie; ie.kind = InputEventKind::Char; ie.character = e; queue.Push(ie); }
+
+        // UI thread only - returns the number of events dispatched (after coalescing)
+        size_t Dispatch(const Dispatcher& dispatch);
+        bool HasPending() const { return !queue.IsEmpty(); }
+
+        // Optionally keep every raw position of a coalesced Move run (e.g. for precise dragging/drawing)
+        void SetKeepMoveHistory(bool keep) { keepMoveHistory = keep; }
+        bool IsKeepingMoveHistory() const { return keepMoveHistory; }
+        // Raw positions (oldest first, last one = dispatched position) of the Move currently being dispatched
+        const std::vector<POINT>& GetMoveHistory() const { return moveHistory; }
+
+    private:
+        static bool IsMove(const InputEvent& e) { return e.kind == InputEventKind::Mouse && e.mouse.type == MouseEventType::Move; }
+
+        MpscQueue<InputEvent> queue;
+        bool keepMoveHistory = false;
+
+        // Dispatch scratch (reused between frames)
+        std::vector<InputEvent> batch;
+        std::vector<POINT> moveHistory;
+};
@@ -0,0 +1,168 @@
+#include <chrono>
+
+#include "InputReplayer.h"
+#include "LayoutProfiler.h"
+#include "Root.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(Clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+    }
+
+    // FNV-1a
+    struct Hasher {
+        uint64_t h = 1469598103934665603ull;
+
+        void Mix(uint64_t v) {
+            h ^= v;
+            h *= 1099511628211ull;
+        }
+        void MixRect(const RECT& r) {
+            Mix(static_cast<uint32_t>(r.left));
+            Mix(static_cast<uint32_t>(r.top));
+            Mix(static_cast<uint32_t>(r.right));
+            Mix(static_cast<uint32_t>(r.bottom));
+        }
+        void MixColor(const Color& c) {
+            Mix((uint64_t(c.a) << 24) | (uint64_t(c.r) << 16) | (uint64_t(c.g) << 8) | uint64_t(c.b));
+        }
+    };
+
+    void HashWidget(Hasher& hasher, const Widget& w) {
+        hasher.MixRect(w.GetRect());
+        hasher.Mix((w.IsDisplayed() ? 1 : 0) | (w.IsVisible() ? 2 : 0) | (w.IsEnabled() ? 4 : 0));
+
+        if(auto* container = dynamic_cast<const Container*>(&w)) {
+            hasher.Mix(container->Children().size());
+            for(const auto& child : container->Children()) {
+                HashWidget(hasher, *child);
+            }
+        }
+    }
+
+    Widget* ResolvePath(Root& root, const std::vector<uint32_t>& path) {
+        Widget* current = &root;
+        for(size_t i = 0; i < path.size(); i++) {
+            uint32_t idx = path[i];
+            if(i == 0 && (idx & OverlayPathFlag)) {
+                size_t overlay = idx & ~OverlayPathFlag;
+                if(overlay >= root.GetOverlayCount()) {
+                    return nullptr;
+                }
+                current = root.GetOverlay(overlay);
+                continue;
+            }
+
+            auto* container = dynamic_cast<Container*>(current);
+            if(!container || idx >= container->Children().size()) {
+                return nullptr;
+            }
+            current = container->Children()[idx].get();
+        }
+        return current;
+    }
+}
+
+double ReplayReport::TotalMs() const {
+    double total = 0;
+    for(const FrameTiming& f : frames) {
+        total += f.dispatchMs + f.layoutMs + f.renderMs;
+    }
+    return total;
+}
+
+ReplayReport InputReplayer::Run(Root& root, const InputTrace& trace) {
+    ReplayReport report;
+    report.frames.reserve(trace.GetFrameCount());
+
+    if(trace.GetRootWidth() > 0 && trace.GetRootHeight() > 0) {
+        root.SetSize(trace.GetRootWidth(), trace.GetRootHeight());
+    }
+
+    RenderSnapshot snapshot;
+    FrameTiming frame;
+    double frameLayoutMs = 0;
+
+    // Collect layout time of everything happening during the replay
+    double* previousSink = LayoutProfiler::Sink();
+    LayoutProfiler::Sink() = &frameLayoutMs;
+
+    for(const TraceRecord& r : trace.Records()) {
+        switch(r.kind) {
+            case TraceRecordKind::Mouse: {
+                double layoutBefore = frameLayoutMs;
+                auto start = Clock::now();
+                root.InitFeedMouseEvent(r.mouse);
+                frame.dispatchMs += ElapsedMs(start) - (frameLayoutMs - layoutBefore);
+                frame.events++;
+                break;
+            }
+
+            case TraceRecordKind::Key:
+            case TraceRecordKind::Char: {
+                double layoutBefore = frameLayoutMs;
+                auto start = Clock::now();
+                if(r.kind == TraceRecordKind::Key) root.FeedKeyEvent(r.key);
+                else root.FeedCharEvent(r.character);
+                frame.dispatchMs += ElapsedMs(start) - (frameLayoutMs - layoutBefore);
+                frame.events++;
+                break;
+            }
+
+            case TraceRecordKind::Mutation: {
+                Widget* target = ResolvePath(root, r.widgetPath);
+                if(!target) {
+                    report.skippedMutations++;
+                    break;
+                }
+                double layoutBefore = frameLayoutMs;
+                auto start = Clock::now();
+                target->ApplyProperty(r.property, r.value);
+                frame.dispatchMs += ElapsedMs(start) - (frameLayoutMs - layoutBefore);
+                frame.events++;
+                break;
+            }
+
+            case TraceRecordKind::Frame: {
+                snapshot.Clear();
+                auto start = Clock::now();
+                root.RecordSnapshot(snapshot);
+                frame.renderMs = ElapsedMs(start);
+
+                frame.layoutMs = frameLayoutMs;
+                report.frames.push_back(frame);
+                frame = FrameTiming{};
+                frameLayoutMs = 0;
+                break;
+            }
+        }
+    }
+
+    LayoutProfiler::Sink() = previousSink;
+
+    // Trailing events without a frame boundary still affect the final state
+    snapshot.Clear();
+    root.RecordSnapshot(snapshot);
+    report.finalStateHash = HashState(root, snapshot);
+    return report;
+}
+
+uint64_t InputReplayer::HashState(const Widget& root, const RenderSnapshot& lastFrame) {
+    Hasher hasher;
+    HashWidget(hasher, root);
+
+    for(const DrawCommand& cmd : lastFrame.Commands()) {
+        hasher.Mix(static_cast<uint8_t>(cmd.op));
+        hasher.MixColor(cmd.color);
+        hasher.Mix(cmd.format);
+        hasher.MixRect(cmd.rect);
+
+        const wchar_t* text = lastFrame.Text(cmd);
+        for(uint32_t i = 0; i < cmd.textLength; i++) {
+            hasher.Mix(static_cast<uint16_t>(text[i]));
+        }
+    }
+    return hasher.h;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "InputTrace.h"
+#include "RenderSnapshot.h"
+
+class Root;
+
+struct FrameTiming {
+    double dispatchMs = 0;  // Input dispatch + mutations (without the layout time below)
+    double layoutMs = 0;    // Relayouts triggered during the frame
+    double renderMs = 0;    // Recording the frame snapshot
+    size_t events = 0;      // Input events + mutations replayed in the frame
+};
+
+struct ReplayReport {
+    std::vector<FrameTiming> frames;
+    size_t skippedMutations = 0; // Target widget path no longer exists in the tree
+    uint64_t finalStateHash = 0; // Geometry + visual state of the tree and the last rendered frame
+
+    double TotalMs() const;
+};
+
+// Headless driver: feeds a recorded trace through a widget tree and times every frame
+// Nothing is drawn - frames are recorded into a RenderSnapshot, so it runs without a window
+class InputReplayer {
+    public:
+        // The tree should be built the same way as when recording (mutations address widgets by child index path)
+        static ReplayReport Run(Root& root, const InputTrace& trace);
+
+        // Stable hash of the tree state; font handles are left out since they differ per process
+        static uint64_t HashState(const Widget& root, const RenderSnapshot& lastFrame);
+};
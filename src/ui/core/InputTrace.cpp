@@ -0,0 +1,335 @@
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+#include "InputTrace.h"
+#include "Root.h"
+
+namespace {
+    const uint8_t TraceMagic[4] = {'G', 'D', 'K', 'T'};
+    const uint8_t TraceVersion = 2; // 2: key/char records (version 1 traces still load)
+
+    // Value kinds (index of the PropertyValue alternative)
+    enum : uint8_t { ValueText, ValueFloat, ValueBool, ValueColor };
+
+    // Last enumerators - anything above is rejected, so corrupt or newer traces never reach the replayer's switches
+    const uint8_t LastMouseEventType = static_cast<uint8_t>(MouseEventType::Click);
+    const uint8_t LastMouseButton = static_cast<uint8_t>(MouseButton::Right);
+    const uint8_t LastPropertyID = static_cast<uint8_t>(PropertyID::Height);
+
+    void WriteVarint(std::vector<uint8_t>& out, uint64_t v) {
+        while(v >= 0x80) {
+            out.push_back(static_cast<uint8_t>(v) | 0x80);
+            v >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(v));
+    }
+    void WriteSigned(std::vector<uint8_t>& out, int64_t v) {
+        WriteVarint(out, (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63)); // zigzag
+    }
+
+    // Bounds-checked reader
+    struct Reader {
+        const uint8_t* data;
+        size_t size;
+        size_t pos = 0;
+        bool ok = true;
+
+        uint8_t Byte() {
+            if(pos >= size) { ok = false; return 0; }
+            return data[pos++];
+        }
+        uint64_t Varint() {
+            uint64_t v = 0;
+            for(int shift = 0; shift < 64; shift += 7) {
+                uint8_t b = Byte();
+                if(!ok) return 0;
+                v |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if(!(b & 0x80)) return v;
+            }
+            ok = false;
+            return 0;
+        }
+        int64_t Signed() {
+            uint64_t v = Varint();
+            return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+        }
+    };
+}
+
+// --- InputTrace ------------------------------------------------------
+size_t InputTrace::GetFrameCount() const {
+    return std::count_if(records.begin(), records.end(), [](const TraceRecord& r) {
+        return r.kind == TraceRecordKind::Frame;
+    });
+}
+
+std::vector<uint8_t> InputTrace::Serialize() const {
+    std::vector<uint8_t> out(TraceMagic, TraceMagic + 4);
+    out.push_back(TraceVersion);
+    WriteSigned(out, rootWidth);
+    WriteSigned(out, rootHeight);
+
+    POINT last = {0, 0};
+    for(const TraceRecord& r : records) {
+        out.push_back(static_cast<uint8_t>(r.kind));
+
+        switch(r.kind) {
+            case TraceRecordKind::Frame:
+                break;
+
+            case TraceRecordKind::Mouse:
+                out.push_back(static_cast<uint8_t>(static_cast<uint8_t>(r.mouse.type) | (static_cast<uint8_t>(r.mouse.button) << 4)));
+                WriteSigned(out, static_cast<int64_t>(r.mouse.pos.x) - last.x);
+                WriteSigned(out, static_cast<int64_t>(r.mouse.pos.y) - last.y);
+                last = r.mouse.pos;
+                break;
+
+            case TraceRecordKind::Key:
+                // type | repeat << 1 | modifiers << 2
+                out.push_back(static_cast<uint8_t>(static_cast<uint8_t>(r.key.type) | (r.key.repeat ? 2 : 0) |
+                                                   (static_cast<uint8_t>(r.key.modifiers) << 2)));
+                WriteVarint(out, r.key.key);
+                break;
+
+            case TraceRecordKind::Char:
+                WriteVarint(out, static_cast<uint16_t>(r.character.character));
+                break;
+
+            case TraceRecordKind::Mutation: {
+                WriteVarint(out, r.widgetPath.size());
+                for(uint32_t idx : r.widgetPath) {
+                    WriteVarint(out, idx);
+                }
+                out.push_back(static_cast<uint8_t>(r.property));
+                out.push_back(static_cast<uint8_t>(r.value.index()));
+
+                if(auto* text = std::get_if<std::wstring>(&r.value)) {
+                    WriteVarint(out, text->size());
+                    for(wchar_t ch : *text) {
+                        WriteVarint(out, static_cast<uint16_t>(ch));
+                    }
+                }
+                else if(auto* f = std::get_if<float>(&r.value)) {
+                    uint32_t bits;
+                    memcpy(&bits, f, sizeof(bits));
+                    for(int i = 0; i < 4; i++) out.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+                }
+                else if(auto* b = std::get_if<bool>(&r.value)) {
+                    out.push_back(*b ? 1 : 0);
+                }
+                else if(auto* c = std::get_if<Color>(&r.value)) {
+                    out.push_back(c->a);
+                    out.push_back(c->r);
+                    out.push_back(c->g);
+                    out.push_back(c->b);
+                }
+                break;
+            }
+        }
+    }
+    return out;
+}
+
+bool InputTrace::Deserialize(const uint8_t* data, size_t size) {
+    records.clear();
+
+    Reader in{data, size};
+    for(int i = 0; i < 4; i++) {
+        if(in.Byte() != TraceMagic[i]) return false;
+    }
+    uint8_t version = in.Byte();
+    if(version < 1 || version > TraceVersion) return false;
+    rootWidth = static_cast<int>(in.Signed());
+    rootHeight = static_cast<int>(in.Signed());
+
+    POINT last = {0, 0};
+    while(in.ok && in.pos < in.size) {
+        TraceRecord r;
+        r.kind = static_cast<TraceRecordKind>(in.Byte());
+
+        switch(r.kind) {
+            case TraceRecordKind::Frame:
+                break;
+
+            case TraceRecordKind::Mouse: {
+                uint8_t packed = in.Byte();
+                if((packed & 0x0F) > LastMouseEventType || (packed >> 4) > LastMouseButton) return false;
+                r.mouse.type = static_cast<MouseEventType>(packed & 0x0F);
+                r.mouse.button = static_cast<MouseButton>(packed >> 4);
+                r.mouse.pos.x = static_cast<LONG>(last.x + in.Signed());
+                r.mouse.pos.y = static_cast<LONG>(last.y + in.Signed());
+                last = r.mouse.pos;
+                break;
+            }
+
+            case TraceRecordKind::Key: {
+                uint8_t packed = in.Byte();
+                if(packed >> 5) return false; // Unknown modifier bits
+                r.key.type = static_cast<KeyEventType>(packed & 1);
+                r.key.repeat = (packed & 2) != 0;
+                r.key.modifiers = static_cast<KeyModifiers>(packed >> 2);
+                r.key.key = static_cast<UINT>(in.Varint());
+                break;
+            }
+
+            case TraceRecordKind::Char:
+                r.character.character = static_cast<wchar_t>(in.Varint());
+                break;
+
+            case TraceRecordKind::Mutation: {
+                uint64_t depth = in.Varint();
+                if(depth > in.size) return false; // Garbage guard
+                for(uint64_t i = 0; i < depth && in.ok; i++) {
+                    r.widgetPath.push_back(static_cast<uint32_t>(in.Varint()));
+                }
+                uint8_t property = in.Byte();
+                if(property > LastPropertyID) return false;
+                r.property = static_cast<PropertyID>(property);
+
+                switch(in.Byte()) {
+                    case ValueText: {
+                        uint64_t len = in.Varint();
+                        if(len > in.size) return false;
+                        std::wstring text;
+                        text.reserve(static_cast<size_t>(len));
+                        for(uint64_t i = 0; i < len && in.ok; i++) {
+                            text.push_back(static_cast<wchar_t>(in.Varint()));
+                        }
+                        r.value = std::move(text);
+                        break;
+                    }
+                    case ValueFloat: {
+                        uint32_t bits = 0;
+                        for(int i = 0; i < 4; i++) bits |= static_cast<uint32_t>(in.Byte()) << (8 * i);
+                        float f;
+                        memcpy(&f, &bits, sizeof(f));
+                        r.value = f;
+                        break;
+                    }
+                    case ValueBool:
+                        r.value = in.Byte() != 0;
+                        break;
+                    case ValueColor: {
+                        Color c;
+                        c.a = in.Byte();
+                        c.r = in.Byte();
+                        c.g = in.Byte();
+                        c.b = in.Byte();
+                        r.value = c;
+                        break;
+                    }
+                    default:
+                        return false;
+                }
+                break;
+            }
+
+            default:
+                return false;
+        }
+
+        if(!in.ok) return false;
+        records.push_back(std::move(r));
+    }
+    return in.ok;
+}
+
+bool InputTrace::SaveToFile(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if(!file) return false;
+
+    std::vector<uint8_t> bytes = Serialize();
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool InputTrace::LoadFromFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if(!file) return false;
+
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return Deserialize(bytes.data(), bytes.size());
+}
+
+// --- InputRecorder ---------------------------------------------------
+void InputRecorder::Begin(const Root& root) {
+    trace.Clear();
+    trace.SetRootSize(root.GetWidth(), root.GetHeight());
+}
+
+void InputRecorder::RecordMouse(const MouseEvent& e) {
+    TraceRecord r;
+    r.kind = TraceRecordKind::Mouse;
+    r.mouse = e;
+    trace.Add(std::move(r));
+}
+
+void InputRecorder::RecordKey(const KeyEvent& e) {
+    TraceRecord r;
+    r.kind = TraceRecordKind::Key;
+    r.key = e;
+    trace.Add(std::move(r));
+}
+
+void InputRecorder::RecordChar(const CharEvent& e) {
+    TraceRecord r;
+    r.kind = TraceRecordKind::Char;
+    r.character = e;
+    trace.Add(std::move(r));
+}
+
+void InputRecorder::RecordFrame() {
+    trace.Add(TraceRecord{});
+}
+
+void InputRecorder::RecordMutation(const Widget& target, PropertyID property, const PropertyValue& value) {
+    TraceRecord r;
+    r.kind = TraceRecordKind::Mutation;
+    if(!ComputeWidgetPath(target, r.widgetPath)) {
+        return; // Not replayable (e.g. detached widget)
+    }
+    r.property = property;
+    r.value = value;
+    trace.Add(std::move(r));
+}
+
+bool InputRecorder::ComputeWidgetPath(const Widget& w, std::vector<uint32_t>& path) {
+    path.clear();
+
+    const Widget* current = &w;
+    while(Widget* ancestor = current->GetParent()) {
+        auto* parent = dynamic_cast<Container*>(ancestor);
+        if(!parent) {
+            return false;
+        }
+
+        const auto& siblings = parent->Children();
+        auto it = std::find_if(siblings.begin(), siblings.end(), [current](const Container::WidgetPtr& c) {
+            return c.get() == current;
+        });
+        if(it != siblings.end()) {
+            path.push_back(static_cast<uint32_t>(it - siblings.begin()));
+            current = parent;
+            continue;
+        }
+
+        // Overlays aren't children of Root - they're addressed by their position in its overlay stack
+        auto* root = dynamic_cast<const Root*>(parent);
+        if(!root) {
+            return false;
+        }
+        size_t overlay = 0;
+        while(overlay < root->GetOverlayCount() && root->GetOverlay(overlay) != current) {
+            overlay++;
+        }
+        if(overlay == root->GetOverlayCount()) {
+            return false;
+        }
+        path.push_back(OverlayPathFlag | static_cast<uint32_t>(overlay));
+        current = parent;
+    }
+
+    std::reverse(path.begin(), path.end());
+    return true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "Widget.h"
+#include "Property.h"
+
+class Root;
+
+// Using uint8_t instead of int for optimization
+enum class TraceRecordKind : uint8_t {
+    Frame,      // Frame boundary
+    Mouse,      // MouseEvent that reached Root
+    Mutation,   // Programmatic property change (applied deferred/cross-thread update)
+    Key,        // KeyEvent that reached Root
+    Char        // CharEvent that reached Root
+};
+
+// First widget path index of an overlay: the flag plus the overlay's position in Root's stack (bottom to top)
+constexpr uint32_t OverlayPathFlag = 0x80000000u;
+
+struct TraceRecord {
+    TraceRecordKind kind = TraceRecordKind::Frame;
+    MouseEvent mouse{};                 // Mouse only
+    KeyEvent key{};                     // Key only
+    CharEvent character{};              // Char only
+    std::vector<uint32_t> widgetPath;   // Mutation only: child indices from Root (the first may be an overlay)
+    PropertyID property = PropertyID::Text;
+    PropertyValue value;
+};
+
+// Recorded session, serializable to a compact binary form
+// (tagged records; mouse positions are delta + zigzag varint encoded, key codes and characters varints)
+class InputTrace {
+    public:
+        int GetRootWidth() const { return rootWidth; }
+        int GetRootHeight() const { return rootHeight; }
+        void SetRootSize(int w, int h) { rootWidth = w; rootHeight = h; }
+
+        const std::vector<TraceRecord>& Records() const { return records; }
+        void Add(TraceRecord record) { records.push_back(std::move(record)); }
+        void Clear() { records.clear(); }
+        size_t GetFrameCount() const;
+
+        std::vector<uint8_t> Serialize() const;
+        bool Deserialize(const uint8_t* data, size_t size); // False if malformed (incl. out-of-range enum values)
+
+        bool SaveToFile(const std::string& path) const;
+        bool LoadFromFile(const std::string& path);
+
+    private:
+        int rootWidth = 0, rootHeight = 0;
+        std::vector<TraceRecord> records;
+};
+
+// Records everything reaching a Root while attached (Root::SetInputRecorder)
+class InputRecorder {
+    public:
+        void Begin(const Root& root); // Clears the trace and stores the root size
+        const InputTrace& GetTrace() const { return trace; }
+
+        void RecordMouse(const MouseEvent& e);
+        void RecordKey(const KeyEvent& e);
+        void RecordChar(const CharEvent& e);
+        void RecordFrame();
+        void RecordMutation(const Widget& target, PropertyID property, const PropertyValue& value);
+
+        // Child index path from the root, through Children() and Root's overlays (false if detached)
+        static bool ComputeWidgetPath(const Widget& w, std::vector<uint32_t>& path);
+
+    private:
+        InputTrace trace;
+};
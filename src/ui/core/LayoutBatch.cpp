@@ -0,0 +1,40 @@
+#include <unordered_set>
+
+#include "LayoutBatch.h"
+#include "Widget.h"
+
+namespace {
+    // Reflow starts of the running collect scope (reused between scopes to avoid reallocations)
+    std::vector<Widget*>& Collected() {
+        thread_local std::vector<Widget*> widgets;
+        return widgets;
+    }
+}
+
+void LayoutBatch::Collect(Widget& w) {
+    // Where Widget::InvalidateLayout would start the reflow - the topmost ancestor in an unbroken chain of layouts
+    Widget* start = &w;
+    while(Widget* p = start->GetParent()) {
+        if(!p->GetLayout()) break;
+        start = p;
+    }
+
+    auto& collected = Collected();
+    if(collected.empty() || collected.back() != start) collected.push_back(start); // Siblings usually come in a row
+}
+
+LayoutBatch::ScopedCollect::~ScopedCollect() {
+    if(--CollectDepth() > 0) return;
+
+    std::vector<Widget*> starts;
+    starts.swap(Collected());
+
+    std::unordered_set<Widget*> done;
+    for(Widget* w : starts) {
+        if(done.insert(w).second) w->InvalidateLayout();
+    }
+
+    // Hand the storage back
+    starts.clear();
+    if(Collected().empty()) Collected().swap(starts);
+}
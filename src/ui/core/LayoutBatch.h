@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+
+class Widget;
+
+// Deferred relayouts on the current thread
+// ScopedDefer - while a tree is bulk-built (e.g. instantiating a UI description):
+//   Widget::InvalidateLayout is a no-op inside a batch - the builder relayouts the finished subtree once afterwards
+//   Only meant for subtrees that aren't attached to a live Root yet
+// ScopedCollect - while many widgets of a live tree change at once (e.g. a ChangeBatch flush):
+//   Widget::InvalidateLayout only records where the reflow would start; when the outermost scope ends,
+//   each of those reflows runs once. Collected widgets must stay alive (and attached) until then.
+namespace LayoutBatch {
+    inline int& Depth() {
+        thread_local int depth = 0;
+        return depth;
+    }
+    inline bool IsDeferring() { return Depth() > 0; }
+
+    inline int& CollectDepth() {
+        thread_local int depth = 0;
+        return depth;
+    }
+    inline bool IsCollecting() { return CollectDepth() > 0; }
+    void Collect(Widget& w); // Called by Widget::InvalidateLayout inside a ScopedCollect
+
+    class ScopedDefer {
+        public:
+            ScopedDefer() { Depth()++; }
+            ~ScopedDefer() { Depth()--; }
+
+            ScopedDefer(const ScopedDefer&) = delete;
+            ScopedDefer& operator=(const ScopedDefer&) = delete;
+    };
+
+    class ScopedCollect {
+        public:
+            ScopedCollect() { CollectDepth()++; }
+            ~ScopedCollect(); // The outermost scope runs the collected reflows
+
+            ScopedCollect(const ScopedCollect&) = delete;
+            ScopedCollect& operator=(const ScopedCollect&) = delete;
+    };
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+
+// Opt-in measurement of time spent in layout passes on the current thread
+// Only the outermost relayout is timed, so nested invalidations aren't counted twice
+namespace LayoutProfiler {
+    // Accumulator of the current thread (nullptr = profiling off, the default)
+    inline double*& Sink() {
+        thread_local double* sink = nullptr;
+        return sink;
+    }
+    inline int& Depth() {
+        thread_local int depth = 0;
+        return depth;
+    }
+
+    class ScopedTiming {
+        public:
+            ScopedTiming() {
+                counted = Sink() != nullptr;
+                if(!counted) return;
+
+                active = Depth()++ == 0;
+                if(active) start = std::chrono::steady_clock::now();
+            }
+            ~ScopedTiming() {
+                if(!counted) return;
+
+                if(active && Sink()) {
+                    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                    *Sink() += elapsed.count();
+                }
+                Depth()--;
+            }
+
+            ScopedTiming(const ScopedTiming&) = delete;
+            ScopedTiming& operator=(const ScopedTiming&) = delete;
+
+        private:
+            bool counted = false;   // Profiling was on when entering
+            bool active = false;    // Outermost timed scope
+            std::chrono::steady_clock::time_point start;
+    };
+}
@@ -0,0 +1,172 @@
+#include "LayoutScheduler.h"
+
+namespace {
+    // Index of the worker queue owned by the current thread (-1 = not a worker)
+    thread_local int currentWorker = -1;
+
+    // Nesting depth of ForkJoin tasks on the current thread
+    thread_local int taskDepth = 0;
+
+    struct TaskScope {
+        TaskScope() { taskDepth++; }
+        ~TaskScope() { taskDepth--; }
+    };
+}
+
+LayoutScheduler& LayoutScheduler::Get() {
+    static LayoutScheduler instance;
+    return instance;
+}
+
+LayoutScheduler::~LayoutScheduler() {
+    Stop();
+}
+
+void LayoutScheduler::SetWorkerCount(unsigned count) {
+    Stop();
+    if(count == 0) return;
+
+    queues.clear();
+    for(unsigned i = 0; i < count + 1; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    running.store(true, std::memory_order_release);
+    for(unsigned i = 0; i < count; i++) {
+        workers.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+}
+
+void LayoutScheduler::Stop() {
+    if(workers.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running.store(false, std::memory_order_release);
+    }
+    sleepSignal.notify_all();
+    for(auto& w : workers) {
+        w.join();
+    }
+    workers.clear();
+    queues.clear();
+}
+
+LayoutScheduler::WorkQueue& LayoutScheduler::LocalQueue() {
+    return currentWorker >= 0 ? *queues[currentWorker] : *queues.back();
+}
+
+bool LayoutScheduler::InTask() {
+    return taskDepth > 0;
+}
+
+void LayoutScheduler::Execute(const Task& task) {
+    {
+        TaskScope scope;
+        (*task.fn)(task.index);
+    }
+    task.pending->fetch_sub(1, std::memory_order_acq_rel);
+}
+
+bool LayoutScheduler::TryRunOne(size_t preferredQueue) {
+    Task task;
+    bool found = false;
+
+    // Own queue first (newest task)
+    {
+        WorkQueue& own = *queues[preferredQueue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if(!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // Steal the oldest task from the others
+    for(size_t i = 1; !found && i < queues.size(); i++) {
+        WorkQueue& victim = *queues[(preferredQueue + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if(!found) return false;
+
+    queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    Execute(task);
+    return true;
+}
+
+void LayoutScheduler::WorkerLoop(size_t index) {
+    currentWorker = static_cast<int>(index);
+
+    while(true) {
+        if(TryRunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepSignal.wait(lock, [this]() {
+            return !running.load(std::memory_order_acquire) || queuedTasks.load(std::memory_order_relaxed) > 0;
+        });
+        if(!running.load(std::memory_order_acquire)) {
+            return;
+        }
+    }
+}
+
+void LayoutScheduler::ForkJoin(
+    size_t count,
+    const std::function<bool(size_t)>& spawn,
+    const std::function<void(size_t)>& task
+) {
+    TaskScope scope; // Inline tasks (and the ones run while helping) count as tasks too
+
+    if(workers.empty()) {
+        // Serial fallback
+        for(size_t i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> pending{0};
+    size_t ownQueue = currentWorker >= 0 ? static_cast<size_t>(currentWorker) : queues.size() - 1;
+
+    // Publish the heavy subtrees first so idle workers can start stealing right away
+    size_t spawned = 0;
+    {
+        WorkQueue& local = *queues[ownQueue];
+        std::lock_guard<std::mutex> lock(local.mutex);
+        for(size_t i = 0; i < count; i++) {
+            if(spawn(i)) {
+                local.tasks.push_back({&task, i, &pending});
+                spawned++;
+            }
+        }
+        pending.store(spawned, std::memory_order_release);
+    }
+    if(spawned > 0) {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            queuedTasks.fetch_add(spawned, std::memory_order_relaxed);
+        }
+        sleepSignal.notify_all();
+    }
+
+    // Light subtrees inline
+    for(size_t i = 0; i < count; i++) {
+        if(!spawn(i)) {
+            task(i);
+        }
+    }
+
+    // Help until every spawned task has finished (possibly running tasks from unrelated ForkJoins)
+    while(pending.load(std::memory_order_acquire) > 0) {
+        if(!TryRunOne(ownQueue)) {
+            std::this_thread::yield();
+        }
+    }
+}
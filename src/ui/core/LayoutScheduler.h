@@ -0,0 +1,74 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+// Opt-in work-stealing scheduler for laying out independent sibling subtrees in parallel
+// Each sibling subtree only writes its own widgets, so results are identical to serial layout
+// Disabled by default (0 workers) - layout then runs serially exactly as before
+class LayoutScheduler {
+    public:
+        LayoutScheduler(const LayoutScheduler&) = delete;
+        LayoutScheduler& operator=(const LayoutScheduler&) = delete;
+
+        static LayoutScheduler& Get();
+
+        // 0 disables parallel layout; must not be called while a layout pass is running
+        void SetWorkerCount(unsigned count);
+        unsigned GetWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+        bool IsEnabled() const { return !workers.empty(); }
+
+        // Minimum number of widgets in a subtree for it to be worth a separate task
+        void SetSubtreeThreshold(size_t threshold) { subtreeThreshold = threshold; }
+        size_t GetSubtreeThreshold() const { return subtreeThreshold; }
+
+        // Runs task(i) for every i in [0, count)
+        // Indices with spawn(i) == true become stealable tasks, the rest run inline on the calling thread
+        // Returns once everything is done - the calling thread executes pending tasks meanwhile instead of blocking
+        // May be called from several threads at once (e.g. independent Roots laid out concurrently)
+        void ForkJoin(
+            size_t count,
+            const std::function<bool(size_t)>& spawn,
+            const std::function<void(size_t)>& task
+        );
+
+        // True while the current thread runs ForkJoin tasks (shared state like paint damage must not be touched)
+        static bool InTask();
+
+    private:
+        LayoutScheduler() = default;
+        ~LayoutScheduler();
+
+        struct Task {
+            const std::function<void(size_t)>* fn;
+            size_t index;
+            std::atomic<size_t>* pending; // Join counter of the spawning ForkJoin
+        };
+
+        // Owner pushes/pops at the back (LIFO, cache-friendly), thieves steal from the front (FIFO, biggest work)
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::thread> workers;
+        std::vector<std::unique_ptr<WorkQueue>> queues; // One per worker + one shared by external threads (last)
+        std::atomic<size_t> queuedTasks{0};
+        std::atomic<bool> running{false};
+        std::mutex sleepMutex;
+        std::condition_variable sleepSignal;
+
+        size_t subtreeThreshold = 256;
+
+        void Stop();
+        void WorkerLoop(size_t index);
+        WorkQueue& LocalQueue();
+        bool TryRunOne(size_t preferredQueue);
+        static void Execute(const Task& task);
+};
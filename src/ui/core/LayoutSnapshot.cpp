@@ -0,0 +1,224 @@
+#include <cstdio>
+#include <cstring>
+
+#include "LayoutSnapshot.h"
+#include "Container.h"
+
+namespace {
+    const uint8_t SnapshotMagic[4] = {'G', 'D', 'K', 'L'};
+    const uint8_t SnapshotVersion = 1;
+    const int EntryFields = 8; // rect (4), layout size (2), measured content (2)
+
+    void WriteUInt32(std::vector<uint8_t>& out, uint32_t v) {
+        for(int i = 0; i < 4; i++) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+    void WriteUInt64(std::vector<uint8_t>& out, uint64_t v) {
+        for(int i = 0; i < 8; i++) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+    uint32_t ReadUInt32(const uint8_t* p) {
+        uint32_t v = 0;
+        for(int i = 0; i < 4; i++) v |= static_cast<uint32_t>(p[i]) << (8 * i);
+        return v;
+    }
+    uint64_t ReadUInt64(const uint8_t* p) {
+        return ReadUInt32(p) | (static_cast<uint64_t>(ReadUInt32(p + 4)) << 32);
+    }
+
+    // Pre-order walk through Children() - the same order for hashing, capturing and applying
+    template<typename W, typename F>
+    void ForEachInTree(W& root, F&& visit) {
+        std::vector<W*> stack{&root};
+        while(!stack.empty()) {
+            W* w = stack.back();
+            stack.pop_back();
+            visit(*w);
+
+            auto* c = dynamic_cast<const Container*>(w);
+            if(!c) continue;
+            const auto& children = c->Children();
+            for(size_t i = children.size(); i-- > 0;) {
+                if(children[i]) stack.push_back(children[i].get());
+            }
+        }
+    }
+}
+
+// --- LayoutHash ------------------------------------------------------
+void LayoutHash::Add(float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    Add(static_cast<uint64_t>(bits));
+}
+
+void LayoutHash::Add(const std::wstring& text) {
+    Add(static_cast<uint64_t>(text.size()));
+    for(wchar_t c : text) Add(static_cast<uint64_t>(c));
+}
+
+void LayoutHash::AddType(const std::type_info& type) {
+    if(&type != lastType) {
+        auto it = types.find(type);
+        if(it == types.end()) {
+            LayoutHash name;
+            for(const char* c = type.name(); *c; c++) name.Add(static_cast<uint64_t>(*c));
+            it = types.emplace(type, name.Get()).first;
+        }
+        lastType = &type;
+        lastTypeHash = it->second;
+    }
+    Add(lastTypeHash);
+}
+
+void LayoutHash::AddFont(HFONT font) {
+    if(hasLastFont && font == lastFont) {
+        Add(lastFontHash);
+        return;
+    }
+
+    auto it = fonts.find(font);
+    if(it == fonts.end()) {
+        // Handles differ between runs - the description doesn't
+        LayoutHash description;
+        LOGFONTW lf{};
+        if(font && GetObjectW(font, sizeof(lf), &lf)) {
+            description.Add(static_cast<int>(lf.lfHeight));
+            description.Add(static_cast<int>(lf.lfWidth));
+            description.Add(static_cast<int>(lf.lfWeight));
+            description.Add(static_cast<int>(lf.lfItalic));
+            description.Add(static_cast<int>(lf.lfCharSet));
+            for(const WCHAR* c = lf.lfFaceName; *c && c < lf.lfFaceName + 32; c++) description.Add(static_cast<uint64_t>(*c));
+        }
+        it = fonts.emplace(font, description.Get()).first;
+    }
+    hasLastFont = true;
+    lastFont = font;
+    lastFontHash = it->second;
+    Add(lastFontHash);
+}
+
+// --- LayoutSnapshot --------------------------------------------------
+uint64_t LayoutSnapshot::ComputeHash(const Widget& root) {
+    LayoutHash hash;
+
+    // The subtree root is placed within its parent
+    if(const Widget* parent = root.GetParent()) hash.Add(parent->ComputeInnerRect());
+
+    uint64_t count = 0;
+    ForEachInTree(root, [&](const Widget& w) {
+        w.HashLayoutInputs(hash);
+        count++;
+    });
+    hash.Add(count);
+
+    // 0 never matches (Apply refuses empty hashes)
+    return hash.IsCacheable() && hash.Get() != 0 ? hash.Get() : 0;
+}
+
+void LayoutSnapshot::Capture(const Widget& root) {
+    hash = ComputeHash(root);
+    entries.clear();
+    entries.reserve(root.GetSubtreeSize());
+    ForEachInTree(root, [&](const Widget& w) {
+        entries.push_back({w.effectiveRect, w.layoutWidth, w.layoutHeight, w.GetMeasuredContent()});
+    });
+}
+
+bool LayoutSnapshot::Apply(Widget& root) const {
+    if(hash == 0 || ComputeHash(root) != hash) return false; // The hash covers the widget count
+
+    size_t i = 0;
+    ForEachInTree(root, [&](Widget& w) {
+        if(i == entries.size()) return;
+        const Entry& e = entries[i++];
+        w.effectiveRect = e.effectiveRect;
+        w.layoutWidth = e.layoutWidth;
+        w.layoutHeight = e.layoutHeight;
+        w.AdoptMeasuredContent(e.content);
+    });
+
+    // Same notifications as after a layout pass
+    ForEachInTree(root, [](Widget& w) {
+        if(dynamic_cast<Container*>(&w)) w.OnInternalLayoutUpdated();
+    });
+    root.InvalidatePaint();
+    return true;
+}
+
+bool LayoutSnapshot::AdoptOrLayOut(Widget& root, const std::wstring& cachePath) {
+    LayoutSnapshot snapshot;
+    if(snapshot.LoadFromFile(cachePath) && snapshot.Apply(root)) return true;
+
+    root.InvalidateLayout();
+    snapshot.Capture(root);
+    snapshot.SaveToFile(cachePath);
+    return false;
+}
+
+// --- Serialization ---------------------------------------------------
+std::vector<uint8_t> LayoutSnapshot::Serialize() const {
+    std::vector<uint8_t> out(SnapshotMagic, SnapshotMagic + 4);
+    out.push_back(SnapshotVersion);
+    WriteUInt64(out, hash);
+    WriteUInt32(out, static_cast<uint32_t>(entries.size()));
+
+    // Fixed-width records, read back without parsing
+    out.reserve(out.size() + entries.size() * EntryFields * 4);
+    for(const Entry& e : entries) {
+        int32_t fields[EntryFields] = {
+            static_cast<int32_t>(e.effectiveRect.left), static_cast<int32_t>(e.effectiveRect.top),
+            static_cast<int32_t>(e.effectiveRect.right), static_cast<int32_t>(e.effectiveRect.bottom),
+            e.layoutWidth, e.layoutHeight, static_cast<int32_t>(e.content.cx), static_cast<int32_t>(e.content.cy)
+        };
+        for(int32_t f : fields) WriteUInt32(out, static_cast<uint32_t>(f));
+    }
+    return out;
+}
+
+bool LayoutSnapshot::Deserialize(const uint8_t* data, size_t size) {
+    hash = 0;
+    entries.clear();
+
+    const size_t headerSize = 4 + 1 + 8 + 4;
+    if(!data || size < headerSize) return false;
+    if(std::memcmp(data, SnapshotMagic, 4) != 0 || data[4] != SnapshotVersion) return false;
+
+    uint64_t storedHash = ReadUInt64(data + 5);
+    uint32_t count = ReadUInt32(data + 13);
+    if(static_cast<uint64_t>(count) * EntryFields * 4 != size - headerSize) return false;
+
+    entries.resize(count);
+    const uint8_t* p = data + headerSize;
+    for(Entry& e : entries) {
+        int32_t f[EntryFields];
+        for(int k = 0; k < EntryFields; k++, p += 4) f[k] = static_cast<int32_t>(ReadUInt32(p));
+        e.effectiveRect = {f[0], f[1], f[2], f[3]};
+        e.layoutWidth = f[4];
+        e.layoutHeight = f[5];
+        e.content = {f[6], f[7]};
+    }
+    hash = storedHash;
+    return true;
+}
+
+bool LayoutSnapshot::SaveToFile(const std::wstring& path) const {
+    FILE* file = _wfopen(path.c_str(), L"wb");
+    if(!file) return false;
+
+    std::vector<uint8_t> bytes = Serialize();
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+bool LayoutSnapshot::LoadFromFile(const std::wstring& path) {
+    FILE* file = _wfopen(path.c_str(), L"rb");
+    if(!file) return false;
+
+    // One read of the known size - snapshots of big trees are a few hundred KB
+    long size = -1;
+    if(std::fseek(file, 0, SEEK_END) == 0) size = std::ftell(file);
+    std::vector<uint8_t> bytes(size > 0 ? static_cast<size_t>(size) : 0);
+    bool ok = size > 0 && std::fseek(file, 0, SEEK_SET) == 0
+           && std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    std::fclose(file);
+    return ok && Deserialize(bytes.data(), bytes.size());
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <typeinfo>
+#include <typeindex>
+#include <unordered_map>
+#include <windows.h>
+
+class Widget;
+
+// Running hash of layout inputs (see Widget::HashLayoutInputs and Layout::HashInputs)
+class LayoutHash {
+    public:
+        void Add(uint64_t v) {
+            // 64-bit multiply-xorshift mix per word
+            h = (h ^ v) * 0x9E3779B97F4A7C15ull;
+            h ^= h >> 32;
+        }
+        void Add(int v) { Add(static_cast<uint64_t>(static_cast<uint32_t>(v))); }
+        void Add(bool v) { Add(static_cast<uint64_t>(v)); }
+        void Add(float v);
+        void Add(const RECT& r) { Add(static_cast<int>(r.left)); Add(static_cast<int>(r.top)); Add(static_cast<int>(r.right)); Add(static_cast<int>(r.bottom)); }
+        void Add(const std::wstring& text);
+        void AddType(const std::type_info& type); // Type name (stable between runs, unlike hash_code), hashed once per type
+        void AddFont(HFONT font); // Font description (LOGFONT), looked up once per handle
+
+        // Set by inputs that can't be hashed (e.g. a custom layout without HashInputs) - no snapshot ever matches
+        void MarkUncacheable() { cacheable = false; }
+        bool IsCacheable() const { return cacheable; }
+
+        uint64_t Get() const { return h; }
+
+    private:
+        uint64_t h = 0xCBF29CE484222325ull;
+        bool cacheable = true;
+        std::unordered_map<std::type_index, uint64_t> types;
+        std::unordered_map<HFONT, uint64_t> fonts;
+        const std::type_info* lastType = nullptr;   // Siblings mostly share types and fonts
+        uint64_t lastTypeHash = 0;
+        HFONT lastFont = nullptr;
+        uint64_t lastFontHash = 0;
+        bool hasLastFont = false;
+};
+
+// Solved geometry of a widget subtree (effective rects, layout sizes, measured content), saved for the next startup
+// A snapshot is only adopted if the subtree still hashes the same - same structure, geometry properties, layouts,
+// texts and fonts - otherwise the subtree is laid out as usual. Hashing is a plain tree walk (no measuring).
+// Intended for tree tops (a Root, or a subtree whose parent has no layout); overlays are separate subtrees.
+//
+// Startup sketch (no relayout cascade while building, one layout or adoption at the end):
+//     {
+//         LayoutBatch::ScopedDefer defer;
+//         ...build the tree...
+//     }
+//     LayoutSnapshot::AdoptOrLayOut(*root, cachePath);
+class LayoutSnapshot {
+    public:
+        // Hash of everything the layout of the subtree depends on (0 if some input can't be hashed)
+        static uint64_t ComputeHash(const Widget& root);
+
+        // Records the current (solved) geometry of the subtree
+        void Capture(const Widget& root);
+        // Adopts the recorded geometry if the subtree still matches; false = nothing changed, lay out as usual
+        bool Apply(Widget& root) const;
+
+        bool IsEmpty() const { return entries.empty(); }
+        size_t GetWidgetCount() const { return entries.size(); }
+
+        std::vector<uint8_t> Serialize() const;
+        bool Deserialize(const uint8_t* data, size_t size); // False if malformed
+
+        bool SaveToFile(const std::wstring& path) const;
+        bool LoadFromFile(const std::wstring& path);
+
+        // Adopts the cached geometry from the file, or lays the subtree out and rewrites the file
+        // Returns true if the cache was used
+        static bool AdoptOrLayOut(Widget& root, const std::wstring& cachePath);
+
+    private:
+        struct Entry { // Per widget, in pre-order
+            RECT effectiveRect;
+            int layoutWidth, layoutHeight;
+            SIZE content; // Widget::GetMeasuredContent
+        };
+
+        uint64_t hash = 0;
+        std::vector<Entry> entries;
+};
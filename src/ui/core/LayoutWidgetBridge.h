@@ -20,4 +20,7 @@ class LayoutWidgetBridge {
         ) {
             w.SetLayoutSize(width, height);
         }
+        static void ApplyIntrinsicSize(Widget& w) {
+            w.ApplyIntrinsicSize();
+        }
 };
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+// Lock-free multi-producer/single-consumer queue (Vyukov style linked list)
+// Push may be called from any thread; Pop/IsEmpty only from the single consumer thread (usually the UI thread)
+template<typename T>
+class MpscQueue {
+    public:
+        MpscQueue() {
+            Node* stub = new Node();
+            head.store(stub, std::memory_order_relaxed);
+            tail = stub;
+        }
+        ~MpscQueue() {
+            T discarded;
+            while(Pop(discarded)) {}
+            delete tail;
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Producers: never blocks, wait-free apart from the allocation
+        void Push(T value) {
+            Node* node = new Node();
+            node->value = std::move(value);
+            Node* prev = head.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release); // Publish to the consumer
+        }
+
+        // Consumer: returns false if empty
+        // (a producer preempted between exchange and publish makes the queue look empty until it resumes)
+        bool Pop(T& out) {
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if(!next) return false;
+
+            out = std::move(next->value);
+            delete tail;
+            tail = next; // Popped node becomes the new stub
+            return true;
+        }
+
+        bool IsEmpty() const {
+            return tail->next.load(std::memory_order_acquire) == nullptr;
+        }
+
+    private:
+        struct Node {
+            std::atomic<Node*> next{nullptr};
+            T value{};
+        };
+
+        alignas(64) std::atomic<Node*> head;    // Producers side
+        alignas(64) Node* tail;                 // Consumer side
+};
@@ -0,0 +1,49 @@
+#include "Observable.h"
+#include "LayoutBatch.h"
+
+ChangeBatch::~ChangeBatch() {
+    for(ObservableBase* o : pending) {
+        if(o) o->queued = false;
+    }
+}
+
+void ChangeBatch::Enqueue(ObservableBase& o) {
+    o.queued = true;
+    o.queueSlot = pending.size();
+    pending.push_back(&o);
+    pendingCount++;
+}
+
+void ChangeBatch::Dequeue(ObservableBase& o) {
+    if(!o.queued || o.queueSlot >= pending.size() || pending[o.queueSlot] != &o) return;
+    pending[o.queueSlot] = nullptr;
+    o.queued = false;
+    pendingCount--;
+}
+
+size_t ChangeBatch::Flush() {
+    if(flushing || pendingCount == 0) return 0; // Called from an observer - the running flush covers it
+    flushing = true;
+
+    size_t notified = 0;
+    {
+        // One relayout per affected layout, after every observer ran
+        LayoutBatch::ScopedCollect relayouts;
+
+        // By index - observers changing other observables append to the queue
+        for(size_t i = 0; i < pending.size(); i++) {
+            ObservableBase* o = pending[i];
+            if(!o) continue;
+            pending[i] = nullptr;
+            o->queued = false;
+            pendingCount--;
+
+            o->NotifyObservers();
+            notified++;
+        }
+        pending.clear();
+    }
+
+    flushing = false;
+    return notified;
+}
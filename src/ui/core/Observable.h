@@ -0,0 +1,166 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+
+#include "InlineFunction.h"
+
+class ObservableBase;
+
+// Per-frame queue of changed observables (UI thread)
+// Each changed observable is queued once, however often it's set; Flush notifies its observers once with the
+// latest value. Relayouts requested by the observers (e.g. bound labels changing text) are collected and run
+// once per affected layout at the end of the flush. Root owns one (Root::GetChangeBatch, flushed by FrameScheduler).
+// The batch must outlive its observables.
+class ChangeBatch {
+    public:
+        ChangeBatch() = default;
+        ChangeBatch(const ChangeBatch&) = delete;
+        ChangeBatch& operator=(const ChangeBatch&) = delete;
+        ~ChangeBatch();
+
+        // Returns the number of observables notified; observables changed by observers are notified in the same flush
+        size_t Flush();
+        bool HasPending() const { return pendingCount > 0; }
+
+    private:
+        friend class ObservableBase;
+
+        std::vector<ObservableBase*> pending;   // Slots of destroyed/detached observables are nulled
+        size_t pendingCount = 0;
+        bool flushing = false;
+
+        void Enqueue(ObservableBase& o);
+        void Dequeue(ObservableBase& o);
+};
+
+// Non-template part of Observable<T> - the batch bookkeeping
+class ObservableBase {
+    public:
+        ObservableBase(const ObservableBase&) = delete;
+        ObservableBase& operator=(const ObservableBase&) = delete;
+
+        ChangeBatch* GetBatch() const { return batch; }
+        uint32_t GetVersion() const { return version; } // Bumped by every effective change
+
+    protected:
+        explicit ObservableBase(ChangeBatch* batch) : batch(batch) {}
+        ~ObservableBase() { if(batch && queued) batch->Dequeue(*this); }
+
+        void Changed() {
+            version++;
+            if(!batch) {
+                NotifyObservers(); // Unbatched - observers run right away
+                return;
+            }
+            if(!queued) batch->Enqueue(*this);
+        }
+
+    private:
+        friend class ChangeBatch;
+
+        ChangeBatch* batch;
+        size_t queueSlot = 0;
+        uint32_t version = 0;
+        bool queued = false;
+
+        virtual void NotifyObservers() = 0;
+};
+
+// Typed value with change notifications (UI thread; cross-thread producers use Root::PostPropertyUpdate)
+// Set short-circuits on equality, so polling code may set every frame - only real changes reach the observers.
+// With a ChangeBatch, observers are notified once per flush; without, on every change.
+// Observers must not outlive the observable (widget bindings unsubscribe through their Binding handle).
+template<typename T>
+class Observable : public ObservableBase {
+    public:
+        using ObserverID = uint32_t; // 0 = invalid
+        using Observer = InlineFunction<void(const T&)>;
+
+        explicit Observable(ChangeBatch* batch = nullptr, T initial = T{}) :
+            ObservableBase(batch),
+            value(std::move(initial))
+        {}
+        explicit Observable(ChangeBatch& batch, T initial = T{}) : Observable(&batch, std::move(initial)) {}
+
+        const T& Get() const { return value; }
+        operator const T&() const { return value; }
+
+        // Returns true if the value changed
+        bool Set(const T& newValue) {
+            if(value == newValue) return false;
+            value = newValue;
+            Changed();
+            return true;
+        }
+        bool Set(T&& newValue) {
+            if(value == newValue) return false;
+            value = std::move(newValue);
+            Changed();
+            return true;
+        }
+        Observable& operator=(const T& newValue) { Set(newValue); return *this; }
+
+        // Safe to call from within an observer
+        ObserverID Subscribe(Observer observer) {
+            // Added while notifying - appended afterwards (no reallocation under a running observer)
+            auto& list = notifyDepth > 0 ? pendingObservers : observers;
+            list.push_back({std::move(observer), ++lastObserverID});
+            return lastObserverID;
+        }
+        void Unsubscribe(ObserverID id) {
+            for(size_t i = 0; i < pendingObservers.size(); i++) {
+                if(pendingObservers[i].id == id) {
+                    pendingObservers.erase(pendingObservers.begin() + static_cast<std::ptrdiff_t>(i));
+                    return;
+                }
+            }
+            for(size_t i = 0; i < observers.size(); i++) {
+                if(observers[i].id != id) continue;
+                if(notifyDepth > 0) {
+                    observers[i].id = 0; // Compacted after notifying
+                    hasRemoved = true;
+                }
+                else {
+                    observers.erase(observers.begin() + static_cast<std::ptrdiff_t>(i));
+                }
+                return;
+            }
+        }
+        size_t GetObserverCount() const { return observers.size() + pendingObservers.size(); }
+
+    private:
+        struct Entry {
+            Observer fn;
+            ObserverID id;
+        };
+
+        T value;
+        std::vector<Entry> observers;
+        std::vector<Entry> pendingObservers;
+        ObserverID lastObserverID = 0;
+        uint16_t notifyDepth = 0;
+        bool hasRemoved = false;
+
+        void NotifyObservers() override {
+            notifyDepth++;
+            for(size_t i = 0; i < observers.size(); i++) {
+                if(observers[i].id != 0) observers[i].fn(value);
+            }
+            notifyDepth--;
+            if(notifyDepth > 0) return;
+
+            if(hasRemoved) {
+                hasRemoved = false;
+                observers.erase(std::remove_if(observers.begin(), observers.end(), [](const Entry& e) {
+                    return e.id == 0;
+                }), observers.end());
+            }
+            if(!pendingObservers.empty()) {
+                for(Entry& e : pendingObservers) observers.push_back(std::move(e));
+                pendingObservers.clear();
+            }
+        }
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <windows.h>
+
+#include "Color.h"
+
+// Drawing backend used by widgets
+// GdiPainter draws immediately; RecordingPainter records a RenderSnapshot (e.g. for the render thread)
+class Painter {
+    public:
+        virtual ~Painter() {}
+
+        virtual void FillRect(const RECT& r, const Color& color) = 0;
+        // Same semantics as DrawTextW (length -1 = null-terminated); font nullptr = DEFAULT_GUI_FONT
+        virtual void DrawString(const wchar_t* text, int length, const RECT& r, UINT format, HFONT font, const Color& color) = 0;
+        // 1px solid line, end point excluded (a'la MoveToEx/LineTo)
+        virtual void DrawLine(int x0, int y0, int x1, int y1, const Color& color) = 0;
+
+        // Clip stack - PushClip intersects with the current clip, PopClip restores the previous one
+        virtual void PushClip(const RECT& r) = 0;
+        virtual void PopClip() = 0;
+};
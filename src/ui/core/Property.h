@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <variant>
+#include <cstdint>
+
+#include "Color.h"
+
+// Widget properties that can be set generically (e.g. from other threads via Root::PostPropertyUpdate)
+// Using uint8_t instead of int for optimization
+enum class PropertyID : uint8_t {
+    Text,
+    Value,
+    Checked,
+    Displayed,
+    Visible,
+    Enabled,
+    BackgroundColor,
+    TextColor,
+    Width,
+    Height
+};
+
+// Text => std::wstring
+// Value => float
+// Width, Height => float (rounded to pixels)
+// Checked, Displayed, Visible, Enabled => bool
+// BackgroundColor, TextColor => Color
+using PropertyValue = std::variant<std::wstring, float, bool, Color>;
@@ -0,0 +1,45 @@
+#include "PropertyUpdateQueue.h"
+#include "Widget.h"
+
+void PropertyUpdateQueue::Post(const std::shared_ptr<Widget>& target, PropertyID property, PropertyValue value) {
+    if(!target) return;
+
+    Update update;
+    update.target = target;
+    update.key = target.get();
+    update.property = property;
+    update.value = std::move(value);
+    queue.Push(std::move(update));
+}
+
+size_t PropertyUpdateQueue::Drain(const ApplyObserver& observer) {
+    batch.clear();
+    latest.clear();
+
+    // Take everything posted so far, remembering the latest update per (widget, property)
+    Update update;
+    while(queue.Pop(update)) {
+        latest[{update.key, update.property}] = batch.size();
+        batch.push_back(std::move(update));
+    }
+
+    // Apply surviving updates in posting order
+    size_t applied = 0;
+    for(size_t i = 0; i < batch.size(); i++) {
+        Update& u = batch[i];
+        if(latest[{u.key, u.property}] != i) {
+            continue; // Superseded by a later update
+        }
+        if(auto target = u.target.lock()) {
+            if(target->ApplyProperty(u.property, u.value)) {
+                applied++;
+                if(observer) {
+                    observer(*target, u.property, u.value);
+                }
+            }
+        }
+    }
+
+    batch.clear(); // Release widget references and strings early
+    return applied;
+}
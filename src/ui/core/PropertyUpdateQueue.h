@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+#include "Property.h"
+#include "MpscQueue.h"
+
+class Widget;
+
+// Cross-thread property updates (e.g. game thread updating overlay labels)
+// Producers post from any thread; the UI thread drains once per frame
+// Repeated updates of the same property of the same widget are coalesced - only the latest one is applied
+class PropertyUpdateQueue {
+    public:
+        // Called for every applied update (e.g. trace recording)
+        using ApplyObserver = std::function<void(Widget&, PropertyID, const PropertyValue&)>;
+
+        // Any thread
+        void Post(const std::shared_ptr<Widget>& target, PropertyID property, PropertyValue value);
+
+        // UI thread only
+        size_t Drain(const ApplyObserver& observer = nullptr); // Returns the number of updates applied (after coalescing)
+        bool HasPending() const { return !queue.IsEmpty(); }
+
+    private:
+        struct Update {
+            std::weak_ptr<Widget> target;   // Widgets may die before the update is applied
+            Widget* key = nullptr;          // Coalescing key (only compared, never dereferenced)
+            PropertyID property = PropertyID::Text;
+            PropertyValue value;
+        };
+        struct UpdateKey {
+            Widget* widget;
+            PropertyID property;
+            bool operator==(const UpdateKey& o) const { return widget == o.widget && property == o.property; }
+        };
+        struct UpdateKeyHash {
+            size_t operator()(const UpdateKey& k) const {
+                return std::hash<Widget*>()(k.widget) ^ (static_cast<size_t>(k.property) * 0x9E3779B9u);
+            }
+        };
+
+        MpscQueue<Update> queue;
+
+        // Drain scratch (consumer only, reused between frames to avoid reallocations)
+        std::vector<Update> batch;
+        std::unordered_map<UpdateKey, size_t, UpdateKeyHash> latest; // Key => index of the latest update in batch
+};
@@ -0,0 +1,58 @@
+#include <cwchar>
+
+#include "RenderSnapshot.h"
+
+void RenderSnapshot::Clear() {
+    // Keep capacity - snapshots are recycled every frame
+    commands.clear();
+    text.clear();
+}
+
+void RenderSnapshot::AddFillRect(const RECT& r, const Color& color) {
+    commands.push_back({DrawOp::FillRect, color, 0, r, nullptr, 0, 0});
+}
+
+void RenderSnapshot::AddText(const wchar_t* str, int length, const RECT& r, UINT format, HFONT font, const Color& color) {
+    if(!str) return;
+    size_t len = length < 0 ? wcslen(str) : static_cast<size_t>(length);
+
+    uint32_t offset = static_cast<uint32_t>(text.size());
+    text.insert(text.end(), str, str + len);
+    text.push_back(L'\0'); // Keep runs null-terminated for convenience
+
+    commands.push_back({DrawOp::Text, color, format, r, font, offset, static_cast<uint32_t>(len)});
+}
+
+void RenderSnapshot::AddLine(int x0, int y0, int x1, int y1, const Color& color) {
+    commands.push_back({DrawOp::Line, color, 0, RECT{x0, y0, x1, y1}, nullptr, 0, 0});
+}
+
+void RenderSnapshot::AddPushClip(const RECT& r) {
+    commands.push_back({DrawOp::PushClip, Color::FromARGB(0, 0, 0, 0), 0, r, nullptr, 0, 0});
+}
+
+void RenderSnapshot::AddPopClip() {
+    commands.push_back({DrawOp::PopClip, Color::FromARGB(0, 0, 0, 0), 0, RECT{0, 0, 0, 0}, nullptr, 0, 0});
+}
+
+void RenderSnapshot::Replay(Painter& painter) const {
+    for(const DrawCommand& cmd : commands) {
+        switch(cmd.op) {
+            case DrawOp::FillRect:
+                painter.FillRect(cmd.rect, cmd.color);
+                break;
+            case DrawOp::Text:
+                painter.DrawString(Text(cmd), static_cast<int>(cmd.textLength), cmd.rect, cmd.format, cmd.font, cmd.color);
+                break;
+            case DrawOp::Line:
+                painter.DrawLine(cmd.rect.left, cmd.rect.top, cmd.rect.right, cmd.rect.bottom, cmd.color);
+                break;
+            case DrawOp::PushClip:
+                painter.PushClip(cmd.rect);
+                break;
+            case DrawOp::PopClip:
+                painter.PopClip();
+                break;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <windows.h>
+
+#include "Color.h"
+#include "Painter.h"
+
+// Using uint8_t instead of int for optimization
+enum class DrawOp : uint8_t {
+    FillRect,
+    Text,
+    Line,
+    PushClip,
+    PopClip
+};
+
+// Single recorded drawing command
+// Line stores its end points in rect (left,top = start; right,bottom = end)
+struct DrawCommand {
+    DrawOp op;
+    Color color;
+    UINT format;            // DrawTextW flags (Text only)
+    RECT rect;
+    HFONT font;             // Text only (GDI objects are process-wide, so safe to use on the render thread)
+    uint32_t textOffset;    // Into RenderSnapshot text arena (Text only)
+    uint32_t textLength;
+};
+
+// Immutable-once-submitted, compact description of a rendered frame
+// All strings live in a single arena, so a snapshot is just two flat arrays (cheap to reuse between frames)
+class RenderSnapshot {
+    public:
+        void Clear();
+
+        const std::vector<DrawCommand>& Commands() const { return commands; }
+        const wchar_t* Text(const DrawCommand& cmd) const { return text.data() + cmd.textOffset; }
+
+        int GetWidth() const { return width; }
+        int GetHeight() const { return height; }
+        void SetSize(int w, int h) { width = w; height = h; }
+
+        uint64_t GetFrameNumber() const { return frameNumber; }
+        void SetFrameNumber(uint64_t n) { frameNumber = n; }
+
+        // Recording
+        void AddFillRect(const RECT& r, const Color& color);
+        void AddText(const wchar_t* str, int length, const RECT& r, UINT format, HFONT font, const Color& color);
+        void AddLine(int x0, int y0, int x1, int y1, const Color& color);
+        void AddPushClip(const RECT& r);
+        void AddPopClip();
+
+        // Draw the recorded frame with any backend
+        void Replay(Painter& painter) const;
+
+    private:
+        std::vector<DrawCommand> commands;
+        std::vector<wchar_t> text;
+        int width = 0, height = 0;
+        uint64_t frameNumber = 0;
+};
+
+// Painter that records into a snapshot instead of drawing
+class RecordingPainter : public Painter {
+    public:
+        explicit RecordingPainter(RenderSnapshot& snapshot) : snapshot(snapshot) {}
+
+        void FillRect(const RECT& r, const Color& color) override { snapshot.AddFillRect(r, color); }
+        void DrawString(const wchar_t* str, int length, const RECT& r, UINT format, HFONT font, const Color& color) override {
+            snapshot.AddText(str, length, r, format, font, color);
+        }
+        void DrawLine(int x0, int y0, int x1, int y1, const Color& color) override { snapshot.AddLine(x0, y0, x1, y1, color); }
+
+        void PushClip(const RECT& r) override { snapshot.AddPushClip(r); }
+        void PopClip() override { snapshot.AddPopClip(); }
+
+    private:
+        RenderSnapshot& snapshot;
+};
@@ -0,0 +1,59 @@
+#include "RenderThread.h"
+
+RenderThread::RenderThread(Backend backend) :
+    backend(std::move(backend))
+{
+    thread = std::thread([this]() { Run(); });
+}
+
+RenderThread::~RenderThread() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running.store(false, std::memory_order_release);
+    }
+    wakeSignal.notify_one();
+    if(thread.joinable()) {
+        thread.join();
+    }
+}
+
+RenderSnapshot& RenderThread::BeginFrame() {
+    RenderSnapshot& snapshot = buffers.Back();
+    snapshot.Clear();
+    snapshot.SetFrameNumber(submittedFrames + 1);
+    return snapshot;
+}
+
+void RenderThread::SubmitFrame() {
+    buffers.Publish();
+    submittedFrames++;
+
+    // The render thread holds the mutex only while checking for work, so this is never a long wait
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wakeSignal.notify_one();
+}
+
+void RenderThread::Run() {
+    while(true) {
+        {
+            // Sleep until there's a fresh frame (or shutdown)
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeSignal.wait(lock, [this]() {
+                return !running.load(std::memory_order_acquire) || buffers.HasFresh();
+            });
+            if(!running.load(std::memory_order_acquire)) {
+                return;
+            }
+        }
+
+        // Always jump to the newest frame - stale ones are simply skipped
+        if(buffers.Acquire()) {
+            if(backend) {
+                backend(buffers.Front());
+            }
+            renderedFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
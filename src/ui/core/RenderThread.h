@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
+
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+
+// Dedicated render thread consuming snapshots produced by the UI thread
+// Handoff goes through a triple buffer: the UI thread never waits for a slow frame (e.g. a slow DrawTextW)
+class RenderThread {
+    public:
+        // Called on the render thread with the newest frame (e.g. replay with GdiPainter into a back buffer DC)
+        using Backend = std::function<void(const RenderSnapshot&)>;
+
+        explicit RenderThread(Backend backend);
+        ~RenderThread(); // Stops and joins
+
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        // UI thread: buffer to record the next frame into (cleared)
+        RenderSnapshot& BeginFrame();
+        // UI thread: hand the recorded frame over - never blocks
+        void SubmitFrame();
+
+        uint64_t GetSubmittedFrames() const { return submittedFrames; }
+        uint64_t GetRenderedFrames() const { return renderedFrames.load(std::memory_order_relaxed); }
+
+    private:
+        Backend backend;
+        TripleBuffer<RenderSnapshot> buffers;
+
+        std::thread thread;
+        std::atomic<bool> running{true};
+        std::mutex wakeMutex;               // Only guards the sleep/wake of the idle render thread
+        std::condition_variable wakeSignal;
+
+        uint64_t submittedFrames = 0;       // UI thread only
+        std::atomic<uint64_t> renderedFrames{0};
+
+        void Run();
+};
@@ -1,27 +1,296 @@
-#include "Root.h"
+#include <climits>
+#include <algorithm>
 
-std::shared_ptr<Root> Root::instance;
+#include "Root.h"
 
-Root::Root(int width, int height) {
+Root::Root(int width, int height) :
+    focus(*this)
+{
     rect = {0, 0, width, height};
+    index.Add(*this); // Root never gets a parent - it is indexed from the start
 
     UpdateConvenienceGeometry();
 }
 
 std::shared_ptr<Root> Root::Create(int width, int height) {
-    auto existing = instance;
-    if(existing) {
-        throw std::runtime_error("Root already exists!");
+    return std::shared_ptr<Root>(new Root(width, height));
+}
+
+// --- Property updates ------------------------------------------------
+size_t Root::FlushPropertyUpdates() {
+    if(!inputRecorder) {
+        return propertyUpdates.Drain();
+    }
+    return propertyUpdates.Drain([this](Widget& target, PropertyID property, const PropertyValue& value) {
+        inputRecorder->RecordMutation(target, property, value);
+    });
+}
+
+// --- Input -----------------------------------------------------------
+size_t Root::DispatchInput() {
+    return inputQueue.Dispatch([this](const InputEvent& e) {
+        switch(e.kind) {
+            case InputEventKind::Mouse: InitFeedMouseEvent(e.mouse); break;
+            case InputEventKind::Key:   FeedKeyEvent(e.key); break;
+            case InputEventKind::Char:  FeedCharEvent(e.character); break;
+        }
+    });
+}
+
+bool Root::FeedKeyEvent(const KeyEvent& e) {
+    if(inputRecorder) {
+        inputRecorder->RecordKey(e);
+    }
+    return focus.DispatchKey(e);
+}
+
+bool Root::FeedCharEvent(const CharEvent& e) {
+    if(inputRecorder) {
+        inputRecorder->RecordChar(e);
+    }
+    return focus.DispatchChar(e);
+}
+
+bool Root::FeedMouseEvent(const MouseEvent& e) {
+    if(inputRecorder) {
+        inputRecorder->RecordMouse(e);
+    }
+    if(e.type == MouseEventType::Down) {
+        focus.OnMouseDown(e.pos); // Before dispatch - the clicked widget may take the focus
+    }
+    if(overlays.empty()) {
+        pointerOccluded = false;
+        return Container::FeedMouseEvent(e);
+    }
+
+    if(e.type == MouseEventType::Down) {
+        DismissPopupsOutside(e.pos);
+    }
+
+    // Top layer first
+    bool occluded = false;
+    bool handled = DispatchToOverlays(e, occluded);
+
+    switch(e.type) {
+        case MouseEventType::Enter:
+        case MouseEventType::Leave:
+        case MouseEventType::Move:
+            if(occluded) {
+                // Pointer went over a popup - the base tree gets a single move to nowhere, so its hover states end
+                if(!pointerOccluded) {
+                    pointerOccluded = true;
+                    Container::FeedMouseEvent({e.type, {LONG_MIN, LONG_MIN}, e.button});
+                }
+                return handled;
+            }
+            pointerOccluded = false;
+            break;
+
+        case MouseEventType::Up:
+            break; // Always reaches the base tree - pressed widgets must be released
+
+        default:
+            if(occluded || handled) {
+                return handled; // Stop early - the base tree is hidden under the popup
+            }
+            break;
+    }
+    return Container::FeedMouseEvent(e) || handled;
+}
+
+// --- Overlays --------------------------------------------------------
+void Root::ShowOverlay(const WidgetPtr& overlay, OverlayLayer layer, int zIndex, InlineFunction<void()> onDismiss, const Widget* owner) {
+    if(!overlay) return;
+
+    auto existing = std::find_if(overlays.begin(), overlays.end(), [&](const OverlayEntry& o) {
+        return o.widget == overlay;
+    });
+    if(existing != overlays.end()) {
+        overlays.erase(existing); // Re-insert at the new position (already parented and counted)
+    }
+    else {
+        overlay->SetParent(this);
+        AdjustSubtreeSize(static_cast<long long>(overlay->GetSubtreeSize()));
+    }
+
+    // Insert after every overlay that is below or level with the new one
+    auto pos = std::upper_bound(overlays.begin(), overlays.end(), std::make_pair(layer, zIndex),
+        [](const std::pair<OverlayLayer, int>& key, const OverlayEntry& o) {
+            return key < std::make_pair(o.layer, o.zIndex);
+        }
+    );
+    overlays.insert(pos, OverlayEntry{overlay, layer, zIndex, std::move(onDismiss), owner});
+
+    overlay->UpdateEffectiveDisplay();
+    overlay->InvalidateLayout();
+    overlay->InvalidatePaint();
+}
+
+void Root::HideOverlay(const WidgetPtr& overlay) {
+    auto it = std::find_if(overlays.begin(), overlays.end(), [&](const OverlayEntry& o) {
+        return o.widget == overlay;
+    });
+    if(it == overlays.end()) return;
+
+    WidgetPtr widget = it->widget; // Keep alive while detaching
+    overlays.erase(it);
+
+    widget->SetParent(nullptr);
+    AdjustSubtreeSize(-static_cast<long long>(widget->GetSubtreeSize()));
+    InvalidatePaint(); // Uncovered area
+}
+
+bool Root::IsOverlayShown(const Widget* overlay) const {
+    return std::any_of(overlays.begin(), overlays.end(), [overlay](const OverlayEntry& o) {
+        return o.widget.get() == overlay;
+    });
+}
+
+bool Root::DispatchToOverlays(const MouseEvent& e, bool& occluded) {
+    bool handled = false;
+    bool exclusive = e.type != MouseEventType::Move && e.type != MouseEventType::Enter && e.type != MouseEventType::Leave;
+
+    // Iterate over a copy of the pointers - handlers may show/hide overlays
+    std::vector<WidgetPtr> targets = TakeOverlayScratch();
+    for(auto it = overlays.rbegin(); it != overlays.rend(); ++it) {
+        if(it->layer == OverlayLayer::Popup) {
+            targets.push_back(it->widget);
+        }
+    }
+
+    for(const WidgetPtr& w : targets) {
+        bool inside = w->IsDisplayed() && w->MouseInRect(e.pos);
+        bool consumed = w->InitFeedMouseEvent(e);
+        handled = handled || consumed;
+        occluded = occluded || inside;
+
+        if(exclusive && (consumed || inside)) {
+            break; // Lower popups are covered
+        }
+    }
+    ReturnOverlayScratch(std::move(targets));
+    return handled;
+}
+
+void Root::DismissPopupsOutside(POINT p) {
+    std::vector<WidgetPtr> dismissed;
+    for(auto it = overlays.rbegin(); it != overlays.rend(); ++it) {
+        if(it->layer != OverlayLayer::Popup) continue;
+        if(it->widget->MouseInRect(p)) break; // Clicked into a popup - it and the ones below stay
+
+        if(it->owner && it->owner->MouseInRect(p)) continue;
+        dismissed.push_back(it->widget);
+    }
+
+    for(const WidgetPtr& w : dismissed) {
+        auto it = std::find_if(overlays.begin(), overlays.end(), [&](const OverlayEntry& o) {
+            return o.widget == w;
+        });
+        if(it == overlays.end()) continue; // Already hidden by a previous callback
+
+        InlineFunction<void()> callback = std::move(it->onDismiss);
+        HideOverlay(w);
+        if(callback) callback();
+    }
+}
+
+void Root::UpdateInternalLayout() {
+    Container::UpdateInternalLayout();
+    for(auto& o : overlays) {
+        o.widget->UpdateInternalLayout();
     }
+}
+
+void Root::UpdateEffectiveGeometry() {
+    Container::UpdateEffectiveGeometry();
+    for(auto& o : overlays) {
+        o.widget->UpdateEffectiveGeometry();
+    }
+}
 
-    auto root = std::shared_ptr<Root>(new Root(width, height));
-    instance = root;
-    return root;
+void Root::UpdateEffectiveDisplay() {
+    Container::UpdateEffectiveDisplay();
+    for(auto& o : overlays) {
+        o.widget->UpdateEffectiveDisplay();
+    }
 }
 
-std::shared_ptr<Root> Root::Get() {
-    if(auto inst = instance) {
-        return inst;
+// --- Session recording -----------------------------------------------
+void Root::SetInputRecorder(InputRecorder* recorder) {
+    inputRecorder = recorder;
+    if(recorder) {
+        recorder->Begin(*this);
+    }
+}
+
+// --- Rendering -------------------------------------------------------
+void Root::Render(Painter& painter) {
+    Container::Render(painter);
+
+    if(overlays.empty()) return;
+
+    // Bottom to top, above the base tree
+    // Iterate over a copy of the pointers - rendering may show/hide overlays (and reallocate the list)
+    std::vector<WidgetPtr> targets = TakeOverlayScratch();
+    for(auto& o : overlays) {
+        targets.push_back(o.widget);
+    }
+    for(const WidgetPtr& w : targets) {
+        w->InitRender(painter);
     }
-    throw std::runtime_error("Root not created yet! Call Root::Create() first.");
-}
\ No newline at end of file
+    ReturnOverlayScratch(std::move(targets));
+}
+
+// Moved out while in use, so a nested dispatch (a handler feeding another event) gets its own vector
+std::vector<Root::WidgetPtr> Root::TakeOverlayScratch() {
+    std::vector<WidgetPtr> scratch = std::move(overlayScratch);
+    overlayScratch.clear();
+    return scratch;
+}
+
+void Root::ReturnOverlayScratch(std::vector<WidgetPtr> scratch) {
+    scratch.clear(); // Don't keep hidden overlays alive
+    if(scratch.capacity() > overlayScratch.capacity()) {
+        overlayScratch = std::move(scratch);
+    }
+}
+
+void Root::RecordSnapshot(RenderSnapshot& snapshot) {
+    snapshot.SetSize(width, height);
+    RecordingPainter painter(snapshot);
+    InitRender(painter);
+}
+
+void Root::EnableThreadedRendering(RenderThread::Backend backend) {
+    renderThread = std::make_unique<RenderThread>(std::move(backend));
+}
+
+void Root::DisableThreadedRendering() {
+    renderThread.reset(); // Joins the render thread
+}
+
+void Root::SubmitFrame() {
+    if(!renderThread) return;
+
+    RecordSnapshot(renderThread->BeginFrame());
+    renderThread->SubmitFrame();
+}
+
+void Root::AddDamage(const RECT& area) {
+    if(area.right <= area.left || area.bottom <= area.top) return;
+
+    if(damage.right <= damage.left || damage.bottom <= damage.top) {
+        damage = area;
+        return;
+    }
+    damage.left = std::min(damage.left, area.left);
+    damage.top = std::min(damage.top, area.top);
+    damage.right = std::max(damage.right, area.right);
+    damage.bottom = std::max(damage.bottom, area.bottom);
+}
+
+RECT Root::TakeDamage() {
+    RECT taken = damage;
+    damage = {0, 0, 0, 0};
+    return taken;
+}
@@ -1,27 +1,162 @@
 #pragma once
 
-#include <stdexcept>
-
 #include "Container.h"
+#include "PropertyUpdateQueue.h"
+#include "InputQueue.h"
+#include "RenderSnapshot.h"
+#include "RenderThread.h"
+#include "InputTrace.h"
+#include "FocusManager.h"
+#include "Animator.h"
+#include "WidgetIndex.h"
+#include "Observable.h"
+
+// Layers above the regular widget tree (the base layer), bottom to top
+// Using uint8_t instead of int for optimization
+enum class OverlayLayer : uint8_t {
+    Popup,          // Menus, dropdowns - capture input over their area
+    Tooltip,        // Input-transparent
+    DragPreview     // Input-transparent
+};
 
+// Top of a widget tree (one per window/viewport)
+// Roots are fully independent - each has its own popups, input and update queues - so separate Roots
+// may be laid out and rendered on separate threads (one thread per Root at a time)
+// Widgets find their Root through the parent chain (Widget::GetRoot)
 class Root : public Container {
     public:
-        // Deleted copy/move constructors to enforce singleton
+        // Non-copyable/movable - widgets keep pointers to their ancestors
         Root(const Root&) = delete;
         Root& operator=(const Root&) = delete;
         Root(Root&&) = delete;
         Root& operator=(Root&&) = delete;
 
-        // Factory to create/get the single Root instance
         static std::shared_ptr<Root> Create(int width, int height);
 
-        // Getter for the singleton (throws if not yet created)
-        static std::shared_ptr<Root> Get();
-
         // Root never has a parent
         void SetParent(Widget*) = delete;
 
+        // --- Overlays ---
+        // Shows the widget above the base tree (absolutely positioned); within a layer, higher zIndex is on top,
+        // equal zIndex keeps showing order. Showing an already shown overlay moves it.
+        // Popups are dismissed (hidden, then onDismiss called) by a mouse down outside of them and outside of owner
+        void ShowOverlay(
+            const WidgetPtr& overlay,
+            OverlayLayer layer,
+            int zIndex = 0,
+            InlineFunction<void()> onDismiss = nullptr,
+            const Widget* owner = nullptr
+        );
+        void HideOverlay(const WidgetPtr& overlay);
+        bool IsOverlayShown(const Widget* overlay) const;
+        size_t GetOverlayCount() const { return overlays.size(); }
+        Widget* GetOverlay(size_t i) const { return overlays[i].widget.get(); } // Bottom to top
+
+        // Root listens for layout/display/geometry changes of overlays as well
+        void UpdateInternalLayout() override;
+        void UpdateEffectiveGeometry() override;
+        void UpdateEffectiveDisplay() override;
+        void Render(Painter& painter) override;
+
+        // --- Cross-thread property updates ---
+        // Safe to call from any thread; applied on the next FlushPropertyUpdates
+        void PostPropertyUpdate(const std::shared_ptr<Widget>& target, PropertyID property, PropertyValue value) {
+            propertyUpdates.Post(target, property, std::move(value));
+        }
+        // UI thread only - call once per frame before rendering
+        size_t FlushPropertyUpdates();
+        bool HasPendingPropertyUpdates() const { return propertyUpdates.HasPending(); }
+
+        // --- Observables ---
+        // Batch for Observable<T> models bound to this tree (UI thread); flushed once per frame
+        ChangeBatch& GetChangeBatch() { return changes; }
+        size_t FlushObservableChanges() { return changes.Flush(); }
+        bool HasPendingObservableChanges() const { return changes.HasPending(); }
+
+        // --- Input ---
+        // Safe to call from any thread; events are dispatched on the next DispatchInput (in posting order)
+        void PostMouseEvent(const MouseEvent& e) { inputQueue.Post(e); }
+        void PostKeyEvent(const KeyEvent& e) { inputQueue.Post(e); }
+        void PostCharEvent(const CharEvent& e) { inputQueue.Post(e); }
+        // UI thread only - call once per frame; consecutive moves are coalesced
+        size_t DispatchInput();
+        bool HasPendingInput() const { return inputQueue.HasPending(); }
+
+        // Full history of the coalesced Move being dispatched (only if enabled)
+        void SetKeepMoveHistory(bool keep) { inputQueue.SetKeepMoveHistory(keep); }
+        const std::vector<POINT>& GetCoalescedMoves() const { return inputQueue.GetMoveHistory(); }
+
+        // --- Keyboard focus ---
+        // Key/char events go to the focused widget and bubble up (UI thread; DispatchInput calls these)
+        FocusManager& GetFocusManager() { return focus; }
+        Widget* GetFocusedWidget() const { return focus.GetFocused(); }
+        bool FeedKeyEvent(const KeyEvent& e);
+        bool FeedCharEvent(const CharEvent& e);
+
+        // --- Ids & tags ---
+        // Widgets of the tree (overlays included) by id/tag - hash lookups, no traversal
+        WidgetIndex& GetWidgetIndex() { return index; }
+        Widget* FindById(int id) const { return index.FindById(id); }
+        Widget* FindById(const std::string& id) const { return index.FindByName(WidgetNames::Get().Find(id)); }
+        const std::vector<Widget*>& GetTagged(const std::string& tag) const { return index.GetTagged(WidgetNames::Get().Find(tag)); }
+
+        // --- Animations ---
+        // UI thread only - tick once per frame, before layout and rendering
+        Animator& GetAnimator() { return animator; }
+        size_t TickAnimations(float deltaSeconds) { return animator.Tick(deltaSeconds); }
+        bool IsAnimating() const { return !animator.IsIdle(); }
+
+        // --- Session recording ---
+        // While set, every mouse event reaching Root, frame boundary and flushed property update is recorded
+        void SetInputRecorder(InputRecorder* recorder); // nullptr stops recording; the recorder must outlive it
+        InputRecorder* GetInputRecorder() const { return inputRecorder; }
+        // Call once per presented frame (after rendering)
+        void MarkFrame() { if(inputRecorder) inputRecorder->RecordFrame(); }
+
+        // --- Rendering ---
+        // Records the render-relevant state of the whole tree (UI thread)
+        void RecordSnapshot(RenderSnapshot& snapshot);
+
+        // Optional threaded mode: the UI thread records snapshots, a dedicated thread draws them with the backend
+        void EnableThreadedRendering(RenderThread::Backend backend);
+        void DisableThreadedRendering();
+        bool IsThreadedRendering() const { return renderThread != nullptr; }
+        // UI thread, at frame end: records the frame and hands it over to the render thread (never blocks)
+        void SubmitFrame();
+
+        // Union of the areas invalidated since the last TakeDamage (e.g. to pass to InvalidateRect)
+        void AddDamage(const RECT& area);
+        const RECT& GetDamage() const { return damage; }
+        RECT TakeDamage();
+
+        bool FeedMouseEvent(const MouseEvent& e) override;
+
     private:
-        static std::shared_ptr<Root> instance;
         explicit Root(int width, int height);
+
+        PropertyUpdateQueue propertyUpdates;
+        ChangeBatch changes;
+        InputQueue inputQueue;
+        FocusManager focus;
+        WidgetIndex index;
+        Animator animator;
+        std::unique_ptr<RenderThread> renderThread;
+        InputRecorder* inputRecorder = nullptr;
+        RECT damage = {0, 0, 0, 0};
+
+        struct OverlayEntry {
+            WidgetPtr widget;
+            OverlayLayer layer;
+            int zIndex;
+            InlineFunction<void()> onDismiss;
+            const Widget* owner;
+        };
+        std::vector<OverlayEntry> overlays; // Bottom to top
+        bool pointerOccluded = false;       // Last Move was over a popup (base tree already got a Leave)
+        std::vector<WidgetPtr> overlayScratch; // Reused overlay pointer copies (dispatch, render)
+
+        std::vector<WidgetPtr> TakeOverlayScratch();
+        void ReturnOverlayScratch(std::vector<WidgetPtr> scratch);
+        bool DispatchToOverlays(const MouseEvent& e, bool& occluded);
+        void DismissPopupsOutside(POINT p);
 };
\ No newline at end of file
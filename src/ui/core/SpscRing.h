@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+// Lock-free single-producer/single-consumer ring of fixed capacity (rounded up to a power of two)
+// Push never blocks or allocates: values that don't fit (the consumer fell behind) are dropped and counted.
+// Both sides cache the other side's index, so the shared cache lines are only touched when the cached view runs out.
+template<typename T>
+class SpscRing {
+    public:
+        explicit SpscRing(size_t capacity) {
+            size_t rounded = 1;
+            while(rounded < capacity) rounded <<= 1;
+            items.reset(new T[rounded]);
+            mask = rounded - 1;
+        }
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        size_t GetCapacity() const { return mask + 1; }
+
+        // --- Producer ---
+        bool Push(const T& value) { return Push(&value, 1) == 1; }
+
+        // Returns the number of values pushed (the rest were dropped)
+        size_t Push(const T* values, size_t count) {
+            size_t h = head.load(std::memory_order_relaxed);
+            if(h - cachedTail + count > GetCapacity()) cachedTail = tail.load(std::memory_order_acquire);
+
+            size_t n = std::min(count, GetCapacity() - (h - cachedTail));
+            if(n < count) dropped.fetch_add(count - n, std::memory_order_relaxed);
+            if(n == 0) return 0;
+
+            // At most two contiguous copies (around the end of the storage)
+            size_t at = h & mask;
+            size_t first = std::min(n, GetCapacity() - at);
+            std::copy(values, values + first, items.get() + at);
+            std::copy(values + first, values + n, items.get());
+
+            head.store(h + n, std::memory_order_release); // Publish to the consumer
+            return n;
+        }
+
+        // --- Consumer ---
+        // Calls fn(const T* values, size_t count) for the pending values (at most two contiguous spans), then frees them
+        // Returns the number of values consumed
+        template<typename Fn>
+        size_t Consume(Fn&& fn) {
+            size_t t = tail.load(std::memory_order_relaxed);
+            size_t h = head.load(std::memory_order_acquire);
+            if(h == t) return 0;
+
+            size_t n = h - t;
+            size_t at = t & mask;
+            size_t first = std::min(n, GetCapacity() - at);
+            fn(static_cast<const T*>(items.get() + at), first);
+            if(first < n) fn(static_cast<const T*>(items.get()), n - first);
+
+            tail.store(h, std::memory_order_release); // Slots go back to the producer
+            return n;
+        }
+
+        bool IsEmpty() const {
+            return head.load(std::memory_order_acquire) == tail.load(std::memory_order_relaxed);
+        }
+
+        // Values dropped because the ring was full (any thread)
+        uint64_t GetDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    private:
+        std::unique_ptr<T[]> items;
+        size_t mask = 0;
+
+        alignas(64) std::atomic<size_t> head{0};    // Written by the producer
+        size_t cachedTail = 0;                      // Producer's view of tail
+        std::atomic<uint64_t> dropped{0};
+
+        alignas(64) std::atomic<size_t> tail{0};    // Written by the consumer
+};
@@ -0,0 +1,175 @@
+#include "Style.h"
+#include "Widget.h"
+
+// FNV-1a over all color channels and the font handle
+size_t StyleDesc::Hash() const {
+    uint64_t h = 1469598103934665603ull;
+    auto mix = [&h](uint64_t v) {
+        h ^= v;
+        h *= 1099511628211ull;
+    };
+    auto mixColor = [&mix](const Color& c) {
+        mix((uint64_t(c.a) << 24) | (uint64_t(c.r) << 16) | (uint64_t(c.g) << 8) | uint64_t(c.b));
+    };
+
+    for(const StyleColors& s : states) {
+        mixColor(s.background);
+        mixColor(s.foreground);
+        mixColor(s.border);
+        mixColor(s.accent);
+    }
+    mix(reinterpret_cast<uintptr_t>(font));
+
+    return static_cast<size_t>(h);
+}
+
+StyleRegistry& StyleRegistry::Get() {
+    static StyleRegistry instance;
+    return instance;
+}
+
+const Style* StyleRegistry::Intern(const StyleDesc& desc) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return InternLocked(desc);
+}
+
+const Style* StyleRegistry::InternLocked(const StyleDesc& desc) {
+    size_t hash = desc.Hash();
+
+    // Reuse an existing record if the looks are identical
+    auto range = interned.equal_range(hash);
+    for(auto it = range.first; it != range.second; ++it) {
+        if(it->second->GetDesc() == desc) {
+            return AcquireLocked(it->second.get());
+        }
+    }
+
+    auto record = std::unique_ptr<Style>(new Style(desc));
+    record->hash = hash;
+    const Style* ptr = record.get();
+    interned.emplace(hash, std::move(record));
+    return AcquireLocked(ptr);
+}
+
+const Style* StyleRegistry::AcquireLocked(const Style* style) {
+    if(style) style->refs++;
+    return style;
+}
+
+void StyleRegistry::Release(const Style* style) {
+    if(!style) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    ReleaseLocked(style);
+}
+
+void StyleRegistry::ReleaseLocked(const Style* style) {
+    if(!style || --style->refs > 0) return;
+
+    auto range = interned.equal_range(style->hash);
+    for(auto it = range.first; it != range.second; ++it) {
+        if(it->second.get() == style) {
+            interned.erase(it);
+            return;
+        }
+    }
+}
+
+size_t StyleRegistry::GetInternedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return interned.size();
+}
+
+StyleClassID StyleRegistry::DefineClass(const std::string& name, const StyleDesc& defaults) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    StyleClassID existing = FindClassLocked(name);
+    if(existing != NoStyleClass) {
+        return existing;
+    }
+
+    StyleClassID id = static_cast<StyleClassID>(classes.size());
+    classes.push_back({name, InternLocked(defaults), {}});
+    classNames.emplace(name, id);
+    return id;
+}
+
+StyleClassID StyleRegistry::FindClass(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return FindClassLocked(name);
+}
+
+StyleClassID StyleRegistry::FindClassLocked(const std::string& name) const {
+    auto it = classNames.find(name);
+    return it != classNames.end() ? it->second : NoStyleClass;
+}
+
+const Style* StyleRegistry::GetClassStyle(StyleClassID id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(id >= classes.size()) return nullptr;
+    return classes[id].style;
+}
+
+void StyleRegistry::SetClassStyle(StyleClassID id, const StyleDesc& desc) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(id >= classes.size()) return;
+
+    StyleClass& cls = classes[id];
+    const Style* newStyle = InternLocked(desc);
+    if(newStyle == cls.style) {
+        ReleaseLocked(newStyle);
+        return; // Nothing changed - nobody needs to repaint
+    }
+
+    ReleaseLocked(cls.style);
+    cls.style = newStyle;
+
+    // Notify under the lock - a subscriber can't be destroyed (it unsubscribes under the same lock) while it's restyled.
+    // OnStyleChanged overrides must therefore not call back into the registry.
+    for(Widget* w : cls.subscribers) {
+        ReleaseLocked(w->ApplyStyle(AcquireLocked(newStyle)));
+    }
+}
+
+void StyleRegistry::SetClassStyle(const std::string& name, const StyleDesc& desc) {
+    StyleClassID id = FindClass(name);
+    if(id == NoStyleClass) {
+        DefineClass(name, desc);
+        return;
+    }
+    SetClassStyle(id, desc);
+}
+
+const Style* StyleRegistry::Follow(StyleClassID id, StyleClassID previous, Widget* w) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(id >= classes.size() || !w) return nullptr;
+
+    if(previous != id) {
+        UnsubscribeLocked(previous, w);
+        SubscribeLocked(id, w);
+    }
+    return AcquireLocked(classes[id].style);
+}
+
+void StyleRegistry::Unsubscribe(StyleClassID id, Widget* w) {
+    std::lock_guard<std::mutex> lock(mutex);
+    UnsubscribeLocked(id, w);
+}
+
+void StyleRegistry::SubscribeLocked(StyleClassID id, Widget* w) {
+    auto& subs = classes[id].subscribers;
+    w->styleSubscriberIndex = subs.size();
+    subs.push_back(w);
+}
+
+void StyleRegistry::UnsubscribeLocked(StyleClassID id, Widget* w) {
+    if(id >= classes.size() || !w) return;
+
+    // Swap-remove using the index cached in the widget - O(1)
+    auto& subs = classes[id].subscribers;
+    size_t idx = w->styleSubscriberIndex;
+    if(idx >= subs.size() || subs[idx] != w) return;
+
+    subs[idx] = subs.back();
+    subs[idx]->styleSubscriberIndex = idx;
+    subs.pop_back();
+}
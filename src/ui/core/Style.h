@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <windows.h>
+
+#include "Color.h"
+
+class Widget;
+
+// Interaction states a style provides colors for
+// Using uint8_t instead of int for optimization
+enum class StyleState : uint8_t {
+    Normal,
+    Hover,
+    Pressed,
+    Disabled,
+    Selected,
+    Count
+};
+
+// Color roles of a single state
+// What each role means is up to the widget (e.g. Slider: background = track, accent = handle)
+struct StyleColors {
+    Color background    = Color::FromARGB(0, 0, 0, 0);
+    Color foreground    = Color::FromRGB(255, 255, 255);  // Text
+    Color border        = Color::FromARGB(0, 0, 0, 0);
+    Color accent        = Color::FromARGB(0, 0, 0, 0);    // Check marks, handles, etc.
+
+    bool operator==(const StyleColors& o) const {
+        return background == o.background && foreground == o.foreground && border == o.border && accent == o.accent;
+    }
+    bool operator!=(const StyleColors& o) const { return !(*this == o); }
+};
+
+// Mutable style description - only used to build (intern) immutable Style records
+struct StyleDesc {
+    std::array<StyleColors, static_cast<size_t>(StyleState::Count)> states;
+    HFONT font = nullptr; // nullptr = DEFAULT_GUI_FONT
+
+    StyleColors& operator[](StyleState s) { return states[static_cast<size_t>(s)]; }
+    const StyleColors& operator[](StyleState s) const { return states[static_cast<size_t>(s)]; }
+
+    // Same colors in every state (tweak individual states afterwards)
+    static StyleDesc Uniform(const StyleColors& colors) {
+        StyleDesc d;
+        d.states.fill(colors);
+        return d;
+    }
+
+    bool operator==(const StyleDesc& o) const { return states == o.states && font == o.font; }
+    size_t Hash() const;
+};
+
+// Immutable, interned style record
+// Widgets with identical looks share a single instance (flyweight), so only a pointer is stored per widget
+// Reference counted by the registry: every widget and style class using the record holds one reference
+class Style {
+    public:
+        friend class StyleRegistry;
+
+        const StyleColors& Get(StyleState state) const { return desc[state]; }
+        HFONT GetFont() const { return desc.font; }
+        const StyleDesc& GetDesc() const { return desc; }
+
+    private:
+        explicit Style(const StyleDesc& d) : desc(d) {}
+        StyleDesc desc;
+        size_t hash = 0;            // StyleDesc::Hash(), the key in the registry
+        mutable uint32_t refs = 0;  // Guarded by the registry mutex
+};
+
+using StyleClassID = uint16_t;
+constexpr StyleClassID NoStyleClass = 0xFFFF;
+
+// Process-wide style storage
+// Style classes are named slots (e.g. "Button") which widgets follow by default
+// Swapping the style of a class (theming) is O(1) per class and only repaints the widgets following that class
+// Thread-safe, so widgets of independent Roots can be built on separate threads
+// (theme swaps restyle widgets of every Root though - don't swap while another Root is being laid out/rendered)
+class StyleRegistry {
+    public:
+        StyleRegistry(const StyleRegistry&) = delete;
+        StyleRegistry& operator=(const StyleRegistry&) = delete;
+
+        static StyleRegistry& Get();
+
+        // Returns the shared record for the description (created on first use) with a reference for the caller
+        // Records are freed with their last reference, so per-widget looks don't pile up - Release what you Intern
+        const Style* Intern(const StyleDesc& desc);
+        void Release(const Style* style); // nullptr is ignored
+        size_t GetInternedCount() const;
+
+        // Defines a class with default looks; if the class already exists (e.g. themed before first use), it's kept as is
+        StyleClassID DefineClass(const std::string& name, const StyleDesc& defaults);
+        StyleClassID FindClass(const std::string& name) const; // NoStyleClass if not defined
+        const Style* GetClassStyle(StyleClassID id) const; // Not referenced - only valid until the class is restyled
+
+        // Theme swap - notifies only the widgets following the class
+        void SetClassStyle(StyleClassID id, const StyleDesc& desc);
+        void SetClassStyle(const std::string& name, const StyleDesc& desc); // Defines the class if needed
+
+    private:
+        // Widget (un)subscribes itself when following/leaving a class
+        friend class Widget;
+
+        StyleRegistry() = default;
+
+        struct StyleClass {
+            std::string name;
+            const Style* style = nullptr; // Referenced
+            std::vector<Widget*> subscribers;
+        };
+
+        std::unordered_multimap<size_t, std::unique_ptr<Style>> interned; // Keyed by StyleDesc::Hash()
+        std::vector<StyleClass> classes;                                   // Indexed by StyleClassID
+        std::unordered_map<std::string, StyleClassID> classNames;
+        mutable std::mutex mutex;
+
+        const Style* InternLocked(const StyleDesc& desc);
+        const Style* AcquireLocked(const Style* style);
+        void ReleaseLocked(const Style* style);
+        StyleClassID FindClassLocked(const std::string& name) const;
+
+        // Moves the widget's subscription from one class to another and returns the new class style, referenced
+        // (one step, so a theme swap can't slip in between); nullptr if the class doesn't exist
+        const Style* Follow(StyleClassID id, StyleClassID previous, Widget* w);
+        void Unsubscribe(StyleClassID id, Widget* w);
+        void SubscribeLocked(StyleClassID id, Widget* w);
+        void UnsubscribeLocked(StyleClassID id, Widget* w);
+};
\ No newline at end of file
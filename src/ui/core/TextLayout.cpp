@@ -0,0 +1,190 @@
+#include <climits>
+#include <algorithm>
+
+#include "TextLayout.h"
+#include "TextMeasure.h"
+#include "ScopedGDI.h"
+
+namespace {
+    bool IsSpace(wchar_t c) {
+        return c == L' ' || c == L'\t' || c == L'\r';
+    }
+}
+
+void TextLayout::SetText(const wchar_t* newText, int newLength) {
+    text = newText;
+    length = text ? std::max(0, newLength) : 0;
+    Invalidate();
+}
+
+void TextLayout::SetFont(HFONT newFont) {
+    if(font == newFont) return;
+    font = newFont;
+    Invalidate();
+}
+
+void TextLayout::Invalidate() {
+    measured = false;
+    for(BreakCache& cache : caches) {
+        cache.width = -1;
+        cache.lines.clear();
+    }
+}
+
+int TextLayout::GetMinContentWidth() {
+    Measure();
+    return minContentWidth;
+}
+
+int TextLayout::GetMaxContentWidth() {
+    Measure();
+    return maxContentWidth;
+}
+
+int TextLayout::GetLineHeight() {
+    Measure();
+    return lineHeight;
+}
+
+int TextLayout::MeasureRange(int start, int end) {
+    Measure();
+    return Width(std::max(0, start), std::min(end, length));
+}
+
+// --- Measuring -------------------------------------------------------
+// One extent query per paragraph gives the advances of all its characters
+void TextLayout::Measure() {
+    if(measured) return;
+    measured = true;
+
+    advances.assign(length + 1, 0);
+    segments.clear();
+    minContentWidth = 0;
+    maxContentWidth = 0;
+    lineHeight = TextMeasure::GetLineHeight(font);
+
+    HDC hdc = TextMeasure::GetMeasureDC();
+    ScopedSelectFont sel(hdc, TextMeasure::ResolveFont(font));
+
+    int paragraphStart = 0;
+    while(paragraphStart <= length) {
+        int paragraphEnd = paragraphStart;
+        while(paragraphEnd < length && text[paragraphEnd] != L'\n') paragraphEnd++;
+
+        // Advances (relative to the paragraph start - lines never span paragraphs)
+        int count = paragraphEnd - paragraphStart;
+        if(count > 0) {
+            SIZE size;
+            GetTextExtentExPointW(hdc, text + paragraphStart, count, 0, nullptr, &advances[paragraphStart + 1], &size);
+        }
+        advances[paragraphStart] = 0;
+
+        // Segments: word + following whitespace
+        int pos = paragraphStart;
+        do {
+            Segment seg;
+            seg.start = pos;
+            while(pos < paragraphEnd && !IsSpace(text[pos])) pos++;
+            seg.wordEnd = pos;
+            while(pos < paragraphEnd && IsSpace(text[pos])) pos++;
+            seg.end = pos;
+            seg.hardBreak = pos == paragraphEnd && paragraphEnd < length;
+
+            minContentWidth = std::max(minContentWidth, Width(seg.start, seg.wordEnd));
+            maxContentWidth = std::max(maxContentWidth, Width(paragraphStart, seg.wordEnd));
+            segments.push_back(seg);
+        } while(pos < paragraphEnd);
+
+        paragraphStart = paragraphEnd + 1;
+    }
+}
+
+// --- Line breaking ---------------------------------------------------
+TextLayout::Line TextLayout::BreakLine(int pos, int seg, int width) const {
+    const Segment& first = segments[seg];
+
+    // The first word alone doesn't fit - break it between characters (at least one per line)
+    if(pos < first.wordEnd && Width(pos, first.wordEnd) > width) {
+        // Advances are monotonic - binary search the last character that still fits
+        int limit = advances[pos] + width;
+        int end = static_cast<int>(std::upper_bound(advances.begin() + pos + 1, advances.begin() + first.wordEnd, limit) - advances.begin()) - 1;
+        end = std::max(end, pos + 1);
+
+        if(end < first.wordEnd) {
+            return {pos, end, end, seg, Width(pos, end), Width(pos, end + 1)};
+        }
+
+        // Forced last character of the word (nothing fits) - takes the whitespace along and is never kept on a resize
+        int next = first.hardBreak ? first.end + 1 : first.end;
+        return {pos, end, next, seg + 1, Width(pos, end), Width(pos, end)};
+    }
+
+    // Take as many whole words as fit
+    int last = seg;
+    int count = static_cast<int>(segments.size());
+    while(!segments[last].hardBreak && last + 1 < count && Width(pos, segments[last + 1].wordEnd) <= width) {
+        last++;
+    }
+
+    const Segment& end = segments[last];
+    bool atHardBreak = end.hardBreak || last + 1 == count;
+
+    Line line;
+    line.start = pos;
+    line.end = end.wordEnd;
+    line.next = end.hardBreak ? end.end + 1 : end.end;
+    line.nextSegment = last + 1;
+    line.width = Width(pos, end.wordEnd);
+    line.overflowWidth = atHardBreak ? INT_MAX : Width(pos, segments[last + 1].wordEnd);
+    return line;
+}
+
+const std::vector<TextLayout::Line>& TextLayout::BreakLines(int width) {
+    Measure();
+    width = std::max(0, width);
+    useCounter++;
+
+    // Exact hit; otherwise re-break from the most recently used width, replacing the least recently used one
+    BreakCache* base = nullptr;
+    BreakCache* target = &caches[0];
+    for(BreakCache& cache : caches) {
+        if(cache.width == width) {
+            cache.lastUse = useCounter;
+            return cache.lines;
+        }
+        if(cache.width >= 0 && (!base || cache.lastUse > base->lastUse)) base = &cache;
+        if(cache.width < 0 || (target->width >= 0 && cache.lastUse < target->lastUse)) target = &cache;
+    }
+
+    // Greedy breaking is prefix-stable: a line keeps its break as long as it still fits and the next word still doesn't
+    size_t kept = 0;
+    if(base) {
+        while(kept < base->lines.size()) {
+            const Line& l = base->lines[kept];
+            if(l.width > width || width >= l.overflowWidth) break;
+            kept++;
+        }
+        if(target != base) {
+            target->lines.assign(base->lines.begin(), base->lines.begin() + kept);
+        }
+        else {
+            target->lines.resize(kept);
+        }
+    }
+    else {
+        target->lines.clear();
+    }
+    target->width = width;
+    target->lastUse = useCounter;
+
+    std::vector<Line>& lines = target->lines;
+    int pos = kept > 0 ? lines.back().next : 0;
+    int seg = kept > 0 ? lines.back().nextSegment : 0;
+    while(seg < static_cast<int>(segments.size())) {
+        Line line = BreakLine(pos, seg, width);
+        lines.push_back(line);
+        pos = line.next;
+        seg = line.nextSegment;
+    }
+    return lines;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <windows.h>
+
+// Word-wrapping line breaker for a (text, font) pair
+// Character advances are measured once per text/font; line breaks are cached for the last few widths.
+// A width change re-breaks only from the first line whose break actually moves (lines before it are kept).
+// Lines break after whitespace runs and at '\n'; words wider than the line are broken between characters.
+class TextLayout {
+    public:
+        struct Line {
+            int start;          // First character
+            int end;            // Past the last visible character (trailing whitespace excluded)
+            int next;           // Start of the next line (after the trailing whitespace / '\n')
+            int nextSegment;    // Segment the next line starts in
+            int width;          // Width of [start, end)
+            int overflowWidth;  // Width the line would need to take one more word (INT_MAX at hard breaks)
+        };
+
+        // The text isn't copied - it must stay alive and unchanged until the next SetText
+        void SetText(const wchar_t* newText, int newLength);
+        void SetFont(HFONT newFont);
+
+        // Lines for the given available width (cached)
+        const std::vector<Line>& BreakLines(int width);
+
+        // Height-for-width
+        int MeasureHeight(int width) { return static_cast<int>(BreakLines(width).size()) * GetLineHeight(); }
+
+        // Content sizes
+        int GetMinContentWidth();   // Widest word
+        int GetMaxContentWidth();   // Widest paragraph (no wrapping)
+        int GetLineHeight();
+
+        // Width of [start, end) within one line
+        int MeasureRange(int start, int end);
+
+    private:
+        // Word followed by its whitespace run: [start, wordEnd) + [wordEnd, end)
+        struct Segment {
+            int start;
+            int wordEnd;
+            int end;
+            bool hardBreak;     // Followed by '\n' (at end)
+        };
+
+        // Line breaks for one width
+        struct BreakCache {
+            int width = -1;
+            uint32_t lastUse = 0;
+            std::vector<Line> lines;
+        };
+        static const int BreakCacheSize = 4;
+
+        const wchar_t* text = nullptr;
+        int length = 0;
+        HFONT font = nullptr;
+
+        // Per-text/font measurement (lazily rebuilt)
+        bool measured = false;
+        std::vector<int> advances;      // advances[i] = x of character i (relative to its paragraph); length + 1 entries
+        std::vector<Segment> segments;
+        int minContentWidth = 0;
+        int maxContentWidth = 0;
+        int lineHeight = 0;
+
+        BreakCache caches[BreakCacheSize];
+        uint32_t useCounter = 0;
+
+        void Measure();
+        void Invalidate();
+
+        // Greedy break of the line starting at pos (within segment seg)
+        Line BreakLine(int pos, int seg, int width) const;
+        int Width(int start, int end) const { return advances[end] - advances[start]; }
+};
@@ -0,0 +1,77 @@
+#include <vector>
+#include <utility>
+
+#include "TextMeasure.h"
+#include "ScopedGDI.h"
+
+namespace TextMeasure {
+
+// Owns the per-thread memory DC
+struct MeasureDC {
+    HDC hdc = nullptr;
+    MeasureDC() {
+        HDC screen = GetDC(nullptr);
+        hdc = CreateCompatibleDC(screen);
+        ReleaseDC(nullptr, screen);
+    }
+    ~MeasureDC() {
+        if(hdc) DeleteDC(hdc);
+    }
+};
+
+HDC GetMeasureDC() {
+    thread_local MeasureDC dc;
+    return dc.hdc;
+}
+
+HFONT ResolveFont(HFONT font) {
+    return font ? font : (HFONT)GetStockObject(DEFAULT_GUI_FONT);
+}
+
+SIZE MeasureString(HFONT font, const wchar_t* text, int length) {
+    SIZE size{0, 0};
+    if(!text || length <= 0) return size;
+
+    HDC hdc = GetMeasureDC();
+    ScopedSelectFont sel(hdc, ResolveFont(font));
+    GetTextExtentPoint32W(hdc, text, length, &size);
+    return size;
+}
+
+void MeasureAdvances(HFONT font, const wchar_t* text, int length, int* extents) {
+    if(!text || length <= 0) return;
+
+    HDC hdc = GetMeasureDC();
+    ScopedSelectFont sel(hdc, ResolveFont(font));
+    SIZE size;
+    GetTextExtentExPointW(hdc, text, length, 0, nullptr, extents, &size);
+}
+
+FontMetrics GetFontMetrics(HFONT font) {
+    // An application uses a handful of fonts - a linear scan beats hashing here
+    thread_local std::vector<std::pair<HFONT, FontMetrics>> cache;
+
+    font = ResolveFont(font);
+    for(const auto& entry : cache) {
+        if(entry.first == font) return entry.second;
+    }
+
+    HDC hdc = GetMeasureDC();
+    ScopedSelectFont sel(hdc, font);
+    TEXTMETRICW tm;
+    GetTextMetricsW(hdc, &tm);
+
+    cache.push_back({font, {static_cast<int>(tm.tmHeight), static_cast<int>(tm.tmAscent)}});
+    return cache.back().second;
+}
+
+int CenteredBaseline(HFONT font, int boxHeight) {
+    FontMetrics metrics = GetFontMetrics(font);
+    return (boxHeight - metrics.height) / 2 + metrics.ascent;
+}
+
+int GetLineHeight(HFONT font) {
+    return GetFontMetrics(font).height;
+}
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <windows.h>
+
+// Text measuring helpers shared by widgets
+// Measuring uses a memory DC per thread, so layouts may run on worker threads
+namespace TextMeasure {
+    HDC GetMeasureDC();
+    HFONT ResolveFont(HFONT font); // nullptr => DEFAULT_GUI_FONT
+
+    // Vertical metrics of a font, cached per thread (fonts are expected to outlive the widgets using them)
+    struct FontMetrics {
+        int height;     // tmHeight
+        int ascent;     // tmAscent - baseline offset from the line top
+    };
+    FontMetrics GetFontMetrics(HFONT font);
+    int CenteredBaseline(HFONT font, int boxHeight); // Baseline of a line drawn with DT_VCENTER, from the box top
+
+    SIZE MeasureString(HFONT font, const wchar_t* text, int length);
+    void MeasureAdvances(HFONT font, const wchar_t* text, int length, int* extents); // extents[i] = width of the first i + 1 characters
+    int GetLineHeight(HFONT font); // tmHeight
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free single-producer/single-consumer triple buffer
+// The producer always has a back buffer to write and the consumer always has a front buffer to read,
+// so neither side ever waits for the other; the consumer simply skips frames it was too slow for
+template<typename T>
+class TripleBuffer {
+    public:
+        // Producer
+        T& Back() { return buffers[back]; }
+        void Publish() {
+            uint8_t prev = middle.exchange(static_cast<uint8_t>(back | FreshBit), std::memory_order_acq_rel);
+            back = prev & IndexMask;
+        }
+
+        // Consumer - returns true if a newer frame was swapped into Front()
+        bool Acquire() {
+            if(!HasFresh()) return false;
+            uint8_t prev = middle.exchange(front, std::memory_order_acq_rel);
+            front = prev & IndexMask;
+            return true;
+        }
+        const T& Front() const { return buffers[front]; }
+        bool HasFresh() const { return (middle.load(std::memory_order_acquire) & FreshBit) != 0; }
+
+    private:
+        static constexpr uint8_t IndexMask = 0x3;
+        static constexpr uint8_t FreshBit = 0x4; // Middle buffer holds a frame the consumer hasn't seen
+
+        T buffers[3];
+        uint8_t back = 0;                   // Producer only
+        std::atomic<uint8_t> middle{1};     // Shared
+        uint8_t front = 2;                  // Consumer only
+};
@@ -1,18 +1,58 @@
+#include <cmath>
+#include <atomic>
+#include <typeinfo>
 #include <algorithm>
 
 #include "Widget.h"
-#include "ScopedGDI.h"
-
-// Constructor
+#include "Root.h"
+#include "GdiPainter.h"
+#include "LayoutProfiler.h"
+#include "LayoutBatch.h"
+#include "LayoutSnapshot.h"
+#include "LayoutScheduler.h"
+
+// Constructor & destructor
 Widget::Widget() {}
 
+Widget::~Widget() {
+    // Stop receiving theme changes and let go of the style record
+    StyleRegistry& registry = StyleRegistry::Get();
+    if(styleClass != NoStyleClass) {
+        registry.Unsubscribe(styleClass, this);
+    }
+    registry.Release(style);
+}
+
 // Ancestors
+namespace {
+    std::atomic<uint64_t> treeEpoch{1}; // Bumped on every reparenting - invalidates all cached roots at once
+}
+
 void Widget::SetParent(Widget* newParent) {
     if(parent && !newParent) {
         // parent = nullptr -- parent removes this child
+        if(Root* root = GetRoot()) {
+            root->GetFocusManager().OnSubtreeDetached(*this);
+            root->GetWidgetIndex().RemoveSubtree(*this);
+        }
         OnRemovedFromTree();
     }
     parent = newParent;
+    treeEpoch.fetch_add(1, std::memory_order_relaxed);
+
+    // The tab order and the id/tag index follow the tree
+    if(newParent) {
+        if(Root* root = GetRoot()) {
+            root->GetFocusManager().InvalidateTabOrder();
+            root->GetWidgetIndex().AddSubtree(*this);
+        }
+    }
+}
+
+void Widget::AdjustSubtreeSize(long long delta) {
+    for(Widget* w = this; w; w = w->parent) {
+        w->subtreeSize = static_cast<size_t>(static_cast<long long>(w->subtreeSize) + delta);
+    }
 }
 
 Widget* Widget::GetMainContainer() const {
@@ -23,6 +63,70 @@ Widget* Widget::GetMainContainer() const {
     return const_cast<Widget*>(w);
 }
 
+Root* Widget::GetRoot() const {
+    uint64_t epoch = treeEpoch.load(std::memory_order_relaxed);
+    if(cachedRootEpoch != epoch) {
+        cachedRoot = dynamic_cast<Root*>(GetMainContainer());
+        cachedRootEpoch = epoch;
+    }
+    return cachedRoot;
+}
+
+// --- Identity -----------------------------------------------------
+WidgetIndex* Widget::GetIndex() const {
+    if(!indexed) return nullptr;
+    Root* root = GetRoot();
+    return root ? &root->GetWidgetIndex() : nullptr;
+}
+
+void Widget::SetId(int newId) {
+    if(id == newId) return;
+
+    // Re-indexed as a whole - id changes are rare
+    WidgetIndex* index = GetIndex();
+    if(index) index->Remove(*this);
+    id = newId;
+    if(index) index->Add(*this);
+}
+
+void Widget::SetId(const std::string& newId) {
+    WidgetName name = WidgetNames::Get().Intern(newId);
+    if(stringId == name) return;
+
+    WidgetIndex* index = GetIndex();
+    if(index) index->Remove(*this);
+    stringId = name;
+    if(index) index->Add(*this);
+}
+
+void Widget::AddTag(const std::string& tag) {
+    WidgetName name = WidgetNames::Get().Intern(tag);
+    if(name == NoWidgetName || HasTag(name)) return;
+
+    WidgetIndex* index = GetIndex();
+    if(index) index->Remove(*this);
+    tags.push_back({name});
+    if(index) index->Add(*this);
+}
+
+void Widget::RemoveTag(const std::string& tag) {
+    WidgetName name = WidgetNames::Get().Find(tag);
+    if(name == NoWidgetName || !HasTag(name)) return;
+
+    WidgetIndex* index = GetIndex();
+    if(index) index->Remove(*this);
+    tags.erase(std::find_if(tags.begin(), tags.end(), [name](const WidgetTag& t) { return t.name == name; }));
+    if(index) index->Add(*this);
+}
+
+bool Widget::HasTag(WidgetName tag) const {
+    if(tag == NoWidgetName) return false;
+    for(const WidgetTag& t : tags) {
+        if(t.name == tag) return true;
+    }
+    return false;
+}
+
 // --- Geometry -----------------------------------------------------
 // Absolute coordinate getters (relative => absolute)
 int Widget::AbsX() const {
@@ -78,6 +182,7 @@ void Widget::SetPos(int x, int y) {
     int h = rect.bottom - rect.top;
     rect = {x, y, x + w, y + h};
     UpdateConvenienceGeometry();
+    LayoutProfiler::ScopedTiming timing;
     UpdateEffectiveGeometry();  // Don't invalidate - no need for relayout
                                 // just update effective geometry of the subtree
 }
@@ -101,6 +206,17 @@ void Widget::SetLayoutSize(int w, int h) {
     layoutHeight = h;
     // Don't invalidate here to avoid infinite loops with layouts
 }
+void Widget::ApplyIntrinsicSize() {
+    if(!widthProperties.isAuto && !heightProperties.isAuto) return;
+
+    IntrinsicSize content = GetIntrinsicSize();
+    if(content.maxWidth < 0) return;
+
+    SetLayoutSize(
+        widthProperties.isAuto ? content.maxWidth : width,
+        heightProperties.isAuto ? content.height : height
+    );
+}
 
 RECT Widget::ComputeInnerRect() const {
     RECT r = EffectiveRect();
@@ -178,6 +294,12 @@ void Widget::SetEffectiveRect(int l, int t, int r, int b) {
     effectiveRect = {l, t, r, b};
 }
 void Widget::InvalidateLayout() {
+    if(LayoutBatch::IsDeferring()) return; // The builder lays the whole subtree out once
+    if(LayoutBatch::IsCollecting()) {
+        LayoutBatch::Collect(*this); // Reflowed once when the collect scope ends
+        return;
+    }
+
     if(auto* p = GetParent()) {
         if(p->GetLayout()) {
             // Start reflow at parent if current Container is a layout item
@@ -185,8 +307,18 @@ void Widget::InvalidateLayout() {
             return;
         }
     }
+    LayoutProfiler::ScopedTiming timing;
+    RECT before = effectiveRect;
+    ApplyIntrinsicSize(); // Size to content before the rect is derived from it
     ApplyLogicalGeometry();
     UpdateInternalLayout();
+
+    // The reflowed subtree repaints where it was and where it is now
+    // Not from within parallel layout tasks - the paint flags and damage are shared; the reflow that started
+    // the layout pass repaints its whole subtree
+    if(LayoutScheduler::InTask()) return;
+    InvalidatePaint(before);
+    InvalidatePaint();
 }
 void Widget::UpdateInternalLayout() {
     // Updates automatic layouts on geometry changes
@@ -254,6 +386,81 @@ void Widget::SetAutoHeight(bool isAuto) {
     InvalidateLayout();
 }
 
+void Widget::SetFlexGrow(bool flexGrow) {
+    flex.grow = flexGrow ? 1.0f : 0.0f;
+    flex.basis = flexGrow ? 0 : -1;
+    InvalidateLayout();
+}
+void Widget::SetFlexGrowFactor(float grow) {
+    flex.grow = std::max(0.0f, grow);
+    InvalidateLayout();
+}
+void Widget::SetFlexShrink(float shrink) {
+    flex.shrink = std::max(0.0f, shrink);
+    InvalidateLayout();
+}
+void Widget::SetFlexBasis(int basis) {
+    flex.basis = basis;
+    InvalidateLayout();
+}
+
+void Widget::SetMinSize(int minWidth, int minHeight) {
+    sizeLimits.minWidth = std::max(-1, minWidth);
+    sizeLimits.minHeight = std::max(-1, minHeight);
+    InvalidateLayout();
+}
+void Widget::SetMaxSize(int maxWidth, int maxHeight) {
+    sizeLimits.maxWidth = std::max(0, maxWidth);
+    sizeLimits.maxHeight = std::max(0, maxHeight);
+    InvalidateLayout();
+}
+
+void Widget::SetGridCell(int row, int column, int rowSpan, int columnSpan) {
+    // Clamped to what GridPlacement holds (any negative row/column = automatic); cell ends stay within int16_t
+    gridPlacement.row = static_cast<int16_t>(std::max(-1, std::min<int>(row, INT16_MAX)));
+    gridPlacement.column = static_cast<int16_t>(std::max(-1, std::min<int>(column, INT16_MAX)));
+    gridPlacement.rowSpan = static_cast<uint16_t>(std::max(1, std::min<int>(rowSpan, INT16_MAX - std::max(0, row))));
+    gridPlacement.columnSpan = static_cast<uint16_t>(std::max(1, std::min<int>(columnSpan, INT16_MAX - std::max(0, column))));
+    InvalidateLayout();
+}
+void Widget::SetGridSpan(int rowSpan, int columnSpan) {
+    SetGridCell(-1, -1, rowSpan, columnSpan);
+}
+
+void Widget::HashLayoutInputs(LayoutHash& hash) const {
+    hash.AddType(typeid(*this));
+
+    hash.Add(rect);
+    hash.Add(preferredWidth);
+    hash.Add(preferredHeight);
+    for(const Spacing* s : {&padding, &margin}) {
+        hash.Add(s->top);
+        hash.Add(s->bottom);
+        hash.Add(s->left);
+        hash.Add(s->right);
+    }
+    hash.Add(widthProperties.isAuto);
+    hash.Add(heightProperties.isAuto);
+    hash.Add(flex.grow);
+    hash.Add(flex.shrink);
+    hash.Add(flex.basis);
+    hash.Add(sizeLimits.minWidth);
+    hash.Add(sizeLimits.minHeight);
+    hash.Add(sizeLimits.maxWidth);
+    hash.Add(sizeLimits.maxHeight);
+    hash.Add(static_cast<int>(gridPlacement.row));
+    hash.Add(static_cast<int>(gridPlacement.column));
+    hash.Add(static_cast<int>(gridPlacement.rowSpan));
+    hash.Add(static_cast<int>(gridPlacement.columnSpan));
+    hash.Add(static_cast<int>(anchor));
+    hash.Add(displayed);
+    hash.Add(border.top.thickness);
+    hash.Add(border.bottom.thickness);
+    hash.Add(border.left.thickness);
+    hash.Add(border.right.thickness);
+    hash.AddFont(StyleFont()); // Baselines
+}
+
 // --- Display & Visibility --------------------------------------------
 void Widget::SetDisplayed(bool displayed) {
     this->displayed = displayed;
@@ -271,11 +478,13 @@ void Widget::UpdateEffectiveDisplay() {
 
     effectiveDisplayed = newEff;
     OnDisplayChanged(effectiveDisplayed);
+    InvalidatePaint();
 }
 
 void Widget::SetVisible(bool visible)  {
     this->visible = visible;
     OnVisibilityChanged(visible);
+    InvalidatePaint();
 }
 
 // --- Mouse event handlers -------------------------------------------
@@ -297,22 +506,63 @@ bool Widget::MouseInRect(POINT p) const {
 }
 
 // Mouse listeners
-size_t Widget::AddMouseListener(std::function<void(const MouseEvent&)> callback) {
-    size_t id = nextListenerID++;
-    mouseListeners.push_back({id, callback});
-    return id;
-}
-void Widget::RemoveMouseListener(size_t id) {
-    mouseListeners.erase(
-        std::remove_if(
-            mouseListeners.begin(),
-            mouseListeners.end(),
-            [&](const MouseListener& l) {
-                return l.id == id;
-            }
-        ),
-        mouseListeners.end()
-    );
+namespace {
+    constexpr unsigned ListenerIndexBits = 32; // Lower half: slot index + 1, upper half: generation
+    constexpr uint64_t ListenerIndexMask = (uint64_t(1) << ListenerIndexBits) - 1;
+
+    uint64_t MakeListenerID(uint32_t generation, size_t index) {
+        return (static_cast<uint64_t>(generation) << ListenerIndexBits) | ((index + 1) & ListenerIndexMask);
+    }
+}
+
+uint64_t Widget::AddMouseListener(MouseCallback callback) {
+    uint32_t index;
+    MouseListener* slot;
+
+    if(!freeListenerSlots.empty()) {
+        index = freeListenerSlots.back();
+        freeListenerSlots.pop_back();
+        slot = &mouseListeners[index];
+    }
+    else if(listenerFiringDepth > 0) {
+        index = static_cast<uint32_t>(mouseListeners.size() + pendingMouseListeners.size());
+        pendingMouseListeners.emplace_back();
+        slot = &pendingMouseListeners.back();
+    }
+    else {
+        index = static_cast<uint32_t>(mouseListeners.size());
+        mouseListeners.emplace_back();
+        slot = &mouseListeners.back();
+    }
+
+    slot->callback = std::move(callback);
+    slot->alive = true;
+    return MakeListenerID(slot->generation, index);
+}
+void Widget::RemoveMouseListener(uint64_t id) {
+    size_t index = static_cast<size_t>((id & ListenerIndexMask) - 1);
+
+    MouseListener* slot = nullptr;
+    if(index < mouseListeners.size()) {
+        slot = &mouseListeners[index];
+    }
+    else if(index - mouseListeners.size() < pendingMouseListeners.size()) {
+        slot = &pendingMouseListeners[index - mouseListeners.size()];
+    }
+    if(!slot || !slot->alive || MakeListenerID(slot->generation, index) != id) {
+        return; // Stale or invalid ID
+    }
+
+    slot->alive = false;
+    slot->generation++;
+
+    // The callback may be the one currently running - destroy it only once firing is done
+    if(listenerFiringDepth > 0) {
+        listenerSlotsToFree = true;
+        return;
+    }
+    slot->callback.Reset();
+    freeListenerSlots.push_back(static_cast<uint32_t>(index));
 }
 
 bool Widget::InitFeedMouseEvent(const MouseEvent& e) {
@@ -334,14 +584,52 @@ bool Widget::FeedMouseEvent(const MouseEvent& e) {
 }
 
 void Widget::FireMouseEvent(const MouseEvent& e) {
-    for(auto& listener : mouseListeners) {
-        listener.callback(e);
+    OnMouseEvent(e);
+    if(mouseListeners.empty()) return;
+
+    // Indexed loop - listeners may add/remove listeners while running
+    listenerFiringDepth++;
+    for(size_t i = 0; i < mouseListeners.size(); i++) {
+        if(mouseListeners[i].alive) {
+            mouseListeners[i].callback(e);
+        }
+    }
+    listenerFiringDepth--;
+
+    if(listenerFiringDepth == 0) {
+        FlushListenerChanges();
+    }
+}
+
+void Widget::FlushListenerChanges() {
+    if(listenerSlotsToFree) {
+        listenerSlotsToFree = false;
+        for(size_t i = 0; i < mouseListeners.size(); i++) {
+            MouseListener& slot = mouseListeners[i];
+            if(!slot.alive && slot.callback) {
+                slot.callback.Reset();
+                freeListenerSlots.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
+
+    if(!pendingMouseListeners.empty()) {
+        size_t first = mouseListeners.size();
+        for(size_t i = 0; i < pendingMouseListeners.size(); i++) {
+            mouseListeners.push_back(std::move(pendingMouseListeners[i]));
+            if(!mouseListeners.back().alive) {
+                mouseListeners.back().callback.Reset();
+                freeListenerSlots.push_back(static_cast<uint32_t>(first + i)); // Added and removed within the same dispatch
+            }
+        }
+        pendingMouseListeners.clear();
     }
 }
 
 bool Widget::OnMouseMove(POINT p) {
     bool wasHovered = hovered; // read old state
     hovered = MouseInRect(p);  // read current state
+    if(hovered != wasHovered && style) InvalidatePaint(); // State colors (unstyled widgets look the same)
 
     if(hovered && !wasHovered) {
         FireMouseEvent({MouseEventType::Enter, p, MouseButton::Left});
@@ -364,6 +652,8 @@ bool Widget::OnMouseDown(POINT p) {
     if(MouseInRect(p)) {
         pressed = true;
         mouseDownInside = true; // track click start
+        if(style) InvalidatePaint();
+        if(focusable) Focus();
         FireMouseEvent({MouseEventType::Down, p, MouseButton::Left});
         return true;
     }
@@ -380,21 +670,42 @@ bool Widget::OnMouseUp(POINT p) {
             FireMouseEvent({MouseEventType::Click, p, MouseButton::Left});
         }
     }
+    if(pressed && style) InvalidatePaint();
     pressed = false;
     mouseDownInside = false;
 
     return handled;
 }
 
+// --- Keyboard & focus -----------------------------------------------
+void Widget::SetFocusable(bool focusable) {
+    if(this->focusable == focusable) return;
+    if(!focusable) Blur();
+    this->focusable = focusable;
+
+    if(Root* root = GetRoot()) root->GetFocusManager().InvalidateTabOrder();
+}
+
+bool Widget::Focus() {
+    Root* root = GetRoot();
+    return root && root->GetFocusManager().SetFocus(this);
+}
+
+void Widget::Blur() {
+    if(!focused) return;
+    if(Root* root = GetRoot()) root->GetFocusManager().SetFocus(nullptr);
+}
+
 // --- Appearance -----------------------------------------------------
 void Widget::SetBorder(int thickness, const Color& color, BorderSide sides) {
     if(HasSide(sides, BorderSide::Top))    border.top    = {thickness, color};
     if(HasSide(sides, BorderSide::Right))  border.right  = {thickness, color};
     if(HasSide(sides, BorderSide::Bottom)) border.bottom = {thickness, color};
     if(HasSide(sides, BorderSide::Left))   border.left   = {thickness, color};
+    InvalidatePaint();
 }
 
-void Widget::DrawBorderEdge(HDC hdc, BorderData borderData, BorderSide side) {
+void Widget::DrawBorderEdge(Painter& painter, BorderData borderData, BorderSide side) {
     if(borderData.thickness <= 0) return;
 
     RECT r = EffectiveRect();
@@ -414,50 +725,154 @@ void Widget::DrawBorderEdge(HDC hdc, BorderData borderData, BorderSide side) {
         case BorderSide::Right:
             br.left = br.right - borderData.thickness;
             break;
+        case BorderSide::None:
+        case BorderSide::All:
+            return; // Not a single edge
     }
-    ScopedOwnedBrush brush(hdc, borderData.color.toCOLORREF());
-    FillRect(hdc, &br, brush.get());
+    painter.FillRect(br, borderData.color);
 }
 
-void Widget::RenderBorder(HDC hdc) {
-    DrawBorderEdge(hdc, border.top, BorderSide::Top);
-    DrawBorderEdge(hdc, border.bottom, BorderSide::Bottom);
-    DrawBorderEdge(hdc, border.left, BorderSide::Left);
-    DrawBorderEdge(hdc, border.right, BorderSide::Right);
+void Widget::RenderBorder(Painter& painter) {
+    DrawBorderEdge(painter, border.top, BorderSide::Top);
+    DrawBorderEdge(painter, border.bottom, BorderSide::Bottom);
+    DrawBorderEdge(painter, border.left, BorderSide::Left);
+    DrawBorderEdge(painter, border.right, BorderSide::Right);
 }
 
-void Widget::RenderBackground(HDC hdc) {
+void Widget::RenderBackground(Painter& painter) {
     if(backgroundColor.a > 0) { // only draw if non-transparent
-        ScopedOwnedBrush br(hdc, backgroundColor.toCOLORREF());
-        RECT r = EffectiveRect();
-        FillRect(hdc, &r, br.get());
+        painter.FillRect(EffectiveRect(), backgroundColor);
     }
 }
 
+// --- Generic properties ---------------------------------------------
+bool Widget::ApplyProperty(PropertyID property, const PropertyValue& value) {
+    switch(property) {
+        case PropertyID::Displayed:
+            if(auto* v = std::get_if<bool>(&value)) { SetDisplayed(*v); return true; }
+            break;
+        case PropertyID::Visible:
+            if(auto* v = std::get_if<bool>(&value)) { SetVisible(*v); return true; }
+            break;
+        case PropertyID::Enabled:
+            if(auto* v = std::get_if<bool>(&value)) { SetEnabled(*v); return true; }
+            break;
+        case PropertyID::BackgroundColor:
+            if(auto* v = std::get_if<Color>(&value)) { SetBackgroundColor(*v); return true; }
+            break;
+        case PropertyID::Width:
+            if(auto* v = std::get_if<float>(&value)) { SetSize(static_cast<int>(std::lround(*v)), height); return true; }
+            break;
+        case PropertyID::Height:
+            if(auto* v = std::get_if<float>(&value)) { SetSize(width, static_cast<int>(std::lround(*v))); return true; }
+            break;
+        default:
+            break;
+    }
+    return false;
+}
+
+// --- Style --------------------------------------------------------
+void Widget::SetStyleClass(StyleClassID id) {
+    StyleRegistry& registry = StyleRegistry::Get();
+    const Style* classStyle = registry.Follow(id, styleClass, this);
+    if(!classStyle) return;
+
+    styleClass = id;
+    registry.Release(ApplyStyle(classStyle));
+}
+
+void Widget::SetStyle(const StyleDesc& desc) {
+    StyleRegistry& registry = StyleRegistry::Get();
+
+    // Private look - theme changes of the class no longer apply
+    if(styleClass != NoStyleClass) {
+        registry.Unsubscribe(styleClass, this);
+        styleClass = NoStyleClass;
+    }
+    registry.Release(ApplyStyle(registry.Intern(desc)));
+}
+
+const Style* Widget::ApplyStyle(const Style* newStyle) {
+    const Style* previous = style;
+    style = newStyle;
+    if(newStyle != previous) {
+        OnStyleChanged();
+    }
+    return previous;
+}
+
+const StyleColors& Widget::StateColors() const {
+    static const StyleColors unstyled;
+    return style ? style->Get(CurrentStyleState()) : unstyled;
+}
+
+void Widget::SetTextColorOverride(Color color) {
+    if(hasTextColor && textColorOverride == color) return;
+    hasTextColor = true;
+    textColorOverride = color;
+    InvalidatePaint();
+}
+
+Color Widget::StateTextColor(StyleState state) const {
+    if(hasTextColor) return textColorOverride;
+    return style ? style->Get(state).foreground : StyleColors{}.foreground;
+}
+
+StyleState Widget::CurrentStyleState() const {
+    if(!enabled) return StyleState::Disabled;
+    if(pressed) return StyleState::Pressed;
+    if(hovered) return StyleState::Hover;
+    return StyleState::Normal;
+}
+
 // --- Rendering ------------------------------------------------------
+void Widget::InvalidatePaint() {
+    InvalidatePaint(effectiveRect);
+}
+
+void Widget::InvalidatePaint(const RECT& area) {
+    paintDirty = true;
+
+    // Mark the ancestor chain, up to the first already marked ancestor - everything above it is marked too.
+    // (Stale flags only survive in hidden subtrees, which aren't rendered - and stay hidden until invalidated themselves.)
+    for(Widget* p = parent; p && !p->childPaintDirty; p = p->parent) {
+        p->childPaintDirty = true;
+    }
+
+    if(Root* root = GetRoot()) {
+        root->AddDamage(area);
+    }
+}
+
 void Widget::InitRender(HDC hdc) {
+    GdiPainter painter(hdc);
+    InitRender(painter);
+}
+
+void Widget::InitRender(Painter& painter) {
+    paintDirty = false;
+    childPaintDirty = false;
     if(!effectiveDisplayed || !visible) return;
     
-    // Render must not call SaveDC/RestoreDC again - it's taken care of here
-    int saved = SaveDC(hdc);
-
+    // Render must not clip itself again - it's taken care of here
     if(clipChildren) {
-        IntersectClipRect(
-            hdc,
-            effectiveRect.left,
-            effectiveRect.top,
-            effectiveRect.right,
-            effectiveRect.bottom
-        );
-    }
-
-    RenderBackground(hdc);
-    Render(hdc);
-    RenderBorder(hdc);
+        painter.PushClip(effectiveRect);
+    }
+
+    if(styleBackground && style) {
+        backgroundColor = StateColors().background;
+    }
+    RenderBackground(painter);
+    Render(painter);
+    RenderBorder(painter);
     if(onRender) {
         onRender();
     }
-    RestoreDC(hdc, saved);
+
+    if(clipChildren) {
+        painter.PopClip();
+    }
 }
 
 // --- Other ----------------------------------------------------------
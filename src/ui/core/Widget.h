@@ -1,12 +1,20 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <climits>
+#include <cstdint>
 #include <vector>
 #include <functional>
 #include <windows.h>
 
 #include "Color.h"
 #include "Border.h"
+#include "Style.h"
+#include "Property.h"
+#include "Painter.h"
+#include "InlineFunction.h"
+#include "WidgetIndex.h"
 
 enum class MouseEventType { Enter, Leave, Move, Down, Up, Click };
 enum class MouseButton { None = 0, Left = 1, Right = 2 };
@@ -16,10 +24,42 @@ struct MouseEvent {
     POINT pos;  // absolute (screen coordinates)
     MouseButton button;
 };
-struct MouseListener {
-    size_t id;
-    std::function<void(const MouseEvent&)> callback;
+// Captures up to 32 bytes are stored inline (no allocation per listener)
+using MouseCallback = InlineFunction<void(const MouseEvent&)>;
+struct MouseListener { // Slot of the listener slot map
+    MouseCallback callback;
+    uint32_t generation = 0; // Bumped on removal, so stale IDs never hit a reused slot
+    bool alive = false;
 };
+
+enum class KeyEventType { Down, Up };
+// Using uint8_t instead of int for optimization
+enum class KeyModifiers : uint8_t {
+    None    = 0,
+    Shift   = 1 << 0,
+    Control = 1 << 1,
+    Alt     = 1 << 2
+};
+inline KeyModifiers operator|(KeyModifiers a, KeyModifiers b) {
+    return static_cast<KeyModifiers>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
+}
+inline bool HasModifier(KeyModifiers modifiers, KeyModifiers modifier) {
+    return (static_cast<uint8_t>(modifiers) & static_cast<uint8_t>(modifier)) != 0;
+}
+
+struct KeyEvent { // WM_KEYDOWN/WM_KEYUP
+    KeyEventType type;
+    UINT key;               // Virtual-key code (VK_*)
+    KeyModifiers modifiers;
+    bool repeat;            // Auto-repeated Down
+};
+struct CharEvent { // WM_CHAR - text input, after keyboard layout translation
+    wchar_t character;
+};
+// Return true if handled (stops bubbling to the ancestors)
+using KeyCallback = std::function<bool(const KeyEvent&)>;
+using CharCallback = std::function<bool(const CharEvent&)>;
+
 enum class Anchor { // Dictates which rect corners x,y refer to
     TopLeft,
     TopRight,
@@ -36,21 +76,75 @@ struct Spacing {
 struct DimensionProperties {
     bool isAuto = false;
 };
+struct FlexProperties { // Used by FlexLayout (CSS flex-grow/flex-shrink/flex-basis)
+    float grow = 0.0f;
+    float shrink = 1.0f;    // Scaled by the basis, like CSS
+    int basis = -1;         // Main length before flexing; -1 = layout width/height
+};
+struct SizeLimits { // Honored by FlexLayout on both axes
+    int minWidth = -1;      // -1 = automatic: content minimum of content-sized axes (CSS min-width: auto), 0 otherwise
+    int minHeight = -1;
+    int maxWidth = INT_MAX;
+    int maxHeight = INT_MAX;
+};
+struct IntrinsicSize { // Content-based size incl. padding; -1 = the widget doesn't size to its content
+    int minWidth = -1;  // Narrowest width without overflowing (min-content)
+    int maxWidth = -1;  // Width without any wrapping (max-content)
+    int height = -1;    // Height at maxWidth
+};
+struct WidgetTag {
+    WidgetName name;
+    uint32_t slot = 0;  // Position in the Root's list of widgets with this tag (maintained by WidgetIndex)
+};
+struct GridPlacement { // Cell of a GridLayout child (row/column < 0 = placed automatically)
+    int16_t row = -1;
+    int16_t column = -1;
+    uint16_t rowSpan = 1;
+    uint16_t columnSpan = 1;
+};
 
 class Layout;
+class LayoutHash;
+class Root;
 class Widget {
     public:
         // Allow Layout access to select parts of Widget via a dedicated proxy
         friend class LayoutWidgetBridge;
+        // Allow the style registry to push theme changes to subscribed widgets
+        friend class StyleRegistry;
+        // Allow the focus manager to deliver keyboard events and track focus/tab order state
+        friend class FocusManager;
+        // Allow layout snapshots to capture and restore solved geometry
+        friend class LayoutSnapshot;
+        // Allow the Root's id/tag index to track its position in the tag lists
+        friend class WidgetIndex;
+        // Allow selector queries to match ids/tags and walk up parent pointers
+        friend class Selector;
 
         // Constructor & destructor
         Widget();
-        virtual ~Widget() {};
+        virtual ~Widget();
 
         // Ancestors
         virtual Widget* GetParent() const { return parent; }
         void SetParent(Widget* newParent);
         Widget* GetMainContainer() const; // Gets the topmost non-Root container
+        Root* GetRoot() const;            // Root of the tree this widget is in (nullptr if detached)
+        size_t GetSubtreeSize() const { return subtreeSize; } // Number of widgets in this subtree (including itself)
+
+        // --- Identity ---
+        // Ids and tags are indexed by the Root (Root::FindById, Root::GetTagged, Selector queries)
+        int GetId() const { return id; }
+        void SetId(int id);                         // 0 = none
+        const std::string& GetStringId() const { return WidgetNames::Get().GetString(stringId); }
+        WidgetName GetInternedId() const { return stringId; }
+        void SetId(const std::string& id);          // "" = none
+
+        void AddTag(const std::string& tag);
+        void RemoveTag(const std::string& tag);
+        bool HasTag(const std::string& tag) const { return HasTag(WidgetNames::Get().Find(tag)); }
+        bool HasTag(WidgetName tag) const;
+        const std::vector<WidgetTag>& GetTags() const { return tags; }
 
         // Visual state
         bool IsDisplayed() const { return displayed; }
@@ -60,10 +154,10 @@ class Widget {
         void SetVisible(bool visible);
 
         bool IsEnabled() const { return enabled; }
-        void SetEnabled(bool enabled) { this->enabled = enabled; }
+        void SetEnabled(bool enabled) { this->enabled = enabled; InvalidatePaint(); }
 
         bool IsClippingChildren() const { return clipChildren; }
-        void SetChildrenClipping(bool clipChildren) { this->clipChildren = clipChildren; }
+        void SetChildrenClipping(bool clipChildren) { this->clipChildren = clipChildren; InvalidatePaint(); }
 
         // --- Geometry -----------------------------------------------------
         // Relative geometry read access
@@ -120,6 +214,17 @@ class Widget {
         virtual void UpdateEffectiveGeometry(); // Updates effective geometry
                                                 // Virtual, because Container should override to propagate further
 
+        // Content-based sizing, queried by layouts before measuring (auto-sized axes take it without a relayout)
+        virtual IntrinsicSize GetIntrinsicSize() const { return {}; }
+        // Height (incl. padding) at the given width, for content that wraps (-1 = doesn't depend on the width)
+        virtual int GetHeightForWidth(int /*width*/) const { return -1; }
+        // First text baseline as offset from the top of a box of the given height (-1 = no text)
+        virtual int GetBaseline(int /*height*/) const { return -1; }
+
+        // Everything the solved geometry depends on, for LayoutSnapshot validation
+        // Widgets sizing to their content (or with a font-dependent baseline) add the content, then call the base
+        virtual void HashLayoutInputs(LayoutHash& hash) const;
+
         // Spacing and dynamic geometry properties
         const Spacing& GetPadding() const { return padding; }
         void SetPadding(int all);
@@ -140,8 +245,23 @@ class Widget {
         bool IsAutoHeight() const { return heightProperties.isAuto; }
         void SetAutoHeight(bool isAuto);
 
-        bool IsFlexGrow() const { return isFlexGrow; }
-        void SetFlexGrow(bool flexGrow) { isFlexGrow = flexGrow; }
+        // Flex factors
+        bool IsFlexGrow() const { return flex.grow > 0.0f; }
+        void SetFlexGrow(bool flexGrow); // true = grow 1 from a zero basis (CSS flex: 1) - children share space equally
+        const FlexProperties& GetFlexProperties() const { return flex; }
+        void SetFlexGrowFactor(float grow);
+        void SetFlexShrink(float shrink); // 0 = never shrink below the basis
+        void SetFlexBasis(int basis);
+
+        // Min/max size constraints
+        const SizeLimits& GetSizeLimits() const { return sizeLimits; }
+        void SetMinSize(int minWidth, int minHeight); // -1 = automatic
+        void SetMaxSize(int maxWidth, int maxHeight); // INT_MAX = unlimited
+
+        // GridLayout placement (only used if the parent has a GridLayout)
+        const GridPlacement& GetGridPlacement() const { return gridPlacement; }
+        void SetGridCell(int row, int column, int rowSpan = 1, int columnSpan = 1);
+        void SetGridSpan(int rowSpan, int columnSpan); // Placed automatically, spanning multiple cells
 
         Anchor GetAnchor() const { return anchor; }
         void SetAnchor(Anchor newAnchor) { anchor = newAnchor; }
@@ -154,8 +274,9 @@ class Widget {
         bool MouseInRect(POINT p) const;
 
         // Mouse listeners
-        size_t AddMouseListener(std::function<void(const MouseEvent&)> callback); // returns ID
-        void RemoveMouseListener(size_t id);
+        // Safe to call from within a listener; IDs are never 0 (64-bit on every target, so the generation isn't truncated)
+        uint64_t AddMouseListener(MouseCallback callback); // returns ID
+        void RemoveMouseListener(uint64_t id);             // O(1), ignores stale IDs
 
         // Pre-feeding logic (condition checks, etc.) - template method
         virtual bool InitFeedMouseEvent(const MouseEvent& e) final;
@@ -164,25 +285,71 @@ class Widget {
         void SetMouseEventsIgnoring(bool ignore) { ignoreMouseEvents = ignore; }
         bool IsIgnoringMouseEvents() const { return ignoreMouseEvents; }
 
+        // --- Keyboard & focus ---
+        // Focusable widgets take the focus when clicked and are part of the Tab order (tree order)
+        bool IsFocusable() const { return focusable; }
+        void SetFocusable(bool focusable);
+        bool HasFocus() const { return focused; }
+        bool Focus();   // Returns false if the widget can't take focus (not focusable/displayed/enabled or not in a Root)
+        void Blur();
+
+        // Keyboard listeners - called for the focused widget, then for its ancestors until one returns true
+        void SetOnKey(KeyCallback cb) { onKey = std::move(cb); }
+        void SetOnChar(CharCallback cb) { onChar = std::move(cb); }
+
         // --- Appearance ---
+        // An explicit background overrides the style's state backgrounds (like a text color override)
         Color GetBackgroundColor() const { return backgroundColor; }
-        void SetBackgroundColor(const Color& newColor) { backgroundColor = newColor; }
+        void SetBackgroundColor(const Color& newColor) {
+            if(!styleBackground && backgroundColor == newColor) return;
+            styleBackground = false;
+            backgroundColor = newColor;
+            InvalidatePaint();
+        }
 
         Border GetBorder() const { return border; }
         void SetBorder(int thickness, const Color& color, BorderSide sides);        
 
+        // --- Generic properties ---
+        // Sets a property by ID (used by deferred/cross-thread updates)
+        // Returns false if the widget doesn't have the property or the value type doesn't match
+        virtual bool ApplyProperty(PropertyID property, const PropertyValue& value);
+
+        // --- Style ---
+        const Style* GetStyle() const { return style; }
+        StyleClassID GetStyleClass() const { return styleClass; }
+        void SetStyleClass(StyleClassID id);    // Follow a (themeable) style class
+        void SetStyle(const StyleDesc& desc);   // Use a private look (stops following the style class)
+
         // --- Rendering ---
-        virtual void InitRender(HDC hdc) final; // Pre-render logic (condition checks, etc.) - template method
+        virtual void InitRender(Painter& painter) final; // Pre-render logic (condition checks, etc.) - template method
+        void InitRender(HDC hdc);                        // Convenience: immediate GDI rendering
         void SetOnRender(std::function<void()> cb) { onRender = std::move(cb); }
 
+        // Request repaint of this widget (flag is propagated to ancestors so the root knows a frame is needed)
+        void InvalidatePaint();
+        void InvalidatePaint(const RECT& area); // Only the (absolute) area changed - it's all the Root reports as damaged
+        bool IsPaintDirty() const { return paintDirty || childPaintDirty; }
+
     protected:
         // Pointer to parent widget (container)
         Widget* parent = nullptr;
+        mutable Root* cachedRoot = nullptr; // GetRoot() result, valid while cachedRootEpoch matches the tree epoch
+        mutable uint64_t cachedRootEpoch = 0;
+        size_t subtreeSize = 1; // Maintained by Container on child changes
+        void AdjustSubtreeSize(long long delta); // Propagates a subtree size change up to the root
+
+        // Identity
+        int id = 0;
+        WidgetName stringId = NoWidgetName;
+        std::vector<WidgetTag> tags;    // Few per widget; empty vectors don't allocate
+        bool indexed = false;           // Registered in the WidgetIndex of a Root (maintained by WidgetIndex)
+        WidgetIndex* GetIndex() const;  // Index of the Root this widget is registered in (nullptr if none)
 
         // Bounding rectangles relative to parent
         RECT rect = {0, 0, 0, 0};   // LOGICAL - as set by client code
-        RECT effectiveRect;         // EFFECTIVE - as computed internally and rendered on the screen
-                                    // (includes offsets, margins, padding, etc.)
+        RECT effectiveRect = {0, 0, 0, 0}; // EFFECTIVE - as computed internally and rendered on the screen
+                                           // (includes offsets, margins, padding, etc.)
         void SetEffectiveRect(int l, int t, int r, int b);
         // Compute and apply effective geometry from logical geometry + padding, margins, etc.
         void ApplyLogicalGeometry(); 
@@ -205,6 +372,11 @@ class Widget {
         int preferredWidth = 0, preferredHeight = 0;    // Widget size hint set by client code
         int layoutWidth = -1, layoutHeight = -1;        // Final size computed by layout system (mainly for auto sizing); -1 means unset
         void SetLayoutSize(int w, int h);               // Should only be used internally, mainly by layouts
+        void ApplyIntrinsicSize();                      // Auto-sized axes take the intrinsic size (if any)
+
+        // Cached content measurement (e.g. text size) that a LayoutSnapshot restores with the geometry; {-1, -1} = none
+        virtual SIZE GetMeasuredContent() const { return {-1, -1}; }
+        virtual void AdoptMeasuredContent(SIZE /*size*/) {}
 
         // Helper functions reacting to geometry changes
         void UpdateConvenienceGeometry();       // Updates convenience geometry vars on internal geometry changes
@@ -214,14 +386,24 @@ class Widget {
         Spacing margin;
         DimensionProperties widthProperties;
         DimensionProperties heightProperties;
-        bool isFlexGrow = false;
+        FlexProperties flex;
+        SizeLimits sizeLimits;
+        GridPlacement gridPlacement;
         Anchor anchor = Anchor::TopLeft;
 
         // --- Mouse events  ------------------------------------------------
+        // Slot map (ID = generation + slot index); empty vectors don't allocate, so listener-less widgets cost nothing
         std::vector<MouseListener> mouseListeners;
-        size_t nextListenerID = 1; // 0 reserved for special cases (null, invalid, etc.)
+        std::vector<uint32_t> freeListenerSlots;
+        std::vector<MouseListener> pendingMouseListeners;  // Added while firing, appended afterwards (no reallocation under a running callback)
+        uint16_t listenerFiringDepth = 0;
+        bool listenerSlotsToFree = false;                 // Removed while firing, freed afterwards
 
         void FireMouseEvent(const MouseEvent& e);
+        void FlushListenerChanges();
+
+        // Built-in widgets react here instead of registering a listener (called before the listeners)
+        virtual void OnMouseEvent(const MouseEvent& /*e*/) {}
 
         // Public FireMouseEvent wrapper for forwarding mouse events from system or parents
         // Contains actual feeding logic
@@ -231,6 +413,18 @@ class Widget {
         virtual bool OnMouseDown(POINT p);
         virtual bool OnMouseUp(POINT p);
 
+        // --- Keyboard events  ---------------------------------------------
+        bool focusable = false;
+        bool focused = false;
+        size_t tabPosition = SIZE_MAX;  // Index in the Root's tab order (maintained by FocusManager)
+        KeyCallback onKey;
+        CharCallback onChar;
+
+        // Built-in widgets react here (called before the listener); return true if handled
+        virtual bool OnKeyEvent(const KeyEvent& /*e*/) { return false; }
+        virtual bool OnCharEvent(const CharEvent& /*e*/) { return false; }
+        virtual void OnFocusChanged(bool /*focused*/) { InvalidatePaint(); }
+
         // --- Other events  ------------------------------------------------
         virtual void OnRemovedFromTree() { ResetTransientStates(); };
         virtual void OnDisplayChanged(bool displayed) { if(!displayed) ResetTransientStates(); };
@@ -239,13 +433,46 @@ class Widget {
 
         // --- Appearance ---
         Border border;
-        void DrawBorderEdge(HDC hdc, BorderData borderData, BorderSide side);
-        void RenderBorder(HDC hdc);
+        void DrawBorderEdge(Painter& painter, BorderData borderData, BorderSide side);
+        void RenderBorder(Painter& painter);
         
         Color backgroundColor = Color::FromARGB(0, 0, 0, 0);
-        void RenderBackground(HDC hdc);
+        bool styleBackground = false; // Background follows the state colors of the style (picked right before drawing)
+        void RenderBackground(Painter& painter);
+
+        // --- Style ---
+        const Style* style = nullptr;           // Shared, immutable record (one registry reference held)
+        StyleClassID styleClass = NoStyleClass; // Class followed for theme changes (NoStyleClass if private look)
+        size_t styleSubscriberIndex = 0;        // Position in the class subscriber list (O(1) unsubscribe)
+
+        // Takes over a reference to newStyle; returns the previous record, for the caller to release
+        const Style* ApplyStyle(const Style* newStyle);
+        virtual void OnStyleChanged() { InvalidatePaint(); } // Runs under the style registry lock on theme swaps
+
+        // Derive a private look from the current one (used by per-widget color setters)
+        template<typename Mutator>
+        void Restyle(Mutator mutate) {
+            StyleDesc desc = style ? style->GetDesc() : StyleDesc{};
+            mutate(desc);
+            SetStyle(desc);
+        }
+
+        // Per-widget text color (every state), kept out of the style: text colors are often set per widget
+        // (TextColor updates from other threads, markup), and restyling would intern a style per color
+        // and detach the widget from its style class
+        bool hasTextColor = false;
+        Color textColorOverride = Color::FromRGB(255, 255, 255);
+        void SetTextColorOverride(Color color);
+        Color StateTextColor(StyleState state) const; // The override if set, else the state's foreground
+
+        // State used to pick colors from the style
+        virtual StyleState CurrentStyleState() const;
+        const StyleColors& StateColors() const; // Default colors if the widget has no style
+        HFONT StyleFont() const { return style && style->GetFont() ? style->GetFont() : (HFONT)GetStockObject(DEFAULT_GUI_FONT); }
 
         // --- Rendering ---
-        virtual void Render(HDC hdc) {}; // Actual render logic
+        virtual void Render(Painter& painter) {}; // Actual render logic
         std::function<void()> onRender; // Optional custom render callback (e.g. update state via external events)
+        bool paintDirty = true;         // Widget itself needs repainting
+        bool childPaintDirty = false;   // Some descendant needs repainting
 };
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <algorithm>
+
+#include "WidgetIndex.h"
+#include "Container.h"
+
+// --- WidgetNames -----------------------------------------------------
+WidgetNames& WidgetNames::Get() {
+    static WidgetNames instance;
+    return instance;
+}
+
+WidgetName WidgetNames::Intern(const std::string& name) {
+    if(name.empty()) return NoWidgetName;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = names.find(name);
+    if(it != names.end()) return it->second;
+
+    WidgetName id = static_cast<WidgetName>(strings.size());
+    strings.push_back(name);
+    names.emplace(name, id);
+    return id;
+}
+
+WidgetName WidgetNames::Find(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = names.find(name);
+    return it != names.end() ? it->second : NoWidgetName;
+}
+
+const std::string& WidgetNames::GetString(WidgetName name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return name < strings.size() ? strings[name] : strings[NoWidgetName];
+}
+
+// --- WidgetIndex -----------------------------------------------------
+Widget* WidgetIndex::FindById(int id) const {
+    auto it = ids.find(id);
+    return it != ids.end() ? it->second : nullptr;
+}
+
+Widget* WidgetIndex::FindByName(WidgetName name) const {
+    auto it = names.find(name);
+    return it != names.end() ? it->second : nullptr;
+}
+
+const std::vector<Widget*>& WidgetIndex::GetTagged(WidgetName tag) const {
+    static const std::vector<Widget*> none;
+    auto it = tagged.find(tag);
+    return it != tagged.end() ? it->second : none;
+}
+
+void WidgetIndex::AddSubtree(Widget& subtree) {
+    std::vector<Widget*> stack{&subtree};
+    while(!stack.empty()) {
+        Widget* w = stack.back();
+        stack.pop_back();
+        Add(*w);
+
+        if(auto* c = dynamic_cast<Container*>(w)) {
+            for(const auto& child : c->Children()) {
+                if(child) stack.push_back(child.get());
+            }
+        }
+    }
+}
+
+void WidgetIndex::RemoveSubtree(Widget& subtree) {
+    std::vector<Widget*> stack{&subtree};
+    while(!stack.empty()) {
+        Widget* w = stack.back();
+        stack.pop_back();
+        Remove(*w);
+
+        if(auto* c = dynamic_cast<Container*>(w)) {
+            for(const auto& child : c->Children()) {
+                if(child) stack.push_back(child.get());
+            }
+        }
+    }
+}
+
+void WidgetIndex::Add(Widget& w) {
+    if(w.indexed) return;
+    w.indexed = true;
+
+    if(w.id != 0) ids.emplace(w.id, &w);
+    if(w.stringId != NoWidgetName) names.emplace(w.stringId, &w);
+    for(WidgetTag& tag : w.tags) {
+        auto& list = tagged[tag.name];
+        tag.slot = static_cast<uint32_t>(list.size());
+        list.push_back(&w);
+    }
+}
+
+void WidgetIndex::Remove(Widget& w) {
+    if(!w.indexed) return;
+    w.indexed = false;
+
+    // Erase exactly this widget's entry (ids may be duplicated)
+    auto eraseEntry = [&w](auto& map, auto key) {
+        auto range = map.equal_range(key);
+        for(auto it = range.first; it != range.second; ++it) {
+            if(it->second == &w) {
+                map.erase(it);
+                return;
+            }
+        }
+    };
+    if(w.id != 0) eraseEntry(ids, w.id);
+    if(w.stringId != NoWidgetName) eraseEntry(names, w.stringId);
+
+    // Swap-remove using the slots cached in the widget - O(1) per tag
+    for(const WidgetTag& tag : w.tags) {
+        auto it = tagged.find(tag.name);
+        if(it == tagged.end()) continue;
+        auto& list = it->second;
+        if(tag.slot >= list.size() || list[tag.slot] != &w) continue;
+
+        Widget* moved = list.back();
+        list[tag.slot] = moved;
+        list.pop_back();
+        if(moved != &w) {
+            for(WidgetTag& movedTag : moved->tags) {
+                if(movedTag.name == tag.name) movedTag.slot = tag.slot;
+            }
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+class Widget;
+
+// Interned string of a widget id or tag (compared as an integer)
+using WidgetName = uint32_t;
+constexpr WidgetName NoWidgetName = 0;
+
+// Process-wide name table (thread-safe); names are never freed
+class WidgetNames {
+    public:
+        WidgetNames(const WidgetNames&) = delete;
+        WidgetNames& operator=(const WidgetNames&) = delete;
+
+        static WidgetNames& Get();
+
+        WidgetName Intern(const std::string& name);     // NoWidgetName for ""
+        WidgetName Find(const std::string& name) const; // NoWidgetName if never interned
+        const std::string& GetString(WidgetName name) const;
+
+    private:
+        WidgetNames() : strings(1) {} // Index 0 = NoWidgetName = ""
+
+        std::deque<std::string> strings; // Indexed by WidgetName (deque - references stay valid as names are added)
+        std::unordered_map<std::string, WidgetName> names;
+        mutable std::mutex mutex;
+};
+
+// Id and tag lookup of one Root (UI thread)
+// Widgets are (un)indexed as their subtrees are attached to/detached from the Root (Widget::SetParent),
+// and re-indexed when their ids/tags change. Ids should be unique; with duplicates, lookups return any of them.
+class WidgetIndex {
+    public:
+        WidgetIndex() = default;
+        WidgetIndex(const WidgetIndex&) = delete;
+        WidgetIndex& operator=(const WidgetIndex&) = delete;
+
+        Widget* FindById(int id) const;
+        Widget* FindByName(WidgetName name) const;      // String id
+        const std::vector<Widget*>& GetTagged(WidgetName tag) const; // In no particular order
+
+        // Tree changes
+        void AddSubtree(Widget& subtree);
+        void RemoveSubtree(Widget& subtree);
+
+        // Single widget (id/tag changes)
+        void Add(Widget& w);
+        void Remove(Widget& w);
+
+    private:
+        std::unordered_multimap<int, Widget*> ids;
+        std::unordered_multimap<WidgetName, Widget*> names;
+        std::unordered_map<WidgetName, std::vector<Widget*>> tagged; // Swap-removed via WidgetTag::slot
+};
@@ -0,0 +1,319 @@
+#include "ImmediateUi.h"
+#include "FlexLayout.h"
+#include "Label.h"
+#include "Button.h"
+#include "Checkbox.h"
+#include "Slider.h"
+
+namespace {
+    const uint64_t RootSeed = 0xCBF29CE484222325ull;
+
+    // FNV-1a, continuing from the enclosing scope
+    uint64_t HashString(uint64_t seed, const char* s) {
+        uint64_t h = seed;
+        for(; *s; s++) {
+            h ^= static_cast<uint8_t>(*s);
+            h *= 0x100000001B3ull;
+        }
+        return h;
+    }
+    uint64_t HashInt(uint64_t seed, int v) {
+        uint64_t h = (seed ^ static_cast<uint32_t>(v)) * 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 32);
+    }
+}
+
+ImmediateUi::ImmediateUi(std::shared_ptr<Container> hostContainer) :
+    host(std::move(hostContainer))
+{
+    if(host && !host->GetLayout()) {
+        host->SetLayout(std::make_unique<FlexLayout>(FlexDirection::Column, 4));
+    }
+}
+
+ImmediateUi::~ImmediateUi() {
+    // Widget callbacks point back here - take the widgets out of the tree (they die with the elements)
+    relayouts.reset();
+    if(host) host->RemoveAllChildren();
+}
+
+// --- Frame -----------------------------------------------------------
+void ImmediateUi::BeginFrame() {
+    frame++;
+    groups.clear();
+    groups.push_back({host.get(), 0});
+    seeds.clear();
+    seeds.push_back(RootSeed);
+    nextWidth = nextHeight = -1;
+
+    relayouts.emplace(); // Creations and moves reflow once, at EndFrame
+}
+
+void ImmediateUi::EndFrame() {
+    // Elements whose calls stopped
+    stale.clear();
+    for(uint32_t i = 0; i < elements.size(); i++) {
+        if(elements[i].alive && elements[i].lastFrame != frame) stale.push_back(i);
+    }
+
+    // Detach every stale widget before releasing any (a stale group may still hold stale children)
+    for(uint32_t i : stale) {
+        Element& e = elements[i];
+        if(e.parent) e.parent->RemoveChild(e.widget);
+        e.parent = nullptr;
+    }
+    for(uint32_t i : stale) Release(i);
+
+    relayouts.reset();  // Runs the collected reflows
+    graveyard.clear();  // Released widgets die only now - the reflows may still have referred to them
+}
+
+// --- Element bookkeeping ---------------------------------------------
+uint64_t ImmediateUi::KeyOf(const char* id) const {
+    return HashString(seeds.empty() ? RootSeed : seeds.back(), id);
+}
+
+ImmediateUi::Element& ImmediateUi::Use(const char* id, ElementKind kind) {
+    uint64_t key = KeyOf(id);
+    uint32_t index;
+    for(;;) {
+        auto it = lookup.find(key);
+        if(it == lookup.end()) {
+            index = Create(key, kind, 0);
+            break;
+        }
+        if(elements[it->second].lastFrame == frame) {
+            key = HashInt(key, 1); // Same id twice in a scope - the repeat gets a derived key (stable while the order is)
+            continue;
+        }
+        if(elements[it->second].kind != kind) {
+            uint32_t old = it->second;
+            Element& e = elements[old];
+            if(e.parent) e.parent->RemoveChild(e.widget);
+            e.parent = nullptr;
+            Release(old);
+            index = Create(key, kind, 0);
+            break;
+        }
+        index = it->second;
+        break;
+    }
+
+    Element& e = elements[index];
+    e.lastFrame = frame;
+    Place(e);
+    return e;
+}
+
+uint32_t ImmediateUi::Create(uint64_t key, ElementKind kind, int param) {
+    uint32_t index;
+    if(!freeElements.empty()) {
+        index = freeElements.back();
+        freeElements.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(elements.size());
+        elements.emplace_back();
+    }
+
+    // Input is flagged by index - the callbacks don't hold pointers into the element vector
+    std::shared_ptr<Widget> widget;
+    switch(kind) {
+        case ElementKind::Label:
+            widget = std::make_shared<::Label>();
+            break;
+        case ElementKind::Button: {
+            auto button = std::make_shared<::Button>(L"");
+            button->SetOnClick([this, index] { elements[index].input = true; });
+            widget = button;
+            break;
+        }
+        case ElementKind::Checkbox: {
+            auto checkbox = std::make_shared<::Checkbox>();
+            checkbox->SetOnToggle([this, index](bool) { if(!applying) elements[index].input = true; });
+            widget = checkbox;
+            break;
+        }
+        case ElementKind::Slider: {
+            auto slider = std::make_shared<::Slider>(L"", 0.0f, 1.0f, 0.0f, 0.0f);
+            slider->SetShowLabel(false);
+            slider->SetOnValueChanged([this, index](float) { if(!applying) elements[index].input = true; });
+            widget = slider;
+            break;
+        }
+        case ElementKind::Row:
+        case ElementKind::Column: {
+            auto group = std::make_shared<Container>();
+            FlexDirection direction = kind == ElementKind::Row ? FlexDirection::Row : FlexDirection::Column;
+            group->SetLayout(std::make_unique<FlexLayout>(direction, param));
+            group->SetAutoWidth(true);
+            group->SetAutoHeight(true);
+            widget = group;
+            break;
+        }
+    }
+
+    Element& e = elements[index];
+    e.widget = std::move(widget);
+    e.parent = nullptr;
+    e.key = key;
+    e.lastFrame = 0;
+    e.param = param;
+    e.kind = kind;
+    e.input = false;
+    e.alive = true;
+    lookup[key] = index;
+    return index;
+}
+
+void ImmediateUi::Place(Element& e) {
+    Group& g = groups.back();
+    if(e.parent != g.container) {
+        if(e.parent) e.parent->RemoveChild(e.widget);
+        g.container->InsertChild(e.widget, g.cursor);
+        e.parent = g.container;
+    }
+    else {
+        // Only moved if the call order changed (stale widgets end up behind the live ones)
+        const auto& children = g.container->Children();
+        if(g.cursor >= children.size() || children[g.cursor] != e.widget) {
+            g.container->MoveChild(e.widget.get(), g.cursor);
+        }
+    }
+    g.cursor++;
+}
+
+void ImmediateUi::Release(uint32_t index) {
+    Element& e = elements[index];
+
+    if(auto* group = dynamic_cast<Container*>(e.widget.get())) {
+        // Whatever is still inside is detached with it - calls of live children (re)insert them where they belong
+        for(Element& other : elements) {
+            if(other.parent == group) other.parent = nullptr;
+        }
+        group->RemoveAllChildren();
+    }
+
+    lookup.erase(e.key);
+    graveyard.push_back(std::move(e.widget));
+    e.widget = nullptr;
+    e.parent = nullptr;
+    e.alive = false;
+    freeElements.push_back(index);
+}
+
+void ImmediateUi::ApplyNextSize(Widget& w, int defaultWidth, int defaultHeight) {
+    int width = nextWidth >= 0 ? nextWidth : defaultWidth;
+    int height = nextHeight >= 0 ? nextHeight : defaultHeight;
+    nextWidth = nextHeight = -1;
+    if(w.GetWidth() != width || w.GetHeight() != height) w.SetSize(width, height);
+}
+
+Widget* ImmediateUi::Find(const char* id) const {
+    auto it = lookup.find(KeyOf(id));
+    return it != lookup.end() ? elements[it->second].widget.get() : nullptr;
+}
+
+// --- Id scopes -------------------------------------------------------
+void ImmediateUi::PushId(const char* id) {
+    seeds.push_back(KeyOf(id));
+}
+
+void ImmediateUi::PushId(int id) {
+    seeds.push_back(HashInt(seeds.empty() ? RootSeed : seeds.back(), id));
+}
+
+void ImmediateUi::PopId() {
+    if(seeds.size() > 1) seeds.pop_back();
+}
+
+// --- Elements --------------------------------------------------------
+void ImmediateUi::Label(const char* id, const wchar_t* text) {
+    Element& e = Use(id, ElementKind::Label);
+    auto& label = static_cast<::Label&>(*e.widget);
+    if(label.GetText() != text) label.SetText(text); // Compared in place - a string is only built on changes
+    nextWidth = nextHeight = -1;
+}
+
+bool ImmediateUi::Button(const char* id, const wchar_t* text) {
+    Element& e = Use(id, ElementKind::Button);
+    auto& button = static_cast<::Button&>(*e.widget);
+    if(button.GetText() != text) button.SetText(text);
+    ApplyNextSize(button, 80, 22);
+
+    bool clicked = e.input;
+    e.input = false;
+    return clicked;
+}
+
+bool ImmediateUi::Checkbox(const char* id, const wchar_t* text, bool& checked) {
+    Element& e = Use(id, ElementKind::Checkbox);
+    auto& checkbox = static_cast<::Checkbox&>(*e.widget);
+    if(checkbox.GetText() != text) checkbox.SetText(text);
+    ApplyNextSize(checkbox, 120, 20);
+
+    // User input wins over the caller's value for this frame
+    if(e.input) {
+        e.input = false;
+        checked = checkbox.IsChecked();
+        return true;
+    }
+    if(checkbox.IsChecked() != checked) {
+        applying = true;
+        checkbox.SetChecked(checked);
+        applying = false;
+    }
+    return false;
+}
+
+bool ImmediateUi::Slider(const char* id, float& value, float min, float max, float step) {
+    Element& e = Use(id, ElementKind::Slider);
+    auto& slider = static_cast<::Slider&>(*e.widget);
+    ApplyNextSize(slider, 160, 24);
+
+    applying = true;
+    if(slider.GetMinValue() != min) slider.SetMinValue(min);
+    if(slider.GetMaxValue() != max) slider.SetMaxValue(max);
+    if(slider.GetStep() != step) slider.SetStep(step);
+    applying = false;
+
+    if(e.input) {
+        e.input = false;
+        value = slider.GetValue();
+        return true;
+    }
+    if(slider.GetValue() != value) {
+        applying = true;
+        slider.SetValue(value);
+        applying = false;
+    }
+    return false;
+}
+
+// --- Groups ----------------------------------------------------------
+void ImmediateUi::BeginGroup(const char* id, ElementKind kind, int gap) {
+    Element& e = Use(id, kind);
+    if(e.param != gap) {
+        static_cast<FlexLayout*>(static_cast<Container&>(*e.widget).GetLayout())->SetSpacing(gap);
+        e.param = gap;
+        e.widget->InvalidateLayout();
+    }
+    nextWidth = nextHeight = -1;
+
+    groups.push_back({static_cast<Container*>(e.widget.get()), 0});
+    seeds.push_back(e.key);
+}
+
+void ImmediateUi::BeginRow(const char* id, int gap) {
+    BeginGroup(id, ElementKind::Row, gap);
+}
+
+void ImmediateUi::BeginColumn(const char* id, int gap) {
+    BeginGroup(id, ElementKind::Column, gap);
+}
+
+void ImmediateUi::EndGroup() {
+    if(groups.size() <= 1) return; // Unbalanced - the host stays
+    groups.pop_back();
+    seeds.pop_back();
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+#include "Container.h"
+#include "LayoutBatch.h"
+
+// Immediate-mode front end over retained widgets (UI thread)
+//     ui.BeginFrame();
+//     ui.Label("title", L"Settings");
+//     ui.BeginRow("buttons");
+//     if(ui.Button("ok", L"OK")) Apply();
+//     ui.EndGroup();
+//     ui.Checkbox("mute", L"Mute", muted);
+//     ui.EndFrame();
+// Every call is keyed by its id (within the enclosing groups and PushId scopes) and diffed against the widget
+// the same call produced last frame: widgets are created on the first call, moved only if the call order changed
+// and updated only if a value differs; widgets whose calls stopped are removed at EndFrame.
+// Layout, hit testing and rendering stay with the retained tree - user input (clicks, toggles, drags) is reported
+// by the matching call of the next frame. At steady state (same calls and values) a frame doesn't allocate.
+class ImmediateUi {
+    public:
+        // The host's children are managed by the UI - don't add others (a host without layout gets a column FlexLayout)
+        explicit ImmediateUi(std::shared_ptr<Container> host);
+        ~ImmediateUi();
+
+        ImmediateUi(const ImmediateUi&) = delete;
+        ImmediateUi& operator=(const ImmediateUi&) = delete;
+
+        void BeginFrame();
+        void EndFrame();
+
+        // --- Elements ---
+        void Label(const char* id, const wchar_t* text);
+        void Label(const char* id, const std::wstring& text) { Label(id, text.c_str()); }
+        bool Button(const char* id, const wchar_t* text);                           // True if clicked since the last frame
+        bool Checkbox(const char* id, const wchar_t* text, bool& checked);          // True if the user toggled it (checked updated)
+        bool Slider(const char* id, float& value, float min, float max, float step = 0.0f); // True if the user moved it
+
+        // Containers laid out with a FlexLayout, sized to their content
+        void BeginRow(const char* id, int gap = 4);
+        void BeginColumn(const char* id, int gap = 4);
+        void EndGroup();
+
+        // Size of the next Button/Checkbox/Slider (labels size to their text)
+        void SetNextSize(int width, int height) { nextWidth = width; nextHeight = height; }
+
+        // Id scopes for repeated calls (e.g. loops)
+        void PushId(const char* id);
+        void PushId(int id);
+        void PopId();
+
+        size_t GetElementCount() const { return lookup.size(); }
+        Widget* Find(const char* id) const; // Widget of the call with this id in the current scope (nullptr if none)
+
+    private:
+        // Using uint8_t instead of int for optimization
+        enum class ElementKind : uint8_t {
+            Label,
+            Button,
+            Checkbox,
+            Slider,
+            Row,
+            Column
+        };
+
+        struct Element {
+            std::shared_ptr<Widget> widget;
+            Container* parent = nullptr;    // Group (or host) the widget is in
+            uint64_t key = 0;
+            uint32_t lastFrame = 0;
+            int param = 0;                  // Group gap
+            ElementKind kind = ElementKind::Label;
+            bool input = false;             // Clicked/toggled/moved by the user since the last call
+            bool alive = false;
+        };
+        struct Group {
+            Container* container;
+            size_t cursor;                  // Position of the next element
+        };
+
+        std::shared_ptr<Container> host;
+        std::vector<Element> elements;
+        std::vector<uint32_t> freeElements;
+        std::unordered_map<uint64_t, uint32_t> lookup; // Key => element index
+        std::vector<Group> groups;
+        std::vector<uint64_t> seeds;                   // Id scopes (groups and PushId)
+        std::vector<uint32_t> stale;                   // EndFrame scratch
+        std::vector<std::shared_ptr<Widget>> graveyard; // Released this frame, destroyed after the reflows
+        std::optional<LayoutBatch::ScopedCollect> relayouts; // Open from BeginFrame to EndFrame
+
+        uint32_t frame = 0;
+        int nextWidth = -1, nextHeight = -1;
+        bool applying = false;                         // Setting widget values from the caller (not user input)
+
+        uint64_t KeyOf(const char* id) const;
+        Element& Use(const char* id, ElementKind kind);
+        uint32_t Create(uint64_t key, ElementKind kind, int param);
+        void Place(Element& e);
+        void ApplyNextSize(Widget& w, int defaultWidth, int defaultHeight);
+        void BeginGroup(const char* id, ElementKind kind, int gap);
+        void Release(uint32_t index);
+};
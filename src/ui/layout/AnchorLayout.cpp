@@ -0,0 +1,428 @@
+#include <algorithm>
+
+#include "AnchorLayout.h"
+#include "Container.h"
+#include "LayoutSnapshot.h"
+
+namespace {
+    bool IsVertical(AnchorEdge e) {
+        return e >= AnchorEdge::Top;
+    }
+
+    // Axis-independent meaning of an edge
+    enum class EdgeKind { Start, End, Center, Length };
+
+    EdgeKind KindOf(AnchorEdge e) {
+        switch(e) {
+            case AnchorEdge::Left:
+            case AnchorEdge::Top:       return EdgeKind::Start;
+            case AnchorEdge::Right:
+            case AnchorEdge::Bottom:    return EdgeKind::End;
+            case AnchorEdge::CenterX:
+            case AnchorEdge::CenterY:   return EdgeKind::Center;
+            default:                    return EdgeKind::Length;
+        }
+    }
+
+    int EdgeOf(EdgeKind kind, int start, int length) {
+        switch(kind) {
+            case EdgeKind::Start:   return start;
+            case EdgeKind::End:     return start + length;
+            case EdgeKind::Center:  return start + length / 2;
+            default:                return length;
+        }
+    }
+
+    AnchorLayout::ConstraintID MakeConstraintID(uint32_t generation, size_t slot) {
+        return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(slot + 1);
+    }
+}
+
+// --- Constraints -----------------------------------------------------
+AnchorLayout::ConstraintID AnchorLayout::AddConstraint(
+    Widget* target, AnchorEdge edge,
+    const Widget* source, AnchorEdge sourceEdge,
+    int offset, float multiplier
+) {
+    if(!target || (target == source && IsVertical(edge) == IsVertical(sourceEdge))) {
+        return 0; // An axis can't depend on itself
+    }
+
+    // Removed slots are reused, so adding and removing constraints doesn't grow the list
+    size_t slot;
+    if(!freeConstraints.empty()) {
+        slot = freeConstraints.back();
+        freeConstraints.pop_back();
+    }
+    else {
+        slot = constraints.size();
+        constraints.push_back({});
+    }
+    Constraint& c = constraints[slot];
+    c = {target, source, edge, sourceEdge, offset, multiplier, true, c.generation};
+    ConstraintID id = MakeConstraintID(c.generation, slot);
+
+    uint32_t targetNode = NodeFor(target, IsVertical(edge));
+    nodes[targetNode].constraints.push_back(id);
+    nodes[targetNode & ~1u].refs++;
+    if(source) {
+        nodes[NodeFor(source, false)].refs++;
+    }
+
+    graphDirty = true;
+    if(container) container->InvalidateLayout();
+    return id;
+}
+
+AnchorLayout::Constraint* AnchorLayout::Find(ConstraintID id) {
+    uint32_t low = static_cast<uint32_t>(id);
+    if(low == 0 || low > constraints.size()) return nullptr;
+
+    size_t slot = low - 1;
+
+    Constraint& c = constraints[slot];
+    return c.alive && MakeConstraintID(c.generation, slot) == id ? &c : nullptr;
+}
+
+bool AnchorLayout::SetConstraintOffset(ConstraintID id, int offset) {
+    Constraint* c = Find(id);
+    if(!c) return false;
+    if(c->offset == offset) return true;
+    c->offset = offset;
+
+    // Same graph - only the target axis (and what depends on it) is re-solved on the next pass
+    auto it = nodeOf.find(c->target);
+    if(!graphDirty && it != nodeOf.end()) {
+        MarkDirty(it->second + (IsVertical(c->edge) ? 1 : 0));
+    }
+    if(container) container->InvalidateLayout();
+    return true;
+}
+
+void AnchorLayout::RemoveConstraint(ConstraintID id) {
+    Constraint* c = Find(id);
+    if(!c) return;
+
+    c->alive = false;
+    c->generation++;
+    freeConstraints.push_back(static_cast<uint32_t>(c - constraints.data()));
+
+    // The target's nodes live as long as it has constraints - but don't create them if they're somehow gone
+    auto it = nodeOf.find(c->target);
+    if(it != nodeOf.end()) {
+        auto& list = nodes[it->second + (IsVertical(c->edge) ? 1 : 0)].constraints;
+        list.erase(std::remove(list.begin(), list.end(), id), list.end());
+    }
+    Release(c->target);
+    if(c->source) Release(c->source);
+
+    graphDirty = true;
+    if(container) container->InvalidateLayout();
+}
+
+void AnchorLayout::RemoveConstraintsOf(const Widget* w) {
+    for(size_t i = 0; i < constraints.size(); i++) {
+        const Constraint& c = constraints[i];
+        if(c.alive && (c.target == w || c.source == w)) {
+            RemoveConstraint(MakeConstraintID(c.generation, i));
+        }
+    }
+}
+
+void AnchorLayout::OnChildRemoved(Widget& child) {
+    RemoveConstraintsOf(&child);
+}
+
+uint32_t AnchorLayout::NodeFor(const Widget* w, bool vertical) {
+    auto it = nodeOf.find(w);
+    if(it == nodeOf.end()) {
+        uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.resize(nodes.size() + 2);
+        nodes[index].widget = const_cast<Widget*>(w);
+        nodes[index + 1].widget = const_cast<Widget*>(w);
+        it = nodeOf.emplace(w, index).first;
+    }
+    return it->second + (vertical ? 1 : 0);
+}
+
+void AnchorLayout::Release(const Widget* w) {
+    auto it = nodeOf.find(w);
+    if(it == nodeOf.end() || --nodes[it->second].refs > 0) return;
+
+    // Last pair moves into the freed slot; node indices are only kept in nodeOf (the graph is rebuilt next pass)
+    uint32_t index = it->second;
+    nodeOf.erase(it);
+    uint32_t last = static_cast<uint32_t>(nodes.size()) - 2;
+    if(index != last) {
+        nodes[index] = std::move(nodes[last]);
+        nodes[index + 1] = std::move(nodes[last + 1]);
+        nodeOf[nodes[index].widget] = index;
+    }
+    nodes.resize(last);
+
+    queue.clear();
+    for(Node& n : nodes) n.queued = false;
+    graphDirty = true;
+}
+
+// --- Solving ---------------------------------------------------------
+void AnchorLayout::RebuildGraph() {
+    std::vector<uint32_t> indegree(nodes.size(), 0);
+    for(Node& n : nodes) {
+        n.dependents.clear();
+        n.dependsOnContainer = false;
+        n.cyclic = false;
+    }
+
+    for(const Constraint& c : constraints) {
+        if(!c.alive) continue;
+
+        // Live constraints keep the nodes of their target and source
+        uint32_t target = nodeOf.find(c.target)->second + (IsVertical(c.edge) ? 1 : 0);
+        if(!c.source) {
+            nodes[target].dependsOnContainer = true;
+            continue;
+        }
+        uint32_t source = nodeOf.find(c.source)->second + (IsVertical(c.sourceEdge) ? 1 : 0);
+        nodes[source].dependents.push_back(target);
+        indegree[target]++;
+    }
+
+    // Kahn's algorithm; whatever is left afterwards is in (or behind) a cycle
+    std::vector<uint32_t> ready;
+    for(uint32_t i = 0; i < nodes.size(); i++) {
+        if(indegree[i] == 0) ready.push_back(i);
+    }
+
+    uint32_t order = 0;
+    while(!ready.empty()) {
+        uint32_t i = ready.back();
+        ready.pop_back();
+        nodes[i].order = order++;
+
+        for(uint32_t d : nodes[i].dependents) {
+            if(--indegree[d] == 0) ready.push_back(d);
+        }
+    }
+    for(uint32_t i = 0; i < nodes.size(); i++) {
+        if(indegree[i] > 0) {
+            nodes[i].cyclic = true;
+            nodes[i].order = order++;
+        }
+    }
+}
+
+void AnchorLayout::MarkDirty(uint32_t node) {
+    if(nodes[node].queued) return;
+    nodes[node].queued = true;
+
+    queue.push_back(node);
+    std::push_heap(queue.begin(), queue.end(), [this](uint32_t a, uint32_t b) {
+        return nodes[a].order > nodes[b].order;
+    });
+}
+
+bool AnchorLayout::EdgeValue(const Widget* source, AnchorEdge edge, int& value) const {
+    if(!source) {
+        int length = IsVertical(edge) ? innerHeight : innerWidth;
+        value = EdgeOf(KindOf(edge), 0, length);
+        return true;
+    }
+
+    auto it = nodeOf.find(source);
+    if(it == nodeOf.end()) return false;
+
+    const Node& n = nodes[it->second + (IsVertical(edge) ? 1 : 0)];
+    value = EdgeOf(KindOf(edge), n.start, n.length);
+    return true;
+}
+
+void AnchorLayout::SolveNode(Node& node, bool vertical) {
+    // Widgets outside the container (sources that aren't children) keep their last solution - they may be gone
+    if(!node.attached) return;
+
+    Widget& w = *node.widget;
+    node.cachedPos = vertical ? w.GetRect().top : w.GetRect().left;
+    node.cachedSize = vertical ? w.GetLayoutHeight() : w.GetLayoutWidth();
+
+    // Values of the (at most two) constraints of this axis
+    EdgeKind kinds[2];
+    int values[2];
+    int count = 0;
+
+    if(!node.cyclic) {
+        for(ConstraintID id : node.constraints) {
+            const Constraint& c = constraints[static_cast<uint32_t>(id) - 1];
+
+            int sourceValue;
+            if(!EdgeValue(c.source, c.sourceEdge, sourceValue)) continue;
+
+            EdgeKind kind = KindOf(c.edge);
+            if(count == 1 && kinds[0] == kind) continue; // Same edge twice - the first wins
+
+            kinds[count] = kind;
+            values[count] = static_cast<int>(sourceValue * c.multiplier) + c.offset;
+            if(++count == 2) break;
+        }
+    }
+
+    int start = node.cachedPos;
+    int length = node.cachedSize;
+
+    if(count == 1) {
+        // Single constraint - own size (or own position, if the size is constrained)
+        switch(kinds[0]) {
+            case EdgeKind::Start:   start = values[0]; break;
+            case EdgeKind::End:     start = values[0] - length; break;
+            case EdgeKind::Center:  start = values[0] - length / 2; break;
+            case EdgeKind::Length:  length = values[0]; break;
+        }
+    }
+    else if(count == 2) {
+        // Normalize the pair, so the first one is "smaller" (Start < End < Center < Length)
+        if(kinds[0] > kinds[1]) {
+            std::swap(kinds[0], kinds[1]);
+            std::swap(values[0], values[1]);
+        }
+        int a = values[0], b = values[1];
+
+        if(kinds[0] == EdgeKind::Start) {
+            start = a;
+            switch(kinds[1]) {
+                case EdgeKind::End:     length = b - a; break;
+                case EdgeKind::Center:  length = 2 * (b - a); break;
+                default:                length = b; break;
+            }
+        }
+        else if(kinds[0] == EdgeKind::End) {
+            length = kinds[1] == EdgeKind::Center ? 2 * (a - b) : b;
+            start = a - length;
+        }
+        else { // Center + Length
+            length = b;
+            start = a - length / 2;
+        }
+    }
+
+    length = std::max(0, length);
+    if(start == node.start && length == node.length) return;
+
+    node.start = start;
+    node.length = length;
+    moved.push_back(static_cast<uint32_t>(&node - nodes.data()) & ~1u);
+
+    for(uint32_t d : node.dependents) {
+        MarkDirty(d);
+    }
+}
+
+void AnchorLayout::Apply(const RECT& innerRect) {
+    if(!container) return;
+
+    int width = innerRect.right - innerRect.left;
+    int height = innerRect.bottom - innerRect.top;
+
+    if(graphDirty) {
+        graphDirty = false;
+        RebuildGraph();
+
+        queue.clear();
+        for(Node& n : nodes) n.queued = false;
+        for(uint32_t i = 0; i < nodes.size(); i++) MarkDirty(i);
+    }
+
+    // Container resize only affects the axes anchored to it (and their dependents)
+    if(width != innerWidth || height != innerHeight) {
+        for(uint32_t i = 0; i < nodes.size(); i++) {
+            bool vertical = i % 2 == 1;
+            if(nodes[i].dependsOnContainer && (vertical ? height != innerHeight : width != innerWidth)) {
+                MarkDirty(i);
+            }
+        }
+        innerWidth = width;
+        innerHeight = height;
+    }
+
+    bool originMoved = origin.x != innerRect.left || origin.y != innerRect.top;
+    origin = {innerRect.left, innerRect.top};
+
+    // Children whose own geometry changed; unconstrained children are placed right away
+    for(Node& n : nodes) n.attached = false;
+    for(auto& child : container->Children()) {
+        if(!child) continue;
+        ApplyIntrinsicSize(*child);
+
+        auto it = nodeOf.find(child.get());
+        if(it == nodeOf.end()) {
+            RECT r = child->GetRect();
+            int l = origin.x + r.left;
+            int t = origin.y + r.top;
+            SetEffectiveRect(*child, l, t, l + child->GetLayoutWidth(), t + child->GetLayoutHeight());
+            continue;
+        }
+
+        Node& h = nodes[it->second];
+        Node& v = nodes[it->second + 1];
+        h.attached = v.attached = true;
+        if(h.cachedPos != child->GetRect().left || h.cachedSize != child->GetLayoutWidth()) MarkDirty(it->second);
+        if(v.cachedPos != child->GetRect().top || v.cachedSize != child->GetLayoutHeight()) MarkDirty(it->second + 1);
+    }
+
+    // Re-solve dirty axes in dependency order
+    moved.clear();
+    auto byOrder = [this](uint32_t a, uint32_t b) { return nodes[a].order > nodes[b].order; };
+    while(!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), byOrder);
+        uint32_t i = queue.back();
+        queue.pop_back();
+
+        nodes[i].queued = false;
+        SolveNode(nodes[i], i % 2 == 1);
+    }
+
+    auto place = [this](uint32_t index) {
+        const Node& h = nodes[index];
+        const Node& v = nodes[index + 1];
+        if(!h.attached) return; // Only referenced as a source
+
+        SetEffectiveRect(*h.widget, origin.x + h.start, origin.y + v.start, origin.x + h.start + h.length, origin.y + v.start + v.length);
+    };
+
+    if(originMoved) {
+        for(uint32_t i = 0; i < nodes.size(); i += 2) {
+            place(i);
+        }
+    }
+    else {
+        for(uint32_t index : moved) {
+            place(index);
+        }
+    }
+}
+
+// Widgets are hashed by child index (pointers differ between runs)
+bool AnchorLayout::HashInputs(LayoutHash& hash) const {
+    if(!container) return false;
+
+    std::unordered_map<const Widget*, int> indexOf;
+    const auto& children = container->Children();
+    for(size_t i = 0; i < children.size(); i++) {
+        indexOf[children[i].get()] = static_cast<int>(i);
+    }
+
+    for(const Constraint& c : constraints) {
+        if(!c.alive) continue;
+
+        auto target = indexOf.find(c.target);
+        auto source = c.source ? indexOf.find(c.source) : indexOf.end();
+        if(target == indexOf.end() || (c.source && source == indexOf.end())) return false; // Refers outside the container
+
+        hash.Add(target->second);
+        hash.Add(c.source ? source->second : -1);
+        hash.Add(static_cast<int>(c.edge));
+        hash.Add(static_cast<int>(c.sourceEdge));
+        hash.Add(c.offset);
+        hash.Add(c.multiplier);
+    }
+    return true;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Layout.h"
+
+class Widget;
+
+// Edges (and sizes) constraints can refer to
+enum class AnchorEdge {
+    Left,
+    Right,
+    CenterX,
+    Width,
+    Top,
+    Bottom,
+    CenterY,
+    Height
+};
+
+// Positions children by linear equality constraints between their edges, e.g.
+//   target.Left = source.Right * 1.0 + 8        (source = sibling)
+//   target.CenterX = parent.CenterX             (source = nullptr -> container inner rect)
+// Each child axis is solved from up to two constraints (e.g. Left + Right, or CenterX + Width);
+// an axis with a single constraint keeps the child's layout size, an unconstrained one its logical position.
+// Constraints form a dependency graph solved in topological order; editing an offset or resizing the container
+// re-solves only the affected axes. Axes in (or depending on) a cycle are laid out as if unconstrained.
+class AnchorLayout : public Layout {
+    public:
+        using ConstraintID = uint64_t; // 0 = invalid; slot index + 1 in the low half, slot generation in the high half
+
+        void Apply(const RECT& innerRect) override;
+        bool HashInputs(LayoutHash& hash) const override;
+
+        ConstraintID AddConstraint(
+            Widget* target, AnchorEdge edge,
+            const Widget* source, AnchorEdge sourceEdge,
+            int offset = 0, float multiplier = 1.0f
+        );
+        bool SetConstraintOffset(ConstraintID id, int offset); // Incremental - no graph rebuild
+        void RemoveConstraint(ConstraintID id);
+        void RemoveConstraintsOf(const Widget* w);             // Done automatically when a child leaves the container
+
+    private:
+        struct Constraint {
+            Widget* target;
+            const Widget* source;   // nullptr = container
+            AnchorEdge edge;
+            AnchorEdge sourceEdge;
+            int offset;
+            float multiplier;
+            bool alive;
+            uint32_t generation;    // Bumped on removal, so stale IDs never hit a reused slot
+        };
+
+        // One axis (horizontal/vertical) of a widget
+        struct Node {
+            Widget* widget;                         // Only dereferenced while it's a child of the container
+            std::vector<ConstraintID> constraints;  // Constraints targeting this axis (first two are used)
+            std::vector<uint32_t> dependents;       // Nodes with constraints referring to this one
+            uint32_t order = 0;                     // Topological position
+            bool dependsOnContainer = false;
+            bool cyclic = false;                    // Part of (or behind) a cycle - solved unconstrained
+            bool queued = false;
+            bool attached = false;                  // Widget was a child of the container in the current pass
+            uint32_t refs = 0;                      // Live constraints referring to the widget (horizontal node only)
+            int start = 0, length = 0;              // Solution, relative to the container inner rect
+            int cachedPos = INT32_MIN, cachedSize = INT32_MIN; // Own geometry used by the last solve
+        };
+
+        std::vector<Constraint> constraints;            // Slots, indexed by the low half of the ID - 1
+        std::vector<uint32_t> freeConstraints;          // Slots of removed constraints, reused first
+        std::vector<Node> nodes;                        // Horizontal node of a widget at even index, vertical at +1
+        std::unordered_map<const Widget*, uint32_t> nodeOf; // Widget => horizontal node; dropped with the last constraint
+        std::vector<uint32_t> queue;                    // Min-heap of dirty nodes by topological order
+        std::vector<uint32_t> moved;                    // Horizontal nodes of widgets whose solution changed in this pass
+
+        bool graphDirty = true;
+        int innerWidth = -1, innerHeight = -1;
+        POINT origin = {INT32_MIN, INT32_MIN};
+
+        void OnChildRemoved(Widget& child) override;
+
+        Constraint* Find(ConstraintID id);              // nullptr for stale/invalid IDs
+        uint32_t NodeFor(const Widget* w, bool vertical);
+        void Release(const Widget* w);                  // Drops a reference; the node pair goes with the last one
+        void RebuildGraph();
+        void MarkDirty(uint32_t node);
+        void SolveNode(Node& node, bool vertical);
+        bool EdgeValue(const Widget* source, AnchorEdge edge, int& value) const;
+};
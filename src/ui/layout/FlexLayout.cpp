@@ -1,6 +1,11 @@
+#include <cmath>
+#include <climits>
+#include <algorithm>
+
 #include "FlexLayout.h"
 #include "Container.h"
 #include "LayoutWidgetBridge.h"
+#include "LayoutSnapshot.h"
 #include "string"
 
 void FlexLayout::SetSpacing(int newSpacing) {
@@ -14,10 +19,34 @@ void FlexLayout::SetSpacing(int newSpacing) {
     }
 }
 
+void FlexLayout::SetLineSpacing(int newSpacing) {
+    if(lineSpacing == newSpacing) return;
+
+    lineSpacing = newSpacing;
+
+    if(container && wrap != FlexWrap::NoWrap) {
+        container->InvalidateLayout();
+    }
+}
+
 void FlexLayout::Apply(const RECT& innerRect) {
     if(!container) return;
 
-    auto children = container->Children();
+    // Content-sized children are measured at their current content - no second pass after their own update
+    for(auto& child : container->Children()) {
+        if(child) ApplyIntrinsicSize(*child);
+    }
+
+    bool autoSizeMain = MainIsAuto(
+        container->IsAutoWidth(),
+        container->IsAutoHeight()
+    );
+    if(wrap != FlexWrap::NoWrap && !autoSizeMain) {
+        ApplyWrapped(innerRect);
+        return;
+    }
+
+    const auto& children = container->Children();
 
     int containerWidth = innerRect.right - innerRect.left;
     int containerHeight = innerRect.bottom - innerRect.top;
@@ -33,133 +62,429 @@ void FlexLayout::Apply(const RECT& innerRect) {
     );
 
     // --- PASS 1: Measure ---
-    int totalFixedMainLength = 0;       // Sum of all fixed main lengths + margins
-    int totalGrowingItems = 0;          // Count of children that grow along the main axis
-    int maxChildCrossLength = 0;        // Max cross length among children (for container auto-sizing)
+    CollectItems(children, containerCrossLength);
+    FlexLine line = {0, items.size(), 0, 0, 0};
+
+    // --- PASS 2: Flex ---
+    // An auto-sized container takes the children's sizes, so there's nothing to grow into or shrink from
+    int totalSpacing = spacing * std::max(0, int(items.size()) - 1);
+    int totalMargins = 0;
+    for(const FlexItem& item : items) {
+        totalMargins += item.marginMain;
+    }
+    if(!autoSizeMain) {
+        ResolveFlexibleLengths(line, containerMainLength - totalSpacing - totalMargins);
+    }
+
+    // Cross lengths may depend on the resolved main lengths (wrapping text)
+    MeasureLineCross(line);
+
+    // --- PASS 3: Assign positions ---
+    int cursor = PlaceLine(line, innerRect, containerMainLength, !autoSizeMain, CrossStart(innerRect), containerCrossLength);
+
+    // --- PASS 4: Adjust container size if auto-sizing ---
+    ResizeContainer(innerRect, cursor, line.crossLength);
+}
+
+void FlexLayout::ApplyWrapped(const RECT& innerRect) {
+    const auto& children = container->Children();
+
+    int containerWidth = innerRect.right - innerRect.left;
+    int containerHeight = innerRect.bottom - innerRect.top;
+    int containerMainLength = MainLength(containerWidth, containerHeight);
+    int containerCrossLength = CrossLength(containerWidth, containerHeight);
+
+    // --- PASS 1: Break into lines, flex & measure them ---
+    // Children take part in breaking with their hypothetical size (basis clamped to min/max), then flex within the line
+    CollectItems(children, containerCrossLength);
+    lines.clear();
+
+    size_t first = 0;
+    while(first < items.size()) {
+        FlexLine line = {first, first, 0, 0, 0};
+        int margins = 0;
+
+        // Break before the item if it doesn't fit (a line always holds at least one item)
+        while(line.end < items.size()) {
+            const FlexItem& item = items[line.end];
+            int itemMain = item.hypothetical + item.marginMain;
+            if(line.end > line.first && line.mainLength + spacing + itemMain > containerMainLength) break;
+
+            line.mainLength += (line.end > line.first ? spacing : 0) + itemMain;
+            margins += item.marginMain;
+            line.end++;
+        }
+
+        int totalSpacing = spacing * int(line.end - line.first - 1);
+        ResolveFlexibleLengths(line, containerMainLength - totalSpacing - margins);
+        MeasureLineCross(line);
+
+        lines.push_back(line);
+        first = line.end;
+    }
+
+    int contentCrossLength = 0;
+    for(const FlexLine& l : lines) {
+        contentCrossLength += l.crossLength;
+    }
+    contentCrossLength += lineSpacing * std::max(0, int(lines.size()) - 1);
+
+    // --- PASS 2: Distribute lines along the cross axis (align-content) ---
+    bool autoSizeCross = CrossIsAuto(
+        container->IsAutoWidth(),
+        container->IsAutoHeight()
+    );
+    // Auto cross size shrink-wraps the lines, so there's nothing to distribute
+    int crossExtent = autoSizeCross ? contentCrossLength : containerCrossLength;
+    int freeCross = std::max(0, crossExtent - contentCrossLength);
+    int lineCount = static_cast<int>(lines.size());
+
+    int crossOffset = 0;
+    int effectiveLineSpacing = lineSpacing;
+    if(lineCount > 0) {
+        switch(alignContent) {
+            case AlignContent::Start:
+                break;
+            case AlignContent::Center:
+                crossOffset += freeCross / 2;
+                break;
+            case AlignContent::End:
+                crossOffset += freeCross;
+                break;
+            case AlignContent::SpaceBetween:
+                if(lineCount > 1)
+                    effectiveLineSpacing += freeCross / (lineCount - 1);
+                break;
+            case AlignContent::SpaceAround:
+                effectiveLineSpacing += freeCross / lineCount;
+                crossOffset += (freeCross / lineCount) / 2;
+                break;
+            case AlignContent::SpaceEvenly:
+                effectiveLineSpacing += freeCross / (lineCount + 1);
+                crossOffset += freeCross / (lineCount + 1);
+                break;
+            case AlignContent::Stretch: {
+                // Spread the free space over lines (remainder goes to the first ones)
+                int share = freeCross / lineCount;
+                int remainder = freeCross % lineCount;
+                for(int i = 0; i < lineCount; i++) {
+                    lines[i].crossLength += share + (i < remainder ? 1 : 0);
+                }
+                break;
+            }
+        }
+    }
+
+    // --- PASS 3: Place children line by line ---
+    for(const FlexLine& l : lines) {
+        // Reverse wrapping mirrors the line order along the cross axis
+        int lineCrossStart = wrap == FlexWrap::WrapReverse
+            ? CrossStart(innerRect) + crossExtent - crossOffset - l.crossLength
+            : CrossStart(innerRect) + crossOffset;
+        crossOffset += l.crossLength + effectiveLineSpacing;
+
+        PlaceLine(l, innerRect, containerMainLength, true, lineCrossStart, l.crossLength);
+    }
+
+    // Main axis isn't auto-sized here (wrapping is off then), only the cross axis may shrink-wrap
+    ResizeContainer(innerRect, MainStart(innerRect) + containerMainLength, contentCrossLength);
+}
+
+void FlexLayout::CollectItems(const std::vector<std::shared_ptr<Widget>>& children, int availableCross) {
+    items.clear();
 
     for(auto& child : children) {
         if(!child) continue;
 
-        const Spacing& m = child->GetMargin();
-
-        // Measure child main length + margins
-        int childMainLength = ChildMainLength(
-            child->GetLayoutWidth(),
-            child->GetLayoutHeight()
-        );
-        int childMarginMain = ChildTotalMarginMain(m);
+        const SizeLimits& limits = child->GetSizeLimits();
+        const FlexProperties& flex = child->GetFlexProperties();
 
-        // Count flex-grow items and accumulate fixed lengths
-        if(child->IsFlexGrow()) {
-            totalGrowingItems++;
-            totalFixedMainLength += childMarginMain; // margins still count
+        // Columns know the width of wrapping children up front, so their height is measured for it
+        if(direction == FlexDirection::Column && child->IsAutoHeight() && flex.basis < 0) {
+            int width = ClampedCrossLength(*child);
+            if(align == AlignItems::Stretch) {
+                int minCross = MinCross(limits);
+                width = std::max(0, availableCross - ChildTotalMarginCross(child->GetMargin()));
+                width = std::max(minCross, std::min(width, std::max(minCross, MaxCross(limits))));
+            }
+            int height = child->GetHeightForWidth(width);
+            if(height >= 0) {
+                SetLayoutSize(*child, child->GetLayoutWidth(), height);
+            }
         }
-        else {
-            totalFixedMainLength += childMainLength + childMarginMain;
+
+        FlexItem item;
+        item.widget = child.get();
+        item.marginMain = ChildTotalMarginMain(child->GetMargin());
+        item.base = flex.basis >= 0 ? flex.basis : ChildMainLength(child->GetLayoutWidth(), child->GetLayoutHeight());
+        item.minMain = MinMain(*child);
+        item.maxMain = std::max(item.minMain, MaxMain(limits)); // Min wins, like CSS
+        item.hypothetical = std::max(item.minMain, std::min(item.base, item.maxMain));
+        item.mainLength = item.hypothetical;
+
+        items.push_back(item);
+    }
+}
+
+void FlexLayout::MeasureLineCross(FlexLine& line) {
+    int maxBelowBaseline = 0; // Most extent below the baseline, when aligning baselines
+    line.crossLength = 0;
+    line.baseline = 0;
+
+    for(const FlexItem& item : LineItems(line)) {
+        Widget& child = *item.widget;
+
+        // Rows: wrapping children get the height for their resolved width
+        if(direction == FlexDirection::Row && child.IsAutoHeight()) {
+            int height = child.GetHeightForWidth(item.mainLength);
+            if(height >= 0) {
+                SetLayoutSize(child, item.mainLength, height);
+            }
         }
 
-        // Track max cross length
-        int childCrossLength = ChildCrossLength(child->GetLayoutWidth(), child->GetLayoutHeight());
-        childCrossLength += ChildTotalMarginCross(m);
-        maxChildCrossLength = std::max(maxChildCrossLength, childCrossLength);
+        int childCrossLength = ClampedCrossLength(child);
+        int outerCrossLength = childCrossLength + ChildTotalMarginCross(child.GetMargin());
+        line.crossLength = std::max(line.crossLength, outerCrossLength);
+
+        if(AlignsBaselines()) {
+            int above = BaselineOffset(child, childCrossLength);
+            line.baseline = std::max(line.baseline, above);
+            maxBelowBaseline = std::max(maxBelowBaseline, outerCrossLength - above);
+        }
     }
+    line.crossLength = std::max(line.crossLength, line.baseline + maxBelowBaseline);
+}
+
+int FlexLayout::PlaceLine(const FlexLine& line, const RECT& innerRect, int containerMainLength, bool justifyFree, int lineCrossStart, int lineCrossLength) {
+    ItemRange lineItems = LineItems(line);
 
-    int totalSpacing = spacing * std::max(0, int(children.size() - 1));
-    int remainingLength = std::max(0, containerMainLength - totalFixedMainLength - totalSpacing);
-    int remainingGrowingItems = totalGrowingItems;
+    int usedLength = spacing * std::max(0, int(lineItems.size()) - 1);
+    for(const FlexItem& item : lineItems) {
+        usedLength += item.mainLength + item.marginMain;
+    }
+    int remainingLength = justifyFree ? std::max(0, containerMainLength - usedLength) : 0;
 
-    // --- PASS 2: Assign positions ---
     int cursor = MainStart(innerRect);
     int effectiveSpacing = spacing; // Set spacing + extra computed justify spacing
+    DistributeMainSpace(remainingLength, lineItems.size(), cursor, effectiveSpacing);
+
+    for(size_t i = 0; i < lineItems.size(); i++) {
+        // Advance cursor to the next child
+        cursor += PlaceChild(*lineItems[i].widget, cursor, lineItems[i].mainLength, lineCrossStart, lineCrossLength, line.baseline);
+        if(i + 1 < lineItems.size()) {
+            // Don't add spacing after last child
+            cursor += effectiveSpacing;
+        }
+    }
+    return cursor;
+}
+
+// CSS "resolve flexible lengths" without the iterative freeze loop
+// Every child ends up at clamp(base + factor * t, min, max) for one common t (the free space per flex unit),
+// which is exactly the state the freeze-and-redistribute loop converges to.
+// (Except for flex factors below 1 in total: they take their fraction of the whole line's free space up front,
+// while CSS re-checks the sum of the unfrozen children on every round and may leave more space unused.)
+// The sum of sizes is monotonic in t, so t is found by sweeping the sorted points where children
+// start/stop flexing (hit their min/max): O(n log n) instead of O(n^2) for the loop.
+void FlexLayout::ResolveFlexibleLengths(const FlexLine& line, int availableMain) {
+    ItemRange lineItems = LineItems(line);
+
+    long long hypotheticalSum = 0;
+    for(const FlexItem& item : lineItems) {
+        hypotheticalSum += item.hypothetical;
+    }
+
+    long long freeSpace = availableMain - hypotheticalSum;
+    if(freeSpace == 0 || lineItems.empty()) return;
+
+    bool growing = freeSpace > 0;
+
+    // Shrinking is solved as growing on negated sizes: size = -clamp(-base + rate * t, -max, -min)
+    auto rateOf = [growing](const FlexItem& item) -> double {
+        const FlexProperties& flex = item.widget->GetFlexProperties();
+        return growing ? flex.grow : static_cast<double>(flex.shrink) * item.base; // Shrink is scaled by the basis
+    };
+    auto startOf = [growing](const FlexItem& item) -> double { return growing ? item.base : -item.base; };
+    auto lowOf = [growing](const FlexItem& item) -> double {
+        if(growing) return item.minMain;
+        return item.maxMain == INT_MAX ? -1e300 : -static_cast<double>(item.maxMain);
+    };
+    auto highOf = [growing](const FlexItem& item) -> double {
+        if(growing) return item.maxMain == INT_MAX ? 1e300 : static_cast<double>(item.maxMain);
+        return -static_cast<double>(item.minMain);
+    };
+
+    // Sum of flex factors below 1 only takes that fraction of the free space (CSS)
+    double factorSum = 0.0;
+    for(const FlexItem& item : lineItems) {
+        const FlexProperties& flex = item.widget->GetFlexProperties();
+        factorSum += growing ? flex.grow : flex.shrink;
+    }
+    if(factorSum <= 0.0) return; // Nothing flexes - children keep their sizes (and may overflow)
+
+    double distributed = static_cast<double>(freeSpace) * std::min(1.0, factorSum);
+    double target = static_cast<double>(hypotheticalSum) + distributed;
+    if(!growing) target = -target;
+
+    // Build the breakpoints
+    flexEvents.clear();
+    double sum = 0.0; // Sum of sizes at t = 0
+    for(const FlexItem& item : lineItems) {
+        double rate = rateOf(item), start = startOf(item), low = lowOf(item), high = highOf(item);
+        sum += std::max(low, std::min(start, high));
+
+        if(rate <= 0.0 || start >= high) continue; // Never changes
+
+        double enter = std::max(0.0, (low - start) / rate);
+        flexEvents.push_back({enter, rate});
+        if(high < 1e300) {
+            flexEvents.push_back({(high - start) / rate, -rate});
+        }
+    }
+    std::sort(flexEvents.begin(), flexEvents.end(), [](const FlexEvent& a, const FlexEvent& b) {
+        return a.at < b.at;
+    });
+
+    // Sweep until the sizes add up to the target
+    double t = 0.0, slope = 0.0;
+    size_t next = 0;
+    while(true) {
+        while(next < flexEvents.size() && flexEvents[next].at <= t) {
+            slope += flexEvents[next++].rateDelta;
+        }
+
+        double nextAt = next < flexEvents.size() ? flexEvents[next].at : 1e300;
+        if(slope > 1e-12 && sum + slope * (nextAt - t) >= target) {
+            t += (target - sum) / slope;
+            break;
+        }
+        if(next >= flexEvents.size()) break; // Everything hit its limit
+
+        sum += slope * (nextAt - t);
+        t = nextAt;
+    }
+
+    // Final sizes, rounded by cumulative edges so the line doesn't gain/lose pixels
+    // A child at its limit can still round a pixel past it (an edge right at .5 before it, float noise after it);
+    // the clamp then moves that pixel to the next child instead of dropping it - placedEdge is the actual edge.
+    double edge = 0.0;
+    int placedEdge = 0;
+    for(FlexItem& item : lineItems) {
+        double size = std::max(lowOf(item), std::min(startOf(item) + rateOf(item) * t, highOf(item)));
+        if(!growing) size = -size;
+
+        edge += size;
+        int roundedEdge = static_cast<int>(std::floor(edge + 0.5));
+        item.mainLength = std::max(item.minMain, std::min(roundedEdge - placedEdge, item.maxMain));
+        placedEdge += item.mainLength;
+    }
+}
+
+void FlexLayout::DistributeMainSpace(int freeLength, size_t count, int& cursor, int& effectiveSpacing) const {
+    if(count == 0) return;
 
     switch(justify) {
         case JustifyContent::Start:
             break;
         case JustifyContent::Center:
-            cursor += remainingLength / 2;
+            cursor += freeLength / 2;
             break;
         case JustifyContent::End:
-            cursor += remainingLength;
+            cursor += freeLength;
             break;
         case JustifyContent::SpaceBetween:
-            if(children.size() > 1)
-                effectiveSpacing += remainingLength / (children.size() - 1);
+            if(count > 1)
+                effectiveSpacing += freeLength / int(count - 1);
             break;
         case JustifyContent::SpaceAround:
-            effectiveSpacing += remainingLength / children.size();
+            effectiveSpacing += freeLength / int(count);
             cursor += effectiveSpacing / 2;
             break;
         case JustifyContent::SpaceEvenly:
-            effectiveSpacing += remainingLength / (children.size() + 1);
+            effectiveSpacing += freeLength / int(count + 1);
             cursor += effectiveSpacing;
             break;
     }
+}
 
-    for(size_t i = 0; i < children.size(); i++) {
-        auto& child = children[i];
-        if(!child) continue;
+int FlexLayout::PlaceChild(Widget& child, int mainCursor, int childMainLength, int lineCrossStart, int lineCrossLength, int lineBaseline) {
+    const Spacing& m = child.GetMargin();
 
-        const Spacing& m = child->GetMargin();
-
-        int childMainLength = ChildMainLength(
-            child->GetLayoutWidth(),
-            child->GetLayoutHeight()
-        );
-        int childCrossLength = ChildCrossLength(
-            child->GetLayoutWidth(),
-            child->GetLayoutHeight()
-        );
-
-        int marginMainStart         = ChildMarginMainStart(m);
-        int marginMainEnd           = ChildMarginMainEnd(m);
-        int marginCrossStart        = ChildMarginCrossStart(m);
-        int marginCrossEnd          = ChildMarginCrossEnd(m);
-
-        // Flex-grow children get proportional width
-        if(child->IsFlexGrow() && remainingGrowingItems > 0) {
-            childMainLength = remainingLength / remainingGrowingItems;
-            remainingGrowingItems--;            // reduce remaining flex units
-            remainingLength -= childMainLength; // reduce remaining space
-        }
+    int marginMainStart         = ChildMarginMainStart(m);
+    int marginMainEnd           = ChildMarginMainEnd(m);
+    int marginCrossStart        = ChildMarginCrossStart(m);
+    int marginCrossEnd          = ChildMarginCrossEnd(m);
 
-        // Compute final cross axis length
-        int finalCrossLength = childCrossLength;
+    // Compute final cross axis length
+    const SizeLimits& limits = child.GetSizeLimits();
+    int minCross = MinCross(limits);
+    int maxCross = std::max(minCross, MaxCross(limits));
+    int finalCrossLength = ClampedCrossLength(child);
 
-        // Make & set final effective rect for the child
-        int mainPos = cursor + marginMainStart;
-        int crossPos;
-        switch(align) {
-            case AlignItems::Start:
-                crossPos = CrossStart(innerRect) + marginCrossStart;
-                break;
-            case AlignItems::Center:
-                crossPos = CrossStart(innerRect) + (containerCrossLength - finalCrossLength - marginCrossEnd - marginCrossStart) / 2 + marginCrossStart;
-                break;
-            case AlignItems::End:
-                crossPos = CrossEnd(innerRect) - finalCrossLength - marginCrossEnd;
-                break;
-            case AlignItems::Stretch:
-                crossPos = CrossStart(innerRect) + marginCrossStart;
-                finalCrossLength = std::max(0, containerCrossLength - marginCrossStart - marginCrossEnd);
-                break;
-        }
-        RECT r = MakeRect(
-            mainPos,
-            crossPos,
-            childMainLength,
-            finalCrossLength
-        );
-        SetEffectiveRect(*child, r.left, r.top, r.right, r.bottom);
-               
-        // Advance cursor to the next child
-        cursor += childMainLength + marginMainStart + marginMainEnd;
-        if(i + 1 < children.size()) {
-            // Don't add spacing after last child
-            cursor += effectiveSpacing;
-        }
+    // Make & set final effective rect for the child
+    int mainPos = mainCursor + marginMainStart;
+    int crossPos = lineCrossStart + marginCrossStart;
+    switch(align) {
+        case AlignItems::Start:
+            crossPos = lineCrossStart + marginCrossStart;
+            break;
+        case AlignItems::Center:
+            crossPos = lineCrossStart + (lineCrossLength - finalCrossLength - marginCrossEnd - marginCrossStart) / 2 + marginCrossStart;
+            break;
+        case AlignItems::End:
+            crossPos = lineCrossStart + lineCrossLength - finalCrossLength - marginCrossEnd;
+            break;
+        case AlignItems::Stretch:
+            crossPos = lineCrossStart + marginCrossStart;
+            finalCrossLength = std::max(0, lineCrossLength - marginCrossStart - marginCrossEnd);
+            finalCrossLength = std::max(minCross, std::min(finalCrossLength, maxCross));
+            break;
+        case AlignItems::Baseline:
+            crossPos = lineCrossStart + marginCrossStart;
+            if(AlignsBaselines()) {
+                crossPos += lineBaseline - BaselineOffset(child, finalCrossLength);
+            }
+            break;
     }
+    RECT r = MakeRect(
+        mainPos,
+        crossPos,
+        childMainLength,
+        finalCrossLength
+    );
+    SetEffectiveRect(child, r.left, r.top, r.right, r.bottom);
+
+    return childMainLength + marginMainStart + marginMainEnd;
+}
+
+int FlexLayout::BaselineOffset(const Widget& child, int childCrossLength) const {
+    int baseline = child.GetBaseline(childCrossLength);
+    if(baseline < 0) baseline = childCrossLength;
+    return child.GetMargin().top + baseline; // Rows only - the cross start is the top
+}
+
+int FlexLayout::ClampedCrossLength(const Widget& child) {
+    const SizeLimits& limits = child.GetSizeLimits();
+    int minCross = MinCross(limits);
+    int maxCross = std::max(minCross, MaxCross(limits));
+    return std::max(minCross, std::min(ChildCrossLength(child.GetLayoutWidth(), child.GetLayoutHeight()), maxCross));
+}
+
+int FlexLayout::MinMain(const Widget& child) {
+    const SizeLimits& limits = child.GetSizeLimits();
+    int specified = direction == FlexDirection::Row ? limits.minWidth : limits.minHeight;
+    if(specified >= 0) return specified;
+
+    // Automatic minimum: content-sized children don't shrink below their content (CSS min-width: auto)
+    bool contentSized = direction == FlexDirection::Row ? child.IsAutoWidth() : child.IsAutoHeight();
+    if(!contentSized) return 0;
+
+    IntrinsicSize content = child.GetIntrinsicSize();
+    int contentMin = direction == FlexDirection::Row ? content.minWidth : content.height;
+    return std::max(0, std::min(contentMin, MaxMain(limits)));
+}
 
-    // --- PASS 3: Adjust container size if auto-sizing ---
+void FlexLayout::ResizeContainer(const RECT& innerRect, int mainEnd, int contentCrossLength) {
     RECT effectiveRect = container->EffectiveRect();
     Spacing padding = container->GetPadding();
     Border border = container->GetBorder();
@@ -177,7 +502,7 @@ void FlexLayout::Apply(const RECT& innerRect) {
 
     if(autoSizeMain) {
         int mainStartPos = MainStart(innerRect);    // where the main axis starts
-        int mainLength = cursor - mainStartPos;     // total length of children + spacing
+        int mainLength = mainEnd - mainStartPos;    // total length of children + spacing
         if(direction == FlexDirection::Row) {
             finalRect.left = mainStartPos;
             finalRect.right = finalRect.left + mainLength + padding.left + padding.right + border.left.thickness + border.right.thickness;
@@ -189,10 +514,10 @@ void FlexLayout::Apply(const RECT& innerRect) {
     }
     if(autoSizeCross) {
         if(direction == FlexDirection::Row) {
-            finalRect.bottom = effectiveRect.top + border.top.thickness + padding.top + maxChildCrossLength + padding.bottom + border.bottom.thickness;
+            finalRect.bottom = effectiveRect.top + border.top.thickness + padding.top + contentCrossLength + padding.bottom + border.bottom.thickness;
         } 
         else {
-            finalRect.right = effectiveRect.left + border.left.thickness + padding.left + maxChildCrossLength + padding.right + border.right.thickness;
+            finalRect.right = effectiveRect.left + border.left.thickness + padding.left + contentCrossLength + padding.right + border.right.thickness;
         }
     }
 
@@ -209,4 +534,15 @@ void FlexLayout::Apply(const RECT& innerRect) {
         finalRect.right - finalRect.left,
         finalRect.bottom - finalRect.top
     );
-}
\ No newline at end of file
+}
+
+bool FlexLayout::HashInputs(LayoutHash& hash) const {
+    hash.Add(static_cast<int>(direction));
+    hash.Add(spacing);
+    hash.Add(lineSpacing);
+    hash.Add(static_cast<int>(justify));
+    hash.Add(static_cast<int>(align));
+    hash.Add(static_cast<int>(wrap));
+    hash.Add(static_cast<int>(alignContent));
+    return true;
+}
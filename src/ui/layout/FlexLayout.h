@@ -1,3 +1,6 @@
+#include <vector>
+#include <algorithm>
+
 #include "Layout.h"
 
 enum class FlexDirection {
@@ -23,12 +26,22 @@ enum class JustifyContent {
     SpaceEvenly
 };
 
-// Placement perpendicular to layout direction
-enum class AlignItems {
+// Line breaking
+enum class FlexWrap {
+    NoWrap,         // Single line, overflowing children spill past the container
+    Wrap,           // Lines stacked from cross start
+    WrapReverse     // Lines stacked from cross end
+};
+
+// Distribution of wrapped lines along the cross axis
+enum class AlignContent {
     Start,
     Center,
     End,
-    Stretch
+    SpaceBetween,
+    SpaceAround,
+    SpaceEvenly,
+    Stretch         // Lines share the free cross space
 };
 
 class FlexLayout : public Layout {
@@ -41,6 +54,7 @@ class FlexLayout : public Layout {
 
         // Internal updates
         void Apply(const RECT& innerRect) override;
+        bool HashInputs(LayoutHash& hash) const override;
 
         // Direction
         FlexDirection GetDirection() const { return direction; }
@@ -57,12 +71,96 @@ class FlexLayout : public Layout {
         AlignItems GetAlign() const { return align; }
         void SetAlign(AlignItems newAlign) { align = newAlign; }
 
+        // Wrapping (ignored if the container main axis is auto-sized - nothing to wrap at)
+        FlexWrap GetWrap() const { return wrap; }
+        void SetWrap(FlexWrap newWrap) { wrap = newWrap; }
+
+        AlignContent GetAlignContent() const { return alignContent; }
+        void SetAlignContent(AlignContent newAlignContent) { alignContent = newAlignContent; }
+
+        // Gap between wrapped lines
+        int GetLineSpacing() const { return lineSpacing; }
+        void SetLineSpacing(int gap);
+
     private:
         FlexDirection direction;
         int spacing = 0;
+        int lineSpacing = 0;
 
         JustifyContent justify = JustifyContent::Start;
         AlignItems align = AlignItems::Start;
+        FlexWrap wrap = FlexWrap::NoWrap;
+        AlignContent alignContent = AlignContent::Start;
+
+        // Line of items [first, end) (the whole container if not wrapping)
+        struct FlexLine {
+            size_t first;
+            size_t end;
+            int mainLength;     // Hypothetical sizes + margins + spacing
+            int crossLength;    // Tallest child incl. margins (+ stretch share)
+            int baseline;       // Aligned baseline offset from the line cross start (AlignItems::Baseline)
+        };
+        std::vector<FlexLine> lines; // Reused between passes - no per-line allocation once warmed up
+
+        // Non-null child, in children order
+        struct FlexItem {
+            Widget* widget;
+            int marginMain;
+            int base;           // Flex basis
+            int hypothetical;   // Basis clamped to min/max
+            int minMain, maxMain;
+            int mainLength;     // Resolved
+        };
+        // Point where a child starts/stops flexing while sweeping the free space
+        struct FlexEvent {
+            double at;
+            double rateDelta;
+        };
+        std::vector<FlexItem> items;
+        std::vector<FlexEvent> flexEvents;
+
+        // Items of a line, iterable with range-for
+        struct ItemRange {
+            FlexItem* first;
+            FlexItem* last;
+            FlexItem* begin() const { return first; }
+            FlexItem* end() const { return last; }
+            size_t size() const { return last - first; }
+            bool empty() const { return first == last; }
+            FlexItem& operator[](size_t i) const { return first[i]; }
+        };
+        ItemRange LineItems(const FlexLine& line) {
+            return {items.data() + line.first, items.data() + line.end};
+        }
+
+        // Fills items with the non-null children (availableCross: cross length stretched children get)
+        void CollectItems(const std::vector<std::shared_ptr<Widget>>& children, int availableCross);
+        // Grows/shrinks the line items to fill the main length available to them (margins/spacing excluded)
+        void ResolveFlexibleLengths(const FlexLine& line, int availableMain);
+        // Sizes wrapping children to their resolved width (rows) and sets the line cross length/baseline
+        void MeasureLineCross(FlexLine& line);
+        // Lays the line out along the main axis within [MainStart(innerRect), + containerMainLength); returns the main cursor after it
+        int PlaceLine(const FlexLine& line, const RECT& innerRect, int containerMainLength, bool justifyFree, int lineCrossStart, int lineCrossLength);
+
+        void ApplyWrapped(const RECT& innerRect);
+
+        // Moves cursor/extends spacing according to justify for free main space shared by count items
+        void DistributeMainSpace(int freeLength, size_t count, int& cursor, int& effectiveSpacing) const;
+
+        // Sets the child rect within the line [lineCrossStart, lineCrossStart + lineCrossLength); returns the consumed main length
+        int PlaceChild(Widget& child, int mainCursor, int childMainLength, int lineCrossStart, int lineCrossLength, int lineBaseline);
+
+        // Baselines only line up across a row; columns align baseline items to the start
+        bool AlignsBaselines() const {
+            return align == AlignItems::Baseline && direction == FlexDirection::Row;
+        }
+        // Child baseline from its cross start margin edge (synthesized at the cross end if it has no text, like CSS)
+        int BaselineOffset(const Widget& child, int childCrossLength) const;
+        // Layout cross length clamped to the cross limits
+        int ClampedCrossLength(const Widget& child);
+
+        // Auto-sizes the container to the content (mainEnd = main cursor after the last child)
+        void ResizeContainer(const RECT& innerRect, int mainEnd, int contentCrossLength);
 
         // Helper functions
         int MainStart(const RECT& r) {
@@ -87,6 +185,18 @@ class FlexLayout : public Layout {
             return direction == FlexDirection::Row ? isAutoHeight : isAutoWidth;
         }
 
+        // Resolves the automatic minimum (content minimum of content-sized axes, 0 otherwise)
+        int MinMain(const Widget& child);
+        int MaxMain(const SizeLimits& l) {
+            return direction == FlexDirection::Row ? l.maxWidth : l.maxHeight;
+        }
+        int MinCross(const SizeLimits& l) {
+            return std::max(0, direction == FlexDirection::Row ? l.minHeight : l.minWidth);
+        }
+        int MaxCross(const SizeLimits& l) {
+            return direction == FlexDirection::Row ? l.maxHeight : l.maxWidth;
+        }
+
         int ChildMainLength(int preferredWidth, int preferredHeight) {
             return direction == FlexDirection::Row ? preferredWidth : preferredHeight;
         }
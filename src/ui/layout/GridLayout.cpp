@@ -0,0 +1,343 @@
+#include <algorithm>
+
+#include "GridLayout.h"
+#include "Container.h"
+#include "LayoutSnapshot.h"
+
+namespace {
+    // Position/length of a child within [areaStart, areaStart + areaLength)
+    void AlignInArea(AlignItems align, int areaStart, int areaLength, int marginStart, int marginEnd, int& pos, int& length) {
+        switch(align) {
+            case AlignItems::Start:
+            case AlignItems::Baseline: // Not supported across grid cells
+                pos = areaStart + marginStart;
+                break;
+            case AlignItems::Center:
+                pos = areaStart + (areaLength - length - marginStart - marginEnd) / 2 + marginStart;
+                break;
+            case AlignItems::End:
+                pos = areaStart + areaLength - length - marginEnd;
+                break;
+            case AlignItems::Stretch:
+                pos = areaStart + marginStart;
+                length = std::max(0, areaLength - marginStart - marginEnd);
+                break;
+        }
+    }
+}
+
+GridLayout::GridLayout(std::vector<GridTrack> columns, std::vector<GridTrack> rows, int columnGap, int rowGap) :
+    columns(std::move(columns)),
+    rows(std::move(rows)),
+    columnGap(columnGap),
+    rowGap(rowGap)
+{}
+
+void GridLayout::SetColumns(std::vector<GridTrack> newColumns) {
+    columns = std::move(newColumns);
+    if(container) container->InvalidateLayout();
+}
+
+void GridLayout::SetRows(std::vector<GridTrack> newRows) {
+    rows = std::move(newRows);
+    if(container) container->InvalidateLayout();
+}
+
+void GridLayout::SetImplicitTrack(GridTrack track) {
+    implicitTrack = track;
+    if(container) container->InvalidateLayout();
+}
+
+void GridLayout::SetGaps(int newColumnGap, int newRowGap) {
+    if(columnGap == newColumnGap && rowGap == newRowGap) return;
+
+    columnGap = newColumnGap;
+    rowGap = newRowGap;
+    if(container) container->InvalidateLayout();
+}
+
+void GridLayout::SetCellAlign(AlignItems horizontal, AlignItems vertical) {
+    horizontalAlign = horizontal;
+    verticalAlign = vertical;
+    if(container) container->InvalidateLayout();
+}
+
+void GridLayout::Apply(const RECT& innerRect) {
+    if(!container) return;
+
+    const auto& children = container->Children();
+
+    // --- PASS 1: Resolve cells ---
+    int columnCount = 0, rowCount = 0;
+    PlaceChildren(columnCount, rowCount);
+
+    // --- PASS 2: Size tracks (once for all children) ---
+    PrepareAxis(columnAxis, columns, columnCount);
+    PrepareAxis(rowAxis, rows, rowCount);
+    SizeAxis(columnAxis, true, innerRect.right - innerRect.left, container->IsAutoWidth(), columnGap);
+    SizeAxis(rowAxis, false, innerRect.bottom - innerRect.top, container->IsAutoHeight(), rowGap);
+
+    // --- PASS 3: Position children (cached track lookups only) ---
+    for(size_t i = 0; i < children.size(); i++) {
+        auto& child = children[i];
+        if(!child) continue;
+
+        const Cell& cell = cells[i];
+        int lastColumn = cell.column + cell.columnSpan - 1;
+        int lastRow = cell.row + cell.rowSpan - 1;
+
+        int areaLeft = innerRect.left + columnAxis.offsets[cell.column];
+        int areaTop = innerRect.top + rowAxis.offsets[cell.row];
+        int areaWidth = columnAxis.offsets[lastColumn] + columnAxis.sizes[lastColumn] - columnAxis.offsets[cell.column];
+        int areaHeight = rowAxis.offsets[lastRow] + rowAxis.sizes[lastRow] - rowAxis.offsets[cell.row];
+
+        const Spacing& m = child->GetMargin();
+        int x = areaLeft, y = areaTop;
+        int w = child->GetLayoutWidth();
+        int h = child->GetLayoutHeight();
+        AlignInArea(horizontalAlign, areaLeft, areaWidth, m.left, m.right, x, w);
+        AlignInArea(verticalAlign, areaTop, areaHeight, m.top, m.bottom, y, h);
+
+        SetEffectiveRect(*child, x, y, x + w, y + h);
+    }
+
+    // --- PASS 4: Adjust container size if auto-sizing ---
+    RECT finalRect = container->EffectiveRect();
+    Spacing padding = container->GetPadding();
+    Border border = container->GetBorder();
+
+    if(container->IsAutoWidth()) {
+        finalRect.right = finalRect.left + border.left.thickness + padding.left + columnAxis.totalLength + padding.right + border.right.thickness;
+    }
+    if(container->IsAutoHeight()) {
+        finalRect.bottom = finalRect.top + border.top.thickness + padding.top + rowAxis.totalLength + padding.bottom + border.bottom.thickness;
+    }
+
+    SetEffectiveRect(
+        *container,
+        finalRect.left,
+        finalRect.top,
+        finalRect.right,
+        finalRect.bottom
+    );
+
+    SetLayoutSize(
+        *container,
+        finalRect.right - finalRect.left,
+        finalRect.bottom - finalRect.top
+    );
+}
+
+void GridLayout::PlaceChildren(int& columnCount, int& rowCount) {
+    const auto& children = container->Children();
+    cells.resize(children.size());
+
+    // Explicitly placed children first - they may extend the grid and auto placement flows around them
+    columnCount = std::max<int>(1, static_cast<int>(columns.size()));
+    rowCount = static_cast<int>(rows.size());
+    for(auto& child : children) {
+        if(!child) continue;
+        ApplyIntrinsicSize(*child); // Tracks are sized from the children's current content
+
+        const GridPlacement& p = child->GetGridPlacement();
+        if(p.row >= 0 && p.column >= 0) {
+            columnCount = std::max(columnCount, p.column + p.columnSpan);
+            rowCount = std::max(rowCount, p.row + p.rowSpan);
+        }
+    }
+
+    occupied.assign(static_cast<size_t>(rowCount) * columnCount, 0);
+    for(size_t i = 0; i < children.size(); i++) {
+        auto& child = children[i];
+        if(!child) continue;
+
+        const GridPlacement& p = child->GetGridPlacement();
+        if(p.row >= 0 && p.column >= 0) {
+            cells[i] = {p.row, p.column, p.rowSpan, p.columnSpan};
+            Occupy(cells[i], columnCount);
+        }
+    }
+
+    // Auto placement: row by row, the cursor never moves back
+    int cursorRow = 0, cursorColumn = 0;
+    for(size_t i = 0; i < children.size(); i++) {
+        auto& child = children[i];
+        if(!child) continue;
+
+        const GridPlacement& p = child->GetGridPlacement();
+        if(p.row >= 0 && p.column >= 0) continue;
+
+        int rowSpan = p.rowSpan;
+        int columnSpan = std::min<int>(p.columnSpan, columnCount);
+        while(true) {
+            if(cursorColumn + columnSpan > columnCount) {
+                cursorRow++;
+                cursorColumn = 0;
+                continue;
+            }
+            if(IsFree(cursorRow, cursorColumn, rowSpan, columnSpan, columnCount)) break;
+            cursorColumn++;
+        }
+
+        cells[i] = {cursorRow, cursorColumn, rowSpan, columnSpan};
+        Occupy(cells[i], columnCount);
+        rowCount = std::max(rowCount, cursorRow + rowSpan);
+        cursorColumn += columnSpan;
+    }
+}
+
+bool GridLayout::IsFree(int row, int column, int rowSpan, int columnSpan, int columnCount) const {
+    for(int r = row; r < row + rowSpan; r++) {
+        size_t rowBase = static_cast<size_t>(r) * columnCount;
+        if(rowBase >= occupied.size()) break; // Rows past the occupancy map are empty
+
+        for(int c = column; c < column + columnSpan; c++) {
+            if(occupied[rowBase + c]) return false;
+        }
+    }
+    return true;
+}
+
+void GridLayout::Occupy(const Cell& cell, int columnCount) {
+    size_t needed = static_cast<size_t>(cell.row + cell.rowSpan) * columnCount;
+    if(occupied.size() < needed) {
+        occupied.resize(needed, 0);
+    }
+
+    for(int r = cell.row; r < cell.row + cell.rowSpan; r++) {
+        for(int c = cell.column; c < cell.column + cell.columnSpan; c++) {
+            occupied[static_cast<size_t>(r) * columnCount + c] = 1;
+        }
+    }
+}
+
+void GridLayout::PrepareAxis(Axis& axis, const std::vector<GridTrack>& defined, int count) const {
+    axis.tracks.assign(defined.begin(), defined.begin() + std::min<size_t>(defined.size(), count));
+    axis.tracks.resize(count, implicitTrack);
+    axis.sizes.assign(count, 0);
+    axis.offsets.resize(count);
+}
+
+void GridLayout::SizeAxis(Axis& axis, bool horizontal, int available, bool autoSized, int gap) const {
+    const auto& children = container->Children();
+    int count = static_cast<int>(axis.tracks.size());
+
+    // Without a definite length there's nothing to share - fractions fit their content instead
+    auto isContentSized = [&](const GridTrack& t) {
+        return t.type == GridTrackType::Auto || (t.type == GridTrackType::Fraction && autoSized);
+    };
+    auto childLength = [horizontal](const Widget& child) {
+        const Spacing& m = child.GetMargin();
+        return horizontal
+            ? child.GetLayoutWidth() + m.left + m.right
+            : child.GetLayoutHeight() + m.top + m.bottom;
+    };
+
+    for(int t = 0; t < count; t++) {
+        if(axis.tracks[t].type == GridTrackType::Fixed) {
+            axis.sizes[t] = static_cast<int>(axis.tracks[t].value);
+        }
+    }
+
+    // Content-sized tracks: single-span children first...
+    bool hasMultiSpan = false;
+    for(size_t i = 0; i < children.size(); i++) {
+        if(!children[i]) continue;
+
+        const Cell& cell = cells[i];
+        int start = horizontal ? cell.column : cell.row;
+        int span = horizontal ? cell.columnSpan : cell.rowSpan;
+        if(span > 1) {
+            hasMultiSpan = true;
+            continue;
+        }
+        if(isContentSized(axis.tracks[start])) {
+            axis.sizes[start] = std::max(axis.sizes[start], childLength(*children[i]));
+        }
+    }
+
+    // ...then spanning children spread what's still missing over their content-sized tracks
+    if(hasMultiSpan) {
+        for(size_t i = 0; i < children.size(); i++) {
+            if(!children[i]) continue;
+
+            const Cell& cell = cells[i];
+            int start = horizontal ? cell.column : cell.row;
+            int span = horizontal ? cell.columnSpan : cell.rowSpan;
+            if(span <= 1) continue;
+
+            int covered = gap * (span - 1);
+            int flexibleTracks = 0;
+            for(int t = start; t < start + span; t++) {
+                covered += axis.sizes[t];
+                if(isContentSized(axis.tracks[t])) flexibleTracks++;
+            }
+
+            int missing = childLength(*children[i]) - covered;
+            if(missing <= 0 || flexibleTracks == 0) continue;
+
+            for(int t = start; t < start + span; t++) {
+                if(!isContentSized(axis.tracks[t])) continue;
+
+                int share = missing / flexibleTracks--;
+                axis.sizes[t] += share;
+                missing -= share;
+            }
+        }
+    }
+
+    // Fractions share the leftover space
+    if(!autoSized) {
+        int used = gap * std::max(0, count - 1);
+        float totalWeight = 0.0f;
+        for(int t = 0; t < count; t++) {
+            if(axis.tracks[t].type == GridTrackType::Fraction) {
+                totalWeight += axis.tracks[t].value;
+            }
+            else {
+                used += axis.sizes[t];
+            }
+        }
+
+        if(totalWeight > 0.0f) {
+            int free = std::max(0, available - used);
+
+            // Distribute by cumulative edges, so rounding never loses pixels
+            float weight = 0.0f;
+            int edge = 0;
+            for(int t = 0; t < count; t++) {
+                if(axis.tracks[t].type != GridTrackType::Fraction) continue;
+
+                weight += axis.tracks[t].value;
+                int nextEdge = static_cast<int>(free * (weight / totalWeight) + 0.5f);
+                axis.sizes[t] = nextEdge - edge;
+                edge = nextEdge;
+            }
+        }
+    }
+
+    // Offsets (prefix sums)
+    int offset = 0;
+    for(int t = 0; t < count; t++) {
+        axis.offsets[t] = offset;
+        offset += axis.sizes[t] + gap;
+    }
+    axis.totalLength = count > 0 ? offset - gap : 0;
+}
+
+bool GridLayout::HashInputs(LayoutHash& hash) const {
+    for(const std::vector<GridTrack>* tracks : {&columns, &rows}) {
+        hash.Add(static_cast<int>(tracks->size()));
+        for(const GridTrack& t : *tracks) {
+            hash.Add(static_cast<int>(t.type));
+            hash.Add(t.value);
+        }
+    }
+    hash.Add(static_cast<int>(implicitTrack.type));
+    hash.Add(implicitTrack.value);
+    hash.Add(columnGap);
+    hash.Add(rowGap);
+    hash.Add(static_cast<int>(horizontalAlign));
+    hash.Add(static_cast<int>(verticalAlign));
+    return true;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "Layout.h"
+
+class Widget;
+
+enum class GridTrackType {
+    Fixed,      // Exact length in pixels
+    Auto,       // Fits the biggest child in the track
+    Fraction    // Share of the space left by fixed/auto tracks (fr)
+};
+
+struct GridTrack {
+    GridTrackType type = GridTrackType::Auto;
+    float value = 0.0f; // Pixels (Fixed) or weight (Fraction)
+
+    static GridTrack Fixed(int length) { return {GridTrackType::Fixed, static_cast<float>(length)}; }
+    static GridTrack Auto() { return {GridTrackType::Auto, 0.0f}; }
+    static GridTrack Fr(float weight = 1.0f) { return {GridTrackType::Fraction, weight}; }
+};
+
+// Rows/columns of tracks; children are placed by Widget::SetGridCell or flow row by row into free cells
+// Track sizes are computed once per pass and cached, so placing a child is just a lookup
+// (a linear pass over the children instead of one flex solve per row)
+class GridLayout : public Layout {
+    public:
+        // Children beyond the defined rows get implicit Auto rows
+        explicit GridLayout(std::vector<GridTrack> columns, std::vector<GridTrack> rows = {}, int columnGap = 0, int rowGap = 0);
+
+        // Internal updates
+        void Apply(const RECT& innerRect) override;
+        bool HashInputs(LayoutHash& hash) const override;
+
+        // Tracks
+        const std::vector<GridTrack>& GetColumns() const { return columns; }
+        void SetColumns(std::vector<GridTrack> newColumns);
+        const std::vector<GridTrack>& GetRows() const { return rows; }
+        void SetRows(std::vector<GridTrack> newRows);
+
+        // Tracks used past the defined ones (by implicit rows, and columns of explicitly placed children)
+        void SetImplicitTrack(GridTrack track);
+
+        // Gaps
+        int GetColumnGap() const { return columnGap; }
+        int GetRowGap() const { return rowGap; }
+        void SetGaps(int newColumnGap, int newRowGap);
+
+        // Child placement within its cell area (default: fill)
+        AlignItems GetHorizontalAlign() const { return horizontalAlign; }
+        AlignItems GetVerticalAlign() const { return verticalAlign; }
+        void SetCellAlign(AlignItems horizontal, AlignItems vertical);
+
+        // Track sizes of the last pass
+        const std::vector<int>& GetColumnSizes() const { return columnAxis.sizes; }
+        const std::vector<int>& GetRowSizes() const { return rowAxis.sizes; }
+
+    private:
+        std::vector<GridTrack> columns;
+        std::vector<GridTrack> rows;
+        GridTrack implicitTrack = GridTrack::Auto();
+        int columnGap = 0;
+        int rowGap = 0;
+
+        AlignItems horizontalAlign = AlignItems::Stretch;
+        AlignItems verticalAlign = AlignItems::Stretch;
+
+        // Resolved cell area of a child (same index as in Children())
+        struct Cell {
+            int row, column;
+            int rowSpan, columnSpan;
+        };
+
+        // Per-axis sizing state, reused between passes
+        struct Axis {
+            std::vector<GridTrack> tracks;  // Defined + implicit
+            std::vector<int> sizes;
+            std::vector<int> offsets;       // Track start relative to the inner rect
+            int totalLength = 0;            // Tracks + gaps
+        };
+
+        std::vector<Cell> cells;
+        std::vector<uint8_t> occupied; // Row-major cell occupancy used by auto placement
+        Axis columnAxis;
+        Axis rowAxis;
+
+        void PlaceChildren(int& columnCount, int& rowCount);
+        void PrepareAxis(Axis& axis, const std::vector<GridTrack>& defined, int count) const;
+        void SizeAxis(Axis& axis, bool horizontal, int available, bool autoSized, int gap) const;
+
+        bool IsFree(int row, int column, int rowSpan, int columnSpan, int columnCount) const;
+        void Occupy(const Cell& cell, int columnCount);
+};
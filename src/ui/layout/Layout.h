@@ -4,6 +4,16 @@
 #include "LayoutWidgetBridge.h"
 
 class Container; // forward
+class LayoutHash;
+
+// Placement of a child within the space the layout assigned to it (perpendicular to layout direction for flex)
+enum class AlignItems {
+    Start,
+    Center,
+    End,
+    Stretch,
+    Baseline    // First text baselines line up (FlexLayout rows; Start elsewhere)
+};
 
 class Layout {
     public:
@@ -17,6 +27,10 @@ class Layout {
 
         virtual Container* GetContainer() const { return container; }
 
+        // Feeds the layout parameters to a LayoutSnapshot hash
+        // False = parameters can't be hashed, so the container never adopts a snapshot (the default for custom layouts)
+        virtual bool HashInputs(LayoutHash& /*hash*/) const { return false; }
+
     protected:
         Container* container = nullptr;
 
@@ -24,6 +38,9 @@ class Layout {
             container = newContainer;
         }
 
+        // Called by the container right before a child leaves it (layouts holding per-child state drop it here)
+        virtual void OnChildRemoved(Widget& /*child*/) {}
+
         // Proxy methods for derived layouts to use the LayoutWidgetBridge
         static void SetEffectiveRect(
             Widget& child,
@@ -38,4 +55,9 @@ class Layout {
         ) {
             LayoutWidgetBridge::SetLayoutSize(child, width, height);
         }
+        // Proxy methods for derived layouts to use the LayoutWidgetBridge
+        // Call before measuring a child, so content-sized children are measured at their current content
+        static void ApplyIntrinsicSize(Widget& child) {
+            LayoutWidgetBridge::ApplyIntrinsicSize(child);
+        }
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <windows.h>
+
+// Read-only memory mapping of a whole file (RAII) - pages are loaded on first access
+class MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::wstring& path) { Open(path); }
+        ~MappedFile() { Close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::wstring& path); // False if the file can't be opened or is empty
+        void Close();
+
+        bool IsOpen() const { return view != nullptr; }
+        const uint8_t* Data() const { return static_cast<const uint8_t*>(view); }
+        size_t Size() const { return size; }
+
+    private:
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+        const void* view = nullptr;
+        size_t size = 0;
+};
@@ -0,0 +1,598 @@
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "UiCompiler.h"
+#include "UiFormat.h"
+#include "FlexLayout.h"
+
+using namespace UiFormat;
+
+namespace {
+    const int MaxDepth = 256;
+
+    // --- Lexing ---------------------------------------------------------
+    enum class TokenKind { Word, String, Equals, Open, Close, End };
+
+    struct Token {
+        TokenKind kind;
+        std::string text;
+        int line;
+    };
+
+    // Words cover names, numbers, number lists (4,8) and colors (#RRGGBB)
+    bool IsWordChar(char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || (c != '\0' && std::strchr("_-+.,#", c));
+    }
+
+    bool Tokenize(const std::string& s, std::vector<Token>& tokens, std::string& error) {
+        int line = 1;
+        size_t i = 0;
+        while(i < s.size()) {
+            char c = s[i];
+            if(c == '\n') { line++; i++; continue; }
+            if(std::isspace(static_cast<unsigned char>(c))) { i++; continue; }
+            if(c == '/' && i + 1 < s.size() && s[i + 1] == '/') {
+                while(i < s.size() && s[i] != '\n') i++;
+                continue;
+            }
+
+            if(c == '=') { tokens.push_back({TokenKind::Equals, "=", line}); i++; continue; }
+            if(c == '{') { tokens.push_back({TokenKind::Open, "{", line}); i++; continue; }
+            if(c == '}') { tokens.push_back({TokenKind::Close, "}", line}); i++; continue; }
+
+            if(c == '"') {
+                Token t{TokenKind::String, "", line};
+                for(i++; i < s.size() && s[i] != '"'; i++) {
+                    if(s[i] == '\n') break;
+                    if(s[i] != '\\') { t.text += s[i]; continue; }
+                    if(++i >= s.size()) break;
+                    switch(s[i]) {
+                        case 'n': t.text += '\n'; break;
+                        case 't': t.text += '\t'; break;
+                        default:  t.text += s[i]; break; // Escaped quote or backslash
+                    }
+                }
+                if(i >= s.size() || s[i] != '"') {
+                    error = "line " + std::to_string(line) + ": unterminated string";
+                    return false;
+                }
+                i++;
+                tokens.push_back(std::move(t));
+                continue;
+            }
+
+            if(!IsWordChar(c)) {
+                error = "line " + std::to_string(line) + ": unexpected '" + std::string(1, c) + "'";
+                return false;
+            }
+            size_t start = i;
+            while(i < s.size() && IsWordChar(s[i])) i++;
+            tokens.push_back({TokenKind::Word, s.substr(start, i - start), line});
+        }
+        tokens.push_back({TokenKind::End, "end of input", line});
+        return true;
+    }
+
+    // UTF-8 -> UTF-16 (false on malformed input)
+    bool AppendUtf16(const std::string& s, std::vector<uint16_t>& out) {
+        for(size_t i = 0; i < s.size();) {
+            unsigned char c = static_cast<unsigned char>(s[i]);
+            int extra = c < 0x80 ? 0 : (c >> 5) == 0x6 ? 1 : (c >> 4) == 0xE ? 2 : (c >> 3) == 0x1E ? 3 : -1;
+            if(extra < 0 || i + extra >= s.size()) return false;
+
+            uint32_t cp = extra == 0 ? c : c & (0x3F >> extra);
+            for(int k = 1; k <= extra; k++) {
+                unsigned char cc = static_cast<unsigned char>(s[i + k]);
+                if((cc & 0xC0) != 0x80) return false;
+                cp = (cp << 6) | (cc & 0x3F);
+            }
+            i += extra + 1;
+            if(cp > 0x10FFFF) return false;
+
+            if(cp >= 0x10000) {
+                cp -= 0x10000;
+                out.push_back(static_cast<uint16_t>(0xD800 + (cp >> 10)));
+                out.push_back(static_cast<uint16_t>(0xDC00 + (cp & 0x3FF)));
+            }
+            else {
+                out.push_back(static_cast<uint16_t>(cp));
+            }
+        }
+        return true;
+    }
+
+    // --- Values ---------------------------------------------------------
+    // Comma-separated integers; returns the count (-1 if malformed or more than maxCount)
+    int ParseInts(const std::string& text, int32_t* out, int maxCount) {
+        int count = 0;
+        const char* p = text.c_str();
+        while(true) {
+            if(count == maxCount) return -1;
+            char* end;
+            long v = std::strtol(p, &end, 10);
+            if(end == p) return -1;
+            out[count++] = static_cast<int32_t>(v);
+            if(*end == '\0') return count;
+            if(*end != ',') return -1;
+            p = end + 1;
+        }
+    }
+
+    int ParseFloats(const std::string& text, float* out, int maxCount) {
+        int count = 0;
+        const char* p = text.c_str();
+        while(true) {
+            if(count == maxCount) return -1;
+            char* end;
+            float v = std::strtof(p, &end);
+            if(end == p) return -1;
+            out[count++] = v;
+            if(*end == '\0') return count;
+            if(*end != ',') return -1;
+            p = end + 1;
+        }
+    }
+
+    bool ParseBool(const std::string& text, int32_t& out) {
+        if(text == "true" || text == "1")  { out = 1; return true; }
+        if(text == "false" || text == "0") { out = 0; return true; }
+        return false;
+    }
+
+    // #RRGGBB or #AARRGGBB -> ARGB
+    bool ParseColor(const std::string& text, int32_t& out) {
+        if(text.size() != 7 && text.size() != 9) return false;
+        if(text[0] != '#') return false;
+
+        uint32_t v = 0;
+        for(size_t i = 1; i < text.size(); i++) {
+            char c = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+            if(c >= '0' && c <= '9')      v = (v << 4) | (c - '0');
+            else if(c >= 'a' && c <= 'f') v = (v << 4) | (c - 'a' + 10);
+            else return false;
+        }
+        if(text.size() == 7) v |= 0xFF000000;
+        out = static_cast<int32_t>(v);
+        return true;
+    }
+
+    int32_t FloatBits(float f) {
+        int32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    // --- Vocabulary -----------------------------------------------------
+    const char* const TypeNames[] = {"Container", "Label", "Button", "Checkbox", "Slider", "TextInput"};
+    static_assert(sizeof(TypeNames) / sizeof(TypeNames[0]) == static_cast<size_t>(NodeType::Count), "Type names");
+
+    constexpr uint32_t Bit(NodeType t) { return 1u << static_cast<uint32_t>(t); }
+    const uint32_t AnyType = (1u << static_cast<uint32_t>(NodeType::Count)) - 1;
+    const uint32_t TextTypes = Bit(NodeType::Label) | Bit(NodeType::Button) | Bit(NodeType::Checkbox) | Bit(NodeType::Slider) | Bit(NodeType::TextInput);
+
+    enum class Attr {
+        Id, Pos, Size, Padding, Margin, AutoWidth, AutoHeight, Grow, Shrink, Basis, MinSize, MaxSize, Cell, Class,
+        Background, TextColor, Displayed, Visible, Enabled, Focusable,
+        Clip, Layout, Gap, LineGap, Align, Justify, Wrap,
+        Text, Checked, Value, Range, WordWrap
+    };
+    struct AttrDesc {
+        const char* name;
+        Attr attr;
+        uint32_t types; // Node types accepting the attribute
+    };
+    const AttrDesc Attributes[] = {
+        {"id",          Attr::Id,           AnyType},
+        {"pos",         Attr::Pos,          AnyType},
+        {"size",        Attr::Size,         AnyType},
+        {"padding",     Attr::Padding,      AnyType},
+        {"margin",      Attr::Margin,       AnyType},
+        {"autoWidth",   Attr::AutoWidth,    AnyType},
+        {"autoHeight",  Attr::AutoHeight,   AnyType},
+        {"grow",        Attr::Grow,         AnyType},
+        {"shrink",      Attr::Shrink,       AnyType},
+        {"basis",       Attr::Basis,        AnyType},
+        {"minSize",     Attr::MinSize,      AnyType},
+        {"maxSize",     Attr::MaxSize,      AnyType},
+        {"cell",        Attr::Cell,         AnyType},
+        {"class",       Attr::Class,        AnyType},
+        {"background",  Attr::Background,   AnyType},
+        {"textColor",   Attr::TextColor,    TextTypes},
+        {"displayed",   Attr::Displayed,    AnyType},
+        {"visible",     Attr::Visible,      AnyType},
+        {"enabled",     Attr::Enabled,      AnyType},
+        {"focusable",   Attr::Focusable,    AnyType},
+        {"clip",        Attr::Clip,         Bit(NodeType::Container)},
+        {"layout",      Attr::Layout,       Bit(NodeType::Container)},
+        {"gap",         Attr::Gap,          Bit(NodeType::Container)},
+        {"lineGap",     Attr::LineGap,      Bit(NodeType::Container)},
+        {"align",       Attr::Align,        Bit(NodeType::Container)},
+        {"justify",     Attr::Justify,      Bit(NodeType::Container)},
+        {"wrap",        Attr::Wrap,         Bit(NodeType::Container)},
+        {"text",        Attr::Text,         TextTypes},
+        {"checked",     Attr::Checked,      Bit(NodeType::Checkbox)},
+        {"value",       Attr::Value,        Bit(NodeType::Slider)},
+        {"range",       Attr::Range,        Bit(NodeType::Slider)},
+        {"wordWrap",    Attr::WordWrap,     Bit(NodeType::Label)}
+    };
+
+    struct EnumName {
+        const char* name;
+        int32_t value;
+    };
+    const EnumName AlignNames[] = {
+        {"start",   static_cast<int32_t>(AlignItems::Start)},
+        {"center",  static_cast<int32_t>(AlignItems::Center)},
+        {"end",     static_cast<int32_t>(AlignItems::End)},
+        {"stretch", static_cast<int32_t>(AlignItems::Stretch)},
+        {"baseline",static_cast<int32_t>(AlignItems::Baseline)}
+    };
+    const EnumName JustifyNames[] = {
+        {"start",   static_cast<int32_t>(JustifyContent::Start)},
+        {"center",  static_cast<int32_t>(JustifyContent::Center)},
+        {"end",     static_cast<int32_t>(JustifyContent::End)},
+        {"between", static_cast<int32_t>(JustifyContent::SpaceBetween)},
+        {"around",  static_cast<int32_t>(JustifyContent::SpaceAround)},
+        {"evenly",  static_cast<int32_t>(JustifyContent::SpaceEvenly)}
+    };
+    const EnumName WrapNames[] = {
+        {"nowrap",  static_cast<int32_t>(FlexWrap::NoWrap)},
+        {"wrap",    static_cast<int32_t>(FlexWrap::Wrap)},
+        {"reverse", static_cast<int32_t>(FlexWrap::WrapReverse)}
+    };
+    const EnumName DirectionNames[] = {
+        {"row",     static_cast<int32_t>(FlexDirection::Row)},
+        {"column",  static_cast<int32_t>(FlexDirection::Column)}
+    };
+
+    template<size_t N>
+    bool ParseEnum(const std::string& text, const EnumName (&names)[N], int32_t& out) {
+        for(const EnumName& e : names) {
+            if(text == e.name) { out = e.value; return true; }
+        }
+        return false;
+    }
+
+    // Spacing shorthand like the SetPadding/SetMargin overloads -> top, bottom, left, right
+    bool ParseSpacing(const std::string& text, int32_t* out) {
+        int32_t v[4];
+        switch(ParseInts(text, v, 4)) {
+            case 1: out[0] = out[1] = out[2] = out[3] = v[0]; return true;
+            case 2: out[0] = out[1] = v[1]; out[2] = out[3] = v[0]; return true;
+            case 4: std::memcpy(out, v, sizeof(v)); return true;
+            default: return false;
+        }
+    }
+
+    // --- Building -------------------------------------------------------
+    // Attributes that are stored merged into one record
+    struct PendingNode {
+        size_t firstProp = 0;
+        int32_t autoSize[2] = {-1, -1};     // -1 = keep the widget default
+        int32_t flexMask = 0;               // 1 = grow, 2 = shrink, 4 = basis
+        float grow = 0.0f, shrink = 1.0f;
+        int32_t basis = -1;
+        bool hasLayout = false;
+        int layoutLine = 0;                 // Line of the first layout attribute (for errors)
+        int32_t direction = 0, gap = 0, lineGap = 0;
+        int32_t align = static_cast<int32_t>(AlignItems::Start);
+        int32_t justify = static_cast<int32_t>(JustifyContent::Start);
+        int32_t wrap = static_cast<int32_t>(FlexWrap::NoWrap);
+        bool hasValue = false;              // Slider value - set after the range, or it'd be clamped to the default one
+        float value = 0.0f;
+        uint64_t seen = 0;                  // Attributes already given (bit per Attr)
+    };
+
+    struct Builder {
+        const std::vector<Token>& tokens;
+        size_t pos = 0;
+
+        std::vector<NodeRecord> nodes;
+        std::vector<PropRecord> props;
+        std::vector<uint16_t> strings;
+        std::unordered_map<std::string, std::pair<int32_t, int32_t>> interned; // Text -> pool offset, length
+        std::unordered_set<std::string> ids;
+        std::string error;
+
+        explicit Builder(const std::vector<Token>& tokens) : tokens(tokens) {}
+
+        bool Fail(int line, const std::string& message) {
+            error = "line " + std::to_string(line) + ": " + message;
+            return false;
+        }
+
+        void Emit(PropKey key, int32_t a = 0, int32_t b = 0, int32_t c = 0, int32_t d = 0) {
+            PropRecord r{};
+            r.key = key;
+            r.v[0] = a;
+            r.v[1] = b;
+            r.v[2] = c;
+            r.v[3] = d;
+            props.push_back(r);
+        }
+
+        bool EmitString(PropKey key, const std::string& text, int line) {
+            auto it = interned.find(text);
+            if(it == interned.end()) {
+                int32_t offset = static_cast<int32_t>(strings.size());
+                if(!AppendUtf16(text, strings)) return Fail(line, "invalid UTF-8 in string");
+                it = interned.emplace(text, std::make_pair(offset, static_cast<int32_t>(strings.size()) - offset)).first;
+            }
+            Emit(key, it->second.first, it->second.second);
+            return true;
+        }
+
+        bool ParseNode(int depth, size_t& index) {
+            const Token& typeToken = tokens[pos];
+            if(typeToken.kind != TokenKind::Word) return Fail(typeToken.line, "expected a widget type, got '" + typeToken.text + "'");
+            if(depth > MaxDepth) return Fail(typeToken.line, "nesting too deep");
+
+            int type = -1;
+            for(int t = 0; t < static_cast<int>(NodeType::Count); t++) {
+                if(typeToken.text == TypeNames[t]) type = t;
+            }
+            if(type < 0) return Fail(typeToken.line, "unknown widget type '" + typeToken.text + "'");
+            pos++;
+
+            index = nodes.size();
+            NodeRecord node{};
+            node.type = static_cast<NodeType>(type);
+            node.firstProp = static_cast<uint32_t>(props.size());
+            nodes.push_back(node);
+
+            // Attributes: name = value
+            PendingNode pending;
+            pending.firstProp = node.firstProp;
+            while(tokens[pos].kind == TokenKind::Word && tokens[pos + 1].kind == TokenKind::Equals) {
+                const Token& name = tokens[pos];
+                const Token& value = tokens[pos + 2];
+                if(value.kind != TokenKind::Word && value.kind != TokenKind::String) {
+                    return Fail(value.line, "expected a value for '" + name.text + "'");
+                }
+                if(!ParseAttribute(node.type, name, value, pending)) return false;
+                pos += 3;
+            }
+            if(!EmitPending(pending)) return false;
+
+            size_t propCount = props.size() - node.firstProp;
+            if(propCount > UINT16_MAX) return Fail(typeToken.line, "too many attributes");
+            nodes[index].propCount = static_cast<uint16_t>(propCount);
+
+            // Children
+            if(tokens[pos].kind != TokenKind::Open) return true;
+            if(node.type != NodeType::Container) return Fail(tokens[pos].line, typeToken.text + " can't have children");
+            pos++;
+
+            uint32_t childCount = 0;
+            while(tokens[pos].kind != TokenKind::Close) {
+                if(tokens[pos].kind == TokenKind::End) return Fail(tokens[pos].line, "missing '}'");
+                size_t child;
+                if(!ParseNode(depth + 1, child)) return false;
+                childCount++;
+            }
+            pos++;
+            nodes[index].childCount = childCount;
+            return true;
+        }
+
+        bool ParseAttribute(NodeType type, const Token& name, const Token& value, PendingNode& pending) {
+            const AttrDesc* desc = nullptr;
+            for(const AttrDesc& a : Attributes) {
+                if(name.text == a.name) desc = &a;
+            }
+            if(!desc) return Fail(name.line, "unknown attribute '" + name.text + "'");
+            if(!(desc->types & Bit(type))) {
+                return Fail(name.line, std::string(TypeNames[static_cast<int>(type)]) + " has no attribute '" + name.text + "'");
+            }
+
+            uint64_t bit = 1ull << static_cast<int>(desc->attr);
+            if(pending.seen & bit) return Fail(name.line, "duplicate attribute '" + name.text + "'");
+            pending.seen |= bit;
+
+            // Strings are only valid for string attributes (and ids), everything else is a word
+            const std::string& text = value.text;
+            bool isString = value.kind == TokenKind::String;
+            if(isString && desc->attr != Attr::Text && desc->attr != Attr::Id && desc->attr != Attr::Class) {
+                return Fail(value.line, "'" + name.text + "' doesn't take a string");
+            }
+
+            std::string bad = "invalid value '" + text + "' for '" + name.text + "'";
+            int32_t v[4] = {0, 0, 0, 0};
+            float f[3] = {0.0f, 0.0f, 0.0f};
+            switch(desc->attr) {
+                case Attr::Id:
+                    if(text.empty()) return Fail(value.line, bad);
+                    for(char c : text) {
+                        // ASCII only, ids are looked up as std::string
+                        if(!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '-' && c != '.') return Fail(value.line, bad);
+                    }
+                    if(!ids.insert(text).second) return Fail(value.line, "duplicate id '" + text + "'");
+                    return EmitString(PropKey::Id, text, value.line);
+                case Attr::Class: {
+                    if(text.empty()) return Fail(value.line, bad);
+                    if(!EmitString(PropKey::StyleClass, text, value.line)) return false;
+
+                    // First, so the color attributes derive their private look from the class
+                    std::rotate(props.begin() + pending.firstProp, props.end() - 1, props.end());
+                    return true;
+                }
+                case Attr::Text:
+                    return EmitString(PropKey::Text, text, value.line);
+
+                case Attr::Pos:
+                case Attr::Size:
+                case Attr::MinSize:
+                case Attr::MaxSize: {
+                    if(ParseInts(text, v, 2) != 2) return Fail(value.line, bad);
+                    PropKey key = desc->attr == Attr::Pos ? PropKey::Pos
+                                : desc->attr == Attr::Size ? PropKey::Size
+                                : desc->attr == Attr::MinSize ? PropKey::MinSize : PropKey::MaxSize;
+                    Emit(key, v[0], v[1]);
+                    return true;
+                }
+                case Attr::Padding:
+                case Attr::Margin:
+                    if(!ParseSpacing(text, v)) return Fail(value.line, bad);
+                    Emit(desc->attr == Attr::Padding ? PropKey::Padding : PropKey::Margin, v[0], v[1], v[2], v[3]);
+                    return true;
+                case Attr::Cell: {
+                    int count = ParseInts(text, v, 4);
+                    if(count != 2 && count != 4) return Fail(value.line, bad);
+                    if(count == 2) v[2] = v[3] = 1;
+                    for(int i = 0; i < 2; i++) {
+                        if(v[i] < -1 || v[i] >= MaxGridLine || v[i + 2] < 1 || v[i + 2] > MaxGridLine) return Fail(value.line, bad);
+                    }
+                    Emit(PropKey::Cell, v[0], v[1], v[2], v[3]);
+                    return true;
+                }
+
+                case Attr::AutoWidth:
+                case Attr::AutoHeight:
+                    if(!ParseBool(text, v[0])) return Fail(value.line, bad);
+                    pending.autoSize[desc->attr == Attr::AutoWidth ? 0 : 1] = v[0];
+                    return true;
+                case Attr::Grow:
+                case Attr::Shrink:
+                    if(ParseFloats(text, f, 1) != 1 || f[0] < 0.0f) return Fail(value.line, bad);
+                    if(desc->attr == Attr::Grow) { pending.grow = f[0]; pending.flexMask |= 1; }
+                    else { pending.shrink = f[0]; pending.flexMask |= 2; }
+                    return true;
+                case Attr::Basis:
+                    if(ParseInts(text, v, 1) != 1) return Fail(value.line, bad);
+                    pending.basis = v[0];
+                    pending.flexMask |= 4;
+                    return true;
+
+                case Attr::Background:
+                case Attr::TextColor:
+                    if(!ParseColor(text, v[0])) return Fail(value.line, bad);
+                    Emit(desc->attr == Attr::Background ? PropKey::Background : PropKey::TextColor, v[0]);
+                    return true;
+
+                case Attr::Displayed:
+                case Attr::Visible:
+                case Attr::Enabled:
+                case Attr::Focusable:
+                case Attr::Clip:
+                case Attr::Checked:
+                case Attr::WordWrap: {
+                    if(!ParseBool(text, v[0])) return Fail(value.line, bad);
+                    PropKey key = desc->attr == Attr::Displayed ? PropKey::Displayed
+                                : desc->attr == Attr::Visible ? PropKey::Visible
+                                : desc->attr == Attr::Enabled ? PropKey::Enabled
+                                : desc->attr == Attr::Focusable ? PropKey::Focusable
+                                : desc->attr == Attr::Clip ? PropKey::Clip
+                                : desc->attr == Attr::Checked ? PropKey::Checked : PropKey::WordWrap;
+                    Emit(key, v[0]);
+                    return true;
+                }
+
+                case Attr::Layout:
+                    if(!ParseEnum(text, DirectionNames, pending.direction)) return Fail(value.line, bad);
+                    pending.hasLayout = true;
+                    return true;
+                case Attr::Gap:
+                case Attr::LineGap:
+                    if(ParseInts(text, v, 1) != 1) return Fail(value.line, bad);
+                    (desc->attr == Attr::Gap ? pending.gap : pending.lineGap) = v[0];
+                    break;
+                case Attr::Align:
+                    if(!ParseEnum(text, AlignNames, pending.align)) return Fail(value.line, bad);
+                    break;
+                case Attr::Justify:
+                    if(!ParseEnum(text, JustifyNames, pending.justify)) return Fail(value.line, bad);
+                    break;
+                case Attr::Wrap:
+                    if(!ParseEnum(text, WrapNames, pending.wrap)) return Fail(value.line, bad);
+                    break;
+
+                case Attr::Value:
+                    if(ParseFloats(text, f, 1) != 1) return Fail(value.line, bad);
+                    pending.hasValue = true;
+                    pending.value = f[0];
+                    return true;
+                case Attr::Range: {
+                    int count = ParseFloats(text, f, 3);
+                    if(count < 2 || f[1] < f[0]) return Fail(value.line, bad);
+                    if(count == 2) f[2] = 0.0f;
+                    Emit(PropKey::Range, FloatBits(f[0]), FloatBits(f[1]), FloatBits(f[2]));
+                    return true;
+                }
+            }
+
+            // Layout options - only valid together with layout=
+            if(!pending.layoutLine) pending.layoutLine = name.line;
+            return true;
+        }
+
+        bool EmitPending(const PendingNode& pending) {
+            if(pending.autoSize[0] >= 0 || pending.autoSize[1] >= 0) {
+                Emit(PropKey::AutoSize, pending.autoSize[0], pending.autoSize[1]);
+            }
+            if(pending.flexMask) {
+                Emit(PropKey::Flex, FloatBits(pending.grow), FloatBits(pending.shrink), pending.basis, pending.flexMask);
+            }
+            if(pending.layoutLine && !pending.hasLayout) {
+                return Fail(pending.layoutLine, "layout options need layout=row|column");
+            }
+            if(pending.hasLayout) {
+                Emit(PropKey::Layout, pending.direction, pending.gap,
+                     pending.align | (pending.justify << 8) | (pending.wrap << 16), pending.lineGap);
+            }
+            if(pending.hasValue) {
+                Emit(PropKey::Value, FloatBits(pending.value));
+            }
+            return true;
+        }
+    };
+
+    template<typename T>
+    void Append(std::vector<uint8_t>& out, const T* data, size_t count) {
+        size_t bytes = sizeof(T) * count;
+        if(bytes == 0) return;
+        size_t at = out.size();
+        out.resize(at + bytes);
+        std::memcpy(out.data() + at, data, bytes);
+    }
+}
+
+bool UiCompiler::Compile(const std::string& source, std::vector<uint8_t>& blob) {
+    error.clear();
+
+    std::vector<Token> tokens;
+    if(!Tokenize(source, tokens, error)) return false;
+    tokens.push_back(tokens.back()); // Lookahead of two never runs past the end
+
+    Builder builder(tokens);
+    size_t root;
+    if(!builder.ParseNode(0, root)) {
+        error = builder.error;
+        return false;
+    }
+    if(tokens[builder.pos].kind != TokenKind::End) {
+        error = "line " + std::to_string(tokens[builder.pos].line) + ": only one root widget allowed";
+        return false;
+    }
+
+    Header header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.nodeCount = static_cast<uint32_t>(builder.nodes.size());
+    header.propCount = static_cast<uint32_t>(builder.props.size());
+    header.stringUnits = static_cast<uint32_t>(builder.strings.size());
+
+    std::vector<uint8_t> out;
+    out.reserve(sizeof(Header) + sizeof(NodeRecord) * builder.nodes.size()
+              + sizeof(PropRecord) * builder.props.size() + sizeof(uint16_t) * builder.strings.size());
+    Append(out, &header, 1);
+    Append(out, builder.nodes.data(), builder.nodes.size());
+    Append(out, builder.props.data(), builder.props.size());
+    Append(out, builder.strings.data(), builder.strings.size());
+
+    blob = std::move(out);
+    return true;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Compiles the declarative UI description into the flat binary form read by UiLoader (see UiFormat.h)
+// Compile once at build/edit time, ship or cache the blob; loading it needs no parsing at all
+//
+// Syntax: one root node; a node is a widget type, attributes and an optional { child block }
+//     // Comments run to the end of the line
+//     Container id=settings layout=column gap=4 padding=8 size=300,0 autoHeight=true {
+//         Label text="Volume" textColor=#FFC8C8C8
+//         Slider id=volume range=0,100,1 value=50 size=200,20
+//         Container layout=row justify=end grow=1 {
+//             Button id=ok text="OK" size=80,24 class=Button
+//         }
+//     }
+//
+// Types: Container, Label, Button, Checkbox, Slider, TextInput
+// Any widget:
+//     id=name                  Unique per description (UiInstance::Find); letters, digits, _ - .
+//     pos=x,y  size=w,h
+//     padding=all | horizontal,vertical | top,bottom,left,right (same for margin)
+//     autoWidth=bool  autoHeight=bool
+//     grow=float  shrink=float  basis=int      Flex factors
+//     minSize=w,h  maxSize=w,h
+//     cell=row,column[,rowSpan,columnSpan]     GridLayout placement (row/column -1 = auto, all below 256)
+//     class=Name                               Style class (must be defined when loading)
+//     background=#RRGGBB|#AARRGGBB  textColor=#RRGGBB|#AARRGGBB
+//     displayed=bool  visible=bool  enabled=bool  focusable=bool
+// Container:
+//     layout=row|column  gap=int  lineGap=int  wrap=nowrap|wrap|reverse
+//     align=start|center|end|stretch|baseline  justify=start|center|end|between|around|evenly
+//     clip=bool
+// Label: text="..." wordWrap=bool    Button, TextInput: text="..."
+// Checkbox: text="..." checked=bool  Slider: text="..." value=float range=min,max[,step] (default 0,1)
+class UiCompiler {
+    public:
+        // False on syntax errors, unknown types/attributes, bad values or duplicate ids (blob is left untouched)
+        bool Compile(const std::string& source /*UTF-8*/, std::vector<uint8_t>& blob);
+        const std::string& GetError() const { return error; } // "line N: message"
+
+    private:
+        std::string error;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+// Compiled UI description - flat little-endian records, read in place (e.g. straight from a mapped file)
+//     Header
+//     NodeRecord[nodeCount]    pre-order: every node is followed by its childCount children (and their subtrees)
+//     PropRecord[propCount]    grouped per node (NodeRecord::firstProp)
+//     uint16_t[stringUnits]    UTF-16 string pool (ids, texts, style class names)
+// All records are 4-byte aligned, so the sections need no padding
+namespace UiFormat {
+    const uint8_t Magic[4] = {'G', 'D', 'K', 'U'};
+    const uint16_t Version = 1;
+
+    // Grid cells are bounded, so a blob can't make a GridLayout allocate an arbitrarily large cell map
+    const int MaxGridLine = 256; // row/column in [-1 (auto), MaxGridLine), spans in [1, MaxGridLine]
+
+    // Using uint8_t instead of int for optimization
+    enum class NodeType : uint8_t {
+        Container,
+        Label,
+        Button,
+        Checkbox,
+        Slider,
+        TextInput,
+        Count
+    };
+
+    // Using uint8_t instead of int for optimization
+    enum class PropKey : uint8_t {
+        // Any widget
+        Id,             // string
+        Pos,            // x, y
+        Size,           // width, height
+        Padding,        // top, bottom, left, right
+        Margin,         // top, bottom, left, right
+        AutoSize,       // width (0/1), height (0/1)
+        Flex,           // grow (float bits), shrink (float bits), basis
+        MinSize,        // width, height
+        MaxSize,        // width, height
+        Cell,           // row, column, rowSpan, columnSpan (bounded by MaxGridLine)
+        StyleClass,     // string (class name, resolved when loading)
+        Background,     // ARGB
+        TextColor,      // ARGB
+        Displayed,      // 0/1
+        Visible,        // 0/1
+        Enabled,        // 0/1
+        Focusable,      // 0/1
+        // Container
+        Clip,           // 0/1
+        Layout,         // FlexDirection, spacing, align | justify << 8 | wrap << 16, line spacing
+        // Widget specific
+        Text,           // string
+        Checked,        // 0/1
+        Value,          // float bits
+        Range,          // min, max, step (float bits)
+        WordWrap,       // 0/1
+        Count
+    };
+
+    struct Header {
+        uint8_t magic[4];
+        uint16_t version;
+        uint16_t reserved;
+        uint32_t nodeCount;
+        uint32_t propCount;
+        uint32_t stringUnits;
+    };
+
+    struct NodeRecord {
+        NodeType type;
+        uint8_t reserved;
+        uint16_t propCount;
+        uint32_t childCount;
+        uint32_t firstProp;
+    };
+
+    struct PropRecord {
+        PropKey key;
+        uint8_t reserved[3];
+        int32_t v[4];   // Strings: pool offset, length (in UTF-16 units)
+    };
+
+    static_assert(sizeof(Header) == 20 && sizeof(NodeRecord) == 12 && sizeof(PropRecord) == 20, "Packed record layout");
+}
@@ -0,0 +1,279 @@
+#include <vector>
+#include <cstring>
+
+#include "UiLoader.h"
+#include "UiFormat.h"
+#include "MappedFile.h"
+#include "LayoutBatch.h"
+#include "Container.h"
+#include "FlexLayout.h"
+#include "Label.h"
+#include "Button.h"
+#include "Checkbox.h"
+#include "Slider.h"
+#include "TextInput.h"
+
+using namespace UiFormat;
+
+namespace {
+    // Records are copied out (the blob may be any buffer - no alignment or aliasing assumptions)
+    template<typename T>
+    T ReadRecord(const uint8_t* p) {
+        T record;
+        std::memcpy(&record, p, sizeof(T));
+        return record;
+    }
+
+    float FloatFromBits(int32_t bits) {
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f;
+    }
+
+    Color ColorFromARGB(int32_t v) {
+        uint32_t argb = static_cast<uint32_t>(v);
+        return Color::FromARGB(BYTE(argb >> 24), BYTE(argb >> 16), BYTE(argb >> 8), BYTE(argb));
+    }
+
+    std::shared_ptr<Widget> CreateWidget(NodeType type) {
+        switch(type) {
+            case NodeType::Container:   return std::make_shared<Container>();
+            case NodeType::Label:       return std::make_shared<Label>();
+            case NodeType::Button:      return std::make_shared<Button>(L"");
+            case NodeType::Checkbox:    return std::make_shared<Checkbox>();
+            case NodeType::Slider:      return std::make_shared<Slider>(L"", 0.0f, 1.0f, 0.0f, 0.0f); // Range/value from the props
+            case NodeType::TextInput:   return std::make_shared<TextInput>();
+            default:                    return nullptr;
+        }
+    }
+
+    // Sections of a validated blob
+    struct Blob {
+        const uint8_t* nodes;
+        const uint8_t* props;
+        const uint8_t* strings;
+        uint32_t nodeCount;
+        uint32_t propCount;
+        uint32_t stringUnits;
+
+        bool ReadString(const PropRecord& p, std::wstring& out) const {
+            if(p.v[0] < 0 || p.v[1] < 0 || uint64_t(p.v[0]) + uint64_t(p.v[1]) > stringUnits) return false;
+
+            out.resize(p.v[1]);
+            const uint8_t* src = strings + sizeof(uint16_t) * p.v[0];
+            for(int32_t i = 0; i < p.v[1]; i++) {
+                uint16_t unit;
+                std::memcpy(&unit, src + sizeof(uint16_t) * i, sizeof(unit));
+                out[i] = static_cast<wchar_t>(unit);
+            }
+            return true;
+        }
+    };
+
+    struct Frame {
+        Container* container;
+        uint32_t remaining; // Children still to come
+    };
+
+    // Applies one record; false if it's malformed or doesn't fit the widget type
+    bool ApplyProp(const std::shared_ptr<Widget>& widget, NodeType type, const PropRecord& p, const Blob& blob,
+                   UiInstance& out, std::unordered_map<int32_t, StyleClassID>& classes, std::string& error) {
+        Widget& w = *widget;
+        const int32_t* v = p.v;
+        std::wstring text;
+        switch(p.key) {
+            case PropKey::Id: {
+                if(!blob.ReadString(p, text)) return false;
+                std::string id(text.begin(), text.end()); // ASCII (UiCompiler)
+                w.SetId(id); // Also findable through the Root's index once attached
+                out.ids[id] = widget;
+                return true;
+            }
+            case PropKey::Pos:          w.SetPos(v[0], v[1]); return true;
+            case PropKey::Size:         w.SetSize(v[0], v[1]); return true;
+            case PropKey::Padding:      w.SetPadding(v[0], v[1], v[2], v[3]); return true;
+            case PropKey::Margin:       w.SetMargin(v[0], v[1], v[2], v[3]); return true;
+            case PropKey::AutoSize:
+                if(v[0] >= 0) w.SetAutoWidth(v[0] != 0);
+                if(v[1] >= 0) w.SetAutoHeight(v[1] != 0);
+                return true;
+            case PropKey::Flex:
+                if(v[3] & 1) w.SetFlexGrowFactor(FloatFromBits(v[0]));
+                if(v[3] & 2) w.SetFlexShrink(FloatFromBits(v[1]));
+                if(v[3] & 4) w.SetFlexBasis(v[2]);
+                return true;
+            case PropKey::MinSize:      w.SetMinSize(v[0], v[1]); return true;
+            case PropKey::MaxSize:      w.SetMaxSize(v[0], v[1]); return true;
+            case PropKey::Cell:
+                for(int i = 0; i < 2; i++) {
+                    if(v[i] < -1 || v[i] >= MaxGridLine || v[i + 2] < 1 || v[i + 2] > MaxGridLine) return false;
+                }
+                w.SetGridCell(v[0], v[1], v[2], v[3]);
+                return true;
+            case PropKey::StyleClass: {
+                // Resolved once per distinct name (pool offset) and load
+                auto it = classes.find(v[0]);
+                if(it == classes.end()) {
+                    if(!blob.ReadString(p, text)) return false;
+                    std::string name(text.begin(), text.end());
+                    StyleClassID id = StyleRegistry::Get().FindClass(name);
+                    if(id == NoStyleClass) {
+                        error = "undefined style class '" + name + "'";
+                        return false;
+                    }
+                    it = classes.emplace(v[0], id).first;
+                }
+                w.SetStyleClass(it->second);
+                return true;
+            }
+            case PropKey::Background:   w.SetBackgroundColor(ColorFromARGB(v[0])); return true;
+            case PropKey::TextColor:    return w.ApplyProperty(PropertyID::TextColor, ColorFromARGB(v[0]));
+            case PropKey::Displayed:    w.SetDisplayed(v[0] != 0); return true;
+            case PropKey::Visible:      w.SetVisible(v[0] != 0); return true;
+            case PropKey::Enabled:      w.SetEnabled(v[0] != 0); return true;
+            case PropKey::Focusable:    w.SetFocusable(v[0] != 0); return true;
+
+            case PropKey::Clip:
+                if(type != NodeType::Container) return false;
+                w.SetChildrenClipping(v[0] != 0);
+                return true;
+            case PropKey::Layout: {
+                if(type != NodeType::Container) return false;
+                if(v[0] < 0 || v[0] > static_cast<int32_t>(FlexDirection::Column)) return false;
+
+                int align = v[2] & 0xFF, justify = (v[2] >> 8) & 0xFF, wrap = (v[2] >> 16) & 0xFF;
+                if(align > static_cast<int>(AlignItems::Baseline)) return false;
+                if(justify > static_cast<int>(JustifyContent::SpaceEvenly)) return false;
+                if(wrap > static_cast<int>(FlexWrap::WrapReverse) || (v[2] >> 24) != 0) return false;
+
+                auto layout = std::make_unique<FlexLayout>(static_cast<FlexDirection>(v[0]), v[1]);
+                layout->SetAlign(static_cast<AlignItems>(align));
+                layout->SetJustify(static_cast<JustifyContent>(justify));
+                layout->SetWrap(static_cast<FlexWrap>(wrap));
+                layout->SetLineSpacing(v[3]);
+                static_cast<Container&>(w).SetLayout(std::move(layout));
+                return true;
+            }
+
+            case PropKey::Text:
+                if(!blob.ReadString(p, text)) return false;
+                return w.ApplyProperty(PropertyID::Text, std::move(text));
+            case PropKey::Checked:
+                return w.ApplyProperty(PropertyID::Checked, v[0] != 0);
+            case PropKey::Value:
+                return w.ApplyProperty(PropertyID::Value, FloatFromBits(v[0]));
+            case PropKey::Range: {
+                if(type != NodeType::Slider) return false;
+                auto& slider = static_cast<Slider&>(w);
+                slider.SetMinValue(FloatFromBits(v[0]));
+                slider.SetMaxValue(FloatFromBits(v[1]));
+                slider.SetStep(FloatFromBits(v[2]));
+                return true;
+            }
+            case PropKey::WordWrap:
+                if(type != NodeType::Label) return false;
+                static_cast<Label&>(w).SetWordWrap(v[0] != 0);
+                return true;
+
+            default:
+                return false;
+        }
+    }
+}
+
+bool UiLoader::Load(const uint8_t* data, size_t size, UiInstance& out) {
+    out = UiInstance{};
+    error.clear();
+
+    // --- Header & sections ---
+    if(!data || size < sizeof(Header)) { error = "truncated blob"; return false; }
+    Header header = ReadRecord<Header>(data);
+    if(std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version) {
+        error = "not a compiled UI description (or another version)";
+        return false;
+    }
+
+    uint64_t nodesBytes = uint64_t(sizeof(NodeRecord)) * header.nodeCount;
+    uint64_t propsBytes = uint64_t(sizeof(PropRecord)) * header.propCount;
+    uint64_t stringBytes = uint64_t(sizeof(uint16_t)) * header.stringUnits;
+    if(header.nodeCount == 0 || sizeof(Header) + nodesBytes + propsBytes + stringBytes > size) {
+        error = "truncated blob";
+        return false;
+    }
+
+    Blob blob;
+    blob.nodes = data + sizeof(Header);
+    blob.props = blob.nodes + nodesBytes;
+    blob.strings = blob.props + propsBytes;
+    blob.nodeCount = header.nodeCount;
+    blob.propCount = header.propCount;
+    blob.stringUnits = header.stringUnits;
+
+    // --- Single pass: create, configure and attach in pre-order ---
+    UiInstance result;
+    std::unordered_map<int32_t, StyleClassID> classes;
+    std::vector<Frame> stack;
+    {
+        LayoutBatch::ScopedDefer defer;
+
+        for(uint32_t i = 0; i < blob.nodeCount; i++) {
+            NodeRecord node = ReadRecord<NodeRecord>(blob.nodes + sizeof(NodeRecord) * i);
+            bool valid = node.type < NodeType::Count
+                      && uint64_t(node.firstProp) + node.propCount <= blob.propCount
+                      && node.childCount <= blob.nodeCount - i - 1
+                      && (node.childCount == 0 || node.type == NodeType::Container)
+                      && (i == 0 || !stack.empty()); // Exactly one root
+            if(!valid) {
+                error = "malformed node " + std::to_string(i);
+                return false;
+            }
+
+            std::shared_ptr<Widget> widget = CreateWidget(node.type);
+            for(uint32_t k = 0; k < node.propCount; k++) {
+                PropRecord p = ReadRecord<PropRecord>(blob.props + sizeof(PropRecord) * (node.firstProp + k));
+                if(!ApplyProp(widget, node.type, p, blob, result, classes, error)) {
+                    if(error.empty()) error = "malformed property of node " + std::to_string(i);
+                    return false;
+                }
+            }
+
+            // Attach - relayouts are deferred, so this is just the child vector push
+            if(stack.empty()) {
+                result.root = widget;
+            }
+            else {
+                stack.back().container->AddChild(widget);
+                stack.back().remaining--;
+            }
+
+            if(node.childCount > 0) {
+                auto* container = static_cast<Container*>(widget.get());
+                container->ReserveChildren(node.childCount);
+                stack.push_back({container, node.childCount});
+            }
+            while(!stack.empty() && stack.back().remaining == 0) {
+                stack.pop_back();
+            }
+        }
+    }
+    if(!stack.empty()) {
+        error = "missing child nodes";
+        return false;
+    }
+
+    // The one layout pass
+    result.root->InvalidateLayout();
+
+    out = std::move(result);
+    return true;
+}
+
+bool UiLoader::LoadFile(const std::wstring& path, UiInstance& out) {
+    MappedFile file;
+    if(!file.Open(path)) {
+        out = UiInstance{};
+        error = "can't open file";
+        return false;
+    }
+    return Load(file.Data(), file.Size(), out);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Widget.h"
+
+// Widgets instantiated from a compiled UI description
+struct UiInstance {
+    std::shared_ptr<Widget> root;
+    std::unordered_map<std::string, std::shared_ptr<Widget>> ids; // Widgets that were given an id
+
+    // nullptr if there's no such id or the widget isn't a T
+    template<typename T = Widget>
+    std::shared_ptr<T> Find(const std::string& id) const {
+        auto it = ids.find(id);
+        return it != ids.end() ? std::dynamic_pointer_cast<T>(it->second) : nullptr;
+    }
+};
+
+// Instantiates compiled UI descriptions (UiCompiler) in a single pass over the records:
+// widgets are created in pre-order, child vectors are sized up front and relayouts are deferred,
+// so the whole tree is laid out once at the end
+class UiLoader {
+    public:
+        // False if the blob is malformed or names an undefined style class (out is left empty)
+        // The blob is only read during the call - strings are copied into the widgets
+        bool Load(const uint8_t* data, size_t size, UiInstance& out);
+        bool LoadFile(const std::wstring& path, UiInstance& out); // Memory-mapped, no read copy
+
+        const std::string& GetError() const { return error; }
+
+    private:
+        std::string error;
+};
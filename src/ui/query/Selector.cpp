@@ -0,0 +1,302 @@
+#include <cctype>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Selector.h"
+#include "Root.h"
+#include "Label.h"
+#include "Button.h"
+#include "Checkbox.h"
+#include "Slider.h"
+#include "TextInput.h"
+#include "Select.h"
+#include "SelectItem.h"
+#include "Menu.h"
+#include "Plot.h"
+
+namespace {
+    using Matchers = std::unordered_map<std::string, bool(*)(const Widget&)>;
+
+    template<typename T>
+    bool IsA(const Widget& w) { return dynamic_cast<const T*>(&w) != nullptr; }
+
+    Matchers& TypeMatchers() {
+        static Matchers matchers = {
+            {"Widget",      [](const Widget&) { return true; }},
+            {"Container",   IsA<Container>},
+            {"Root",        IsA<Root>},
+            {"Label",       IsA<Label>},
+            {"Button",      IsA<Button>},
+            {"Checkbox",    IsA<Checkbox>},
+            {"Slider",      IsA<Slider>},
+            {"TextInput",   IsA<TextInput>},
+            {"Select",      IsA<Select>},
+            {"SelectItem",  IsA<SelectItem>},
+            {"Menu",        IsA<Menu>},
+            {"Plot",        IsA<Plot>}
+        };
+        return matchers;
+    }
+
+    bool IsNameChar(char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-';
+    }
+}
+
+// --- Types -----------------------------------------------------------
+void Selector::RegisterMatcher(const std::string& name, TypeMatcher matcher) {
+    TypeMatchers()[name] = matcher;
+}
+
+Selector::TypeMatcher Selector::FindMatcher(const std::string& name) {
+    auto it = TypeMatchers().find(name);
+    return it != TypeMatchers().end() ? it->second : nullptr;
+}
+
+// --- Parsing ---------------------------------------------------------
+bool Selector::Fail(size_t pos, const std::string& message) {
+    error = "column " + std::to_string(pos + 1) + ": " + message;
+    compounds.clear();
+    valid = false;
+    return false;
+}
+
+bool Selector::Parse(const std::string& text) {
+    compounds.clear();
+    error.clear();
+    valid = false;
+
+    size_t pos = 0;
+    while(pos < text.size()) {
+        if(std::isspace(static_cast<unsigned char>(text[pos]))) {
+            pos++;
+            continue;
+        }
+
+        // One compound: [type | *] (#id | .tag)*
+        Compound compound;
+        bool any = false;
+        if(text[pos] == '*') {
+            pos++;
+            any = true;
+        }
+        else if(std::isalpha(static_cast<unsigned char>(text[pos])) || text[pos] == '_') {
+            size_t start = pos;
+            while(pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '_')) pos++;
+            std::string type = text.substr(start, pos - start);
+            compound.type = FindMatcher(type);
+            if(!compound.type) return Fail(start, "unknown widget type '" + type + "'");
+            if(type == "Widget") compound.type = nullptr; // Matches everything - skip the call
+            any = true;
+        }
+
+        while(pos < text.size() && (text[pos] == '#' || text[pos] == '.')) {
+            char kind = text[pos++];
+            size_t start = pos;
+            while(pos < text.size() && IsNameChar(text[pos])) pos++;
+            if(pos == start) return Fail(start, std::string("expected a name after '") + kind + "'");
+
+            // Interned, not looked up - widgets may get the name after the selector is compiled
+            WidgetName name = WidgetNames::Get().Intern(text.substr(start, pos - start));
+            if(kind == '#') {
+                if(compound.id != NoWidgetName && compound.id != name) return Fail(start - 1, "two different ids");
+                compound.id = name;
+            }
+            else if(std::find(compound.tags.begin(), compound.tags.end(), name) == compound.tags.end()) {
+                compound.tags.push_back(name);
+            }
+            any = true;
+        }
+
+        if(!any) return Fail(pos, "unexpected '" + std::string(1, text[pos]) + "'");
+        if(pos < text.size() && !std::isspace(static_cast<unsigned char>(text[pos]))) {
+            return Fail(pos, "unexpected '" + std::string(1, text[pos]) + "'");
+        }
+        compounds.push_back(std::move(compound));
+    }
+
+    if(compounds.empty()) return Fail(0, "empty selector");
+    valid = true;
+    return true;
+}
+
+// --- Matching --------------------------------------------------------
+bool Selector::MatchesCompound(const Widget& w, const Compound& c) {
+    if(c.id != NoWidgetName && w.stringId != c.id) return false;
+    for(WidgetName tag : c.tags) {
+        if(!w.HasTag(tag)) return false;
+    }
+    return !c.type || c.type(w);
+}
+
+bool Selector::MatchesAncestors(const Widget& w, size_t compound) const {
+    // Descendant combinators only - taking the nearest matching ancestor for each compound is never wrong
+    const Widget* ancestor = w.parent;
+    for(size_t i = compound; i-- > 0;) {
+        while(ancestor && !MatchesCompound(*ancestor, compounds[i])) ancestor = ancestor->parent;
+        if(!ancestor) return false;
+        ancestor = ancestor->parent;
+    }
+    return true;
+}
+
+bool Selector::Matches(const Widget& w) const {
+    return valid && MatchesCompound(w, compounds.back()) && MatchesAncestors(w, compounds.size() - 1);
+}
+
+// --- Queries ---------------------------------------------------------
+void Selector::IndexCandidates(const WidgetIndex& index, const Compound& c, std::vector<Widget*>& out) {
+    if(c.id != NoWidgetName) {
+        if(Widget* w = index.FindByName(c.id)) out.push_back(w);
+        return;
+    }
+
+    // The rarest tag
+    const std::vector<Widget*>* best = nullptr;
+    for(WidgetName tag : c.tags) {
+        const auto& list = index.GetTagged(tag);
+        if(!best || list.size() < best->size()) best = &list;
+    }
+    if(best) out.insert(out.end(), best->begin(), best->end());
+}
+
+void Selector::WalkDescendants(Widget& top, bool withOverlays, const Compound& c, std::vector<Widget*>& out) {
+    std::vector<Widget*> stack;
+    auto pushChildren = [&stack](Widget& w) {
+        if(auto* container = dynamic_cast<Container*>(&w)) {
+            const auto& children = container->Children();
+            for(size_t i = children.size(); i-- > 0;) {
+                if(children[i]) stack.push_back(children[i].get());
+            }
+        }
+    };
+
+    pushChildren(top);
+    if(withOverlays) {
+        if(auto* root = dynamic_cast<Root*>(&top)) {
+            for(size_t i = 0; i < root->GetOverlayCount(); i++) stack.push_back(root->GetOverlay(i));
+        }
+    }
+
+    while(!stack.empty()) {
+        Widget* w = stack.back();
+        stack.pop_back();
+        if(MatchesCompound(*w, c)) out.push_back(w);
+        pushChildren(*w);
+    }
+}
+
+void Selector::Select(Widget& scope, std::vector<Widget*>& out) const {
+    if(!valid) return;
+
+    auto isBelow = [](const Widget& w, const Widget& top) {
+        for(const Widget* p = w.parent; p; p = p->parent) {
+            if(p == &top) return true;
+        }
+        return false;
+    };
+
+    const size_t last = compounds.size() - 1;
+    Root* root = scope.GetRoot();
+    std::vector<Widget*> matches;
+
+    // Nearest compound (from the right) that can be looked up in the index
+    size_t anchor = compounds.size();
+    if(root) {
+        for(size_t i = compounds.size(); i-- > 0;) {
+            if(compounds[i].IsIndexed()) {
+                anchor = i;
+                break;
+            }
+        }
+    }
+
+    if(anchor == last) {
+        // Candidates straight from the index - no walking
+        std::vector<Widget*> candidates;
+        IndexCandidates(root->GetWidgetIndex(), compounds[last], candidates);
+        for(Widget* w : candidates) {
+            if(isBelow(*w, scope) && MatchesCompound(*w, compounds[last]) && MatchesAncestors(*w, last)) {
+                matches.push_back(w);
+            }
+        }
+    }
+    else if(anchor < last) {
+        // Walk only below the anchors (each subtree once - nested anchors are covered by the outer one)
+        std::vector<Widget*> anchors;
+        IndexCandidates(root->GetWidgetIndex(), compounds[anchor], anchors);
+
+        std::unordered_set<const Widget*> tops;
+        bool walkScope = false;
+        for(Widget* a : anchors) {
+            if(!MatchesCompound(*a, compounds[anchor]) || !MatchesAncestors(*a, anchor)) continue;
+            if(a == &scope || isBelow(scope, *a)) {
+                walkScope = true; // The anchor contains the whole scope
+                break;
+            }
+            if(isBelow(*a, scope)) tops.insert(a);
+        }
+
+        std::vector<Widget*> found;
+        if(walkScope) {
+            WalkDescendants(scope, true, compounds[last], found);
+        }
+        else {
+            for(const Widget* top : tops) {
+                bool nested = false;
+                for(const Widget* p = top->parent; p && p != &scope; p = p->parent) {
+                    if(tops.count(p)) {
+                        nested = true;
+                        break;
+                    }
+                }
+                if(!nested) WalkDescendants(const_cast<Widget&>(*top), false, compounds[last], found);
+            }
+        }
+        for(Widget* w : found) {
+            if(MatchesAncestors(*w, last)) matches.push_back(w);
+        }
+    }
+    else {
+        // Nothing indexed (or scope outside of a Root) - walk the whole scope
+        WalkDescendants(scope, true, compounds[last], matches);
+        matches.erase(std::remove_if(matches.begin(), matches.end(), [&](Widget* w) {
+            return !MatchesAncestors(*w, last);
+        }), matches.end());
+    }
+
+    out.insert(out.end(), matches.begin(), matches.end());
+}
+
+std::vector<Widget*> Selector::Select(Widget& scope) const {
+    std::vector<Widget*> out;
+    Select(scope, out);
+    return out;
+}
+
+Widget* Selector::SelectFirst(Widget& scope) const {
+    std::vector<Widget*> out;
+    Select(scope, out);
+    return out.empty() ? nullptr : out.front();
+}
+
+// --- Bulk operations -------------------------------------------------
+size_t Selector::ForEach(Widget& scope, InlineFunction<void(Widget&)> fn) const {
+    std::vector<Widget*> matches;
+    Select(scope, matches);
+    for(Widget* w : matches) fn(*w);
+    return matches.size();
+}
+
+size_t Selector::SetEnabled(Widget& scope, bool enabled) const {
+    return ForEach(scope, [enabled](Widget& w) { w.SetEnabled(enabled); });
+}
+
+size_t Selector::SetVisible(Widget& scope, bool visible) const {
+    return ForEach(scope, [visible](Widget& w) { w.SetVisible(visible); });
+}
+
+size_t Selector::SetDisplayed(Widget& scope, bool displayed) const {
+    return ForEach(scope, [displayed](Widget& w) { w.SetDisplayed(displayed); });
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Widget.h"
+#include "InlineFunction.h"
+
+// Compiled widget selector - type, string id and tags, with descendant combinators:
+//   Button                     type (is-a - "Container" matches Roots and Menus as well; "*" = any)
+//   #ok                        string id (Widget::SetId)
+//   .admin                     tag (Widget::AddTag)
+//   Button.admin.danger        all of them on one widget
+//   #settings .admin Label     descendant at any depth
+// Queries are answered from the Root's WidgetIndex: if the last compound names an id or tag, only those
+// candidates (and their ancestor chains) are checked; otherwise only the subtrees of the widgets matched by
+// the nearest compound naming an id or tag are walked. Only selectors without any id/tag walk the whole scope.
+class Selector {
+    public:
+        Selector() = default;
+        explicit Selector(const std::string& text) { Parse(text); }
+
+        bool Parse(const std::string& text); // False on syntax errors/unknown types (nothing matches then)
+        bool IsValid() const { return valid; }
+        const std::string& GetError() const { return error; }
+
+        // Types usable in selectors (built-in widgets are registered); UI thread
+        template<typename T>
+        static void RegisterType(const std::string& name) {
+            RegisterMatcher(name, [](const Widget& w) { return dynamic_cast<const T*>(&w) != nullptr; });
+        }
+
+        // Matching descendants of scope (overlays too, if scope is a Root), in no particular order
+        void Select(Widget& scope, std::vector<Widget*>& out) const;
+        std::vector<Widget*> Select(Widget& scope) const;
+        Widget* SelectFirst(Widget& scope) const;   // Any match (nullptr if none)
+        bool Matches(const Widget& w) const;        // Ancestor compounds may match up to the tree top
+
+        // Bulk operations - matches are collected first, then visited; return the number of matches
+        // The callback must not remove matched widgets from the tree (other than the one it's called for)
+        size_t ForEach(Widget& scope, InlineFunction<void(Widget&)> fn) const;
+        size_t SetEnabled(Widget& scope, bool enabled) const;
+        size_t SetVisible(Widget& scope, bool visible) const;
+        size_t SetDisplayed(Widget& scope, bool displayed) const;
+
+    private:
+        using TypeMatcher = bool(*)(const Widget&);
+
+        struct Compound {
+            TypeMatcher type = nullptr;     // nullptr = any type
+            WidgetName id = NoWidgetName;
+            std::vector<WidgetName> tags;
+
+            bool IsIndexed() const { return id != NoWidgetName || !tags.empty(); }
+        };
+        std::vector<Compound> compounds;    // Left to right (outermost ancestor first)
+        bool valid = false;
+        std::string error;
+
+        static void RegisterMatcher(const std::string& name, TypeMatcher matcher);
+        static TypeMatcher FindMatcher(const std::string& name);
+
+        bool Fail(size_t pos, const std::string& message);
+
+        static bool MatchesCompound(const Widget& w, const Compound& c);
+        bool MatchesAncestors(const Widget& w, size_t compound) const; // Compounds before `compound`, above w
+        static void IndexCandidates(const WidgetIndex& index, const Compound& c, std::vector<Widget*>& out);
+        static void WalkDescendants(Widget& top, bool withOverlays, const Compound& c, std::vector<Widget*>& out);
+};
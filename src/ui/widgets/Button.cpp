@@ -3,36 +3,66 @@
 
 #include "Color.h"
 #include "Border.h"
-#include "ScopedGDI.h"
 #include "Button.h"
+#include "TextMeasure.h"
 
 Button::Button(std::wstring t) :
     text(t)
 {
-    SetBorder(1, borderColor, BorderSide::All);
-    AddMouseListener([this](const MouseEvent& e) {
-        if(e.type == MouseEventType::Click) {
-            if(onClick) onClick();
-        }
+    static const StyleClassID buttonClass = StyleRegistry::Get().DefineClass("Button", DefaultStyle());
+    SetStyleClass(buttonClass);
+    styleBackground = true;
+}
+
+void Button::OnMouseEvent(const MouseEvent& e) {
+    if(e.type == MouseEventType::Click) {
+        if(onClick) onClick();
+    }
+}
+
+StyleDesc Button::DefaultStyle() {
+    StyleDesc d = StyleDesc::Uniform({
+        Color::FromARGB(200,30,30,30),  // background
+        Color::FromRGB(255,255,255),    // foreground
+        Color::FromRGB(0,0,0),          // border
+        Color::FromARGB(0,0,0,0)        // accent
     });
+    d[StyleState::Hover].background     = Color::FromARGB(220,50,50,50);
+    d[StyleState::Pressed].background   = Color::FromARGB(255,20,110,220);
+    d[StyleState::Disabled].background  = Color::FromRGB(120,120,120);
+    return d;
 }
 
-void Button::Render(HDC hdc) {
-    RECT innerRect = ComputeInnerRect();
+void Button::OnStyleChanged() {
+    SetBorder(1, style->Get(StyleState::Normal).border, BorderSide::All);
+    Widget::OnStyleChanged();
+}
 
-    // Background
-    Color bgColor;
-    if(!enabled) bgColor = Color::FromRGB(120,120,120);
-    else if(pressed) bgColor = pressColor;
-    else if(hovered) bgColor = hoverColor;
-    else bgColor = backColor;
-    SetBackgroundColor(bgColor);
+void Button::Render(Painter& painter) {
+    RECT innerRect = ComputeInnerRect();
 
     // Text
-    SetBkMode(hdc, TRANSPARENT);
-    ScopedSelectFont selFont(hdc, font ? font : (HFONT)GetStockObject(DEFAULT_GUI_FONT));
-    ::SetTextColor(hdc, textColor.toCOLORREF());
-    DrawTextW(hdc, text.c_str(), -1, &innerRect, DT_SINGLELINE | DT_VCENTER | DT_CENTER);
+    painter.DrawString(text.c_str(), -1, innerRect, DT_SINGLELINE | DT_VCENTER | DT_CENTER, StyleFont(), StateTextColor(CurrentStyleState()));
+}
+
+int Button::GetBaseline(int height) const {
+    int innerTop = border.top.thickness + padding.top;
+    int innerHeight = height - innerTop - padding.bottom - border.bottom.thickness;
+    return innerTop + TextMeasure::CenteredBaseline(StyleFont(), innerHeight);
+}
+
+bool Button::ApplyProperty(PropertyID property, const PropertyValue& value) {
+    switch(property) {
+        case PropertyID::Text:
+            if(auto* v = std::get_if<std::wstring>(&value)) { SetText(*v); return true; }
+            break;
+        case PropertyID::TextColor:
+            if(auto* v = std::get_if<Color>(&value)) { SetTextColor(*v); return true; }
+            break;
+        default:
+            break;
+    }
+    return Widget::ApplyProperty(property, value);
 }
 
 void Button::SetOnClick(std::function<void()> cb) {
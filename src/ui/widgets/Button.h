@@ -12,37 +12,48 @@ class Button : public Widget {
         Button(std::wstring t = L"Button");
 
         // Appearance
-        std::wstring GetText() const { return text; }
-        void SetText(std::wstring newText) { text = newText; }
-
-        HFONT GetFont() const { return font; }
-        void SetFont(HFONT newFont) { font = newFont; }
-
-        Color GetBackColor()    const { return backColor; }
-        Color GetHoverColor()   const { return hoverColor; }
-        Color GetPressColor()   const { return pressColor; }
-        Color GetBorderColor()  const { return borderColor; }
-        Color GetTextColor()    const { return textColor; }
-        void SetBackColor(Color newColor)   { backColor = newColor; }
-        void SetHoverColor(Color newColor)  { hoverColor = newColor; }
-        void SetPressColor(Color newColor)  { pressColor = newColor; }
-        void SetBorderColor(Color newColor) { borderColor = newColor; }
-        void SetTextColor(Color newColor)   { textColor = newColor; }
+        const std::wstring& GetText() const { return text; }
+        void SetText(std::wstring newText) {
+            if(newText == text) return;
+            text = std::move(newText);
+            InvalidatePaint();
+        }
+
+        // Colors are stored in the shared style ("Button" class by default)
+        // Setters give this button a private look, detaching it from theme changes (except the text color, kept per button)
+        HFONT GetFont() const { return style->GetFont(); }
+        void SetFont(HFONT newFont) { Restyle([&](StyleDesc& d) { d.font = newFont; }); }
+
+        Color GetBackColor()    const { return style->Get(StyleState::Normal).background; }
+        Color GetHoverColor()   const { return style->Get(StyleState::Hover).background; }
+        Color GetPressColor()   const { return style->Get(StyleState::Pressed).background; }
+        Color GetBorderColor()  const { return style->Get(StyleState::Normal).border; }
+        Color GetTextColor()    const { return StateTextColor(StyleState::Normal); }
+        void SetBackColor(Color newColor)   { Restyle([&](StyleDesc& d) { d[StyleState::Normal].background = newColor; }); }
+        void SetHoverColor(Color newColor)  { Restyle([&](StyleDesc& d) { d[StyleState::Hover].background = newColor; }); }
+        void SetPressColor(Color newColor)  { Restyle([&](StyleDesc& d) { d[StyleState::Pressed].background = newColor; }); }
+        void SetBorderColor(Color newColor) { Restyle([&](StyleDesc& d) { for(auto& s : d.states) s.border = newColor; }); }
+        void SetTextColor(Color newColor)   { SetTextColorOverride(newColor); }
+
+        // Default looks of the "Button" style class
+        static StyleDesc DefaultStyle();
+
+        // Generic properties
+        bool ApplyProperty(PropertyID property, const PropertyValue& value) override;
 
         // Rendering
-        void Render(HDC hdc) override;
+        void Render(Painter& painter) override;
+        int GetBaseline(int height) const override;
 
         // Behavior
         void SetOnClick(std::function<void()> cb);
 
+    protected:
+        void OnMouseEvent(const MouseEvent& e) override;
+        void OnStyleChanged() override;
+
     private:
         std::wstring text;
-        HFONT font = nullptr;
-        Color backColor     = Color::FromARGB(200,30,30,30);
-        Color hoverColor    = Color::FromARGB(220,50,50,50);
-        Color pressColor    = Color::FromARGB(255,20,110,220);
-        Color borderColor   = Color::FromRGB(0,0,0);
-        Color textColor     = Color::FromRGB(255,255,255);
 
         std::function<void()> onClick;
 };
\ No newline at end of file
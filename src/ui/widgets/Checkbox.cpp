@@ -1,47 +1,81 @@
 #include <string>
 
 #include "Checkbox.h"
-#include "ScopedGDI.h"
 #include "Color.h"
+#include "TextMeasure.h"
 
 Checkbox::Checkbox(std::wstring label) :
     text(label)
 {
-    AddMouseListener([this](const MouseEvent& e) {
-        if(e.type == MouseEventType::Click) {
-            SetChecked(!checked);
-        }
+    static const StyleClassID checkboxClass = StyleRegistry::Get().DefineClass("Checkbox", DefaultStyle());
+    SetStyleClass(checkboxClass);
+}
+
+void Checkbox::OnMouseEvent(const MouseEvent& e) {
+    if(e.type == MouseEventType::Click) {
+        SetChecked(!checked);
+    }
+}
+
+StyleDesc Checkbox::DefaultStyle() {
+    StyleDesc d = StyleDesc::Uniform({
+        Color::FromARGB(255, 50, 50, 50),   // background (box)
+        Color::FromRGB(255, 255, 255),      // foreground
+        Color::FromARGB(0, 0, 0, 0),        // border
+        Color::FromARGB(255, 20, 110, 220)  // accent (check mark)
     });
+    d[StyleState::Hover].background = Color::FromARGB(255, 80, 80, 80);
+    return d;
 }
 
 void Checkbox::SetChecked(bool state) {
     if(state == checked) return;
     checked = state;
+    InvalidatePaint();
     if(onToggle) onToggle(checked); // Fire user-provided callback
 }
 
-void Checkbox::Render(HDC hdc) {
+bool Checkbox::ApplyProperty(PropertyID property, const PropertyValue& value) {
+    switch(property) {
+        case PropertyID::Checked:
+            if(auto* v = std::get_if<bool>(&value)) { SetChecked(*v); return true; }
+            break;
+        case PropertyID::Text:
+            if(auto* v = std::get_if<std::wstring>(&value)) { SetText(*v); return true; }
+            break;
+        case PropertyID::TextColor:
+            if(auto* v = std::get_if<Color>(&value)) { SetTextColor(*v); return true; }
+            break;
+        default:
+            break;
+    }
+    return Widget::ApplyProperty(property, value);
+}
+
+void Checkbox::Render(Painter& painter) {
     RECT r = EffectiveRect();
     int boxSize = EffectiveHeight(); // square box same height as widget
 
+    const StyleColors& normal = style->Get(StyleState::Normal);
+
     // Draw box background
-    ScopedOwnedBrush br(hdc, hovered ? hoverColor.toCOLORREF() : boxColor.toCOLORREF());
     RECT checkboxRect = RECT{r.left, r.top, r.left + boxSize, r.top + boxSize};
-    FillRect(hdc, &checkboxRect, br.get());
+    painter.FillRect(checkboxRect, style->Get(hovered ? StyleState::Hover : StyleState::Normal).background);
 
     // Draw checkmark if checked
     if(checked) {
-        ScopedOwnedBrush checkBr(hdc, checkColor.toCOLORREF());
         RECT checkRect = {r.left + 4, r.top + 4, r.left + boxSize - 4, r.top + boxSize - 4};
-        FillRect(hdc, &checkRect, checkBr.get());
+        painter.FillRect(checkRect, normal.accent);
     }
 
     // Draw label text
-    SetBkMode(hdc, TRANSPARENT);
-    ::SetTextColor(hdc, textColor.toCOLORREF());
-    ScopedSelectFont selFont(hdc, font ? font : (HFONT)GetStockObject(DEFAULT_GUI_FONT));
     RECT textRect = { r.left + boxSize + 4, r.top, r.right, r.bottom };
-    DrawTextW(hdc, text.c_str(), -1, &textRect, DT_SINGLELINE | DT_VCENTER | DT_LEFT);
+    painter.DrawString(text.c_str(), -1, textRect, DT_SINGLELINE | DT_VCENTER | DT_LEFT, StyleFont(), StateTextColor(StyleState::Normal));
+}
+
+// Label text is centered over the full height (next to the box)
+int Checkbox::GetBaseline(int height) const {
+    return TextMeasure::CenteredBaseline(StyleFont(), height);
 }
 
 void Checkbox::SetOnToggle(std::function<void(bool)> cb) {
@@ -16,36 +16,47 @@ class Checkbox : public Widget {
         void SetChecked(bool state);
 
         // Appearance
-        std::wstring GetText() const { return text; }
-        void SetText(std::wstring newText) { text = newText; }
-
-        HFONT GetFont() const { return font; }
-        void SetFont(HFONT newFont) { font = newFont; }
-
-        Color GetBoxColor()     const { return boxColor; }
-        Color GetCheckColor()   const { return checkColor; }
-        Color GetHoverColor()   const { return hoverColor; }
-        Color GetTextColor()    const { return textColor; }
-        void SetBoxColor(Color newColor)    { boxColor = newColor; }
-        void SetCheckColor(Color newColor)  { checkColor = newColor; }
-        void SetHoverColor(Color newColor)  { hoverColor = newColor; }
-        void SetTextColor(Color newColor)   { textColor = newColor; }
+        const std::wstring& GetText() const { return text; }
+        void SetText(std::wstring newText) {
+            if(newText == text) return;
+            text = std::move(newText);
+            InvalidatePaint();
+        }
+
+        // Colors are stored in the shared style ("Checkbox" class by default)
+        // Box = background, check mark = accent (the text color is kept per checkbox, outside the style)
+        HFONT GetFont() const { return style->GetFont(); }
+        void SetFont(HFONT newFont) { Restyle([&](StyleDesc& d) { d.font = newFont; }); }
+
+        Color GetBoxColor()     const { return style->Get(StyleState::Normal).background; }
+        Color GetCheckColor()   const { return style->Get(StyleState::Normal).accent; }
+        Color GetHoverColor()   const { return style->Get(StyleState::Hover).background; }
+        Color GetTextColor()    const { return StateTextColor(StyleState::Normal); }
+        void SetBoxColor(Color newColor)    { Restyle([&](StyleDesc& d) { d[StyleState::Normal].background = newColor; }); }
+        void SetCheckColor(Color newColor)  { Restyle([&](StyleDesc& d) { for(auto& s : d.states) s.accent = newColor; }); }
+        void SetHoverColor(Color newColor)  { Restyle([&](StyleDesc& d) { d[StyleState::Hover].background = newColor; }); }
+        void SetTextColor(Color newColor)   { SetTextColorOverride(newColor); }
+
+        // Default looks of the "Checkbox" style class
+        static StyleDesc DefaultStyle();
+
+        // Generic properties
+        bool ApplyProperty(PropertyID property, const PropertyValue& value) override;
 
         // Rendering
-        void Render(HDC hdc) override;
+        void Render(Painter& painter) override;
+        int GetBaseline(int height) const override;
 
         // Behavior
         void SetOnToggle(std::function<void(bool)> cb);
 
+    protected:
+        void OnMouseEvent(const MouseEvent& e) override;
+
     private:
         bool checked = false;
 
         std::wstring text;
-        HFONT font = nullptr;
-        Color boxColor      = Color::FromARGB(255, 50, 50, 50);
-        Color checkColor    = Color::FromARGB(255, 20, 110, 220);
-        Color hoverColor    = Color::FromARGB(255, 80, 80, 80);
-        Color textColor     = Color::FromRGB(255, 255, 255);
-        
+
         std::function<void(bool)> onToggle; // Called when checkbox is toggled
 };
\ No newline at end of file
@@ -2,49 +2,43 @@
 
 #include "Label.h"
 #include "Color.h"
-#include "ScopedGDI.h"
+#include "TextMeasure.h"
+#include "LayoutSnapshot.h"
 
 Label::Label(std::wstring t) : 
     text(t)
 {
+    textLayout.SetText(text.c_str(), (int)text.size());
     SetChildrenClipping(true);
     SetAutoWidth(true);
     SetAutoHeight(true);
 }
 
-// Helper to temporarily get a persistent memory DC for text measuring
+// Helper to get a persistent (per-thread) memory DC for text measuring
 HDC Label::GetMeasureDC() {
-    static HDC hdc = [] {
-        HDC screen = GetDC(nullptr);
-        HDC mem = CreateCompatibleDC(screen);
-        ReleaseDC(nullptr, screen);
-        return mem;
-    }();
-    return hdc;
+    return TextMeasure::GetMeasureDC();
 }
 
 // Compute text geometry from its contents
-SIZE Label::ComputeTextSize() {
-    HDC hdc = GetMeasureDC();
-    ScopedSelectFont old(hdc, font ? font : (HFONT)GetStockObject(DEFAULT_GUI_FONT));
-
-    SIZE size{0, 0};    
-    const std::wstring text = GetText();
-    if(!text.empty()) {
-        GetTextExtentPoint32W(hdc, text.c_str(), (int)text.size(), &size);
+SIZE Label::ComputeTextSize() const {
+    if(!textSizeValid) {
+        textSize = TextMeasure::MeasureString(font, text.c_str(), (int)text.size());
+        textSizeValid = true;
     }
-    return size;
-} 
-
-UINT Label::ComputeDrawTextFlags() const {
-    UINT flags = DT_SINGLELINE;
+    return textSize;
+}
 
-    // Horizontal alignment
+UINT Label::ComputeHAlignFlags() const {
     switch(hAlign) {
-        case TextAlignH::Left:   flags |= DT_LEFT;   break;
-        case TextAlignH::Center: flags |= DT_CENTER; break;
-        case TextAlignH::Right:  flags |= DT_RIGHT;  break;
+        case TextAlignH::Center: return DT_CENTER;
+        case TextAlignH::Right:  return DT_RIGHT;
+        default:                 return DT_LEFT;
     }
+}
+
+UINT Label::ComputeDrawTextFlags() const {
+    UINT flags = DT_SINGLELINE | ComputeHAlignFlags();
+
     // Vertical alignment
     switch(vAlign) {
         case TextAlignV::Top:    flags |= DT_TOP;     break;
@@ -56,37 +50,131 @@ UINT Label::ComputeDrawTextFlags() const {
 }
 
 void Label::SetText(std::wstring newText) {
-    text = newText;
+    if(newText == text) return; // Unchanged text would still cost a remeasure and a relayout
+    text = std::move(newText);
+    textSizeValid = false;
+    textLayout.SetText(text.c_str(), (int)text.size());
     InvalidateLayout(); // Text change may affect size (ergo the rect)
 }
 
 void Label::SetFont(HFONT newFont) {
     font = newFont;
+    textSizeValid = false;
+    textLayout.SetFont(font);
     InvalidateLayout();
 }
 
-// Apply auto size
-void Label::UpdateInternalLayout() {
-    if(!widthProperties.isAuto && !heightProperties.isAuto) return;
+void Label::SetWordWrap(bool wrap) {
+    if(wordWrap == wrap) return;
+    wordWrap = wrap;
+    InvalidateLayout();
+}
+
+bool Label::ApplyProperty(PropertyID property, const PropertyValue& value) {
+    switch(property) {
+        case PropertyID::Text:
+            if(auto* v = std::get_if<std::wstring>(&value)) { SetText(*v); return true; }
+            break;
+        case PropertyID::TextColor:
+            if(auto* v = std::get_if<Color>(&value)) { SetTextColor(*v); return true; }
+            break;
+        default:
+            break;
+    }
+    return Widget::ApplyProperty(property, value);
+}
+
+// Single line - can't get narrower than the whole text; wrapped - than the widest word
+IntrinsicSize Label::GetIntrinsicSize() const {
+    IntrinsicSize content;
+    if(wordWrap) {
+        int maxWidth = textLayout.GetMaxContentWidth();
+        content.minWidth = textLayout.GetMinContentWidth() + padding.left + padding.right;
+        content.maxWidth = maxWidth + padding.left + padding.right;
+        content.height = textLayout.MeasureHeight(maxWidth) + padding.top + padding.bottom;
+        return content;
+    }
+
+    SIZE size = ComputeTextSize();
+    content.maxWidth = size.cx + padding.left + padding.right;
+    content.minWidth = content.maxWidth;
+    content.height = size.cy + padding.top + padding.bottom;
+    return content;
+}
+
+int Label::GetHeightForWidth(int width) const {
+    if(!wordWrap) return -1;
+    return textLayout.MeasureHeight(width - padding.left - padding.right) + padding.top + padding.bottom;
+}
 
-    SIZE textSize = ComputeTextSize();
+void Label::HashLayoutInputs(LayoutHash& hash) const {
+    Widget::HashLayoutInputs(hash);
+    hash.Add(text);
+    hash.AddFont(font);
+    hash.Add(wordWrap);
+    hash.Add(static_cast<int>(vAlign));
+}
 
-    int w = width;
-    int h = height;
+// Single line text size only - wrapped text measures its words again on demand
+SIZE Label::GetMeasuredContent() const {
+    if(wordWrap || !textSizeValid) return {-1, -1};
+    return textSize;
+}
+void Label::AdoptMeasuredContent(SIZE size) {
+    if(size.cx < 0) return;
+    textSize = size;
+    textSizeValid = true;
+}
 
-    if(widthProperties.isAuto) {
-        w = textSize.cx + padding.left + padding.right;
+// Mirrors the vertical placement of the text in Render
+int Label::GetBaseline(int height) const {
+    TextMeasure::FontMetrics metrics = TextMeasure::GetFontMetrics(font);
+    if(wordWrap) {
+        int innerWidth = GetLayoutWidth() - padding.left - padding.right; // Layouts set the width before asking
+        int lineCount = (int)textLayout.BreakLines(innerWidth).size();
+        int innerHeight = height - padding.top - padding.bottom;
+        return padding.top + WrappedTextTop(innerHeight, lineCount, metrics.height) + metrics.ascent;
     }
-    if(heightProperties.isAuto) {
-        h = textSize.cy + padding.top + padding.bottom;
+
+    switch(vAlign) {
+        case TextAlignV::Center: return TextMeasure::CenteredBaseline(font, height);
+        case TextAlignV::Bottom: return height - metrics.height + metrics.ascent;
+        default:                 return metrics.ascent;
     }
+}
 
-    SetLayoutSize(w, h);
+void Label::Render(Painter& painter) {
+    if(wordWrap) {
+        RenderWrapped(painter);
+        return;
+    }
+    painter.DrawString(text.c_str(), -1, effectiveRect, ComputeDrawTextFlags(), font, textColor);
 }
 
-void Label::Render(HDC hdc) {
-    SetBkMode(hdc, TRANSPARENT);
-    ::SetTextColor(hdc, textColor.toCOLORREF());
-    ScopedSelectFont old(hdc, font ? font : (HFONT)GetStockObject(DEFAULT_GUI_FONT));
-    DrawTextW(hdc, text.c_str(), -1, &effectiveRect, ComputeDrawTextFlags());
-}
\ No newline at end of file
+int Label::WrappedTextTop(int boxHeight, int lineCount, int lineHeight) const {
+    switch(vAlign) {
+        case TextAlignV::Center: return (boxHeight - lineCount * lineHeight) / 2;
+        case TextAlignV::Bottom: return boxHeight - lineCount * lineHeight;
+        default:                 return 0;
+    }
+}
+
+// Draws the cached lines one by one (same breaks as measured), skipping the ones outside the label
+void Label::RenderWrapped(Painter& painter) {
+    RECT inner = ComputeInnerRect();
+    const auto& lines = textLayout.BreakLines(inner.right - inner.left);
+    int lineHeight = textLayout.GetLineHeight();
+
+    UINT flags = DT_SINGLELINE | DT_NOPREFIX | DT_TOP | ComputeHAlignFlags();
+    int top = inner.top + WrappedTextTop(inner.bottom - inner.top, (int)lines.size(), lineHeight);
+
+    // Lines have a fixed height - jump straight to the first visible one
+    size_t first = top < inner.top ? (size_t)((inner.top - top) / lineHeight) : 0;
+    for(size_t i = first; i < lines.size(); i++) {
+        int y = top + (int)i * lineHeight;
+        if(y >= inner.bottom) break;
+
+        RECT lineRect = {inner.left, y, inner.right, y + lineHeight};
+        painter.DrawString(text.c_str() + lines[i].start, lines[i].end - lines[i].start, lineRect, flags, font, textColor);
+    }
+}
@@ -4,6 +4,7 @@
 
 #include "Widget.h"
 #include "Color.h"
+#include "TextLayout.h"
 
 enum class TextAlignH {
     Left,
@@ -23,26 +24,38 @@ class Label : public Widget {
         Label(std::wstring t = L"");
 
         // Appearance
-        std::wstring GetText() const { return text; }
+        const std::wstring& GetText() const { return text; }
         void SetText(std::wstring newText);
 
         HFONT GetFont() const { return font; }
         void SetFont(HFONT newFont);
 
         Color GetTextColor() const { return textColor; }
-        void SetTextColor(Color newColor) { textColor = newColor; }
+        void SetTextColor(Color newColor) { textColor = newColor; InvalidatePaint(); }
 
         TextAlignH GetHAlign() const { return hAlign; }
-        void SetHAlign(TextAlignH newAlign) { hAlign = newAlign; }
+        void SetHAlign(TextAlignH newAlign) { hAlign = newAlign; InvalidatePaint(); }
 
         TextAlignV GetVAlign() const { return vAlign; }
-        void SetVAlign(TextAlignV newAlign) { vAlign = newAlign; }
+        void SetVAlign(TextAlignV newAlign) { vAlign = newAlign; InvalidatePaint(); }
+
+        // Wrapping at word boundaries (and '\n'); off = single line
+        bool IsWordWrap() const { return wordWrap; }
+        void SetWordWrap(bool wrap);
+
+        // Generic properties
+        bool ApplyProperty(PropertyID property, const PropertyValue& value) override;
+
+        // Sizing (auto-sized by default)
+        IntrinsicSize GetIntrinsicSize() const override;
+        int GetBaseline(int height) const override;
+        int GetHeightForWidth(int width) const override;
+        void HashLayoutInputs(LayoutHash& hash) const override;
 
         // Rendering
         HDC GetMeasureDC();
-        SIZE ComputeTextSize();
-        void UpdateInternalLayout() override;
-        void Render(HDC hdc) override;
+        SIZE ComputeTextSize() const; // Cached until the text/font changes
+        void Render(Painter& painter) override;
 
     private:
         std::wstring text;
@@ -51,5 +64,17 @@ class Label : public Widget {
         TextAlignH hAlign = TextAlignH::Left;
         TextAlignV vAlign = TextAlignV::Top;
 
+        bool wordWrap = false;
+
+        mutable SIZE textSize = {0, 0};
+        mutable bool textSizeValid = false;
+        mutable TextLayout textLayout; // Line breaks of the wrapped text
+
+        SIZE GetMeasuredContent() const override;
+        void AdoptMeasuredContent(SIZE size) override;
+
         UINT ComputeDrawTextFlags() const;
+        UINT ComputeHAlignFlags() const;
+        int WrappedTextTop(int boxHeight, int lineCount, int lineHeight) const; // Offset of the first line by vAlign
+        void RenderWrapped(Painter& painter);
 };
\ No newline at end of file
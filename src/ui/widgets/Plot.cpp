@@ -0,0 +1,398 @@
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "Plot.h"
+#include "Border.h"
+#include "TextMeasure.h"
+#include "FrameScheduler.h"
+
+// SSE2 is part of every x64 target; 32-bit builds get it with /arch:SSE2 (MSVC) or -msse2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PLOT_USE_SSE2
+#endif
+
+namespace {
+    const float Infinity = std::numeric_limits<float>::infinity();
+
+    // Folds the min/max of n contiguous samples into min/max
+    void MinMax(const float* p, size_t n, float& min, float& max) {
+        size_t i = 0;
+#ifdef PLOT_USE_SSE2
+        if(n >= 8) {
+            // Two independent accumulator pairs hide the min/max latency
+            __m128 min0 = _mm_loadu_ps(p), max0 = min0;
+            __m128 min1 = _mm_loadu_ps(p + 4), max1 = min1;
+            for(i = 8; i + 8 <= n; i += 8) {
+                __m128 a = _mm_loadu_ps(p + i);
+                __m128 b = _mm_loadu_ps(p + i + 4);
+                min0 = _mm_min_ps(min0, a);
+                max0 = _mm_max_ps(max0, a);
+                min1 = _mm_min_ps(min1, b);
+                max1 = _mm_max_ps(max1, b);
+            }
+            min0 = _mm_min_ps(min0, min1);
+            max0 = _mm_max_ps(max0, max1);
+
+            // Horizontal reduction of the four lanes
+            min0 = _mm_min_ps(min0, _mm_shuffle_ps(min0, min0, _MM_SHUFFLE(1, 0, 3, 2)));
+            min0 = _mm_min_ps(min0, _mm_shuffle_ps(min0, min0, _MM_SHUFFLE(2, 3, 0, 1)));
+            max0 = _mm_max_ps(max0, _mm_shuffle_ps(max0, max0, _MM_SHUFFLE(1, 0, 3, 2)));
+            max0 = _mm_max_ps(max0, _mm_shuffle_ps(max0, max0, _MM_SHUFFLE(2, 3, 0, 1)));
+            min = std::min(min, _mm_cvtss_f32(min0));
+            max = std::max(max, _mm_cvtss_f32(max0));
+        }
+#endif
+        for(; i < n; i++) {
+            min = std::min(min, p[i]);
+            max = std::max(max, p[i]);
+        }
+    }
+
+    // Tick step of 1, 2 or 5 times a power of ten giving at most maxTicks steps over range
+    float NiceStep(float range, int maxTicks) {
+        float raw = range / std::max(1, maxTicks);
+        float magnitude = std::pow(10.0f, std::floor(std::log10(raw)));
+        float r = raw / magnitude;
+        float nice = r <= 1.0f ? 1.0f : r <= 2.0f ? 2.0f : r <= 5.0f ? 5.0f : 10.0f;
+        return nice * magnitude;
+    }
+}
+
+Plot::Series::Series(std::wstring name, Color color, size_t capacity, size_t feedCapacity) :
+    name(std::move(name)),
+    color(color),
+    feed(feedCapacity),
+    history(std::max<size_t>(capacity, 1))
+{}
+
+uint64_t Plot::Series::Oldest() const {
+    return total > history.size() ? total - history.size() : 0;
+}
+
+Plot::Plot() {
+    static const StyleClassID plotClass = StyleRegistry::Get().DefineClass("Plot", DefaultStyle());
+    SetStyleClass(plotClass);
+    styleBackground = true;
+}
+
+Plot::~Plot() {
+    DetachScheduler();
+}
+
+StyleDesc Plot::DefaultStyle() {
+    return StyleDesc::Uniform({
+        Color::FromRGB(20, 20, 24),     // background
+        Color::FromRGB(200, 200, 200),  // foreground (labels, legend)
+        Color::FromRGB(70, 70, 70),     // border
+        Color::FromRGB(45, 45, 52)      // accent (grid)
+    });
+}
+
+void Plot::OnStyleChanged() {
+    SetBorder(1, style->Get(StyleState::Normal).border, BorderSide::All);
+    Widget::OnStyleChanged();
+}
+
+// --- Series ----------------------------------------------------------
+size_t Plot::AddSeries(std::wstring name, Color color, size_t capacity, size_t feedCapacity) {
+    series.push_back(std::make_unique<Series>(std::move(name), color, capacity, feedCapacity));
+    InvalidatePaint();
+    return series.size() - 1;
+}
+
+size_t Plot::Poll() {
+    size_t moved = 0;
+    for(auto& s : series) {
+        Series& target = *s;
+        moved += s->feed.Consume([&target](const float* values, size_t count) { Append(target, values, count); });
+    }
+    if(moved > 0) InvalidatePaint();
+    return moved;
+}
+
+bool Plot::HasPendingSamples() const {
+    return std::any_of(series.begin(), series.end(), [](const std::unique_ptr<Series>& s) { return !s->feed.IsEmpty(); });
+}
+
+void Plot::AttachScheduler(FrameScheduler& newScheduler) {
+    DetachScheduler();
+    scheduler = &newScheduler;
+    pollerId = scheduler->AddPoller([this] { return HasPendingSamples(); }, [this] { Poll(); });
+}
+
+void Plot::DetachScheduler() {
+    if(!scheduler) return;
+    scheduler->RemovePoller(pollerId);
+    scheduler = nullptr;
+}
+
+void Plot::Append(Series& s, const float* values, size_t count) {
+    const size_t capacity = s.history.size();
+    if(count > capacity) {
+        // Only the newest samples fit
+        values += count - capacity;
+        s.total += count - capacity;
+        count = capacity;
+    }
+
+    size_t at = static_cast<size_t>(s.total % capacity);
+    size_t first = std::min(count, capacity - at);
+    std::copy(values, values + first, s.history.begin() + static_cast<std::ptrdiff_t>(at));
+    std::copy(values + first, values + count, s.history.begin());
+    s.total += count;
+}
+
+void Plot::Clear(size_t index) {
+    // Samples still in the feed arrive with the next Poll
+    Series& s = *series[index];
+    s.total = 0;
+    s.cachedUpTo = 0;
+    s.cachedSpc = 0;
+    InvalidatePaint();
+}
+
+size_t Plot::GetSampleCount(size_t index) const {
+    const Series& s = *series[index];
+    return static_cast<size_t>(std::min<uint64_t>(s.total, s.history.size()));
+}
+
+void Plot::SetYRange(float min, float max) {
+    autoScale = false;
+    yMin = min;
+    yMax = max > min ? max : min + 1.0f;
+    InvalidatePaint();
+}
+
+// --- Decimation ------------------------------------------------------
+void Plot::ScanRange(const Series& s, uint64_t from, uint64_t to, float& min, float& max) {
+    // [from, to) lies in the history - at most two contiguous spans
+    const size_t capacity = s.history.size();
+    size_t count = static_cast<size_t>(to - from);
+    size_t at = static_cast<size_t>(from % capacity);
+    size_t first = std::min(count, capacity - at);
+    MinMax(s.history.data() + at, first, min, max);
+    MinMax(s.history.data(), count - first, min, max);
+}
+
+void Plot::Decimate(Series& s, size_t spc, size_t columns) {
+    if(s.total == 0) return;
+
+    if(s.cachedSpc != spc || s.columnMin.size() != columns) {
+        s.columnMin.assign(columns, Infinity);
+        s.columnMax.assign(columns, -Infinity);
+        s.cachedSpc = spc;
+        s.cachedUpTo = 0;
+    }
+
+    const uint64_t oldest = s.Oldest();
+    const uint64_t lastColumn = (s.total - 1) / spc;
+    const uint64_t firstColumn = lastColumn + 1 >= columns ? lastColumn + 1 - columns : 0;
+    s.lastColumn = lastColumn;
+    s.firstColumn = std::max(firstColumn, oldest / spc); // Older columns left the history
+
+    auto compute = [&](uint64_t k) {
+        uint64_t from = std::max<uint64_t>(k * spc, oldest);
+        uint64_t to = std::min<uint64_t>((k + 1) * spc, s.total);
+        float min = Infinity, max = -Infinity;
+        if(from < to) ScanRange(s, from, to, min, max);
+        size_t slot = static_cast<size_t>(k % columns);
+        s.columnMin[slot] = min;
+        s.columnMax[slot] = max;
+    };
+
+    uint64_t start = std::max(s.cachedUpTo, firstColumn);
+
+    // The oldest column may have lost samples to the history since it was cached
+    if(oldest % spc != 0 && s.firstColumn < start) compute(s.firstColumn);
+
+    // New columns, and the newest one again while it's still filling
+    for(uint64_t k = start; k <= lastColumn; k++) {
+        compute(k);
+        if((k + 1) * spc <= s.total) s.cachedUpTo = k + 1;
+    }
+}
+
+size_t Plot::VisibleWindow() const {
+    if(visibleSamples > 0) return visibleSamples;
+
+    size_t filled = 0, capacity = 0;
+    for(size_t i = 0; i < series.size(); i++) {
+        filled = std::max(filled, GetSampleCount(i));
+        capacity = std::max(capacity, series[i]->history.size());
+    }
+    size_t window = 16;
+    while(window < filled) window <<= 1;
+    return std::min(window, capacity);
+}
+
+bool Plot::GetColumnRange(size_t index, size_t column, float& min, float& max) const {
+    const Series& s = *series[index];
+    if(s.total == 0 || column >= columnCount || s.columnMin.size() != columnCount) return false;
+
+    // Newest column at the right edge
+    uint64_t fromRight = columnCount - 1 - column;
+    if(fromRight > s.lastColumn || s.lastColumn - fromRight < s.firstColumn) return false;
+
+    size_t slot = static_cast<size_t>((s.lastColumn - fromRight) % columnCount);
+    if(s.columnMin[slot] > s.columnMax[slot]) return false; // Gap
+    min = s.columnMin[slot];
+    max = s.columnMax[slot];
+    return true;
+}
+
+// --- Rendering -------------------------------------------------------
+void Plot::UpdateAutoScale(size_t columns, int maxTicks) {
+    float min = Infinity, max = -Infinity;
+    for(auto& s : series) {
+        if(s->total == 0 || s->columnMin.size() != columns) continue;
+        for(uint64_t k = s->firstColumn; k <= s->lastColumn; k++) {
+            size_t slot = static_cast<size_t>(k % columns);
+            min = std::min(min, s->columnMin[slot]);
+            max = std::max(max, s->columnMax[slot]);
+        }
+    }
+
+    if(min > max) {
+        // No samples
+        min = 0.0f;
+        max = 1.0f;
+    }
+    else if(min == max) {
+        float pad = min != 0.0f ? std::fabs(min) * 0.1f : 1.0f;
+        min -= pad;
+        max += pad;
+    }
+
+    float step = NiceStep(max - min, maxTicks);
+    yMin = std::floor(min / step) * step;
+    yMax = std::ceil(max / step) * step;
+    if(yMax <= yMin) yMax = yMin + step;
+}
+
+int Plot::ValueToY(const RECT& area, float value) const {
+    float t = (value - yMin) / (yMax - yMin);
+    t = std::clamp(t, -0.01f, 1.01f); // Out-of-range samples (fixed ranges) stick to the edges, just outside the clip
+    return area.bottom - 1 - static_cast<int>(std::lround(t * (area.bottom - area.top - 1)));
+}
+
+void Plot::DrawGrid(Painter& painter, const RECT& area, int lineHeight, int maxTicks) {
+    const StyleColors& colors = style->Get(StyleState::Normal);
+
+    // Vertical lines - quarters of the x range
+    for(int i = 1; i < 4; i++) {
+        int x = area.left + (area.right - area.left) * i / 4;
+        painter.DrawLine(x, area.top, x, area.bottom, colors.accent);
+    }
+
+    // Horizontal lines on the y ticks, labeled left of the plot
+    float step = NiceStep(yMax - yMin, maxTicks);
+    float first = std::ceil(yMin / step) * step;
+    HFONT font = StyleFont();
+    RECT inner = ComputeInnerRect();
+    for(int i = 0; i <= 2 * maxTicks + 1; i++) {
+        float value = first + step * i;
+        if(value > yMax + step * 0.001f) break;
+        if(std::fabs(value) < step * 0.001f) value = 0.0f; // No "-1e-09" for zero
+
+        int y = ValueToY(area, value);
+        painter.DrawLine(area.left, y, area.right, y, colors.accent);
+
+        if(showAxisLabels) {
+            wchar_t buf[32];
+            swprintf_s(buf, 32, L"%.4g", value);
+            RECT textRect = {inner.left, y - lineHeight / 2, area.left - 4, y - lineHeight / 2 + lineHeight};
+            painter.DrawString(buf, -1, textRect, DT_RIGHT | DT_SINGLELINE | DT_VCENTER, font, colors.foreground);
+        }
+    }
+}
+
+void Plot::DrawSeries(Painter& painter, const Series& s, const RECT& area, size_t columns) const {
+    if(s.total == 0 || s.columnMin.size() != columns) return;
+
+    const int width = area.right - area.left;
+    bool have = false;
+    int prevX = 0, prevTop = 0, prevBottom = 0;
+    for(uint64_t k = s.firstColumn; k <= s.lastColumn; k++) {
+        size_t slot = static_cast<size_t>(k % columns);
+        float min = s.columnMin[slot], max = s.columnMax[slot];
+        if(min > max) {
+            have = false; // Gap
+            continue;
+        }
+
+        // Newest column at the right edge
+        size_t c = columns - 1 - static_cast<size_t>(s.lastColumn - k);
+        int x = area.left + (columns > 1 ? static_cast<int>(c * static_cast<size_t>(width - 1) / (columns - 1)) : width - 1);
+        int top = ValueToY(area, max);
+        int bottom = ValueToY(area, min);
+
+        int drawTop = top, drawBottom = bottom;
+        if(have) {
+            if(x - prevX > 1) {
+                // Columns spread out (fewer samples than pixels) - connect them
+                painter.DrawLine(prevX, (prevTop + prevBottom) / 2, x, (top + bottom) / 2, s.color);
+            }
+            else {
+                // Neighbors - stretch over the gap between the two ranges
+                drawTop = std::min(drawTop, prevBottom);
+                drawBottom = std::max(drawBottom, prevTop);
+            }
+        }
+        painter.DrawLine(x, drawTop, x, drawBottom + 1, s.color);
+
+        have = true;
+        prevX = x;
+        prevTop = top;
+        prevBottom = bottom;
+    }
+}
+
+void Plot::DrawLegend(Painter& painter, const RECT& area, int lineHeight) {
+    HFONT font = StyleFont();
+    Color textColor = style->Get(StyleState::Normal).foreground;
+    int y = area.top + 4;
+    for(auto& s : series) {
+        if(s->name.empty()) continue;
+        RECT swatch = {area.left + 6, y + lineHeight / 2 - 2, area.left + 14, y + lineHeight / 2 + 2};
+        painter.FillRect(swatch, s->color);
+        RECT textRect = {area.left + 18, y, area.right, y + lineHeight};
+        painter.DrawString(s->name.c_str(), -1, textRect, DT_LEFT | DT_SINGLELINE | DT_VCENTER, font, textColor);
+        y += lineHeight;
+    }
+}
+
+void Plot::Render(Painter& painter) {
+    RECT inner = ComputeInnerRect();
+    HFONT font = StyleFont();
+    int lineHeight = TextMeasure::GetLineHeight(font);
+
+    // Plot area - room for the y labels on the left and half a label above and below (labels center on their lines)
+    RECT area = inner;
+    if(showAxisLabels) {
+        area.left += TextMeasure::MeasureString(font, L"-0.0000", 7).cx + 4;
+        area.top += lineHeight / 2;
+        area.bottom -= lineHeight / 2;
+    }
+    int width = area.right - area.left;
+    int height = area.bottom - area.top;
+    if(width < 2 || height < 2) return;
+
+    // One column per pixel at most; a column covers spc samples
+    size_t window = VisibleWindow();
+    size_t spc = std::max<size_t>(1, (window + width - 1) / width);
+    size_t columns = std::max<size_t>(1, (window + spc - 1) / spc);
+    for(auto& s : series) Decimate(*s, spc, columns);
+    columnCount = columns;
+    samplesPerColumn = spc;
+
+    int maxTicks = std::max(2, height / std::max(1, lineHeight * 2));
+    if(autoScale) UpdateAutoScale(columns, maxTicks);
+
+    DrawGrid(painter, area, lineHeight, maxTicks);
+    painter.PushClip(area);
+    for(auto& s : series) DrawSeries(painter, *s, area, columns);
+    painter.PopClip();
+    if(showLegend) DrawLegend(painter, area, lineHeight);
+}
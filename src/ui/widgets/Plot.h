@@ -0,0 +1,132 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Widget.h"
+#include "Color.h"
+#include "SpscRing.h"
+
+class FrameScheduler;
+
+// Real-time line plot of one or more sample series (frame times, throughput...)
+// Every series keeps a fixed-capacity history. Samples may be pushed from any thread (one producer thread per series)
+// into a lock-free feed ring; Poll moves them into the histories on the UI thread. Nothing shows up until Poll runs:
+// call it once per frame from the host loop, or AttachScheduler to have a FrameScheduler do it.
+// Rendering decimates the visible samples to one min/max pair per pixel column (SSE2 where available). Columns are
+// aligned to absolute sample indices, so completed columns stay cached: a frame scans only the samples that arrived
+// since the last one (plus the partial newest column) and draws one line per column, however many samples are visible.
+// Axes follow the data: x spans the filled history (grown in powers of two, so columns stay put while it fills),
+// y the visible min/max rounded to 1/2/5 steps. Either can be fixed instead. Series are aligned at their newest sample.
+// Style ("Plot" class): background = plot, foreground = axis labels/legend, border = frame, accent = grid lines.
+class Plot : public Widget {
+    public:
+        Plot();
+        ~Plot() override;
+
+        // --- Series ---
+        // Add all series before producers start pushing (the series list itself isn't synchronized)
+        // capacity = history length in samples; feedCapacity = samples that may be pushed between two Polls
+        // (pushed samples stay in the feed until Poll runs - see AttachScheduler)
+        // Returns the index of the series
+        size_t AddSeries(std::wstring name, Color color, size_t capacity, size_t feedCapacity = 16384);
+        size_t GetSeriesCount() const { return series.size(); }
+        const std::wstring& GetSeriesName(size_t index) const { return series[index]->name; }
+        Color GetSeriesColor(size_t index) const { return series[index]->color; }
+        void SetSeriesColor(size_t index, Color color) { series[index]->color = color; InvalidatePaint(); }
+
+        // --- Producers (any thread, one per series) ---
+        // Never block or allocate; samples that don't fit into the feed are dropped. Samples must be finite.
+        bool Push(size_t index, float value) { return series[index]->feed.Push(value); }
+        size_t Push(size_t index, const float* values, size_t count) { return series[index]->feed.Push(values, count); }
+        uint64_t GetDroppedCount(size_t index) const { return series[index]->feed.GetDroppedCount(); }
+
+        // --- History (UI thread) ---
+        // Moves pushed samples into the histories and repaints if any arrived - call once per frame before rendering
+        // Returns the number of samples moved
+        size_t Poll();
+        bool HasPendingSamples() const; // Pushed but not polled yet
+
+        // Registers Poll with the scheduler: frames keep coming while samples arrive, and they're polled before rendering
+        // The scheduler must outlive the plot (or be detached first)
+        void AttachScheduler(FrameScheduler& scheduler);
+        void DetachScheduler();
+
+        void Clear(size_t index);
+        size_t GetSampleCount(size_t index) const;                                  // Samples in the history
+        uint64_t GetTotalCount(size_t index) const { return series[index]->total; } // Samples ever added
+
+        // --- Axes ---
+        void SetVisibleSamples(size_t count) { visibleSamples = count; InvalidatePaint(); } // 0 = follow the history
+        size_t GetVisibleSamples() const { return visibleSamples; }
+        void SetYRange(float min, float max);
+        void SetAutoScale() { autoScale = true; InvalidatePaint(); }
+        bool IsAutoScaled() const { return autoScale; }
+        float GetYMin() const { return yMin; } // Current range (auto-scaled ranges as of the last render)
+        float GetYMax() const { return yMax; }
+
+        // --- Decimation (as of the last render) ---
+        // Columns across the plot area (newest at the right) and the samples each one covers
+        size_t GetColumnCount() const { return columnCount; }
+        size_t GetSamplesPerColumn() const { return samplesPerColumn; }
+        // Min/max of the series' samples in a column (0 = leftmost) - e.g. for hover readouts; false if it holds none
+        bool GetColumnRange(size_t index, size_t column, float& min, float& max) const;
+
+        void SetShowAxisLabels(bool show) { showAxisLabels = show; InvalidatePaint(); }
+        void SetShowLegend(bool show) { showLegend = show; InvalidatePaint(); }
+
+        // Default looks of the "Plot" style class
+        static StyleDesc DefaultStyle();
+
+        // Rendering
+        void Render(Painter& painter) override;
+
+    protected:
+        void OnStyleChanged() override;
+
+    private:
+        struct Series {
+            std::wstring name;
+            Color color;
+            SpscRing<float> feed;
+
+            std::vector<float> history;     // Ring - absolute sample i is at i % capacity
+            uint64_t total = 0;             // Samples ever added
+
+            // Decimation cache - column k (samples [k * spc, (k + 1) * spc)) is at slot k % size
+            std::vector<float> columnMin;
+            std::vector<float> columnMax;
+            uint64_t cachedUpTo = 0;        // Columns before this one are complete and cached
+            size_t cachedSpc = 0;           // Samples per column the cache was built for (0 = none)
+            uint64_t firstColumn = 0;       // Visible columns holding samples (as of the last Decimate)
+            uint64_t lastColumn = 0;
+
+            Series(std::wstring name, Color color, size_t capacity, size_t feedCapacity);
+            uint64_t Oldest() const;        // Absolute index of the oldest sample in the history
+        };
+        std::vector<std::unique_ptr<Series>> series;
+
+        FrameScheduler* scheduler = nullptr;
+        size_t pollerId = 0;
+
+        size_t visibleSamples = 0;
+        size_t columnCount = 0;         // As of the last render
+        size_t samplesPerColumn = 0;
+        bool autoScale = true;
+        float yMin = 0.0f;
+        float yMax = 1.0f;
+        bool showAxisLabels = true;
+        bool showLegend = true;
+
+        static void Append(Series& s, const float* values, size_t count);
+        static void ScanRange(const Series& s, uint64_t from, uint64_t to, float& min, float& max);
+        static void Decimate(Series& s, size_t spc, size_t columns);
+        size_t VisibleWindow() const;
+        void UpdateAutoScale(size_t columns, int maxTicks);
+        int ValueToY(const RECT& area, float value) const;
+        void DrawGrid(Painter& painter, const RECT& area, int lineHeight, int maxTicks);
+        void DrawSeries(Painter& painter, const Series& s, const RECT& area, size_t columns) const;
+        void DrawLegend(Painter& painter, const RECT& area, int lineHeight);
+};
@@ -5,24 +5,54 @@
 #include "Color.h"
 #include "Border.h"
 #include "FlexLayout.h"
-#include "ScopedGDI.h"
+#include "TextMeasure.h"
 
 Select::Select(std::vector<SelectItemPtr> its) :
     selectedIndex(its.empty() ? -1 : 0)
 {
+    static const StyleClassID selectClass = StyleRegistry::Get().DefineClass("Select", DefaultStyle());
+    SetStyleClass(selectClass);
+    styleBackground = true;
     SetItems(its);
-    SetBorder(1, borderColor, BorderSide::All);
     SetPadding(4, 0); // Add some horizontal padding so that the text doesn't touch the border
-    AddMouseListener([this](const MouseEvent& e) {
-        if(e.type == MouseEventType::Click) {
-            if(open) {
-                Close();
-            }
-            else {
-                pendingOpen = true;
-            }
+}
+
+Select::~Select() {
+    Close(); // The overlay layer must not keep the popup with callbacks into this Select
+}
+
+void Select::OnMouseEvent(const MouseEvent& e) {
+    if(e.type == MouseEventType::Click) {
+        if(open) {
+            Close();
         }
+        else {
+            pendingOpen = true;
+        }
+    }
+}
+
+StyleDesc Select::DefaultStyle() {
+    StyleDesc d = StyleDesc::Uniform({
+        Color::FromRGB(40, 40, 40),     // background
+        Color::FromRGB(255, 255, 255),  // foreground
+        Color::FromRGB(20, 20, 20),     // border
+        Color::FromARGB(0, 0, 0, 0)     // accent
     });
+    d[StyleState::Hover].background     = Color::FromRGB(60, 60, 60);
+    d[StyleState::Pressed].background   = Color::FromRGB(50, 50, 50);
+    d[StyleState::Disabled].background  = Color::FromRGB(120, 120, 120);
+    return d;
+}
+
+void Select::OnStyleChanged() {
+    Color borderColor = style->Get(StyleState::Normal).border;
+    SetBorder(1, borderColor, BorderSide::All);
+    if(popup) {
+        popup->SetBorder(1, borderColor, BorderSide::All);
+        popup->InvalidatePaint();
+    }
+    Widget::OnStyleChanged();
 }
 
 Select::SelectItemPtr Select::GetSelectedItem() const {
@@ -73,7 +103,7 @@ void Select::InitPopup() {
     popup = std::make_shared<Container>();
     
     popup->SetBackgroundColor(Color::FromARGB(230, 30, 30, 30));
-    popup->SetBorder(1, borderColor, BorderSide::All);
+    popup->SetBorder(1, style->Get(StyleState::Normal).border, BorderSide::All);
     auto popupLayout = std::make_unique<VerticalLayout>(0);
     popupLayout->SetAlign(AlignItems::Stretch); // Stretch items to fill the popup width
     popup->SetLayout(std::move(popupLayout));
@@ -103,6 +133,9 @@ void Select::InitPopup() {
 }
 
 void Select::Open() {
+    Root* root = GetRoot();
+    if(!root) return; // Popup needs a Root to live in
+
     if(!popup) {
         // Lazy initialization
         InitPopup();
@@ -111,23 +144,13 @@ void Select::Open() {
         popup->SetVisible(true);
     }
 
-    std::shared_ptr<Root> root = Root::Get();
-
     // Dynamic position/size recalculation (Select might change geometry after creation)
     RECT r = EffectiveRect();
     popup->SetPosSize(r.left, r.bottom, r.right - r.left, 0);
     popup->SetAutoHeight(true);
-    root->AddChild(popup);
 
-    // Add listener to root, because popup should close when clicking anywhere outside itself
-    rootListenerID = root->AddMouseListener([this](const MouseEvent& e) {
-        if(!open || e.type != MouseEventType::Down)
-            return;
-
-        if(!MouseInRect(e.pos) && !popup->MouseInRect(e.pos)) {
-            Close();
-        }
-    });
+    // The popup layer closes the popup when clicking anywhere outside of it (and outside of the Select itself)
+    root->ShowOverlay(popup, OverlayLayer::Popup, 0, [this]() { Close(); }, this);
 
     open = true;
 }
@@ -135,17 +158,13 @@ void Select::Open() {
 void Select::Close() {
     if(!open || !popup) return;
 
-    std::shared_ptr<Root> root = Root::Get();
-    if(root) {
-        root->RemoveChild(popup);
-
-        if(rootListenerID != 0) {
-            root->RemoveMouseListener(rootListenerID);
-        }
+    // The popup lives in the overlay layer of the Root it was opened in
+    if(Root* root = popup->GetRoot()) {
+        root->HideOverlay(popup);
     }
 
     // Manually clean up SelectItems transient states
-    // This is crucial, because popup is a direct child of Root
+    // This is crucial, because popup lives in the overlay layer of Root
     // So if any non-root ancestor triggers the reset...
     // SelectItems MUST know about it - and they can (only) learn it from Select
     for(auto& item : items) {
@@ -156,46 +175,30 @@ void Select::Close() {
     open = false;
 }
 
-void Select::Render(HDC hdc) {
+void Select::Render(Painter& painter) {
     if(pendingOpen) {
         pendingOpen = false;
         Open();
     }
 
-    // --- Background ------------------------------------------------------
-    Color bgColor;
-    if(!enabled) {
-        bgColor = Color::FromRGB(120,120,120);
-    }
-    else if(pressed) {
-        bgColor = pressedColor;
-    }
-    else if(hovered) {
-        bgColor = hoverColor;
-    }
-    else {
-        bgColor = backColor;
-    }
-    SetBackgroundColor(bgColor);
-
+    Color textColor = StateTextColor(CurrentStyleState());
     RECT innerRect = ComputeInnerRect();
 
     // --- Text ------------------------------------------------------------
-    SetBkMode(hdc, TRANSPARENT);
-    ::SetTextColor(hdc, textColor.toCOLORREF());
-    ScopedSelectFont oldFont(hdc, (HFONT)GetStockObject(DEFAULT_GUI_FONT));
+    HFONT font = StyleFont();
 
     RECT textRect = innerRect;
     textRect.right -= 16; // leave space for arrow
 
     SelectItemPtr selectedItem = GetSelectedItem();
     if(selectedItem) {
-        DrawTextW(
-            hdc,
+        painter.DrawString(
             selectedItem->GetText().c_str(),
             -1,
-            &textRect,
-            DT_SINGLELINE | DT_VCENTER | DT_LEFT
+            textRect,
+            DT_SINGLELINE | DT_VCENTER | DT_LEFT,
+            font,
+            textColor
         );
 
     }
@@ -204,16 +207,23 @@ void Select::Render(HDC hdc) {
     RECT arrowRect = innerRect;
     arrowRect.left = innerRect.right - 16;
 
-    DrawTextW(
-        hdc,
+    painter.DrawString(
         L"▼",
         -1,
-        &arrowRect,
-        DT_SINGLELINE | DT_VCENTER | DT_CENTER
+        arrowRect,
+        DT_SINGLELINE | DT_VCENTER | DT_CENTER,
+        font,
+        textColor
     );
 }
 
+int Select::GetBaseline(int height) const {
+    int innerTop = border.top.thickness + padding.top;
+    int innerHeight = height - innerTop - padding.bottom - border.bottom.thickness;
+    return innerTop + TextMeasure::CenteredBaseline(StyleFont(), innerHeight);
+}
+
 void Select::ResetTransientStates() {
     Widget::ResetTransientStates();
-    Close(); // ensures popup removed + listener cleaned up
+    Close(); // ensures popup removed from the overlay layer
 }
\ No newline at end of file
@@ -16,6 +16,7 @@ class Select : public Widget {
 
         // Constructor
         Select(std::vector<SelectItemPtr> items = {});
+        ~Select() override;
 
         // --- Items ------------------------------------------------------------
         void SetItems(std::vector<SelectItemPtr> newItems);
@@ -31,24 +32,30 @@ class Select : public Widget {
         int  GetItemHeight() const  { return itemHeight; }
         int  PopupHeight() const    { return itemHeight * static_cast<int>(items.size()); }
 
-        Color GetBackColor()    const { return backColor; }
-        Color GetHoverColor()   const { return hoverColor; }
-        Color GetPressedColor() const { return pressedColor; }
-        Color GetBorderColor()  const { return borderColor; }
-        Color GetTextColor()    const { return textColor; }
-        void SetBackColor(Color c)      { backColor = c; }
-        void SetHoverColor(Color c)     { hoverColor = c; }
-        void SetPressedColor(Color c)   { pressedColor = c; }
-        void SetBorderColor(Color c)    { borderColor = c; }
-        void SetTextColor(Color c)      { textColor = c; }
+        // Colors are stored in the shared style ("Select" class by default), the text color per select
+        Color GetBackColor()    const { return style->Get(StyleState::Normal).background; }
+        Color GetHoverColor()   const { return style->Get(StyleState::Hover).background; }
+        Color GetPressedColor() const { return style->Get(StyleState::Pressed).background; }
+        Color GetBorderColor()  const { return style->Get(StyleState::Normal).border; }
+        Color GetTextColor()    const { return StateTextColor(StyleState::Normal); }
+        void SetBackColor(Color c)      { Restyle([&](StyleDesc& d) { d[StyleState::Normal].background = c; }); }
+        void SetHoverColor(Color c)     { Restyle([&](StyleDesc& d) { d[StyleState::Hover].background = c; }); }
+        void SetPressedColor(Color c)   { Restyle([&](StyleDesc& d) { d[StyleState::Pressed].background = c; }); }
+        void SetBorderColor(Color c)    { Restyle([&](StyleDesc& d) { for(auto& s : d.states) s.border = c; }); }
+        void SetTextColor(Color c)      { SetTextColorOverride(c); }
+
+        // Default looks of the "Select" style class
+        static StyleDesc DefaultStyle();
 
         // --- Behavior ---------------------------------------------------------
         void SetOnSelectionChanged(std::function<void(int)> cb);
 
         // --- Rendering --------------------------------------------------------
-        void Render(HDC hdc) override;
+        void Render(Painter& painter) override;
+        int GetBaseline(int height) const override;
 
     protected:
+        void OnMouseEvent(const MouseEvent& e) override;
         // Popup control
         void Open();
         void Close();
@@ -56,6 +63,7 @@ class Select : public Widget {
 
         // Misc.
         void ResetTransientStates() override;
+        void OnStyleChanged() override;
 
     private:
         // Data
@@ -67,18 +75,10 @@ class Select : public Widget {
         bool pendingOpen = false;
         int itemHeight = 18;
 
-        // Appearance
-        Color backColor     = Color::FromRGB(40, 40, 40);
-        Color hoverColor    = Color::FromRGB(60, 60, 60);
-        Color pressedColor  = Color::FromRGB(50, 50, 50);
-        Color borderColor   = Color::FromRGB(20, 20, 20);
-        Color textColor     = Color::FromRGB(255, 255, 255);
-
         // Popup container (created on demand)
         std::shared_ptr<Container> popup;
         void InitPopup();
 
         // Event listeners
         std::function<void(int)> onSelectionChanged;
-        size_t rootListenerID = 0;
 };
\ No newline at end of file
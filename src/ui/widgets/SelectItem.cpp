@@ -1,53 +1,72 @@
 #include "SelectItem.h"
 #include "Color.h"
-#include "ScopedGDI.h"
 
 SelectItem::SelectItem(std::wstring t, std::string v) :
     text(t), value(v)
 {
+    static const StyleClassID selectItemClass = StyleRegistry::Get().DefineClass("SelectItem", DefaultStyle());
+    SetStyleClass(selectItemClass);
+    styleBackground = true;
     SetPadding(4, 0); // Add some horizontal padding so that the text doesn't touch the border
-    AddMouseListener([this](const MouseEvent& e) {
-        if(e.type == MouseEventType::Click) {
-            if(onSelect) {
-                onSelect();
-            }
+}
+
+void SelectItem::OnMouseEvent(const MouseEvent& e) {
+    if(e.type == MouseEventType::Click) {
+        if(onSelect) {
+            onSelect();
         }
+    }
+}
+
+StyleDesc SelectItem::DefaultStyle() {
+    StyleDesc d = StyleDesc::Uniform({
+        Color::FromRGB(40, 40, 40),     // background
+        Color::FromRGB(255, 255, 255),  // foreground
+        Color::FromARGB(0, 0, 0, 0),    // border
+        Color::FromARGB(0, 0, 0, 0)     // accent
     });
+    d[StyleState::Hover].background     = Color::FromRGB(60, 60, 60);
+    d[StyleState::Pressed].background   = Color::FromRGB(70, 70, 70);
+    d[StyleState::Selected].background  = Color::FromRGB(50, 50, 50);
+    return d;
+}
+
+// Selection has the lowest priority (hover/press feedback must stay visible on the selected item)
+StyleState SelectItem::CurrentStyleState() const {
+    if(pressed) return StyleState::Pressed;
+    if(hovered) return StyleState::Hover;
+    if(selected) return StyleState::Selected;
+    return StyleState::Normal;
 }
 
 void SelectItem::SetOnSelect(std::function<void()> cb) {
     onSelect = std::move(cb);
 }
 
-void SelectItem::Render(HDC hdc) {
-    RECT innerRect = ComputeInnerRect();
-
-    // Background
-    Color bgColor;
-    if(pressed) {
-        bgColor = pressedColor;
-    }
-    else if(hovered) {
-        bgColor = hoverColor;
-    }
-    else if(selected) {
-        bgColor = selectedColor;
-    }
-    else {
-        bgColor = backColor;
+bool SelectItem::ApplyProperty(PropertyID property, const PropertyValue& value) {
+    switch(property) {
+        case PropertyID::Text:
+            if(auto* v = std::get_if<std::wstring>(&value)) { SetText(*v); return true; }
+            break;
+        case PropertyID::TextColor:
+            if(auto* v = std::get_if<Color>(&value)) { SetTextColor(*v); return true; }
+            break;
+        default:
+            break;
     }
-    SetBackgroundColor(bgColor);
+    return Widget::ApplyProperty(property, value);
+}
 
-    // Text
-    SetBkMode(hdc, TRANSPARENT);
-    ::SetTextColor(hdc, textColor.toCOLORREF());
-    ScopedSelectFont oldFont(hdc, font ? font : (HFONT)GetStockObject(DEFAULT_GUI_FONT));
+void SelectItem::Render(Painter& painter) {
+    RECT innerRect = ComputeInnerRect();
 
-    DrawTextW(
-        hdc,
+    // Text
+    painter.DrawString(
         text.c_str(),
         -1,
-        &innerRect,
-        DT_SINGLELINE | DT_VCENTER | DT_LEFT | DT_END_ELLIPSIS
+        innerRect,
+        DT_SINGLELINE | DT_VCENTER | DT_LEFT | DT_END_ELLIPSIS,
+        StyleFont(),
+        StateTextColor(CurrentStyleState())
     );
 }
\ No newline at end of file
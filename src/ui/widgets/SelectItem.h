@@ -12,7 +12,7 @@ class SelectItem : public Widget {
         SelectItem(std::wstring text, std::string value);
 
         const std::wstring& GetText() const { return text; }
-        void SetText(std::wstring t) { text = t; }
+        void SetText(std::wstring t) { text = t; InvalidatePaint(); }
 
         const std::string& GetValue() const { return value; }
         void SetValue(std::string p) { value = std::move(p); }
@@ -20,28 +20,39 @@ class SelectItem : public Widget {
         size_t GetIndex() const { return index; }
         void SetIndex(size_t idx) { index = idx; }
 
-        void SetSelected(bool sel) { selected = sel; }
+        void SetSelected(bool sel) { selected = sel; InvalidatePaint(); }
         bool IsSelected() const { return selected; }
 
         // Appearance
-        HFONT GetFont() const { return font; }
-        void SetFont(HFONT f) { font = f; }
-
-        Color GetBackColor()        const { return backColor; }
-        Color GetHoverColor()       const { return hoverColor; }
-        Color GetPressedColor()     const { return pressedColor; }
-        Color GetSelectedColor()    const { return selectedColor; }
-        Color GetTextColor()        const { return textColor; }
-        void SetBackColor(Color newColor)       { backColor = newColor; }
-        void SetHoverColor(Color newColor)      { hoverColor = newColor; }
-        void SetPressedColor(Color newColor)    { pressedColor = newColor; }
-        void SetSelectedColor(Color newColor)   { selectedColor = newColor; }
-        void SetTextColor(Color newColor)       { textColor = newColor; }
-
-        void Render(HDC hdc) override;
+        // Colors are stored in the shared style ("SelectItem" class by default), the text color per item
+        HFONT GetFont() const { return style->GetFont(); }
+        void SetFont(HFONT f) { Restyle([&](StyleDesc& d) { d.font = f; }); }
+
+        Color GetBackColor()        const { return style->Get(StyleState::Normal).background; }
+        Color GetHoverColor()       const { return style->Get(StyleState::Hover).background; }
+        Color GetPressedColor()     const { return style->Get(StyleState::Pressed).background; }
+        Color GetSelectedColor()    const { return style->Get(StyleState::Selected).background; }
+        Color GetTextColor()        const { return StateTextColor(StyleState::Normal); }
+        void SetBackColor(Color newColor)       { Restyle([&](StyleDesc& d) { d[StyleState::Normal].background = newColor; }); }
+        void SetHoverColor(Color newColor)      { Restyle([&](StyleDesc& d) { d[StyleState::Hover].background = newColor; }); }
+        void SetPressedColor(Color newColor)    { Restyle([&](StyleDesc& d) { d[StyleState::Pressed].background = newColor; }); }
+        void SetSelectedColor(Color newColor)   { Restyle([&](StyleDesc& d) { d[StyleState::Selected].background = newColor; }); }
+        void SetTextColor(Color newColor)       { SetTextColorOverride(newColor); }
+
+        // Default looks of the "SelectItem" style class
+        static StyleDesc DefaultStyle();
+
+        // Generic properties
+        bool ApplyProperty(PropertyID property, const PropertyValue& value) override;
+
+        void Render(Painter& painter) override;
 
         void SetOnSelect(std::function<void()> cb);
 
+    protected:
+        void OnMouseEvent(const MouseEvent& e) override;
+        StyleState CurrentStyleState() const override;
+
     private:
         size_t index;
         std::wstring text;
@@ -49,12 +60,5 @@ class SelectItem : public Widget {
         
         bool selected = false;
 
-        HFONT font = nullptr;
-        Color backColor     = Color::FromRGB(40, 40, 40);
-        Color hoverColor    = Color::FromRGB(60, 60, 60);
-        Color pressedColor  = Color::FromRGB(70, 70, 70);
-        Color selectedColor = Color::FromRGB(50, 50, 50);
-        Color textColor     = Color::FromRGB(255, 255, 255);
-
         std::function<void()> onSelect;
 };
\ No newline at end of file
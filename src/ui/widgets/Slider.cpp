@@ -4,7 +4,7 @@
 
 #include "Slider.h"
 #include "Color.h"
-#include "ScopedGDI.h"
+#include "TextMeasure.h"
 
 // --- Slider ------------------------------------------------------------
 Slider::Slider(
@@ -20,42 +20,59 @@ Slider::Slider(
     step(step),
     value(val)
 {
-    AddMouseListener([this](const MouseEvent& e) {
-        switch(e.type) {
-            case MouseEventType::Down: {
-                // React also to clicks on the track itself
-                // Not using MouseInRect, because the Slider AbsRect...
-                // ...doesn't account for the label offset
-                RECT trackRect = HandleRect();
-                trackRect.left = EffectiveX();
-                trackRect.right = EffectiveX() + width;
-                if(!PtInRect(&trackRect, e.pos)) {
-                    break;
-                }
-                isDragging = true;
-                UpdateValueFromMouse(e.pos.x);
+    static const StyleClassID sliderClass = StyleRegistry::Get().DefineClass("Slider", DefaultStyle());
+    SetStyleClass(sliderClass);
+}
+
+void Slider::OnMouseEvent(const MouseEvent& e) {
+    switch(e.type) {
+        case MouseEventType::Down: {
+            // React also to clicks on the track itself
+            // Not using MouseInRect, because the Slider AbsRect...
+            // ...doesn't account for the label offset
+            RECT trackRect = HandleRect();
+            trackRect.left = EffectiveX();
+            trackRect.right = EffectiveX() + width;
+            if(!PtInRect(&trackRect, e.pos)) {
                 break;
             }
+            isDragging = true;
+            UpdateValueFromMouse(e.pos.x);
+            break;
+        }
 
-            case MouseEventType::Move: {
-                RECT hr = HandleRect();
-                handleHovered = PtInRect(&hr, e.pos);
+        case MouseEventType::Move: {
+            RECT hr = HandleRect();
+            bool wasHovered = handleHovered;
+            handleHovered = PtInRect(&hr, e.pos);
+            if(handleHovered != wasHovered) InvalidatePaint();
 
-                if(isDragging) {
-                    UpdateValueFromMouse(e.pos.x);
-                }
-                break;
+            if(isDragging) {
+                UpdateValueFromMouse(e.pos.x);
             }
+            break;
+        }
 
-            case MouseEventType::Leave:
-                handleHovered = false;
-                break;
+        case MouseEventType::Leave:
+            handleHovered = false;
+            break;
 
-            case MouseEventType::Up:
-                isDragging = false;
-                break;
-        }
+        case MouseEventType::Up:
+            isDragging = false;
+            break;
+    }
+}
+
+StyleDesc Slider::DefaultStyle() {
+    StyleDesc d = StyleDesc::Uniform({
+        Color::FromRGB(100, 100, 100),  // background (track)
+        Color::FromRGB(255, 255, 255),  // foreground (labels)
+        Color::FromARGB(0, 0, 0, 0),    // border
+        Color::FromRGB(180, 180, 180)   // accent (handle)
     });
+    d[StyleState::Hover].accent     = Color::FromRGB(220, 220, 220);
+    d[StyleState::Pressed].accent   = Color::FromRGB(150, 150, 255);
+    return d;
 }
 
 // Compute handle rect in absolute coordinates
@@ -69,56 +86,49 @@ RECT Slider::HandleRect() const {
     return RECT{x, y, x + handleWidth, y + handleHeight};
 }
 
-int Slider::ComputeLabelHeight(HDC hdc) {
+int Slider::ComputeLabelHeight() const {
     if(!(showLabel || showValue)) {
         return 0;
     }
-    int labelHeight = 0;
-    ScopedSelectFont oldFont(hdc, font ? font : (HFONT)GetStockObject(DEFAULT_GUI_FONT));
-    TEXTMETRIC tm;
-    GetTextMetrics(hdc, &tm);
-    labelHeight = tm.tmHeight + 2; // 2px padding
+    int labelHeight = TextMeasure::GetLineHeight(StyleFont()) + 2; // 2px padding
 
     return labelHeight;
 }
 
-void Slider::DrawTrack(HDC hdc) {
+void Slider::DrawTrack(Painter& painter) {
     RECT track = {
         EffectiveX(),
         EffectiveY() + sliderOffsetY + handleHeight/2 - 2,
         EffectiveX() + width,
         EffectiveY() + sliderOffsetY + handleHeight/2 + 2
     };
-    ScopedOwnedBrush br(hdc, trackColor.toCOLORREF());
-    FillRect(hdc, &track, br.get());
+    painter.FillRect(track, style->Get(StyleState::Normal).background);
 }
 
-void Slider::DrawHandle(HDC hdc) {
+void Slider::DrawHandle(Painter& painter) {
     RECT hr = HandleRect();
-    Color handleCol = handleColor;
 
     // Determine handle color based on state
+    StyleState handleState = StyleState::Normal;
     if(handleHovered) {
-        handleCol = hoverColor;
+        handleState = StyleState::Hover;
     }
     if(isDragging) { // Dragging takes precendence over hovering
-        handleCol = dragColor;
+        handleState = StyleState::Pressed;
     }
-    ScopedOwnedBrush br(hdc, handleCol.toCOLORREF());
-    FillRect(hdc, &hr, br.get());
+    painter.FillRect(hr, style->Get(handleState).accent);
 }
 
-void Slider::DrawLabels(HDC hdc) {
+void Slider::DrawLabels(Painter& painter) {
     if(!(showLabel || showValue)) return;
 
-    ScopedSelectFont oldFont(hdc, (HFONT)GetStockObject(DEFAULT_GUI_FONT));
+    HFONT font = StyleFont();
+    Color labelColor = StateTextColor(StyleState::Normal);
     RECT textRect = { EffectiveX(), EffectiveY(), EffectiveX() + width, EffectiveY() + sliderOffsetY};
-    SetBkMode(hdc, TRANSPARENT);
-    SetTextColor(hdc, labelColor.toCOLORREF());
 
     // Left-aligned label
     if(showLabel) {
-        DrawTextW(hdc, label.c_str(), -1, &textRect, DT_LEFT | DT_SINGLELINE | DT_VCENTER);
+        painter.DrawString(label.c_str(), -1, textRect, DT_LEFT | DT_SINGLELINE | DT_VCENTER, font, labelColor);
     }
 
     // Right-aligned numeric value
@@ -126,34 +136,42 @@ void Slider::DrawLabels(HDC hdc) {
         // Round to 2 decimal places
         wchar_t buf[32];
         swprintf_s(buf, 32, L"%.2f", value);
-        DrawTextW(hdc, buf, -1, &textRect, DT_RIGHT | DT_SINGLELINE | DT_VCENTER);
+        painter.DrawString(buf, -1, textRect, DT_RIGHT | DT_SINGLELINE | DT_VCENTER, font, labelColor);
     }
 }
 
-void Slider::Render(HDC hdc) {
+void Slider::Render(Painter& painter) {
     // Only draw what doesn't overflow
     // (track/handle takes precedence)
     if((showLabel || showValue)) {
-        int labelHeight = ComputeLabelHeight(hdc);
+        int labelHeight = ComputeLabelHeight();
         
         // Add offset and draw labels only if labels are going to fit
         if(height >= handleHeight + labelHeight) {
             sliderOffsetY = labelHeight;
-            DrawLabels(hdc);
+            DrawLabels(painter);
         }
         else {
             OutputDebugStringA("[!] Set height is too small for labels! Skipping drawing...\n");
         }
     }
     if(height >= handleHeight) {
-        DrawTrack(hdc);
-        DrawHandle(hdc);
+        DrawTrack(painter);
+        DrawHandle(painter);
     }
     else {
         OutputDebugStringA("[!] Set height is too small! Not drawing anything. Make sure widget height is no smaller than handle height.\n");
     }
 }
 
+// Labels are centered in a row above the track (drawn only if they fit, see Render)
+int Slider::GetBaseline(int height) const {
+    int labelHeight = ComputeLabelHeight();
+    if(labelHeight == 0 || height < handleHeight + labelHeight) return -1;
+
+    return TextMeasure::CenteredBaseline(StyleFont(), labelHeight);
+}
+
 void Slider::UpdateValueFromMouse(int mouseX) {
     // Calculate new value
     RECT r = EffectiveRect();
@@ -173,6 +191,23 @@ void Slider::UpdateValueFromMouse(int mouseX) {
     }
 }
 
+bool Slider::ApplyProperty(PropertyID property, const PropertyValue& value) {
+    switch(property) {
+        case PropertyID::Value:
+            if(auto* v = std::get_if<float>(&value)) { SetValue(*v); return true; }
+            break;
+        case PropertyID::Text:
+            if(auto* v = std::get_if<std::wstring>(&value)) { SetLabel(*v); return true; }
+            break;
+        case PropertyID::TextColor:
+            if(auto* v = std::get_if<Color>(&value)) { SetLabelColor(*v); return true; }
+            break;
+        default:
+            break;
+    }
+    return Widget::ApplyProperty(property, value);
+}
+
 void Slider::SetOnValueChanged(std::function<void(float)> cb) {
     onValueChanged = cb;
 }
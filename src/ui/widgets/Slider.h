@@ -20,57 +20,70 @@ class Slider : public Widget {
 
         // Appearance
         std::wstring GetLabel() const { return label; }
-        void SetLabel(std::wstring l) { label = l; }
+        void SetLabel(std::wstring l) { label = l; InvalidatePaint(); }
 
-        HFONT GetFont() const { return font; }
-        void SetFont(HFONT newFont) { font = newFont; }
+        HFONT GetFont() const { return style->GetFont(); }
+        void SetFont(HFONT newFont) { Restyle([&](StyleDesc& d) { d.font = newFont; }); }
 
         float GetValue() const { return value; }
         void SetValue(float newValue) { 
             // Don't allow illegal values
-            value = std::clamp(newValue, minValue, maxValue);
+            float clamped = std::clamp(newValue, minValue, maxValue);
+            if(clamped == value) return; // No repaint or callback for repeated values (e.g. per-frame syncing)
+            value = clamped;
+            InvalidatePaint();
             if(onValueChanged) onValueChanged(value);
         }
 
         float GetMinValue() const { return minValue; }
-        void SetMinValue(float newValue) { minValue = newValue; }
+        void SetMinValue(float newValue) { minValue = newValue; InvalidatePaint(); }
 
         float GetMaxValue() const { return maxValue; }
-        void SetMaxValue(float newValue) { maxValue = newValue; }
+        void SetMaxValue(float newValue) { maxValue = newValue; InvalidatePaint(); }
 
         float GetStep() const { return step; }
         void SetStep(float newStep) {
             step = std::max(0.0f, newStep);
         }
 
-        void SetShowValue(bool show) { showValue = show; }
-        void SetShowLabel(bool show) { showLabel = show; }
+        void SetShowValue(bool show) { showValue = show; InvalidatePaint(); }
+        void SetShowLabel(bool show) { showLabel = show; InvalidatePaint(); }
 
-        void SetHandleWidth(int w) { handleWidth = w; }
-        void SetHandleHeight(int h) { handleHeight = h; }
+        void SetHandleWidth(int w) { handleWidth = w; InvalidatePaint(); }
+        void SetHandleHeight(int h) { handleHeight = h; InvalidatePaint(); }
 
-        // Colors
-        Color GetTrackColor()   const { return trackColor; }
-        Color GetHandleColor()  const { return handleColor; }
-        Color GetHoverColor()   const { return hoverColor; }
-        Color GetDragColor()    const { return dragColor; }
-        Color GetLabelColor()   const { return labelColor; }
-        void SetTrackColor(Color newColor)  { trackColor = newColor; }
-        void SetHandleColor(Color newColor) { handleColor = newColor; }
-        void SetHoverColor(Color newColor)  { hoverColor = newColor; }
-        void SetDragColor(Color newColor)   { dragColor = newColor; }
-        void SetLabelColor(Color newColor)  { labelColor = newColor; }
+        // Colors are stored in the shared style ("Slider" class by default)
+        // Track = background, handle = accent (hover/drag = Hover/Pressed accent), label = foreground
+        // (the label color set here is kept per slider, outside the style)
+        Color GetTrackColor()   const { return style->Get(StyleState::Normal).background; }
+        Color GetHandleColor()  const { return style->Get(StyleState::Normal).accent; }
+        Color GetHoverColor()   const { return style->Get(StyleState::Hover).accent; }
+        Color GetDragColor()    const { return style->Get(StyleState::Pressed).accent; }
+        Color GetLabelColor()   const { return StateTextColor(StyleState::Normal); }
+        void SetTrackColor(Color newColor)  { Restyle([&](StyleDesc& d) { for(auto& s : d.states) s.background = newColor; }); }
+        void SetHandleColor(Color newColor) { Restyle([&](StyleDesc& d) { d[StyleState::Normal].accent = newColor; }); }
+        void SetHoverColor(Color newColor)  { Restyle([&](StyleDesc& d) { d[StyleState::Hover].accent = newColor; }); }
+        void SetDragColor(Color newColor)   { Restyle([&](StyleDesc& d) { d[StyleState::Pressed].accent = newColor; }); }
+        void SetLabelColor(Color newColor)  { SetTextColorOverride(newColor); }
+
+        // Default looks of the "Slider" style class
+        static StyleDesc DefaultStyle();
+
+        // Generic properties
+        bool ApplyProperty(PropertyID property, const PropertyValue& value) override;
 
         // Rendering
         RECT HandleRect() const;
-        int ComputeLabelHeight(HDC hdc);
-        void Render(HDC hdc) override;
+        int ComputeLabelHeight() const;
+        void Render(Painter& painter) override;
+        int GetBaseline(int height) const override; // Label row baseline (-1 if there are no labels)
 
         // Behavior
         void UpdateValueFromMouse(int mouseX);
         void SetOnValueChanged(std::function<void(float)> cb);
 
     protected:
+        void OnMouseEvent(const MouseEvent& e) override;
         void ResetTransientStates() override;
 
     private:
@@ -88,16 +101,10 @@ class Slider : public Widget {
         bool handleHovered = false;
 
         std::wstring label;
-        Color trackColor    = Color::FromRGB(100, 100, 100);
-        Color handleColor   = Color::FromRGB(180, 180, 180);
-        Color hoverColor    = Color::FromRGB(220, 220, 220);
-        Color dragColor     = Color::FromRGB(150, 150, 255);
-        Color labelColor    = Color::FromRGB(255, 255, 255);
-        HFONT font = nullptr;
 
         std::function<void(float)> onValueChanged;
 
-        void DrawTrack(HDC hdc);
-        void DrawHandle(HDC hdc);
-        void DrawLabels(HDC hdc);
+        void DrawTrack(Painter& painter);
+        void DrawHandle(Painter& painter);
+        void DrawLabels(Painter& painter);
 };
\ No newline at end of file
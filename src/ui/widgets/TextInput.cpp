@@ -0,0 +1,479 @@
+#include <windows.h>
+#include <string>
+#include <algorithm>
+
+#include "Color.h"
+#include "Border.h"
+#include "TextInput.h"
+#include "TextMeasure.h"
+
+TextInput::TextInput(bool multiLine) :
+    multiLine(multiLine)
+{
+    static const StyleClassID textInputClass = StyleRegistry::Get().DefineClass("TextInput", DefaultStyle());
+    SetStyleClass(textInputClass);
+    SetPadding(4, 2);
+    SetFocusable(true);
+    styleBackground = true;
+}
+
+StyleDesc TextInput::DefaultStyle() {
+    StyleDesc d = StyleDesc::Uniform({
+        Color::FromRGB(25,25,25),       // background
+        Color::FromRGB(255,255,255),    // foreground
+        Color::FromRGB(90,90,90),       // border
+        Color::FromRGB(255,255,255)     // accent (caret)
+    });
+    d[StyleState::Hover].border         = Color::FromRGB(130,130,130);
+    d[StyleState::Disabled].foreground  = Color::FromRGB(120,120,120);
+    return d;
+}
+
+void TextInput::OnStyleChanged() {
+    SetBorder(1, style->Get(StyleState::Normal).border, BorderSide::All);
+    measuredLine = SIZE_MAX; // The font may have changed
+    Widget::OnStyleChanged();
+}
+
+// --- Content ---------------------------------------------------------
+std::wstring TextInput::GetText() const {
+    std::wstring text(buffer.Size(), L'\0');
+    buffer.CopyTo(0, text.size(), &text[0]);
+    return text;
+}
+
+void TextInput::SetText(const std::wstring& newText) {
+    if(newText == GetText()) return; // Keeps the caret and scroll position
+    buffer.Clear();
+    lineStarts.assign(1, 0);
+    shiftedAfter = 0;
+    pendingShift = 0;
+    caret = 0;
+    caretLine = 0;
+    measuredLine = SIZE_MAX;
+    scrollX = 0;
+    scrollY = 0;
+
+    InsertText(newText);
+    InvalidatePaint();
+}
+
+// --- Editing ---------------------------------------------------------
+void TextInput::InsertText(const wchar_t* text, size_t length) {
+    if(!text || length == 0) return;
+
+    // Normalize line breaks ("\r\n" and '\r' become '\n', or spaces in single-line inputs)
+    std::wstring inserted;
+    inserted.reserve(length);
+    size_t newLines = 0;
+    for(size_t i = 0; i < length; i++) {
+        wchar_t c = text[i];
+        if(c == L'\r') {
+            if(i + 1 < length && text[i + 1] == L'\n') continue;
+            c = L'\n';
+        }
+        if(c == L'\n') {
+            if(!multiLine) c = L' ';
+            else newLines++;
+        }
+        inserted.push_back(c);
+    }
+    if(inserted.empty()) return;
+
+    size_t count = inserted.size();
+    size_t line = caretLine;
+    size_t column = caret - LineStart(line);
+    buffer.Insert(caret, inserted.data(), count);
+
+    if(newLines == 0) {
+        // Same line - the lines below move lazily, the cached advances get the typed characters spliced in
+        ShiftLines(line, static_cast<ptrdiff_t>(count));
+        if(measuredLine == line) {
+            std::vector<int> extents(count);
+            TextMeasure::MeasureAdvances(StyleFont(), inserted.data(), static_cast<int>(count), extents.data());
+
+            int base = advances[column];
+            int insertedWidth = extents.back();
+            for(size_t i = column + 1; i < advances.size(); i++) advances[i] += insertedWidth;
+            for(int& x : extents) x += base;
+            advances.insert(advances.begin() + column + 1, extents.begin(), extents.end());
+        }
+        InvalidateLines(line, false);
+    }
+    else {
+        // New lines - the index after the caret line is rebuilt
+        FlushLineShift();
+        for(size_t i = line + 1; i < lineStarts.size(); i++) lineStarts[i] += count;
+
+        std::vector<size_t> starts;
+        starts.reserve(newLines);
+        for(size_t i = 0; i < count; i++) {
+            if(inserted[i] == L'\n') starts.push_back(caret + i + 1);
+        }
+        lineStarts.insert(lineStarts.begin() + line + 1, starts.begin(), starts.end());
+
+        measuredLine = SIZE_MAX;
+        InvalidateLines(line, true);
+    }
+
+    PlaceCaret(caret + count);
+    NotifyChanged();
+}
+
+void TextInput::DeleteBackward() {
+    if(caret == 0) return;
+
+    size_t line = caretLine;
+    size_t column = caret - LineStart(line);
+
+    if(column == 0) {
+        // Joins the caret line to the previous one
+        FlushLineShift();
+        buffer.Erase(caret - 1, 1);
+        lineStarts.erase(lineStarts.begin() + line);
+        for(size_t i = line; i < lineStarts.size(); i++) lineStarts[i]--;
+
+        measuredLine = SIZE_MAX;
+        InvalidateLines(line - 1, true);
+    }
+    else {
+        buffer.Erase(caret - 1, 1);
+        ShiftLines(line, -1);
+        if(measuredLine == line) {
+            int removedWidth = advances[column] - advances[column - 1];
+            advances.erase(advances.begin() + column);
+            for(size_t i = column; i < advances.size(); i++) advances[i] -= removedWidth;
+        }
+        InvalidateLines(line, false);
+    }
+
+    PlaceCaret(caret - 1);
+    NotifyChanged();
+}
+
+void TextInput::DeleteForward() {
+    if(caret >= buffer.Size()) return;
+
+    size_t line = caretLine;
+    size_t column = caret - LineStart(line);
+
+    if(caret == LineEnd(line)) {
+        // Joins the next line to the caret line
+        FlushLineShift();
+        buffer.Erase(caret, 1);
+        lineStarts.erase(lineStarts.begin() + line + 1);
+        for(size_t i = line + 1; i < lineStarts.size(); i++) lineStarts[i]--;
+
+        measuredLine = SIZE_MAX;
+        InvalidateLines(line, true);
+    }
+    else {
+        buffer.Erase(caret, 1);
+        ShiftLines(line, -1);
+        if(measuredLine == line) {
+            int removedWidth = advances[column + 1] - advances[column];
+            advances.erase(advances.begin() + column + 1);
+            for(size_t i = column + 1; i < advances.size(); i++) advances[i] -= removedWidth;
+        }
+        InvalidateLines(line, false);
+    }
+
+    PlaceCaret(caret);
+    NotifyChanged();
+}
+
+void TextInput::NotifyChanged() {
+    if(onChange) onChange();
+}
+
+// --- Caret -----------------------------------------------------------
+void TextInput::SetCaret(size_t pos) {
+    PlaceCaret(pos);
+}
+
+void TextInput::MoveCaretLeft() {
+    if(caret > 0) PlaceCaret(caret - 1);
+}
+
+void TextInput::MoveCaretRight() {
+    if(caret < buffer.Size()) PlaceCaret(caret + 1);
+}
+
+void TextInput::MoveCaretUp() {
+    if(caretLine == 0) {
+        MoveCaretHome();
+        return;
+    }
+
+    int x = preferredX >= 0 ? preferredX : GetCaretX();
+    size_t target = caretLine - 1;
+    PlaceCaret(LineStart(target) + ColumnAt(target, x), true);
+    preferredX = x;
+}
+
+void TextInput::MoveCaretDown() {
+    if(caretLine + 1 >= lineStarts.size()) {
+        MoveCaretEnd();
+        return;
+    }
+
+    int x = preferredX >= 0 ? preferredX : GetCaretX();
+    size_t target = caretLine + 1;
+    PlaceCaret(LineStart(target) + ColumnAt(target, x), true);
+    preferredX = x;
+}
+
+void TextInput::MoveCaretHome() {
+    PlaceCaret(LineStart(caretLine));
+}
+
+void TextInput::MoveCaretEnd() {
+    PlaceCaret(LineEnd(caretLine));
+}
+
+int TextInput::GetCaretX() {
+    return LineAdvances(caretLine)[caret - LineStart(caretLine)];
+}
+
+void TextInput::PlaceCaret(size_t pos, bool keepPreferredX) {
+    size_t oldLine = caretLine;
+    caret = std::min(pos, buffer.Size());
+    caretLine = LineOf(caret);
+    if(!keepPreferredX) preferredX = -1;
+
+    // The caret is painted with its line - repaint the lines it left and entered, or everything if the view scrolled
+    if(ScrollToCaret()) {
+        InvalidatePaint();
+        return;
+    }
+    if(oldLine < lineStarts.size()) InvalidateLines(oldLine, false);
+    if(caretLine != oldLine) InvalidateLines(caretLine, false);
+}
+
+bool TextInput::ScrollToCaret() {
+    RECT inner = ComputeInnerRect();
+    int viewWidth = inner.right - inner.left;
+    int viewHeight = inner.bottom - inner.top;
+    if(viewWidth <= 0 || viewHeight <= 0) return false; // Not laid out yet
+
+    int oldScrollX = scrollX;
+    int oldScrollY = scrollY;
+
+    int x = GetCaretX();
+    if(x < scrollX) scrollX = x;
+    else if(x >= scrollX + viewWidth) scrollX = x - viewWidth + 1;
+
+    if(multiLine) {
+        int lineHeight = LineHeight();
+        int y = static_cast<int>(caretLine) * lineHeight;
+        if(y < scrollY) scrollY = y;
+        else if(y + lineHeight > scrollY + viewHeight) scrollY = y + lineHeight - viewHeight;
+    }
+
+    scrollX = std::max(0, scrollX);
+    scrollY = std::max(0, scrollY);
+    return scrollX != oldScrollX || scrollY != oldScrollY;
+}
+
+// --- Line index ------------------------------------------------------
+size_t TextInput::LineOf(size_t pos) const {
+    // Line starts are sorted - binary search the last one at or before pos
+    size_t low = 0;
+    size_t high = lineStarts.size();
+    while(high - low > 1) {
+        size_t mid = low + (high - low) / 2;
+        if(LineStart(mid) <= pos) low = mid;
+        else high = mid;
+    }
+    return low;
+}
+
+void TextInput::ShiftLines(size_t line, ptrdiff_t delta) {
+    // Consecutive edits on one line only accumulate the shift
+    if(pendingShift != 0 && shiftedAfter != line) FlushLineShift();
+    shiftedAfter = line;
+    pendingShift += delta;
+}
+
+void TextInput::FlushLineShift() {
+    if(pendingShift == 0) return;
+    for(size_t i = shiftedAfter + 1; i < lineStarts.size(); i++) lineStarts[i] += pendingShift;
+    pendingShift = 0;
+}
+
+// --- Measuring -------------------------------------------------------
+void TextInput::CopyLine(size_t line) {
+    size_t start = LineStart(line);
+    scratch.resize(LineEnd(line) - start);
+    buffer.CopyTo(start, scratch.size(), &scratch[0]);
+}
+
+const std::vector<int>& TextInput::LineAdvances(size_t line) {
+    if(measuredLine == line) return advances;
+
+    CopyLine(line);
+    advances.assign(scratch.size() + 1, 0);
+    TextMeasure::MeasureAdvances(StyleFont(), scratch.data(), static_cast<int>(scratch.size()), &advances[1]);
+    measuredLine = line;
+    return advances;
+}
+
+size_t TextInput::ColumnAt(size_t line, int x) {
+    const std::vector<int>& adv = LineAdvances(line);
+
+    // Advances are monotonic - binary search, then pick the closer boundary
+    size_t column = std::lower_bound(adv.begin(), adv.end(), x) - adv.begin();
+    if(column >= adv.size()) return adv.size() - 1;
+    if(column > 0 && x - adv[column - 1] < adv[column] - x) column--;
+    return column;
+}
+
+int TextInput::LineHeight() const {
+    return TextMeasure::GetLineHeight(StyleFont());
+}
+
+// --- Painting --------------------------------------------------------
+// Single-line text is centered vertically; multi-line text starts at the top and scrolls
+RECT TextInput::LineRect(size_t line, bool toBottom) const {
+    RECT inner = ComputeInnerRect();
+    int lineHeight = LineHeight();
+
+    int top = multiLine
+        ? inner.top - scrollY + static_cast<int>(line) * lineHeight
+        : inner.top + (inner.bottom - inner.top - lineHeight) / 2;
+
+    RECT r = inner;
+    r.top = std::max<LONG>(inner.top, top);
+    r.bottom = toBottom ? inner.bottom : std::min<LONG>(inner.bottom, top + lineHeight);
+    if(r.bottom < r.top) r.bottom = r.top;
+    return r;
+}
+
+void TextInput::InvalidateLines(size_t line, bool toBottom) {
+    InvalidatePaint(LineRect(line, toBottom));
+}
+
+void TextInput::Render(Painter& painter) {
+    RECT inner = ComputeInnerRect();
+    const StyleColors& colors = StateColors();
+    Color textColor = StateTextColor(CurrentStyleState());
+    HFONT font = StyleFont();
+    int lineHeight = LineHeight();
+
+    if(lineHeight <= 0 || inner.right <= inner.left || inner.bottom <= inner.top) return;
+
+    painter.PushClip(inner);
+
+    int firstTop = multiLine ? inner.top - scrollY : inner.top + (inner.bottom - inner.top - lineHeight) / 2;
+    size_t first = firstTop < inner.top ? static_cast<size_t>((inner.top - firstTop) / lineHeight) : 0;
+    int viewWidth = inner.right - inner.left;
+
+    // Visible lines only
+    for(size_t line = first; line < lineStarts.size(); line++) {
+        int top = firstTop + static_cast<int>(line) * lineHeight;
+        if(top >= inner.bottom) break;
+
+        // Long measured lines are trimmed to their visible columns
+        size_t start = LineStart(line);
+        size_t end = LineEnd(line);
+        int x = inner.left - scrollX;
+        if(line == measuredLine) {
+            size_t firstColumn = std::upper_bound(advances.begin(), advances.end(), scrollX) - advances.begin();
+            firstColumn = firstColumn > 0 ? firstColumn - 1 : 0;
+            size_t endColumn = std::lower_bound(advances.begin(), advances.end(), scrollX + viewWidth) - advances.begin();
+            endColumn = std::min(endColumn + 1, advances.size() - 1);
+
+            x += advances[firstColumn];
+            end = start + endColumn;
+            start += firstColumn;
+        }
+
+        scratch.resize(end - start);
+        if(scratch.empty()) continue;
+        buffer.CopyTo(start, scratch.size(), &scratch[0]);
+
+        RECT lineRect = {x, top, inner.right, top + lineHeight};
+        painter.DrawString(scratch.c_str(), static_cast<int>(scratch.size()), lineRect, DT_SINGLELINE | DT_NOPREFIX | DT_LEFT | DT_TOP, font, textColor);
+    }
+
+    // Caret
+    if(!focused) {
+        painter.PopClip();
+        return;
+    }
+    int caretX = inner.left - scrollX + GetCaretX();
+    int caretTop = firstTop + static_cast<int>(caretLine) * lineHeight;
+    painter.FillRect({caretX, caretTop, caretX + 1, caretTop + lineHeight}, colors.accent);
+
+    painter.PopClip();
+}
+
+int TextInput::GetBaseline(int height) const {
+    int innerTop = border.top.thickness + padding.top;
+    if(multiLine) return innerTop + TextMeasure::GetFontMetrics(StyleFont()).ascent;
+
+    int innerHeight = height - innerTop - padding.bottom - border.bottom.thickness;
+    return innerTop + TextMeasure::CenteredBaseline(StyleFont(), innerHeight);
+}
+
+// --- Events ----------------------------------------------------------
+void TextInput::OnMouseEvent(const MouseEvent& e) {
+    if(e.type != MouseEventType::Down || e.button != MouseButton::Left) return;
+
+    RECT inner = ComputeInnerRect();
+    size_t line = 0;
+    if(multiLine) {
+        int lineHeight = LineHeight();
+        int y = e.pos.y - inner.top + scrollY;
+        if(lineHeight > 0 && y > 0) line = std::min(static_cast<size_t>(y / lineHeight), lineStarts.size() - 1);
+    }
+
+    PlaceCaret(LineStart(line) + ColumnAt(line, e.pos.x - inner.left + scrollX));
+}
+
+bool TextInput::OnKeyEvent(const KeyEvent& e) {
+    if(e.type != KeyEventType::Down) return false;
+
+    switch(e.key) {
+        case VK_LEFT:   MoveCaretLeft(); return true;
+        case VK_RIGHT:  MoveCaretRight(); return true;
+        case VK_UP:     if(!multiLine) return false; MoveCaretUp(); return true;
+        case VK_DOWN:   if(!multiLine) return false; MoveCaretDown(); return true;
+        case VK_HOME:   MoveCaretHome(); return true;
+        case VK_END:    MoveCaretEnd(); return true;
+        case VK_BACK:   DeleteBackward(); return true;
+        case VK_DELETE: DeleteForward(); return true;
+        case VK_RETURN:
+            if(!multiLine) return false; // Bubbles (e.g. to submit a form)
+            InsertText(L"\n", 1);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool TextInput::OnCharEvent(const CharEvent& e) {
+    // Control characters (backspace, enter, tab...) are handled as keys, or not at all
+    if(e.character < L' ' || e.character == 0x7F) return false;
+
+    InsertText(&e.character, 1);
+    return true;
+}
+
+void TextInput::OnFocusChanged(bool /*focused*/) {
+    InvalidateLines(caretLine, false); // Caret shown/hidden
+}
+
+bool TextInput::ApplyProperty(PropertyID property, const PropertyValue& value) {
+    switch(property) {
+        case PropertyID::Text:
+            if(auto* v = std::get_if<std::wstring>(&value)) { SetText(*v); return true; }
+            break;
+        case PropertyID::TextColor:
+            if(auto* v = std::get_if<Color>(&value)) { SetTextColor(*v); return true; }
+            break;
+        default:
+            break;
+    }
+    return Widget::ApplyProperty(property, value);
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+#include "Widget.h"
+#include "Color.h"
+#include "GapBuffer.h"
+
+// Editable text field (single or multi-line)
+// Content lives in a gap buffer, so edits at the caret don't rewrite the text; the caret line keeps
+// cached prefix advances, so typing only measures the typed characters.
+// Edits repaint the edited line (or everything below it, if lines were added/removed) and nothing else.
+// Focusable; the caret is only drawn while focused.
+class TextInput : public Widget {
+    public:
+        // Constructor
+        explicit TextInput(bool multiLine = false);
+
+        // Content
+        std::wstring GetText() const;
+        void SetText(const std::wstring& newText);
+        size_t GetLength() const { return buffer.Size(); }
+        size_t GetLineCount() const { return lineStarts.size(); }
+        bool IsMultiLine() const { return multiLine; }
+
+        // Editing at the caret (line breaks become spaces in single-line inputs)
+        void InsertText(const wchar_t* text, size_t length);
+        void InsertText(const std::wstring& text) { InsertText(text.c_str(), text.size()); }
+        void DeleteBackward();
+        void DeleteForward();
+
+        // Caret
+        size_t GetCaret() const { return caret; }
+        void SetCaret(size_t pos);
+        void MoveCaretLeft();
+        void MoveCaretRight();
+        void MoveCaretUp();     // Keeps the x position across lines of different lengths
+        void MoveCaretDown();
+        void MoveCaretHome();   // Line start
+        void MoveCaretEnd();    // Line end
+        int GetCaretX();        // Relative to the start of the caret line
+
+        // Appearance
+        // Colors are stored in the shared style ("TextInput" class by default), the text color per input
+        HFONT GetFont() const { return style->GetFont(); }
+        void SetFont(HFONT newFont) { Restyle([&](StyleDesc& d) { d.font = newFont; }); }
+        Color GetTextColor() const { return StateTextColor(StyleState::Normal); }
+        void SetTextColor(Color newColor) { SetTextColorOverride(newColor); }
+
+        // Default looks of the "TextInput" style class
+        static StyleDesc DefaultStyle();
+
+        // Generic properties
+        bool ApplyProperty(PropertyID property, const PropertyValue& value) override;
+
+        // Rendering
+        void Render(Painter& painter) override;
+        int GetBaseline(int height) const override;
+
+        // Behavior
+        void SetOnChange(std::function<void()> cb) { onChange = std::move(cb); }
+
+    protected:
+        void OnMouseEvent(const MouseEvent& e) override;
+        bool OnKeyEvent(const KeyEvent& e) override;
+        bool OnCharEvent(const CharEvent& e) override;
+        void OnFocusChanged(bool focused) override;
+        void OnStyleChanged() override;
+
+    private:
+        bool multiLine;
+        GapBuffer<wchar_t> buffer;
+
+        // Line starts; an edit shifts the lines after it lazily (the shift is kept pending while edits
+        // stay on the same line), so typing doesn't touch the whole index
+        std::vector<size_t> lineStarts = {0};
+        size_t shiftedAfter = 0;    // Lines after this one...
+        ptrdiff_t pendingShift = 0; // ...are off by this much
+
+        size_t caret = 0;
+        size_t caretLine = 0;
+        int preferredX = -1;        // Kept by vertical caret moves (-1 = caret x)
+
+        // Prefix advances of one line (advances[i] = x of column i)
+        size_t measuredLine = SIZE_MAX;
+        std::vector<int> advances;
+        std::wstring scratch;       // Line text for measuring/drawing (reused)
+
+        int scrollX = 0;
+        int scrollY = 0;
+
+        std::function<void()> onChange;
+
+        // Line index
+        size_t LineStart(size_t line) const {
+            return line > shiftedAfter ? lineStarts[line] + pendingShift : lineStarts[line];
+        }
+        size_t LineEnd(size_t line) const { // Excludes the '\n'
+            return line + 1 < lineStarts.size() ? LineStart(line + 1) - 1 : buffer.Size();
+        }
+        size_t LineOf(size_t pos) const;
+        void ShiftLines(size_t line, ptrdiff_t delta);
+        void FlushLineShift();
+
+        // Measuring
+        const std::vector<int>& LineAdvances(size_t line);
+        size_t ColumnAt(size_t line, int x); // Nearest column boundary to x
+        int LineHeight() const;
+        void CopyLine(size_t line);
+
+        // Caret & painting
+        void PlaceCaret(size_t pos, bool keepPreferredX = false);
+        bool ScrollToCaret();   // Returns true if the view moved
+        RECT LineRect(size_t line, bool toBottom) const;
+        void InvalidateLines(size_t line, bool toBottom);
+        void NotifyChanged();
+};
@@ -0,0 +1,118 @@
+#include <cstdio>
+#include <vector>
+
+#include "Root.h"
+#include "AnchorLayout.h"
+#include "LayoutBatch.h"
+#include "Check.h"
+
+// Constraint solver cost for 100 chains of 50 children (each child anchored to the right of the previous one,
+// every width a share of the container): full solve, one chain head moved, container resized, batched constraint churn
+
+namespace {
+    const int Chains = 100;
+    const int ChainLength = 50;
+    const int Gap = 2;
+
+    struct Scene {
+        std::shared_ptr<Root> root;
+        std::shared_ptr<Container> box;
+        AnchorLayout* layout;
+        std::vector<Widget*> widgets;
+        std::vector<AnchorLayout::ConstraintID> heads; // Left constraint of each chain's first child
+    };
+
+    Scene Build() {
+        Scene s;
+        s.root = Root::Create(4000, 3000);
+        s.box = std::make_shared<Container>();
+        s.box->SetSize(1000, 2500);
+        auto anchor = std::make_unique<AnchorLayout>();
+        s.layout = anchor.get();
+        s.box->SetLayout(std::move(anchor));
+
+        LayoutBatch::ScopedDefer defer;
+        for(int c = 0; c < Chains; c++) {
+            Widget* previous = nullptr;
+            for(int i = 0; i < ChainLength; i++) {
+                auto w = std::make_shared<Widget>();
+                w->SetSize(10, 20);
+                s.box->AddChild(w);
+
+                if(previous) {
+                    s.layout->AddConstraint(w.get(), AnchorEdge::Left, previous, AnchorEdge::Right, Gap);
+                }
+                else {
+                    s.heads.push_back(s.layout->AddConstraint(w.get(), AnchorEdge::Left, nullptr, AnchorEdge::Left));
+                }
+                s.layout->AddConstraint(w.get(), AnchorEdge::Width, nullptr, AnchorEdge::Width, 0, 0.015f);
+                s.layout->AddConstraint(w.get(), AnchorEdge::Top, nullptr, AnchorEdge::Top, c * 24);
+                s.widgets.push_back(w.get());
+                previous = w.get();
+            }
+        }
+        s.root->AddChild(s.box);
+        return s;
+    }
+
+    // Every chain laid out from its head's offset, children of the expected width
+    bool ChainsAreSolved(Scene& s, int width, int headOffset) {
+        RECT origin = s.box->EffectiveRect();
+        for(int c = 0; c < Chains; c++) {
+            for(int i = 0; i < ChainLength; i++) {
+                RECT r = s.widgets[c * ChainLength + i]->EffectiveRect();
+                int left = (c == 0 ? headOffset : 0) + i * (width + Gap);
+                if(r.left - origin.left != left || r.right - r.left != width || r.top - origin.top != c * 24) return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    const int Runs = 50;
+
+    Scene s = Build();
+    double fullMs = MeasureMs(1, [&] { s.root->UpdateInternalLayout(); });
+    CHECK(ChainsAreSolved(s, 15, 0));
+
+    // Moving the first chain re-solves its 50 horizontal axes only
+    int offset = 0;
+    double headMs = MeasureMs(Runs, [&] {
+        offset = offset == 0 ? 7 : 0;
+        s.layout->SetConstraintOffset(s.heads[0], offset);
+        s.root->UpdateInternalLayout();
+    });
+    CHECK(ChainsAreSolved(s, 15, offset));
+
+    // Resizing the container re-solves every width (and so every position)
+    int width = 1000;
+    double resizeMs = MeasureMs(Runs, [&] {
+        width = width == 1000 ? 2000 : 1000;
+        s.box->SetSize(width, 2500);
+        s.root->UpdateInternalLayout();
+    });
+    CHECK(ChainsAreSolved(s, width == 1000 ? 15 : 30, offset));
+
+    // Churn: removed slots are reused, and stale IDs don't touch the new constraint
+    Widget* last = s.widgets.back();
+    AnchorLayout::ConstraintID id = s.layout->AddConstraint(last, AnchorEdge::Height, nullptr, AnchorEdge::Height, 0, 0.0f);
+    uint32_t slot = static_cast<uint32_t>(id);
+    bool reused = true;
+    double churnMs = MeasureMs(1, [&] {
+        LayoutBatch::ScopedCollect batch; // One reflow for the whole edit
+        for(int i = 0; i < 10000; i++) {
+            s.layout->RemoveConstraint(id);
+            AnchorLayout::ConstraintID next = s.layout->AddConstraint(last, AnchorEdge::Height, nullptr, AnchorEdge::Height, 0, 0.0f);
+            reused = reused && static_cast<uint32_t>(next) == slot && next != id && !s.layout->SetConstraintOffset(id, 5);
+            id = next;
+        }
+        s.layout->RemoveConstraint(id);
+    });
+    CHECK(reused);
+    CHECK(ChainsAreSolved(s, width == 1000 ? 15 : 30, offset));
+
+    std::printf("%d constrained children: full solve %.3f ms, chain head %.3f ms, resize %.3f ms, 10k remove/add %.3f ms\n",
+        Chains * ChainLength, fullMs, headMs, resizeMs, churnMs);
+    return CheckResult();
+}
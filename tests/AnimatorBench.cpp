@@ -0,0 +1,78 @@
+#include <cstdio>
+
+#include "Root.h"
+#include "Button.h"
+#include "Slider.h"
+#include "FlexLayout.h"
+#include "LayoutBatch.h"
+#include "RenderSnapshot.h"
+#include "Check.h"
+
+// 10k concurrent tweens (background colors of 5k buttons, values of 5k sliders) ticked at 60 fps until they finish,
+// a frame recorded after every tick. Every tween must end exactly on its target and complete once.
+
+int main() {
+    const int Pairs = 5000;
+    const float Duration = 0.5f;
+    const float Frame = 1.0f / 60.0f;
+
+    auto root = Root::Create(1920, 1080);
+    auto grid = std::make_shared<Container>();
+    grid->SetSize(1920, 1080);
+    auto flex = std::make_unique<FlexLayout>(FlexDirection::Row, 1);
+    flex->SetWrap(FlexWrap::Wrap);
+    grid->SetLayout(std::move(flex));
+
+    std::vector<std::shared_ptr<Button>> buttons;
+    std::vector<std::shared_ptr<Slider>> sliders;
+    {
+        LayoutBatch::ScopedDefer defer;
+        for(int i = 0; i < Pairs; i++) {
+            auto button = std::make_shared<Button>(L"b");
+            button->SetSize(12, 8);
+            grid->AddChild(button);
+            buttons.push_back(button);
+
+            auto slider = std::make_shared<Slider>(L"", 0.0f, 100.0f, 0.0f, 0.0f);
+            slider->SetShowLabel(false);
+            slider->SetShowValue(false);
+            slider->SetHandleHeight(8);
+            slider->SetSize(12, 8);
+            grid->AddChild(slider);
+            sliders.push_back(slider);
+        }
+    }
+    root->AddChild(grid);
+    root->UpdateInternalLayout();
+
+    Animator& animator = root->GetAnimator();
+    int completed = 0;
+    for(int i = 0; i < Pairs; i++) {
+        Color target = Color::FromRGB(uint8_t(i), uint8_t(i >> 8), 200);
+        CHECK(animator.Animate(buttons[i], PropertyID::BackgroundColor, Color::FromRGB(0, 0, 0), target, Duration,
+            Easing::EaseInOut, [&completed] { completed++; }));
+        CHECK(animator.Animate(sliders[i], PropertyID::Value, 0.0f, float(i % 101), Duration,
+            Easing::EaseOutCubic, [&completed] { completed++; }));
+    }
+    CHECK_EQ(animator.GetCount(), 2 * Pairs);
+
+    RenderSnapshot snapshot;
+    int ticks = 0;
+    double tickMs = 0.0, renderMs = 0.0;
+    while(root->IsAnimating() && ticks < 100) {
+        tickMs += MeasureMs(1, [&] { root->TickAnimations(Frame); });
+        renderMs += MeasureMs(1, [&] { root->RecordSnapshot(snapshot); });
+        root->MarkFrame();
+        ticks++;
+    }
+
+    CHECK_EQ(ticks, 30);
+    CHECK_EQ(completed, 2 * Pairs);
+    for(int i = 0; i < Pairs; i++) {
+        CHECK(buttons[i]->GetBackgroundColor() == Color::FromRGB(uint8_t(i), uint8_t(i >> 8), 200));
+        CHECK(sliders[i]->GetValue() == float(i % 101));
+    }
+
+    std::printf("%d tweens over %d frames: tick %.3f ms, record %.3f ms per frame\n", 2 * Pairs, ticks, tickMs / ticks, renderMs / ticks);
+    return CheckResult();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdio>
+#include <chrono>
+
+// Minimal assertion helpers for the test executables (no test framework dependency)
+// CHECK/CHECK_EQ report the failure and keep going; a test executable returns CheckResult() from main,
+// so ctest sees a non-zero exit code if any check failed.
+
+inline int& CheckFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void ReportFailure(const char* file, int line, const char* expression) {
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+    CheckFailures()++;
+}
+
+#define CHECK(expr) \
+    do { if(!(expr)) ReportFailure(__FILE__, __LINE__, #expr); } while(0)
+
+#define CHECK_EQ(actual, expected) \
+    do { \
+        long long a_ = static_cast<long long>(actual), e_ = static_cast<long long>(expected); \
+        if(a_ != e_) { \
+            std::fprintf(stderr, "%s:%d: %s = %lld, expected %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+            CheckFailures()++; \
+        } \
+    } while(0)
+
+inline int CheckResult() {
+    if(CheckFailures() > 0) std::fprintf(stderr, "%d check(s) failed\n", CheckFailures());
+    return CheckFailures() > 0 ? 1 : 0;
+}
+
+// Average wall time of fn in milliseconds over the given number of runs
+template<typename Fn>
+double MeasureMs(int runs, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < runs; i++) fn();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / runs;
+}
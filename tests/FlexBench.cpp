@@ -0,0 +1,61 @@
+#include <cstdio>
+#include <random>
+#include <climits>
+
+#include "Root.h"
+#include "FlexLayout.h"
+#include "LayoutBatch.h"
+#include "Check.h"
+
+// Flex resolution cost for one row of 10k children with mixed factors and limits (many of them clamping)
+// Every run resizes the row, so each layout resolves all flexible lengths again
+
+int main() {
+    const int ChildCount = 10000;
+    const int Runs = 50;
+
+    auto root = Root::Create(200000, 100);
+    auto row = std::make_shared<Container>();
+    row->SetSize(100000, 50);
+    row->SetLayout(std::make_unique<HorizontalLayout>(1));
+
+    // Built detached, laid out once when attached
+    {
+        LayoutBatch::ScopedDefer defer;
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> basis(0, 20), limit(0, 3);
+        for(int i = 0; i < ChildCount; i++) {
+            auto child = std::make_shared<Widget>();
+            child->SetSize(basis(rng), 20);
+            child->SetFlexGrowFactor(float(1 + i % 3));
+            child->SetMinSize(limit(rng) == 0 ? 5 : 0, -1);
+            child->SetMaxSize(limit(rng) == 0 ? 15 : INT_MAX, INT_MAX);
+            row->AddChild(child);
+        }
+    }
+    root->AddChild(row);
+    root->UpdateInternalLayout();
+
+    int width = 100000;
+    double growMs = MeasureMs(Runs, [&] {
+        width = width == 100000 ? 100001 : 100000;
+        row->SetSize(width, 50);
+        root->UpdateInternalLayout();
+    });
+    double shrinkMs = MeasureMs(Runs, [&] {
+        width = width == 40000 ? 40001 : 40000;
+        row->SetSize(width, 50);
+        root->UpdateInternalLayout();
+    });
+
+    // The line stays exactly full while resizing (children + 1 px spacing between them)
+    long long used = -1;
+    for(auto& child : row->Children()) {
+        RECT r = child->EffectiveRect();
+        used += r.right - r.left + 1;
+    }
+    CHECK_EQ(used, width);
+
+    std::printf("%d children: grow %.3f ms, shrink %.3f ms per layout\n", ChildCount, growMs, shrinkMs);
+    return CheckResult();
+}
@@ -0,0 +1,347 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include <climits>
+#include <algorithm>
+
+#include "Root.h"
+#include "Label.h"
+#include "FlexLayout.h"
+#include "TextMeasure.h"
+#include "Check.h"
+
+// FlexLayout::ResolveFlexibleLengths against hand-computed CSS results and against a straight implementation
+// of the CSS "resolve flexible lengths" freeze loop (css-flexbox-1, 9.7); baseline alignment and auto-sized labels
+
+namespace {
+    struct ItemSpec {
+        int basis;
+        float grow = 0.0f;
+        float shrink = 1.0f;
+        int min = 0;
+        int max = INT_MAX;
+    };
+
+    // Row of fixed-size children in a container of the given width; returns the resolved child widths
+    std::vector<int> LayOutRow(int width, const std::vector<ItemSpec>& specs, int spacing = 0) {
+        auto root = Root::Create(width + 100, 100);
+        auto row = std::make_shared<Container>();
+        row->SetSize(width, 50);
+        row->SetLayout(std::make_unique<HorizontalLayout>(spacing));
+        root->AddChild(row);
+
+        for(const ItemSpec& spec : specs) {
+            auto child = std::make_shared<Widget>();
+            child->SetSize(spec.basis, 20);
+            child->SetFlexGrowFactor(spec.grow);
+            child->SetFlexShrink(spec.shrink);
+            child->SetMinSize(spec.min, -1);
+            child->SetMaxSize(spec.max, INT_MAX);
+            row->AddChild(child);
+        }
+        root->UpdateInternalLayout();
+
+        std::vector<int> widths;
+        for(auto& child : row->Children()) {
+            RECT r = child->EffectiveRect();
+            widths.push_back(r.right - r.left);
+        }
+        return widths;
+    }
+
+    // FlexLayout counting its passes
+    class CountingFlexLayout : public FlexLayout {
+        public:
+            using FlexLayout::FlexLayout;
+            int passes = 0;
+
+            void Apply(const RECT& innerRect) override {
+                passes++;
+                FlexLayout::Apply(innerRect);
+            }
+    };
+
+    HFONT MakeFont(int height) {
+        return CreateFontW(-height, 0, 0, 0, 400, 0, 0, 0, 0, 0, 0, 0, 0, L"Segoe UI");
+    }
+
+    // The CSS algorithm as specified: distribute, clamp, freeze the violators, repeat
+    std::vector<double> ReferenceLengths(int available, const std::vector<ItemSpec>& specs) {
+        size_t n = specs.size();
+        std::vector<double> size(n), hypothetical(n);
+        std::vector<bool> frozen(n, false);
+
+        double hypotheticalSum = 0.0;
+        for(size_t i = 0; i < n; i++) {
+            int max = std::max(specs[i].min, specs[i].max);
+            hypothetical[i] = std::max(specs[i].min, std::min(specs[i].basis, max));
+            hypotheticalSum += hypothetical[i];
+        }
+        bool growing = hypotheticalSum < available;
+
+        auto factor = [&](size_t i) { return growing ? specs[i].grow : specs[i].shrink; };
+        for(size_t i = 0; i < n; i++) {
+            size[i] = hypothetical[i];
+            if(factor(i) == 0.0f || (growing && specs[i].basis > hypothetical[i]) || (!growing && specs[i].basis < hypothetical[i])) {
+                frozen[i] = true;
+            }
+        }
+
+        auto freeSpace = [&]() {
+            double used = 0.0;
+            for(size_t i = 0; i < n; i++) used += frozen[i] ? size[i] : specs[i].basis;
+            return available - used;
+        };
+        double initialFree = freeSpace();
+
+        while(std::find(frozen.begin(), frozen.end(), false) != frozen.end()) {
+            double factorSum = 0.0;
+            for(size_t i = 0; i < n; i++) {
+                if(!frozen[i]) factorSum += factor(i);
+            }
+            double remaining = freeSpace();
+            if(factorSum < 1.0 && std::fabs(initialFree * factorSum) < std::fabs(remaining)) {
+                remaining = initialFree * factorSum;
+            }
+
+            double scaledSum = 0.0;
+            for(size_t i = 0; i < n; i++) {
+                if(!frozen[i]) scaledSum += growing ? specs[i].grow : double(specs[i].shrink) * specs[i].basis;
+            }
+
+            double violation = 0.0;
+            std::vector<double> target(n), clamped(n);
+            for(size_t i = 0; i < n; i++) {
+                if(frozen[i]) continue;
+                double share = growing ? specs[i].grow : double(specs[i].shrink) * specs[i].basis;
+                target[i] = specs[i].basis + (scaledSum > 0.0 ? remaining * share / scaledSum : 0.0);
+
+                double max = std::max(specs[i].min, specs[i].max);
+                clamped[i] = std::max<double>(specs[i].min, std::min(target[i], max));
+                violation += clamped[i] - target[i];
+            }
+
+            for(size_t i = 0; i < n; i++) {
+                if(frozen[i]) continue;
+                size[i] = clamped[i];
+                bool freeze = std::fabs(violation) < 1e-9
+                    || (violation > 0.0 && clamped[i] > target[i])
+                    || (violation < 0.0 && clamped[i] < target[i]);
+                if(freeze) frozen[i] = true;
+            }
+        }
+        return size;
+    }
+
+    int Sum(const std::vector<int>& v) {
+        int sum = 0;
+        for(int x : v) sum += x;
+        return sum;
+    }
+
+    void CheckWidths(const std::vector<int>& actual, const std::vector<int>& expected) {
+        CHECK_EQ(actual.size(), expected.size());
+        for(size_t i = 0; i < actual.size() && i < expected.size(); i++) {
+            CHECK_EQ(actual[i], expected[i]);
+        }
+    }
+}
+
+void TestGrow() {
+    // Free 100 split 1:2
+    CheckWidths(LayOutRow(300, {{100, 1}, {100, 2}}), {133, 167});
+    // b hits its max; a takes the rest
+    CheckWidths(LayOutRow(300, {{100, 1}, {100, 2, 1, 0, 120}}), {180, 120});
+    // a starts below its min: it's frozen at the min, the rest is split
+    CheckWidths(LayOutRow(100, {{0, 1, 1, 50}, {0, 1}, {0, 1}}), {50, 25, 25});
+    // Factors below 1 in total only take that fraction of the free space
+    CheckWidths(LayOutRow(100, {{0, 0.25f}, {0, 0.25f}}), {25, 25});
+    // Nothing grows: children keep their sizes
+    CheckWidths(LayOutRow(300, {{100}, {50}}), {100, 50});
+}
+
+void TestShrink() {
+    // Overflow 200 shrunk in proportion to shrink * basis
+    CheckWidths(LayOutRow(300, {{200}, {200}, {100}}), {120, 120, 60});
+    // c is held at its min; the overflow that's left goes to the others
+    CheckWidths(LayOutRow(300, {{200, 0, 1, 150}, {200}, {100}}), {150, 100, 50});
+    // shrink 0 never shrinks (overflows instead)
+    CheckWidths(LayOutRow(100, {{80, 0, 0}, {80, 0, 0}}), {80, 80});
+    // Everything at its min: the line overflows
+    CheckWidths(LayOutRow(100, {{80, 0, 1, 70}, {80, 0, 1, 70}}), {70, 70});
+}
+
+void TestRounding() {
+    // Thirds: rounded by cumulative edges, the line keeps all 100 pixels
+    std::vector<int> thirds = LayOutRow(100, {{0, 1}, {0, 1}, {0, 1}});
+    CheckWidths(thirds, {33, 34, 33});
+
+    // Sevenths of 1000 with spacing: every child within a pixel of 1000 / 7, the line exactly full
+    std::vector<ItemSpec> seven(7, ItemSpec{0, 1});
+    std::vector<int> sevenths = LayOutRow(1000 + 6 * 3, seven, 3);
+    CHECK_EQ(Sum(sevenths), 1000);
+    for(int w : sevenths) CHECK(w == 142 || w == 143);
+
+    // A clamped child between fractional ones keeps its exact limit, and no pixel is lost around it
+    std::vector<int> clamped = LayOutRow(101, {{0, 1}, {0, 1, 1, 0, 20}, {0, 1}, {0, 1}});
+    CHECK_EQ(clamped[1], 20);
+    CHECK_EQ(Sum(clamped), 101);
+
+    // An edge at x.5 in front of a child at its max: rounding (and float noise) puts the child one pixel past its max.
+    // The clamp must hand that pixel to the next child, not drop it.
+    std::vector<int> tie = LayOutRow(1365, {
+        {7, 1.5f, 0}, {93, 1, 3, 23, 46}, {94, 3, 1}, {155, 1, 1.5f, 38, 140}, {88, 3, 1}, {190, 3, 1.5f},
+        {98, 1.5f, 3}, {18, 3, 0, 112}, {55, 3, 2}, {80, 0, 3}, {21, 3, 0}
+    });
+    CHECK_EQ(tie[3], 140);
+    CHECK_EQ(Sum(tie), 1365);
+
+    // Tiny fractional shares next to big clamped ones
+    std::vector<ItemSpec> mixed;
+    for(int i = 0; i < 50; i++) {
+        mixed.push_back(i % 5 == 0 ? ItemSpec{10, 1, 1, 0, 11} : ItemSpec{3, 0.1f});
+    }
+    std::vector<int> widths = LayOutRow(1003, mixed);
+    CHECK_EQ(Sum(widths), 1003);
+    for(size_t i = 0; i < widths.size(); i++) {
+        if(i % 5 == 0) CHECK_EQ(widths[i], 11);
+    }
+}
+
+void TestAgainstReference() {
+    std::mt19937 rng(12345);
+    auto pick = [&](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); };
+    // Fractional factors only where their sum can't drop below 1 as children freeze (see ResolveFlexibleLengths)
+    const float factors[] = {0.0f, 1.0f, 1.0f, 2.0f, 3.0f, 1.5f};
+
+    for(int round = 0; round < 20000; round++) {
+        std::vector<ItemSpec> specs(pick(1, 12));
+        for(ItemSpec& s : specs) {
+            s.basis = pick(0, 200);
+            s.grow = factors[pick(0, 5)];
+            s.shrink = factors[pick(0, 5)];
+            s.min = pick(0, 3) == 0 ? pick(0, 150) : 0;
+            s.max = pick(0, 3) == 0 ? pick(0, 250) : INT_MAX;
+        }
+        int width = pick(0, 1500);
+
+        std::vector<int> actual = LayOutRow(width, specs);
+        std::vector<double> expected = ReferenceLengths(width, specs);
+
+        double expectedSum = 0.0;
+        for(size_t i = 0; i < specs.size(); i++) {
+            int max = std::max(specs[i].min, specs[i].max);
+            CHECK(actual[i] >= specs[i].min && actual[i] <= max);
+            CHECK(std::fabs(actual[i] - expected[i]) < 1.0 + 1e-6);
+            expectedSum += expected[i];
+        }
+        // Rounding never gains or loses pixels on the line as a whole
+        CHECK_EQ(Sum(actual), std::lround(expectedSum));
+    }
+}
+
+void TestBaselineMixedFonts() {
+    auto root = Root::Create(800, 400);
+    auto row = std::make_shared<Container>();
+    row->SetSize(600, 200);
+    auto flex = std::make_unique<FlexLayout>(FlexDirection::Row, 4);
+    flex->SetAlign(AlignItems::Baseline);
+    row->SetLayout(std::move(flex));
+    root->AddChild(row);
+
+    HFONT fonts[] = {nullptr, MakeFont(40), MakeFont(24)};
+    std::vector<std::shared_ptr<Label>> labels;
+    for(HFONT font : fonts) {
+        auto label = std::make_shared<Label>(L"Baseline");
+        label->SetFont(font);
+        row->AddChild(label);
+        labels.push_back(label);
+    }
+    auto box = std::make_shared<Widget>(); // No text - its bottom edge is its baseline
+    box->SetSize(20, 10);
+    row->AddChild(box);
+    root->UpdateInternalLayout();
+
+    // Every text baseline on the line of the tallest ascent
+    int lineBaseline = 10;
+    for(HFONT font : fonts) {
+        lineBaseline = std::max(lineBaseline, TextMeasure::GetFontMetrics(font).ascent);
+    }
+    RECT origin = row->EffectiveRect();
+    for(size_t i = 0; i < labels.size(); i++) {
+        TextMeasure::FontMetrics metrics = TextMeasure::GetFontMetrics(fonts[i]);
+        RECT r = labels[i]->EffectiveRect();
+        CHECK_EQ(r.top - origin.top + metrics.ascent, lineBaseline);
+        CHECK_EQ(r.bottom - r.top, metrics.height);
+    }
+    CHECK_EQ(box->EffectiveRect().bottom - origin.top, lineBaseline);
+    CHECK(TextMeasure::GetFontMetrics(fonts[1]).ascent > TextMeasure::GetFontMetrics(fonts[2]).ascent);
+
+    // Bigger text on another label moves the line baseline - and everyone with it
+    labels[2]->SetFont(MakeFont(64));
+    root->UpdateInternalLayout();
+    int newBaseline = TextMeasure::GetFontMetrics(labels[2]->GetFont()).ascent;
+    CHECK_EQ(labels[2]->EffectiveRect().top, origin.top);
+    CHECK_EQ(labels[0]->EffectiveRect().top - origin.top + TextMeasure::GetFontMetrics(nullptr).ascent, newBaseline);
+}
+
+void TestAutoSizedLabelsSinglePass() {
+    auto root = Root::Create(1000, 200);
+    auto row = std::make_shared<Container>();
+    row->SetSize(0, 100);
+    row->SetAutoWidth(true);
+    auto flex = std::make_unique<CountingFlexLayout>(FlexDirection::Row, 5);
+    CountingFlexLayout* layout = flex.get();
+    row->SetLayout(std::move(flex));
+    root->AddChild(row);
+
+    HFONT fonts[] = {nullptr, MakeFont(32), MakeFont(20), nullptr};
+    const wchar_t* texts[] = {L"a", L"bcd", L"efghij", L"klmnopqrst"};
+    std::vector<std::shared_ptr<Label>> labels;
+    for(int i = 0; i < 4; i++) {
+        auto label = std::make_shared<Label>(texts[i]);
+        label->SetFont(fonts[i]);
+        row->AddChild(label);
+        labels.push_back(label);
+    }
+    root->UpdateInternalLayout();
+
+    // Labels are measured up front: one pass gives every label its text size and the row its content width
+    auto check = [&] {
+        RECT origin = row->EffectiveRect();
+        int x = 0;
+        for(auto& label : labels) {
+            const std::wstring& text = label->GetText();
+            SIZE size = TextMeasure::MeasureString(label->GetFont(), text.c_str(), (int)text.size());
+            RECT r = label->EffectiveRect();
+            CHECK_EQ(r.left - origin.left, x);
+            CHECK_EQ(r.right - r.left, size.cx);
+            CHECK_EQ(r.bottom - r.top, size.cy);
+            x += size.cx + 5;
+        }
+        CHECK_EQ(origin.right - origin.left, x - 5);
+    };
+    check();
+
+    // A text change is a single pass over the row
+    layout->passes = 0;
+    labels[1]->SetText(L"a much longer text");
+    CHECK_EQ(layout->passes, 1);
+    check();
+
+    // Nothing left for another pass to change
+    RECT before = labels[3]->EffectiveRect();
+    labels[3]->InvalidateLayout();
+    RECT after = labels[3]->EffectiveRect();
+    CHECK(before.left == after.left && before.right == after.right && before.top == after.top && before.bottom == after.bottom);
+}
+
+int main() {
+    TestGrow();
+    TestShrink();
+    TestRounding();
+    TestAgainstReference();
+    TestBaselineMixedFonts();
+    TestAutoSizedLabelsSinglePass();
+    return CheckResult();
+}
@@ -0,0 +1,64 @@
+#include <cstdio>
+#include <random>
+#include <map>
+
+#include "Root.h"
+#include "FlexLayout.h"
+#include "LayoutBatch.h"
+#include "Check.h"
+
+// Line breaking + per-line flex resolution for 10k wrapped children with mixed bases and grow factors
+// Every run resizes the container, so lines are broken and resolved again
+
+int main() {
+    const int ChildCount = 10000;
+    const int Runs = 50;
+    const int Spacing = 2;
+
+    auto root = Root::Create(4000, 100000);
+    auto box = std::make_shared<Container>();
+    box->SetSize(1920, 100000);
+    auto flex = std::make_unique<FlexLayout>(FlexDirection::Row, Spacing);
+    flex->SetWrap(FlexWrap::Wrap);
+    flex->SetLineSpacing(2);
+    box->SetLayout(std::move(flex));
+
+    {
+        LayoutBatch::ScopedDefer defer;
+        std::mt19937 rng(35);
+        std::uniform_int_distribution<int> basis(10, 120);
+        for(int i = 0; i < ChildCount; i++) {
+            auto child = std::make_shared<Widget>();
+            child->SetSize(basis(rng), 16);
+            child->SetFlexGrowFactor(float(1 + i % 3));
+            box->AddChild(child);
+        }
+    }
+    root->AddChild(box);
+    root->UpdateInternalLayout();
+
+    int width = 1920;
+    double ms = MeasureMs(Runs, [&] {
+        width = width == 1920 ? 1601 : 1920;
+        box->SetSize(width, 100000);
+        root->UpdateInternalLayout();
+    });
+
+    // Every line fills the width exactly - all children grow, the last line included
+    RECT origin = box->EffectiveRect();
+    std::map<LONG, long long> used;  // Line top -> children + spacing between them
+    std::map<LONG, int> counts;
+    for(auto& child : box->Children()) {
+        RECT r = child->EffectiveRect();
+        CHECK(r.left >= origin.left && r.right <= origin.right);
+        used[r.top] += r.right - r.left;
+        counts[r.top]++;
+    }
+    for(auto& line : used) {
+        CHECK_EQ(line.second + (counts[line.first] - 1) * Spacing, width);
+    }
+    CHECK(used.size() > 1);
+
+    std::printf("%d children in %zu lines: %.3f ms per layout\n", ChildCount, used.size(), ms);
+    return CheckResult();
+}
@@ -0,0 +1,241 @@
+#include <vector>
+#include <climits>
+
+#include "Root.h"
+#include "FlexLayout.h"
+#include "Check.h"
+
+// Multi-line FlexLayout (flex-wrap, align-content, line spacing = row-gap) against the CSS results
+// Every expected rect is what a browser computes for the equivalent flex container:
+//     display: flex; flex-wrap: wrap; column-gap: <spacing>; row-gap: <lineSpacing>; align-items: flex-start;
+// with fixed-size children (flex: 0 1 auto unless noted). Sizes are chosen so CSS has no fractional positions.
+
+namespace {
+    struct Box {
+        int x, y, w, h;
+    };
+
+    struct Fixture {
+        std::shared_ptr<Root> root;
+        std::shared_ptr<Container> box;
+        FlexLayout* layout;
+
+        Fixture(FlexDirection direction, int width, int height, int spacing, int lineSpacing) {
+            root = Root::Create(1000, 1000);
+            box = std::make_shared<Container>();
+            box->SetSize(width, height);
+
+            auto flex = std::make_unique<FlexLayout>(direction, spacing);
+            flex->SetWrap(FlexWrap::Wrap);
+            flex->SetLineSpacing(lineSpacing);
+            layout = flex.get();
+            box->SetLayout(std::move(flex));
+            root->AddChild(box);
+        }
+
+        Widget& Add(int w, int h) {
+            auto child = std::make_shared<Widget>();
+            child->SetSize(w, h);
+            box->AddChild(child);
+            return *child;
+        }
+        void AddMany(int count, int w, int h) {
+            for(int i = 0; i < count; i++) Add(w, h);
+        }
+
+        // Child rects relative to the container's content box
+        std::vector<Box> Boxes() {
+            box->InvalidateLayout();
+            root->UpdateInternalLayout();
+
+            RECT origin = box->EffectiveRect();
+            std::vector<Box> out;
+            for(auto& child : box->Children()) {
+                RECT r = child->EffectiveRect();
+                out.push_back({int(r.left - origin.left), int(r.top - origin.top), int(r.right - r.left), int(r.bottom - r.top)});
+            }
+            return out;
+        }
+    };
+
+    void CheckBoxes(const std::vector<Box>& actual, const std::vector<Box>& expected, int line) {
+        if(actual.size() != expected.size()) {
+            std::fprintf(stderr, "line %d: %zu children, expected %zu\n", line, actual.size(), expected.size());
+            CheckFailures()++;
+            return;
+        }
+        for(size_t i = 0; i < actual.size(); i++) {
+            const Box& a = actual[i];
+            const Box& e = expected[i];
+            if(a.x != e.x || a.y != e.y || a.w != e.w || a.h != e.h) {
+                std::fprintf(stderr, "line %d: child %zu at %d,%d %dx%d, expected %d,%d %dx%d\n",
+                    line, i, a.x, a.y, a.w, a.h, e.x, e.y, e.w, e.h);
+                CheckFailures()++;
+            }
+        }
+    }
+}
+
+#define CHECK_BOXES(actual, ...) CheckBoxes(actual, __VA_ARGS__, __LINE__)
+
+void TestLineBreaking() {
+    // 60 + 10 + 60 + 10 + 60 = 200: three fit exactly, the line breaks before the fourth
+    Fixture exact(FlexDirection::Row, 200, 200, 10, 5);
+    exact.AddMany(5, 60, 30);
+    CHECK_BOXES(exact.Boxes(), {{0, 0, 60, 30}, {70, 0, 60, 30}, {140, 0, 60, 30}, {0, 35, 60, 30}, {70, 35, 60, 30}});
+
+    // One pixel narrower: two per line
+    Fixture narrow(FlexDirection::Row, 199, 200, 10, 5);
+    narrow.AddMany(5, 60, 30);
+    CHECK_BOXES(narrow.Boxes(), {{0, 0, 60, 30}, {70, 0, 60, 30}, {0, 35, 60, 30}, {70, 35, 60, 30}, {0, 70, 60, 30}});
+
+    // Breaking uses the hypothetical size (basis clamped by max-width: 50), margins included
+    Fixture clamped(FlexDirection::Row, 115, 200, 0, 0);
+    clamped.Add(100, 20).SetMaxSize(50, INT_MAX);
+    clamped.Add(50, 20).SetMargin(0, 0, 5, 5);
+    clamped.Add(10, 20);
+    CHECK_BOXES(clamped.Boxes(), {{0, 0, 50, 20}, {55, 0, 50, 20}, {0, 20, 10, 20}});
+
+    // A child wider than the container gets a line of its own and shrinks to fit it (flex-shrink: 1)
+    Fixture wide(FlexDirection::Row, 100, 200, 0, 0);
+    wide.Add(50, 20);
+    wide.Add(150, 20);
+    wide.Add(50, 20);
+    CHECK_BOXES(wide.Boxes(), {{0, 0, 50, 20}, {0, 20, 100, 20}, {0, 40, 50, 20}});
+
+    // Lines are as tall as their tallest child
+    Fixture tall(FlexDirection::Row, 100, 200, 0, 4);
+    tall.Add(50, 20);
+    tall.Add(50, 40);
+    tall.Add(50, 10);
+    CHECK_BOXES(tall.Boxes(), {{0, 0, 50, 20}, {50, 0, 50, 40}, {0, 44, 50, 10}});
+}
+
+void TestFlexWithinLines() {
+    // flex-grow works per line: the second line's free 190 - 2 * 60 is split between its children
+    Fixture grow(FlexDirection::Row, 200, 200, 10, 5);
+    grow.AddMany(3, 60, 30);
+    grow.Add(60, 30).SetFlexGrowFactor(1);
+    grow.Add(60, 30).SetFlexGrowFactor(1);
+    CHECK_BOXES(grow.Boxes(), {{0, 0, 60, 30}, {70, 0, 60, 30}, {140, 0, 60, 30}, {0, 35, 95, 30}, {105, 35, 95, 30}});
+
+    // justify-content applies per line
+    Fixture justify(FlexDirection::Row, 200, 200, 10, 5);
+    justify.layout->SetJustify(JustifyContent::SpaceBetween);
+    justify.AddMany(5, 60, 30);
+    CHECK_BOXES(justify.Boxes(), {{0, 0, 60, 30}, {70, 0, 60, 30}, {140, 0, 60, 30}, {0, 35, 60, 30}, {140, 35, 60, 30}});
+
+    Fixture center(FlexDirection::Row, 200, 200, 10, 5);
+    center.layout->SetJustify(JustifyContent::Center);
+    center.AddMany(4, 60, 30);
+    CHECK_BOXES(center.Boxes(), {{0, 0, 60, 30}, {70, 0, 60, 30}, {140, 0, 60, 30}, {70, 35, 60, 30}});
+}
+
+void TestAlignContent() {
+    // Two lines of 30 with a row-gap of 5 in 185: 120 free on the cross axis
+    struct Case {
+        AlignContent align;
+        int first, second;  // Line tops
+        int height;         // Line cross size (stretch grows it; fixed-height children keep theirs)
+    };
+    const Case cases[] = {
+        {AlignContent::Start,        0,   35,  30},
+        {AlignContent::Center,       60,  95,  30},
+        {AlignContent::End,          120, 155, 30},
+        {AlignContent::SpaceBetween, 0,   155, 30},
+        {AlignContent::SpaceAround,  30,  125, 30}, // 60 around each line: 30 before, 30 + 30 between
+        {AlignContent::SpaceEvenly,  40,  115, 30}, // 40 before, between and after
+        {AlignContent::Stretch,      0,   95,  90}, // Each line grows by 60
+    };
+
+    for(const Case& c : cases) {
+        Fixture f(FlexDirection::Row, 200, 185, 10, 5);
+        f.layout->SetAlignContent(c.align);
+        f.AddMany(5, 60, 30);
+        std::vector<Box> boxes = f.Boxes();
+        CHECK_BOXES(boxes, {
+            {0, c.first, 60, 30}, {70, c.first, 60, 30}, {140, c.first, 60, 30},
+            {0, c.second, 60, 30}, {70, c.second, 60, 30}
+        });
+
+        // align-items: flex-end puts the children at the bottom of their (stretched) lines
+        Fixture end(FlexDirection::Row, 200, 185, 10, 5);
+        end.layout->SetAlignContent(c.align);
+        end.layout->SetAlign(AlignItems::End);
+        end.AddMany(4, 60, 30);
+        int offset = c.height - 30;
+        CHECK_BOXES(end.Boxes(), {
+            {0, c.first + offset, 60, 30}, {70, c.first + offset, 60, 30}, {140, c.first + offset, 60, 30},
+            {0, c.second + offset, 60, 30}
+        });
+    }
+
+    // A single line is distributed too (align-content applies to any multi-line container)
+    Fixture single(FlexDirection::Row, 200, 100, 10, 5);
+    single.layout->SetAlignContent(AlignContent::Center);
+    single.AddMany(2, 60, 30);
+    CHECK_BOXES(single.Boxes(), {{0, 35, 60, 30}, {70, 35, 60, 30}});
+
+    // Negative free space: space-between falls back to flex-start, the lines overflow the cross end
+    Fixture overflow(FlexDirection::Row, 60, 50, 0, 5);
+    overflow.layout->SetAlignContent(AlignContent::SpaceBetween);
+    overflow.AddMany(3, 60, 30);
+    CHECK_BOXES(overflow.Boxes(), {{0, 0, 60, 30}, {0, 35, 60, 30}, {0, 70, 60, 30}});
+}
+
+void TestWrapReverse() {
+    // Lines stack from the cross end: the first line is at the bottom
+    Fixture start(FlexDirection::Row, 200, 185, 10, 5);
+    start.layout->SetWrap(FlexWrap::WrapReverse);
+    start.AddMany(5, 60, 30);
+    CHECK_BOXES(start.Boxes(), {{0, 155, 60, 30}, {70, 155, 60, 30}, {140, 155, 60, 30}, {0, 120, 60, 30}, {70, 120, 60, 30}});
+
+    // align-content: flex-start is the cross start - the bottom edge with wrap-reverse; flex-end the top
+    Fixture end(FlexDirection::Row, 200, 185, 10, 5);
+    end.layout->SetWrap(FlexWrap::WrapReverse);
+    end.layout->SetAlignContent(AlignContent::End);
+    end.AddMany(5, 60, 30);
+    CHECK_BOXES(end.Boxes(), {{0, 35, 60, 30}, {70, 35, 60, 30}, {140, 35, 60, 30}, {0, 0, 60, 30}, {70, 0, 60, 30}});
+}
+
+void TestColumns() {
+    // flex-direction: column; flex-wrap: wrap in 100px height: 30 + 10 + 30 fit, the third starts a new column
+    Fixture f(FlexDirection::Column, 200, 100, 10, 5);
+    f.AddMany(5, 40, 30);
+    CHECK_BOXES(f.Boxes(), {{0, 0, 40, 30}, {0, 40, 40, 30}, {45, 0, 40, 30}, {45, 40, 40, 30}, {90, 0, 40, 30}});
+
+    // align-content: space-between pushes the last column to the right edge
+    Fixture between(FlexDirection::Column, 200, 100, 10, 5);
+    between.layout->SetAlignContent(AlignContent::SpaceBetween);
+    between.AddMany(4, 40, 30);
+    CHECK_BOXES(between.Boxes(), {{0, 0, 40, 30}, {0, 40, 40, 30}, {160, 0, 40, 30}, {160, 40, 40, 30}});
+}
+
+void TestAutoCrossSize() {
+    // height: auto shrink-wraps the lines plus row-gaps (nothing left for align-content to distribute)
+    Fixture f(FlexDirection::Row, 200, 500, 10, 5);
+    f.box->SetAutoHeight(true);
+    f.layout->SetAlignContent(AlignContent::End);
+    f.AddMany(7, 60, 30);
+    std::vector<Box> boxes = f.Boxes();
+    CHECK_EQ(boxes[6].y, 70);
+    RECT r = f.box->EffectiveRect();
+    CHECK_EQ(r.bottom - r.top, 3 * 30 + 2 * 5);
+
+    // Changing the line spacing alone relays the container out
+    f.layout->SetLineSpacing(8);
+    f.root->UpdateInternalLayout();
+    r = f.box->EffectiveRect();
+    CHECK_EQ(r.bottom - r.top, 3 * 30 + 2 * 8);
+    CHECK_EQ(f.box->Children()[6]->EffectiveRect().top - f.box->EffectiveRect().top, 76);
+}
+
+int main() {
+    TestLineBreaking();
+    TestFlexWithinLines();
+    TestAlignContent();
+    TestWrapReverse();
+    TestColumns();
+    TestAutoCrossSize();
+    return CheckResult();
+}
@@ -0,0 +1,189 @@
+#include <vector>
+
+#include "Root.h"
+#include "FocusManager.h"
+#include "Check.h"
+
+// Keyboard focus: Tab/Shift+Tab order, lazy tab order rebuild on tree changes, key/char bubbling
+
+namespace {
+    struct Scene {
+        std::shared_ptr<Root> root;
+        std::shared_ptr<Container> panelA, panelB;
+        std::shared_ptr<Widget> a1, a2, a3, b1, c;
+    };
+
+    std::shared_ptr<Widget> MakeWidget(bool focusable) {
+        auto w = std::make_shared<Widget>();
+        w->SetSize(20, 20);
+        w->SetFocusable(focusable);
+        return w;
+    }
+
+    // root { panelA { a1, a2 (not focusable), a3 }, panelB { b1 }, c }
+    Scene BuildScene() {
+        Scene s;
+        s.root = Root::Create(400, 300);
+        s.panelA = std::make_shared<Container>();
+        s.panelB = std::make_shared<Container>();
+        s.panelA->SetSize(200, 100);
+        s.panelB->SetSize(200, 100);
+        s.a1 = MakeWidget(true);
+        s.a2 = MakeWidget(false);
+        s.a3 = MakeWidget(true);
+        s.b1 = MakeWidget(true);
+        s.c = MakeWidget(true);
+
+        s.panelA->AddChild(s.a1);
+        s.panelA->AddChild(s.a2);
+        s.panelA->AddChild(s.a3);
+        s.panelB->AddChild(s.b1);
+        s.root->AddChild(s.panelA);
+        s.root->AddChild(s.panelB);
+        s.root->AddChild(s.c);
+        s.root->UpdateInternalLayout();
+        return s;
+    }
+
+    KeyEvent KeyDown(UINT key, KeyModifiers modifiers = KeyModifiers::None) {
+        return {KeyEventType::Down, key, modifiers, false};
+    }
+
+    // Focused widget after each Tab (or Shift+Tab)
+    std::vector<Widget*> Walk(Root& root, int steps, bool backwards) {
+        std::vector<Widget*> order;
+        for(int i = 0; i < steps; i++) {
+            root.FeedKeyEvent(KeyDown(VK_TAB, backwards ? KeyModifiers::Shift : KeyModifiers::None));
+            order.push_back(root.GetFocusManager().GetFocused());
+        }
+        return order;
+    }
+}
+
+void TestTabOrder() {
+    Scene s = BuildScene();
+    FocusManager& focus = s.root->GetFocusManager();
+    CHECK(focus.GetFocused() == nullptr);
+
+    // Tree order, wrapping around; non-focusable widgets aren't part of it
+    CHECK(Walk(*s.root, 5, false) == std::vector<Widget*>({s.a1.get(), s.a3.get(), s.b1.get(), s.c.get(), s.a1.get()}));
+    CHECK(s.a1->HasFocus() && !s.c->HasFocus());
+
+    focus.SetFocus(nullptr);
+    CHECK(Walk(*s.root, 5, true) == std::vector<Widget*>({s.c.get(), s.b1.get(), s.a3.get(), s.a1.get(), s.c.get()}));
+
+    // Hidden and disabled widgets are stepped over (they keep their place in the order)
+    s.b1->SetVisible(false);
+    s.a3->SetEnabled(false);
+    focus.SetFocus(s.a1.get());
+    CHECK(Walk(*s.root, 2, false) == std::vector<Widget*>({s.c.get(), s.a1.get()}));
+    CHECK(!focus.SetFocus(s.b1.get()));
+
+    s.b1->SetVisible(true);
+    s.a3->SetEnabled(true);
+    CHECK(Walk(*s.root, 2, false) == std::vector<Widget*>({s.a3.get(), s.b1.get()}));
+
+    // Ctrl+Tab isn't focus navigation
+    s.root->FeedKeyEvent(KeyDown(VK_TAB, KeyModifiers::Control));
+    CHECK(focus.GetFocused() == s.b1.get());
+}
+
+void TestTreeChanges() {
+    Scene s = BuildScene();
+    FocusManager& focus = s.root->GetFocusManager();
+    Walk(*s.root, 1, false);
+
+    // Insertions, moves and removals show up on the next Tab
+    auto x = MakeWidget(true);
+    s.panelA->InsertChild(x, 1);
+    CHECK(Walk(*s.root, 2, false) == std::vector<Widget*>({x.get(), s.a3.get()}));
+
+    CHECK(s.root->MoveChild(s.panelB.get(), 0));
+    focus.SetFocus(s.b1.get());
+    CHECK(Walk(*s.root, 2, false) == std::vector<Widget*>({s.a1.get(), x.get()}));
+
+    // Removing the focused widget's subtree drops the focus; the removed widgets leave the order
+    CHECK(Walk(*s.root, 1, false) == std::vector<Widget*>({s.a3.get()}));
+    s.root->RemoveChild(s.panelA);
+    CHECK(focus.GetFocused() == nullptr);
+    CHECK(!s.a3->HasFocus());
+    CHECK(Walk(*s.root, 3, false) == std::vector<Widget*>({s.b1.get(), s.c.get(), s.b1.get()}));
+
+    // Removing or adding unfocused widgets keeps the focus
+    focus.SetFocus(s.c.get());
+    s.panelB->RemoveChild(s.b1);
+    CHECK(focus.GetFocused() == s.c.get());
+    s.root->AddChild(s.panelA);
+    CHECK(focus.GetFocused() == s.c.get());
+    CHECK(Walk(*s.root, 2, false) == std::vector<Widget*>({s.a1.get(), x.get()}));
+
+    // Widgets outside the tree can't take the focus
+    CHECK(!focus.SetFocus(s.b1.get()));
+}
+
+void TestBubbling() {
+    Scene s = BuildScene();
+    s.root->GetFocusManager().SetFocus(s.a1.get());
+
+    std::vector<Widget*> reached;
+    auto listen = [&](Widget& w, UINT handledKey) {
+        w.SetOnKey([&reached, &w, handledKey](const KeyEvent& e) {
+            reached.push_back(&w);
+            return e.key == handledKey;
+        });
+    };
+    listen(*s.a1, 'A');
+    listen(*s.panelA, 'P');
+    listen(*s.root, 'R');
+
+    // Focused widget first, then its ancestors - up to the one handling it
+    CHECK(s.root->FeedKeyEvent(KeyDown('P')));
+    CHECK(reached == std::vector<Widget*>({s.a1.get(), s.panelA.get()}));
+
+    reached.clear();
+    CHECK(s.root->FeedKeyEvent(KeyDown('R')));
+    CHECK(reached == std::vector<Widget*>({s.a1.get(), s.panelA.get(), s.root.get()}));
+
+    reached.clear();
+    CHECK(!s.root->FeedKeyEvent(KeyDown('Z')));
+    CHECK_EQ(reached.size(), 3);
+
+    // Siblings never see the event
+    bool siblingReached = false;
+    s.c->SetOnKey([&](const KeyEvent&) { siblingReached = true; return true; });
+    s.root->FeedKeyEvent(KeyDown('Z'));
+    CHECK(!siblingReached);
+
+    // Disabled ancestors are skipped, not a barrier
+    reached.clear();
+    s.panelA->SetEnabled(false);
+    CHECK(s.root->FeedKeyEvent(KeyDown('R')));
+    CHECK(reached == std::vector<Widget*>({s.a1.get(), s.root.get()}));
+    s.panelA->SetEnabled(true);
+
+    // An ancestor handling Tab keeps the focus where it is
+    listen(*s.panelA, VK_TAB);
+    s.root->FeedKeyEvent(KeyDown(VK_TAB));
+    CHECK(s.a1->HasFocus());
+
+    // Chars bubble the same way
+    std::vector<Widget*> chars;
+    s.panelA->SetOnChar([&](const CharEvent& e) { chars.push_back(s.panelA.get()); return e.character == L'p'; });
+    s.root->SetOnChar([&](const CharEvent&) { chars.push_back(s.root.get()); return true; });
+    CHECK(s.root->FeedCharEvent({L'p'}));
+    CHECK(s.root->FeedCharEvent({L'q'}));
+    CHECK(chars == std::vector<Widget*>({s.panelA.get(), s.panelA.get(), s.root.get()}));
+
+    // Without focus, the root gets them
+    s.root->GetFocusManager().SetFocus(nullptr);
+    reached.clear();
+    s.root->FeedKeyEvent(KeyDown('R'));
+    CHECK(reached == std::vector<Widget*>({s.root.get()}));
+}
+
+int main() {
+    TestTabOrder();
+    TestTreeChanges();
+    TestBubbling();
+    return CheckResult();
+}
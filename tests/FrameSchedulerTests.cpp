@@ -0,0 +1,173 @@
+#include "Root.h"
+#include "Painter.h"
+#include "FrameScheduler.h"
+#include "Check.h"
+
+// FrameScheduler on a fake clock: what makes a frame due (dirty paint, animations, queued input), frame pacing,
+// and an idle tree (incl. a shown overlay) never asking for one
+
+namespace {
+    class NullPainter : public Painter {
+        public:
+            void FillRect(const RECT&, const Color&) override {}
+            void DrawString(const wchar_t*, int, const RECT&, UINT, HFONT, const Color&) override {}
+            void DrawLine(int, int, int, int, const Color&) override {}
+            void PushClip(const RECT&) override {}
+            void PopClip() override {}
+    };
+
+    struct Scene {
+        std::shared_ptr<Root> root;
+        std::shared_ptr<Widget> box;
+        FrameScheduler scheduler;
+        double now = 0.0;
+        int renders = 0;
+        FrameScheduler::RenderCallback render;
+
+        Scene() : root(Root::Create(400, 300)), scheduler(*root) {
+            scheduler.SetClock([this] { return now; });
+            scheduler.SetFrameInterval(0.01);
+            render = [this](Root& r, const RECT&) {
+                NullPainter painter;
+                r.InitRender(painter);
+                renders++;
+            };
+
+            box = std::make_shared<Widget>();
+            box->SetSize(50, 50);
+            root->AddChild(box);
+
+            // Settle the initial layout and paint
+            now = 1.0;
+            scheduler.RunFrame(render);
+            renders = 0;
+        }
+    };
+
+    void CheckIdle(Scene& s) {
+        CHECK(!s.scheduler.NeedsFrame());
+        CHECK(s.scheduler.NextDeadline() == FrameScheduler::Never);
+        CHECK(!s.scheduler.IsFrameDue());
+    }
+}
+
+void TestIdle() {
+    Scene s;
+    CheckIdle(s);
+
+    // However much time passes, an idle tree never has a frame due
+    s.now += 1000.0;
+    CheckIdle(s);
+
+    // A frame run anyway renders nothing
+    CHECK(!s.scheduler.RunFrame(s.render));
+    CHECK_EQ(s.renders, 0);
+    CheckIdle(s);
+
+    // A shown overlay costs one frame to appear, then nothing
+    auto tooltip = std::make_shared<Widget>();
+    tooltip->SetSize(40, 20);
+    s.root->ShowOverlay(tooltip, OverlayLayer::Tooltip);
+    CHECK(s.scheduler.NeedsFrame());
+    s.now += 1.0;
+    CHECK(s.scheduler.RunFrame(s.render));
+    CheckIdle(s);
+}
+
+void TestDirtyPaint() {
+    Scene s;
+    s.box->SetBackgroundColor(Color::FromRGB(255, 0, 0));
+    CHECK(s.root->IsPaintDirty());
+    CHECK(s.scheduler.NeedsFrame());
+
+    // After an idle period the deadline has already passed
+    s.now += 1.0;
+    CHECK(s.scheduler.NextDeadline() <= s.now);
+    CHECK(s.scheduler.IsFrameDue());
+    CHECK(s.scheduler.RunFrame(s.render));
+    CHECK_EQ(s.renders, 1);
+    CheckIdle(s);
+
+    // Invalidating right after a frame waits for the frame interval
+    double frameStart = s.now;
+    s.box->SetBackgroundColor(Color::FromRGB(0, 255, 0));
+    CHECK(s.scheduler.NextDeadline() == frameStart + 0.01);
+    s.now += 0.005;
+    CHECK(!s.scheduler.IsFrameDue());
+    s.now = frameStart + 0.01;
+    CHECK(s.scheduler.IsFrameDue());
+    CHECK(s.scheduler.RunFrame(s.render));
+    CHECK_EQ(s.renders, 2);
+    CheckIdle(s);
+}
+
+void TestAnimation() {
+    Scene s;
+    CHECK(s.root->GetAnimator().Animate(s.box, PropertyID::BackgroundColor, Color::FromRGB(10, 20, 30),
+                                        Color::FromRGB(255, 255, 255), 0.045f, Easing::Linear));
+    CHECK(s.root->IsAnimating());
+    CHECK(s.scheduler.NeedsFrame());
+
+    // One frame per interval while the tween runs, each one rendering
+    int frames = 0;
+    while(s.scheduler.NeedsFrame() && frames < 100) {
+        CHECK(s.scheduler.NextDeadline() == s.now + 0.01);
+        CHECK(!s.scheduler.IsFrameDue());
+        s.now += 0.01;
+        CHECK(s.scheduler.IsFrameDue());
+        s.scheduler.RunFrame(s.render);
+        frames++;
+    }
+
+    // The first frame shows the start value, the next five cover the 0.045 s
+    CHECK_EQ(frames, 6);
+    CHECK_EQ(s.renders, frames);
+    CHECK(!s.root->IsAnimating());
+    CHECK(s.box->GetBackgroundColor().r == 255);
+    CheckIdle(s);
+}
+
+void TestQueuedInput() {
+    Scene s;
+    int moves = 0;
+    s.box->AddMouseListener([&moves](const MouseEvent& e) { if(e.type == MouseEventType::Move) moves++; });
+
+    s.root->PostMouseEvent({MouseEventType::Move, {10, 10}, MouseButton::None});
+    CHECK(s.root->HasPendingInput());
+    CHECK(s.scheduler.NeedsFrame());
+    CHECK_EQ(moves, 0);
+
+    s.now += 1.0;
+    CHECK(s.scheduler.IsFrameDue());
+    s.scheduler.RunFrame(s.render);
+    CHECK(!s.root->HasPendingInput());
+    CHECK_EQ(moves, 1);
+
+    // Hover changes may repaint; after that the tree is idle again
+    s.now += 1.0;
+    s.scheduler.RunFrame(s.render);
+    CheckIdle(s);
+}
+
+void TestIdleTasks() {
+    Scene s;
+    int ran = 0;
+    s.scheduler.PostIdleTask([&ran] { ran++; });
+    s.scheduler.PostIdleTask([&ran] { ran++; });
+    CHECK(s.scheduler.NeedsFrame());
+
+    // Nothing rendered - the tasks run within the interval (the fake clock doesn't move)
+    s.now += 1.0;
+    CHECK(!s.scheduler.RunFrame(s.render));
+    CHECK_EQ(ran, 2);
+    CheckIdle(s);
+}
+
+int main() {
+    TestIdle();
+    TestDirtyPaint();
+    TestAnimation();
+    TestQueuedInput();
+    TestIdleTasks();
+    return CheckResult();
+}
@@ -0,0 +1,124 @@
+#include <vector>
+
+#include "Root.h"
+#include "GridLayout.h"
+#include "Check.h"
+
+// GridLayout: track sizing (fixed, auto, fractions), spanning children, auto placement around explicit cells
+
+namespace {
+    struct Fixture {
+        std::shared_ptr<Root> root;
+        std::shared_ptr<Container> box;
+        GridLayout* layout;
+
+        Fixture(std::vector<GridTrack> columns, std::vector<GridTrack> rows, int width, int height, int columnGap, int rowGap) {
+            root = Root::Create(1000, 1000);
+            box = std::make_shared<Container>();
+            box->SetSize(width, height);
+
+            auto grid = std::make_unique<GridLayout>(std::move(columns), std::move(rows), columnGap, rowGap);
+            layout = grid.get();
+            box->SetLayout(std::move(grid));
+            root->AddChild(box);
+        }
+
+        Widget& Add(int w, int h) {
+            auto child = std::make_shared<Widget>();
+            child->SetSize(w, h);
+            box->AddChild(child);
+            return *child;
+        }
+
+        void Update() {
+            box->InvalidateLayout();
+            root->UpdateInternalLayout();
+        }
+
+        // Child rect relative to the container
+        RECT RectOf(size_t index) {
+            RECT origin = box->EffectiveRect();
+            RECT r = box->Children()[index]->EffectiveRect();
+            OffsetRect(&r, -origin.left, -origin.top);
+            return r;
+        }
+    };
+
+    bool RectIs(const RECT& r, int left, int top, int right, int bottom) {
+        return r.left == left && r.top == top && r.right == right && r.bottom == bottom;
+    }
+}
+
+void TestTrackSizing() {
+    Fixture f({GridTrack::Fixed(50), GridTrack::Auto(), GridTrack::Fr(1), GridTrack::Fr(3)}, {GridTrack::Fixed(20), GridTrack::Auto()}, 400, 300, 10, 5);
+    f.Add(30, 10);  f.Add(70, 15);  f.Add(5, 5);  f.Add(5, 5);
+    f.Add(10, 12);  f.Add(40, 25);  f.Add(5, 8);  f.Add(5, 3);
+    f.Update();
+
+    // Auto fits the widest child, fractions split the 250 px left (1:3, rounded by cumulative edges)
+    CHECK(f.layout->GetColumnSizes() == std::vector<int>({50, 70, 63, 187}));
+    CHECK(f.layout->GetRowSizes() == std::vector<int>({20, 25}));
+
+    // Children stretch over their cells
+    CHECK(RectIs(f.RectOf(0), 0, 0, 50, 20));
+    CHECK(RectIs(f.RectOf(1), 60, 0, 130, 20));
+    CHECK(RectIs(f.RectOf(3), 213, 0, 400, 20));
+    CHECK(RectIs(f.RectOf(6), 140, 25, 203, 50));
+
+    // Fixed-size cells: the child keeps its size, aligned within the cell
+    f.layout->SetCellAlign(AlignItems::Center, AlignItems::End);
+    f.Update();
+    CHECK(RectIs(f.RectOf(0), 10, 10, 40, 20));
+    CHECK(RectIs(f.RectOf(5), 75, 25, 115, 50));
+}
+
+void TestSpansAndAutoPlacement() {
+    Fixture f({GridTrack::Auto(), GridTrack::Auto(), GridTrack::Auto()}, {}, 300, 300, 0, 0);
+    f.Add(100, 10).SetGridCell(0, 1, 1, 2); // A: row 0, columns 1-2
+    f.Add(40, 40).SetGridCell(2, 0, 2, 1);  // F: rows 2-3, column 0
+    for(int i = 0; i < 5; i++) {
+        f.Add(20, 10);                       // Auto placed: B C D E G
+    }
+    f.Update();
+
+    // Auto placement flows row by row around the explicit cells, never moving back
+    CHECK(RectIs(f.RectOf(2), 0, 0, 40, 10));    // B: (0, 0) - A covers the rest of row 0
+    CHECK(RectIs(f.RectOf(3), 0, 10, 40, 20));   // C: (1, 0)
+    CHECK(RectIs(f.RectOf(5), 90, 10, 140, 20)); // E: (1, 2)
+    CHECK(RectIs(f.RectOf(6), 40, 20, 90, 45));  // G: (2, 1) - F holds (2, 0)
+
+    // Spanning children add what's missing evenly over their tracks, after the single-span children
+    CHECK(f.layout->GetColumnSizes() == std::vector<int>({40, 50, 50}));
+    CHECK(f.layout->GetRowSizes() == std::vector<int>({10, 10, 25, 15}));
+    CHECK(RectIs(f.RectOf(0), 40, 0, 140, 10));
+    CHECK(RectIs(f.RectOf(1), 0, 20, 40, 60));
+
+    // Auto-sized container wraps the tracks
+    f.box->SetAutoWidth(true);
+    f.box->SetAutoHeight(true);
+    f.Update();
+    RECT r = f.box->EffectiveRect();
+    CHECK_EQ(r.right - r.left, 140);
+    CHECK_EQ(r.bottom - r.top, 60);
+}
+
+void TestPlacementClamping() {
+    Widget w;
+    w.SetGridCell(-5, 40000, 0, 70000);
+    CHECK_EQ(w.GetGridPlacement().row, -1);
+    CHECK_EQ(w.GetGridPlacement().column, 32767);
+    CHECK_EQ(w.GetGridPlacement().rowSpan, 1);
+    CHECK_EQ(w.GetGridPlacement().columnSpan, 1);
+
+    w.SetGridCell(3, 4, 100000, 2);
+    CHECK_EQ(w.GetGridPlacement().row, 3);
+    CHECK_EQ(w.GetGridPlacement().rowSpan, 32764);
+    CHECK_EQ(w.GetGridPlacement().columnSpan, 2);
+}
+
+int main() {
+    TestTrackSizing();
+    TestSpansAndAutoPlacement();
+    TestPlacementClamping();
+    return CheckResult();
+}
@@ -0,0 +1,141 @@
+#include <cstdio>
+#include <vector>
+
+#include "Root.h"
+#include "Label.h"
+#include "Button.h"
+#include "Slider.h"
+#include "Checkbox.h"
+#include "ImmediateUi.h"
+#include "AllocCount.h"
+#include "Check.h"
+
+// Immediate UI over 2k elements: after warm-up, frames with the same calls don't allocate - neither with
+// steady values nor with slider/checkbox values changing every frame - and the retained tree follows the calls
+
+namespace {
+    const int Rows = 250;
+    const int PerRow = 8; // Row group + 7 elements => 2000 elements
+
+    struct Model {
+        std::vector<float> volumes = std::vector<float>(Rows, 0.0f);
+        std::vector<float> balances = std::vector<float>(Rows, 0.5f);
+        std::vector<char> muted = std::vector<char>(Rows, 0);
+        std::vector<char> solo = std::vector<char>(Rows, 0);
+    };
+
+    // One frame of the whole UI; rows is the number of rows drawn
+    int DrawFrame(ImmediateUi& ui, Model& m, int rows) {
+        int clicks = 0;
+        ui.BeginFrame();
+        for(int i = 0; i < rows; i++) {
+            ui.PushId(i);
+            ui.BeginRow("row", 2);
+            ui.Label("name", L"Channel");
+            ui.SetNextSize(40, 16);
+            if(ui.Button("reset", L"Reset")) clicks++;
+            bool mute = m.muted[i] != 0, soloed = m.solo[i] != 0;
+            ui.SetNextSize(40, 16);
+            ui.Checkbox("mute", L"M", mute);
+            ui.SetNextSize(40, 16);
+            ui.Checkbox("solo", L"S", soloed);
+            ui.SetNextSize(60, 16);
+            ui.Slider("volume", m.volumes[i], 0.0f, 100.0f);
+            ui.SetNextSize(60, 16);
+            ui.Slider("balance", m.balances[i], 0.0f, 1.0f);
+            ui.Label("unit", L"dB");
+            ui.EndGroup();
+            ui.PopId();
+            m.muted[i] = mute;
+            m.solo[i] = soloed;
+        }
+        ui.EndFrame();
+        return clicks;
+    }
+
+    struct Scene {
+        std::shared_ptr<Root> root = Root::Create(1920, 1080);
+        std::shared_ptr<Container> host = std::make_shared<Container>();
+        ImmediateUi ui{host};
+        Model model;
+
+        Scene() {
+            host->SetSize(1920, 1080);
+            root->AddChild(host);
+        }
+    };
+}
+
+void TestSteadyFramesDontAllocate() {
+    Scene s;
+    size_t before = AllocationCount();
+    DrawFrame(s.ui, s.model, Rows);
+    CHECK(AllocationCount() - before >= size_t(Rows * PerRow)); // The counter sees the widgets being created
+    for(int warmUp = 0; warmUp < 2; warmUp++) DrawFrame(s.ui, s.model, Rows);
+    CHECK_EQ(s.ui.GetElementCount(), Rows * PerRow);
+    CHECK_EQ(s.host->Children().size(), Rows);
+
+    // Same calls, same values
+    const int Frames = 20;
+    before = AllocationCount();
+    int clicks = 0;
+    for(int f = 0; f < Frames; f++) clicks += DrawFrame(s.ui, s.model, Rows);
+    size_t steady = AllocationCount() - before;
+    CHECK_EQ(steady, 0);
+    CHECK_EQ(clicks, 0);
+
+    // Same calls, values changing every frame (widgets updated in place)
+    before = AllocationCount();
+    for(int f = 0; f < Frames; f++) {
+        for(int i = 0; i < Rows; i++) {
+            s.model.volumes[i] = float((f * 7 + i) % 100);
+            s.model.muted[i] = (f + i) % 2;
+        }
+        DrawFrame(s.ui, s.model, Rows);
+    }
+    size_t changing = AllocationCount() - before;
+    CHECK_EQ(changing, 0);
+
+    // The widgets show the last values
+    s.ui.PushId(Rows - 1);
+    auto* row = dynamic_cast<Container*>(s.ui.Find("row"));
+    s.ui.PopId();
+    CHECK(row && row->Children().size() == PerRow - 1);
+    if(row) {
+        auto* volume = dynamic_cast<Slider*>(row->Children()[4].get());
+        auto* mute = dynamic_cast<Checkbox*>(row->Children()[2].get());
+        CHECK(volume && volume->GetValue() == s.model.volumes[Rows - 1]);
+        CHECK(mute && mute->IsChecked() == (s.model.muted[Rows - 1] != 0));
+    }
+
+    std::printf("%zu elements: %zu allocations in %d steady frames, %zu with changing values\n",
+        s.ui.GetElementCount(), steady, Frames, changing);
+}
+
+void TestStructureChanges() {
+    Scene s;
+    DrawFrame(s.ui, s.model, Rows);
+
+    // Calls that stopped are removed at EndFrame; after warm-up the smaller UI doesn't allocate either
+    DrawFrame(s.ui, s.model, Rows / 2);
+    CHECK_EQ(s.ui.GetElementCount(), Rows / 2 * PerRow);
+    CHECK_EQ(s.host->Children().size(), Rows / 2);
+    DrawFrame(s.ui, s.model, Rows / 2);
+    size_t before = AllocationCount();
+    DrawFrame(s.ui, s.model, Rows / 2);
+    CHECK_EQ(AllocationCount() - before, 0);
+
+    // Rows coming back get fresh widgets, in call order
+    DrawFrame(s.ui, s.model, Rows);
+    CHECK_EQ(s.ui.GetElementCount(), Rows * PerRow);
+    CHECK_EQ(s.host->Children().size(), Rows);
+    s.ui.PushId(Rows - 1);
+    CHECK(s.ui.Find("row") == s.host->Children().back().get());
+    s.ui.PopId();
+}
+
+int main() {
+    TestSteadyFramesDontAllocate();
+    TestStructureChanges();
+    return CheckResult();
+}
@@ -0,0 +1,106 @@
+#include <cstdio>
+#include <random>
+#include <algorithm>
+
+#include "Root.h"
+#include "Button.h"
+#include "FlexLayout.h"
+#include "InputTrace.h"
+#include "InputReplayer.h"
+#include "RenderSnapshot.h"
+#include "Check.h"
+
+// Replays a recorded high-polling-rate mouse session (1000 Hz moves, 60 fps, a click now and then) over 2000 buttons:
+// once dispatching every raw event as it arrives, once through Root's input queue (one DispatchInput per frame).
+// The queue must dispatch exactly one event per run of consecutive moves plus every other event, end in the same
+// state, and take less time.
+
+namespace {
+    const int Frames = 120;
+    const int MovesPerFrame = 17; // ~1000 Hz at 60 fps
+
+    std::shared_ptr<Root> BuildTree() {
+        auto root = Root::Create(1600, 900);
+        auto grid = std::make_shared<Container>();
+        grid->SetSize(1600, 900);
+        auto flex = std::make_unique<FlexLayout>(FlexDirection::Row, 2);
+        flex->SetWrap(FlexWrap::Wrap);
+        flex->SetLineSpacing(2);
+        grid->SetLayout(std::move(flex));
+        for(int i = 0; i < 2000; i++) {
+            auto button = std::make_shared<Button>(L"b");
+            button->SetSize(30, 14);
+            grid->AddChild(button);
+        }
+        root->AddChild(grid);
+        root->UpdateInternalLayout();
+        return root;
+    }
+
+    uint64_t StateOf(Root& root) {
+        RenderSnapshot snapshot;
+        root.RecordSnapshot(snapshot);
+        return InputReplayer::HashState(root, snapshot);
+    }
+
+    bool IsMove(const TraceRecord& r) {
+        return r.kind == TraceRecordKind::Mouse && r.mouse.type == MouseEventType::Move;
+    }
+}
+
+int main() {
+    // Record the raw session: a wandering pointer, clicking every 10th frame in the middle of its moves
+    InputRecorder recorder;
+    auto direct = BuildTree();
+    direct->SetInputRecorder(&recorder);
+    recorder.Begin(*direct);
+
+    std::mt19937 rng(30);
+    std::uniform_int_distribution<int> step(-6, 6);
+    POINT pos = {800, 450};
+    double directMs = MeasureMs(1, [&] {
+        for(int f = 0; f < Frames; f++) {
+            for(int m = 0; m < MovesPerFrame; m++) {
+                pos.x = std::max<LONG>(0, std::min<LONG>(1599, pos.x + step(rng)));
+                pos.y = std::max<LONG>(0, std::min<LONG>(899, pos.y + step(rng)));
+                direct->InitFeedMouseEvent({MouseEventType::Move, pos, MouseButton::None});
+                if(f % 10 == 0 && m == MovesPerFrame / 2) {
+                    direct->InitFeedMouseEvent({MouseEventType::Down, pos, MouseButton::Left});
+                    direct->InitFeedMouseEvent({MouseEventType::Up, pos, MouseButton::Left});
+                }
+            }
+            direct->MarkFrame();
+        }
+    });
+    direct->SetInputRecorder(nullptr);
+    const InputTrace& trace = recorder.GetTrace();
+
+    // What coalescing should leave: every non-move, and one move per run of consecutive moves within a frame
+    size_t raw = 0, expected = 0;
+    for(size_t i = 0; i < trace.Records().size(); i++) {
+        const TraceRecord& r = trace.Records()[i];
+        if(r.kind != TraceRecordKind::Mouse) continue;
+        raw++;
+        bool runContinues = i + 1 < trace.Records().size() && IsMove(r) && IsMove(trace.Records()[i + 1]);
+        if(!runContinues) expected++;
+    }
+
+    // Replay the recording through the queue
+    auto queued = BuildTree();
+    size_t dispatched = 0;
+    double queuedMs = MeasureMs(1, [&] {
+        for(const TraceRecord& r : trace.Records()) {
+            if(r.kind == TraceRecordKind::Mouse) queued->PostMouseEvent(r.mouse);
+            else if(r.kind == TraceRecordKind::Frame) dispatched += queued->DispatchInput();
+        }
+    });
+
+    CHECK_EQ(raw, Frames * MovesPerFrame + (Frames / 10) * 2);
+    CHECK_EQ(dispatched, expected);
+    CHECK(StateOf(*queued) == StateOf(*direct));
+    CHECK(queuedMs < directMs);
+
+    std::printf("%zu raw events over %d frames: direct %.2f ms, queued %.2f ms (%zu dispatched, %.1fx fewer)\n",
+        raw, Frames, directMs, queuedMs, dispatched, double(raw) / double(dispatched));
+    return CheckResult();
+}
@@ -0,0 +1,172 @@
+#include <cstdio>
+#include <vector>
+
+#include "Root.h"
+#include "Label.h"
+#include "Button.h"
+#include "TextInput.h"
+#include "FlexLayout.h"
+#include "InputTrace.h"
+#include "InputReplayer.h"
+#include "RenderSnapshot.h"
+#include "Check.h"
+
+// Input traces: record a session, serialize, deserialize and replay it on a fresh tree - the replay must reach
+// the recorded state. Corrupt traces (out-of-range enums, truncation) must be rejected.
+
+namespace {
+    struct Scene {
+        std::shared_ptr<Root> root;
+        std::shared_ptr<TextInput> input;
+        std::shared_ptr<Label> status;
+        std::shared_ptr<Label> tooltip;
+    };
+
+    Scene BuildScene() {
+        Scene s;
+        s.root = Root::Create(400, 300);
+        auto column = std::make_shared<Container>();
+        column->SetSize(400, 300);
+        column->SetLayout(std::make_unique<VerticalLayout>(4));
+
+        s.input = std::make_shared<TextInput>();
+        s.input->SetSize(300, 24);
+        column->AddChild(s.input);
+        for(int i = 0; i < 5; i++) {
+            auto button = std::make_shared<Button>(L"b" + std::to_wstring(i));
+            button->SetSize(100, 24);
+            column->AddChild(button);
+        }
+        s.status = std::make_shared<Label>(L"idle");
+        s.status->SetSize(300, 20);
+        column->AddChild(s.status);
+        s.root->AddChild(column);
+
+        // Overlays are addressed through the overlay stack, not Children()
+        s.tooltip = std::make_shared<Label>(L"tip");
+        s.tooltip->SetSize(80, 20);
+        s.root->ShowOverlay(s.tooltip, OverlayLayer::Tooltip);
+
+        s.root->UpdateInternalLayout();
+        return s;
+    }
+
+    uint64_t StateOf(Root& root) {
+        RenderSnapshot snapshot;
+        root.RecordSnapshot(snapshot);
+        return InputReplayer::HashState(root, snapshot);
+    }
+
+    void Frame(Scene& s) {
+        s.root->DispatchInput();
+        s.root->FlushPropertyUpdates();
+        s.root->UpdateInternalLayout();
+        s.root->MarkFrame();
+    }
+}
+
+void TestRoundTrip() {
+    Scene recorded = BuildScene();
+    InputRecorder recorder;
+    recorder.Begin(*recorded.root);
+    recorded.root->SetInputRecorder(&recorder);
+
+    // Hover over the buttons, click into the input, type, and update labels (one in an overlay) between frames
+    for(int f = 0; f < 60; f++) {
+        for(int m = 0; m < 5; m++) {
+            recorded.root->PostMouseEvent({MouseEventType::Move, {10 + f * 3 + m, 40 + (f * 7) % 120}, MouseButton::None});
+        }
+        if(f == 10) {
+            recorded.root->PostMouseEvent({MouseEventType::Down, {20, 10}, MouseButton::Left});
+            recorded.root->PostMouseEvent({MouseEventType::Up, {20, 10}, MouseButton::Left});
+        }
+        if(f > 10 && f < 30) {
+            recorded.root->PostCharEvent({wchar_t(L'a' + f % 26)});
+        }
+        if(f == 30) {
+            recorded.root->PostKeyEvent({KeyEventType::Down, VK_BACK, KeyModifiers::None, false});
+            recorded.root->PostKeyEvent({KeyEventType::Up, VK_BACK, KeyModifiers::None, false});
+        }
+        if(f % 7 == 0) {
+            recorded.root->PostPropertyUpdate(recorded.status, PropertyID::Text, L"frame " + std::to_wstring(f));
+            recorded.root->PostPropertyUpdate(recorded.tooltip, PropertyID::Text, L"tip " + std::to_wstring(f));
+        }
+        Frame(recorded);
+    }
+    recorded.root->SetInputRecorder(nullptr);
+    uint64_t recordedState = StateOf(*recorded.root);
+    CHECK(recorded.input->GetText().size() == 18);
+    CHECK(recorded.tooltip->GetText() == L"tip 56");
+
+    // Serialize and back: identical records, identical bytes
+    const InputTrace& trace = recorder.GetTrace();
+    std::vector<uint8_t> bytes = trace.Serialize();
+    InputTrace loaded;
+    CHECK(loaded.Deserialize(bytes.data(), bytes.size()));
+    CHECK_EQ(loaded.Records().size(), trace.Records().size());
+    CHECK_EQ(loaded.GetFrameCount(), 60);
+    CHECK(loaded.Serialize() == bytes);
+
+    size_t overlayMutations = 0;
+    for(const TraceRecord& r : loaded.Records()) {
+        if(r.kind == TraceRecordKind::Mutation && !r.widgetPath.empty() && (r.widgetPath[0] & OverlayPathFlag)) {
+            overlayMutations++;
+        }
+    }
+    CHECK_EQ(overlayMutations, 9);
+
+    // Replay on a freshly built tree: same final state, nothing skipped
+    Scene replayed = BuildScene();
+    ReplayReport report = InputReplayer::Run(*replayed.root, loaded);
+    CHECK_EQ(report.frames.size(), 60);
+    CHECK_EQ(report.skippedMutations, 0);
+    CHECK(report.finalStateHash == recordedState);
+    CHECK(replayed.input->GetText() == recorded.input->GetText());
+    CHECK(replayed.tooltip->GetText() == L"tip 56");
+
+    std::printf("%zu records in %zu bytes, replayed in %.3f ms\n", loaded.Records().size(), bytes.size(), report.TotalMs());
+}
+
+void TestCorruptTraces() {
+    // Header: magic, version, width 0, height 0 (one byte each) = 7 bytes, then the records
+    InputTrace mouse;
+    TraceRecord move;
+    move.kind = TraceRecordKind::Mouse;
+    move.mouse = {MouseEventType::Move, {5, 5}, MouseButton::None};
+    mouse.Add(move);
+    std::vector<uint8_t> bytes = mouse.Serialize();
+    InputTrace loaded;
+    CHECK(loaded.Deserialize(bytes.data(), bytes.size()));
+
+    std::vector<uint8_t> badType = bytes;
+    badType[8] = 0x0F; // Mouse event type 15
+    CHECK(!loaded.Deserialize(badType.data(), badType.size()));
+    std::vector<uint8_t> badButton = bytes;
+    badButton[8] = 0x32; // Button 3
+    CHECK(!loaded.Deserialize(badButton.data(), badButton.size()));
+
+    InputTrace mutation;
+    TraceRecord update;
+    update.kind = TraceRecordKind::Mutation;
+    update.property = PropertyID::Height;
+    update.value = 10.0f;
+    mutation.Add(update);
+    bytes = mutation.Serialize();
+    CHECK(loaded.Deserialize(bytes.data(), bytes.size()));
+    CHECK(loaded.Records()[0].property == PropertyID::Height);
+
+    std::vector<uint8_t> badProperty = bytes;
+    badProperty[9] = static_cast<uint8_t>(PropertyID::Height) + 1; // After the empty path
+    CHECK(!loaded.Deserialize(badProperty.data(), badProperty.size()));
+
+    // Truncated anywhere in the record
+    for(size_t size = 8; size < bytes.size(); size++) {
+        CHECK(!loaded.Deserialize(bytes.data(), size));
+    }
+}
+
+int main() {
+    TestRoundTrip();
+    TestCorruptTraces();
+    return CheckResult();
+}
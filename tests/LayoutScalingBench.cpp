@@ -0,0 +1,108 @@
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <cstdint>
+
+#include "Root.h"
+#include "FlexLayout.h"
+#include "LayoutBatch.h"
+#include "LayoutScheduler.h"
+#include "Check.h"
+
+// Parallel layout scaling: a ~50k widget tree relaid out in full with 0 (serial), 1, 2, 4 and 8 workers
+// 16 panels of 52 wrapped rows of 60 flexible children; every run switches the width, so every line is resolved again.
+// The geometry must be identical to the serial pass for every worker count.
+
+namespace {
+    const int PanelCount = 16;
+    const int RowsPerPanel = 52;
+    const int ChildrenPerRow = 60;
+
+    std::shared_ptr<Container> BuildTree() {
+        auto top = std::make_shared<Container>();
+        top->SetSize(1920, 20000);
+        top->SetLayout(std::make_unique<HorizontalLayout>(4));
+
+        LayoutBatch::ScopedDefer defer;
+        std::mt19937 rng(29);
+        std::uniform_int_distribution<int> basis(5, 40);
+        for(int p = 0; p < PanelCount; p++) {
+            auto panel = std::make_shared<Container>();
+            panel->SetSize(0, 20000);
+            panel->SetFlexGrowFactor(1);
+            panel->SetLayout(std::make_unique<VerticalLayout>(2));
+            for(int r = 0; r < RowsPerPanel; r++) {
+                auto row = std::make_shared<Container>();
+                row->SetSize(0, 300);
+                row->SetFlexShrink(0);
+                auto flex = std::make_unique<FlexLayout>(FlexDirection::Row, 1);
+                flex->SetWrap(FlexWrap::Wrap);
+                row->SetLayout(std::move(flex));
+                for(int c = 0; c < ChildrenPerRow; c++) {
+                    auto child = std::make_shared<Widget>();
+                    child->SetSize(basis(rng), 12);
+                    child->SetFlexGrowFactor(float(1 + c % 3));
+                    row->AddChild(child);
+                }
+                panel->AddChild(row);
+            }
+            top->AddChild(panel);
+        }
+        return top;
+    }
+
+    // Order-dependent hash of every rect in the subtree
+    void HashRects(const Widget& w, uint64_t& hash, size_t& count) {
+        RECT r = w.EffectiveRect();
+        for(LONG v : {r.left, r.top, r.right, r.bottom}) {
+            hash = (hash ^ uint64_t(uint32_t(v))) * 1099511628211ull;
+        }
+        count++;
+        if(auto* c = dynamic_cast<const Container*>(&w)) {
+            for(auto& child : c->Children()) HashRects(*child, hash, count);
+        }
+    }
+}
+
+int main() {
+    const int Runs = 20;
+
+    auto root = Root::Create(2000, 20000);
+    auto top = BuildTree();
+    root->AddChild(top);
+    root->UpdateInternalLayout();
+
+    std::printf("%zu widgets, %u hardware threads\n", top->GetSubtreeSize(), std::thread::hardware_concurrency());
+    std::printf("%8s %12s %9s\n", "workers", "ms/layout", "speedup");
+
+    LayoutScheduler& scheduler = LayoutScheduler::Get();
+    double serialMs = 0.0;
+    uint64_t serialHash = 0;
+    for(unsigned workers : {0u, 1u, 2u, 4u, 8u}) {
+        scheduler.SetWorkerCount(workers);
+
+        int width = 1920;
+        double ms = MeasureMs(Runs, [&] {
+            width = width == 1920 ? 1600 : 1920;
+            top->SetSize(width, 20000);
+            root->UpdateInternalLayout();
+        });
+
+        // Same width for every worker count before comparing
+        top->SetSize(1700, 20000);
+        root->UpdateInternalLayout();
+        uint64_t hash = 1469598103934665603ull;
+        size_t count = 0;
+        HashRects(*top, hash, count);
+        if(workers == 0) {
+            serialMs = ms;
+            serialHash = hash;
+        }
+        CHECK(hash == serialHash);
+        CHECK(count == top->GetSubtreeSize());
+
+        std::printf("%8u %12.2f %8.2fx\n", workers, ms, serialMs / ms);
+    }
+    scheduler.SetWorkerCount(0);
+    return CheckResult();
+}
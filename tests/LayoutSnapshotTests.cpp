@@ -0,0 +1,184 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Root.h"
+#include "Label.h"
+#include "Button.h"
+#include "FlexLayout.h"
+#include "LayoutBatch.h"
+#include "LayoutSnapshot.h"
+#include "Check.h"
+
+// Layout snapshots: save -> load -> adopt on an identical tree gives the laid-out geometry without a layout pass;
+// any change of the layout inputs is a hash mismatch that adopts nothing
+
+namespace {
+    const wchar_t* CachePath = L"LayoutSnapshotTests.snapshot";
+    const char* CachePathA = "LayoutSnapshotTests.snapshot";
+
+    struct Scene {
+        std::shared_ptr<Root> root;
+        std::shared_ptr<Container> column;
+        std::shared_ptr<Label> wrapped;
+        std::vector<std::shared_ptr<Widget>> all; // Pre-order, without the root
+    };
+
+    // root { column { title, wrapped, row { ok, cancel } } }
+    Scene BuildScene(const std::wstring& wrappedText = L"Some longer text that wraps over a few lines of the column") {
+        Scene s;
+        LayoutBatch::ScopedDefer defer;
+        s.root = Root::Create(400, 300);
+        s.column = std::make_shared<Container>();
+        auto flex = std::make_unique<FlexLayout>(FlexDirection::Column, 4);
+        flex->SetAlign(AlignItems::Stretch);
+        s.column->SetLayout(std::move(flex));
+        s.column->SetSize(200, 280);
+        s.column->SetPadding(6);
+
+        auto title = std::make_shared<Label>(L"Title");
+        s.wrapped = std::make_shared<Label>(wrappedText);
+        s.wrapped->SetWordWrap(true);
+        s.wrapped->SetAutoWidth(false);
+        auto row = std::make_shared<Container>();
+        row->SetLayout(std::make_unique<FlexLayout>(FlexDirection::Row, 8));
+        row->SetAutoHeight(true);
+        auto ok = std::make_shared<Button>(L"OK");
+        ok->SetSize(60, 24);
+        auto cancel = std::make_shared<Button>(L"Cancel");
+        cancel->SetSize(60, 24);
+        cancel->SetFlexGrowFactor(1.0f);
+
+        row->AddChild(ok);
+        row->AddChild(cancel);
+        s.column->AddChild(title);
+        s.column->AddChild(s.wrapped);
+        s.column->AddChild(row);
+        s.root->AddChild(s.column);
+        s.all = {s.column, title, s.wrapped, row, ok, cancel};
+        return s;
+    }
+
+    bool SameRect(const RECT& a, const RECT& b) {
+        return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+    }
+
+    bool SameGeometry(const Scene& a, const Scene& b) {
+        for(size_t i = 0; i < a.all.size(); i++) {
+            if(!SameRect(a.all[i]->EffectiveRect(), b.all[i]->EffectiveRect())) return false;
+        }
+        return true;
+    }
+
+    bool IsUnlaidOut(const Scene& s) {
+        for(auto& w : s.all) {
+            RECT r = w->EffectiveRect();
+            if(r.right - r.left > 0 || r.bottom - r.top > 0) return false;
+        }
+        return true;
+    }
+}
+
+void TestSaveLoadAdopt() {
+    // Lay out once and save
+    Scene laidOut = BuildScene();
+    laidOut.root->InvalidateLayout();
+    CHECK(laidOut.wrapped->EffectiveRect().bottom - laidOut.wrapped->EffectiveRect().top > 16); // Wrapped
+    LayoutSnapshot saved;
+    saved.Capture(*laidOut.root);
+    CHECK_EQ(saved.GetWidgetCount(), 1 + laidOut.all.size());
+    CHECK(saved.SaveToFile(CachePath));
+
+    // An identical tree adopts the geometry without being laid out
+    Scene fresh = BuildScene();
+    CHECK(IsUnlaidOut(fresh));
+    LayoutSnapshot loaded;
+    CHECK(loaded.LoadFromFile(CachePath));
+    CHECK_EQ(loaded.GetWidgetCount(), saved.GetWidgetCount());
+    CHECK(loaded.Serialize() == saved.Serialize());
+    CHECK(loaded.Apply(*fresh.root));
+    CHECK(SameGeometry(fresh, laidOut));
+
+    // Adopted geometry is a normal starting point - a later layout pass gives the same result
+    fresh.root->InvalidateLayout();
+    CHECK(SameGeometry(fresh, laidOut));
+
+    // Layout inputs that changed are a hash mismatch: nothing is adopted
+    Scene retexted = BuildScene(L"Other text");
+    CHECK(!loaded.Apply(*retexted.root));
+    CHECK(IsUnlaidOut(retexted));
+
+    Scene resized = BuildScene();
+    {
+        LayoutBatch::ScopedDefer defer;
+        resized.column->SetSize(220, 280);
+    }
+    CHECK(LayoutSnapshot::ComputeHash(*resized.root) != LayoutSnapshot::ComputeHash(*fresh.root));
+    CHECK(!loaded.Apply(*resized.root));
+    CHECK(IsUnlaidOut(resized));
+
+    Scene extended = BuildScene();
+    {
+        LayoutBatch::ScopedDefer defer;
+        extended.column->AddChild(std::make_shared<Label>(L"Extra"));
+    }
+    CHECK(!loaded.Apply(*extended.root));
+    CHECK(IsUnlaidOut(extended));
+
+    std::remove(CachePathA);
+}
+
+void TestAdoptOrLayOut() {
+    std::remove(CachePathA);
+    Scene reference = BuildScene();
+    reference.root->InvalidateLayout();
+
+    // No cache yet: laid out, cache written
+    Scene first = BuildScene();
+    CHECK(!LayoutSnapshot::AdoptOrLayOut(*first.root, CachePath));
+    CHECK(SameGeometry(first, reference));
+
+    // Next startup: adopted
+    Scene second = BuildScene();
+    CHECK(LayoutSnapshot::AdoptOrLayOut(*second.root, CachePath));
+    CHECK(SameGeometry(second, reference));
+
+    // Changed tree: laid out and the cache replaced, then adopted again
+    Scene changed = BuildScene(L"Changed");
+    CHECK(!LayoutSnapshot::AdoptOrLayOut(*changed.root, CachePath));
+    CHECK(!IsUnlaidOut(changed));
+    Scene changedAgain = BuildScene(L"Changed");
+    CHECK(LayoutSnapshot::AdoptOrLayOut(*changedAgain.root, CachePath));
+    CHECK(SameGeometry(changedAgain, changed));
+
+    std::remove(CachePathA);
+}
+
+void TestMalformed() {
+    Scene s = BuildScene();
+    s.root->InvalidateLayout();
+    LayoutSnapshot snapshot;
+    snapshot.Capture(*s.root);
+    std::vector<uint8_t> bytes = snapshot.Serialize();
+
+    LayoutSnapshot loaded;
+    for(size_t size : {size_t(0), size_t(4), size_t(16), bytes.size() - 1}) {
+        CHECK(!loaded.Deserialize(bytes.data(), size));
+        CHECK(loaded.IsEmpty());
+    }
+    std::vector<uint8_t> corrupt = bytes;
+    corrupt[0] ^= 0xFF;
+    CHECK(!loaded.Deserialize(corrupt.data(), corrupt.size()));
+    CHECK(!loaded.Apply(*s.root));
+
+    CHECK(!loaded.LoadFromFile(L"LayoutSnapshotTests.missing"));
+    CHECK(loaded.Deserialize(bytes.data(), bytes.size()));
+    CHECK(loaded.Apply(*s.root));
+}
+
+int main() {
+    TestSaveLoadAdopt();
+    TestAdoptOrLayOut();
+    TestMalformed();
+    return CheckResult();
+}
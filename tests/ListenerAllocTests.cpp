@@ -0,0 +1,91 @@
+#include <cstdint>
+
+#include "Root.h"
+#include "Widget.h"
+#include "AllocCount.h"
+#include "Check.h"
+
+// Mouse listeners: captures up to 32 bytes are stored inline, and once the slot map has grown,
+// adding, firing and removing listeners doesn't allocate
+
+namespace {
+    const int Listeners = 8;
+
+    struct Capture32 {
+        uint64_t* counter;
+        uint64_t a, b, c;
+    };
+    static_assert(sizeof(Capture32) == 32, "Capture must be exactly the inline capacity");
+
+    struct Capture64 {
+        uint64_t* counter;
+        uint64_t pad[7];
+    };
+}
+
+void TestSmallCapturesDontAllocate() {
+    auto root = Root::Create(200, 200);
+    auto target = std::make_shared<Widget>();
+    target->SetSize(100, 100);
+    root->AddChild(target);
+    root->UpdateInternalLayout();
+
+    uint64_t fired = 0;
+    uint64_t ids[Listeners];
+    auto cycle = [&] {
+        for(int i = 0; i < Listeners; i++) {
+            if(i % 2) {
+                Capture32 cap{&fired, uint64_t(i), 2, 3};
+                ids[i] = target->AddMouseListener([cap](const MouseEvent&) { *cap.counter += cap.a + cap.b + cap.c; });
+            }
+            else {
+                uint64_t* counter = &fired;
+                ids[i] = target->AddMouseListener([counter](const MouseEvent&) { (*counter)++; });
+            }
+        }
+        root->InitFeedMouseEvent({MouseEventType::Move, {10, 10}, MouseButton::None});
+        root->InitFeedMouseEvent({MouseEventType::Down, {10, 10}, MouseButton::Left});
+        root->InitFeedMouseEvent({MouseEventType::Up, {10, 10}, MouseButton::Left});
+        root->InitFeedMouseEvent({MouseEventType::Move, {150, 150}, MouseButton::None});
+        for(int i = 0; i < Listeners; i++) {
+            target->RemoveMouseListener(ids[i]);
+        }
+    };
+
+    cycle(); // Warm-up: grows the slot map and free list
+    uint64_t warmFired = fired;
+    CHECK(warmFired > 0);
+
+    size_t before = AllocationCount();
+    for(int round = 0; round < 100; round++) {
+        cycle();
+    }
+    CHECK_EQ(AllocationCount() - before, 0);
+    CHECK_EQ(fired, warmFired * 101);
+
+    // Stale IDs are ignored, even once their slot is reused
+    uint64_t stale = ids[0];
+    uint64_t fresh = target->AddMouseListener([](const MouseEvent&) {});
+    CHECK(fresh != stale);
+    target->RemoveMouseListener(stale);
+    target->RemoveMouseListener(fresh);
+}
+
+void TestLargeCapturesAllocate() {
+    // Sanity check of the counter: captures beyond the inline capacity go to the heap
+    auto target = std::make_shared<Widget>();
+    target->RemoveMouseListener(target->AddMouseListener([](const MouseEvent&) {}));
+
+    uint64_t fired = 0;
+    Capture64 cap{&fired, {}};
+    size_t before = AllocationCount();
+    uint64_t id = target->AddMouseListener([cap](const MouseEvent&) { (*cap.counter)++; });
+    CHECK(AllocationCount() - before > 0);
+    target->RemoveMouseListener(id);
+}
+
+int main() {
+    TestSmallCapturesDontAllocate();
+    TestLargeCapturesAllocate();
+    return CheckResult();
+}
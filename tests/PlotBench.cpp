@@ -0,0 +1,127 @@
+#include <atomic>
+#include <thread>
+#include <random>
+#include <vector>
+#include <cstdio>
+
+#include "Plot.h"
+#include "Painter.h"
+#include "Check.h"
+
+// Plot push throughput and render cost versus sample count
+// Rendering is measured with a painter that only counts lines - the decimation cost, not GDI's
+
+namespace {
+    class CountingPainter : public Painter {
+        public:
+            size_t lines = 0;
+
+            void FillRect(const RECT&, const Color&) override {}
+            void DrawString(const wchar_t*, int, const RECT&, UINT, HFONT, const Color&) override {}
+            void DrawLine(int, int, int, int, const Color&) override { lines++; }
+            void PushClip(const RECT&) override {}
+            void PopClip() override {}
+    };
+}
+
+void BenchPush() {
+    const size_t Count = 20000000;
+
+    // Same thread, polled every 32k samples (well within the feed)
+    Plot plot;
+    plot.AddSeries(L"t", Color::FromRGB(255, 0, 0), 1 << 20, 1 << 16);
+    size_t pushed = 0;
+    double singleMs = MeasureMs(1, [&] {
+        for(size_t i = 0; i < Count; i++) {
+            pushed += plot.Push(0, float(i & 1023));
+            if((i & 32767) == 32767) plot.Poll();
+        }
+        plot.Poll();
+    });
+    CHECK_EQ(pushed, Count);
+
+    std::vector<float> block(256, 1.0f);
+    double blockMs = MeasureMs(1, [&] {
+        for(size_t i = 0; i < Count / 256; i++) {
+            plot.Push(0, block.data(), block.size());
+            if((i & 127) == 127) plot.Poll();
+        }
+        plot.Poll();
+    });
+    CHECK_EQ(plot.GetDroppedCount(0), 0);
+
+    // Producer thread while the UI thread polls every 0.5 ms - whatever doesn't fit is dropped and counted
+    Plot threaded;
+    threaded.AddSeries(L"t", Color::FromRGB(255, 0, 0), 1 << 20, 1 << 18);
+    std::atomic<bool> done{false};
+    size_t polled = 0;
+    double threadedMs = MeasureMs(1, [&] {
+        std::thread producer([&] {
+            for(size_t i = 0; i < Count; i++) threaded.Push(0, float(i));
+            done.store(true, std::memory_order_release);
+        });
+        while(!done.load(std::memory_order_acquire)) {
+            polled += threaded.Poll();
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+        producer.join();
+        polled += threaded.Poll();
+    });
+    CHECK_EQ(polled + threaded.GetDroppedCount(0), Count);
+    CHECK_EQ(threaded.GetTotalCount(0), polled);
+
+    std::printf("push: %.1f M samples/s single, %.1f M samples/s in blocks of 256, %.1f M samples/s from a producer thread (%llu dropped)\n",
+        Count / singleMs / 1e3, Count / blockMs / 1e3, Count / threadedMs / 1e3,
+        static_cast<unsigned long long>(threaded.GetDroppedCount(0)));
+}
+
+void BenchRender() {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+
+    std::printf("%10s %14s %16s %22s\n", "samples", "first render", "full rescan", "frame (+1000 samples)");
+    for(size_t count : {1000u, 10000u, 100000u, 1000000u, 4000000u}) {
+        Plot plot;
+        plot.SetSize(860, 300);
+        plot.AddSeries(L"s", Color::FromRGB(255, 0, 0), count, 1 << 22);
+
+        std::vector<float> data(count);
+        for(float& v : data) v = value(rng);
+        plot.Push(0, data.data(), data.size());
+        plot.Poll();
+
+        CountingPainter painter;
+        double firstMs = MeasureMs(1, [&] { plot.Render(painter); });
+
+        // Width changes (that change the samples per column) drop the column cache - every visible sample is scanned again
+        int width = 860;
+        double rescanMs = MeasureMs(20, [&] {
+            width = width == 860 ? 430 : 860;
+            plot.SetSize(width, 300);
+            plot.Render(painter);
+        });
+
+        // Steady state: only the new samples (and the partial newest column) are scanned
+        std::vector<float> more(1000);
+        for(float& v : more) v = value(rng);
+        size_t lines = 0;
+        double frameMs = MeasureMs(200, [&] {
+            plot.Push(0, more.data(), more.size());
+            plot.Poll();
+            CountingPainter frame;
+            plot.Render(frame);
+            lines = frame.lines;
+        });
+        CHECK(plot.GetColumnCount() <= 860);
+        // A line per column (plus one connecting columns spread wider than a pixel) and the grid, whatever the count
+        CHECK(lines <= 2 * plot.GetColumnCount() + 16);
+
+        std::printf("%10zu %11.1f us %13.1f us %13.1f us (%zu lines)\n", count, firstMs * 1e3, rescanMs * 1e3, frameMs * 1e3, lines);
+    }
+}
+
+int main() {
+    BenchPush();
+    BenchRender();
+    return CheckResult();
+}
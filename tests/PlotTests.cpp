@@ -0,0 +1,155 @@
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "Root.h"
+#include "Plot.h"
+#include "Painter.h"
+#include "FrameScheduler.h"
+#include "Check.h"
+
+// Plot decimation checked against a brute-force scan of everything pushed, and Poll driven by a FrameScheduler
+
+namespace {
+    class NullPainter : public Painter {
+        public:
+            void FillRect(const RECT&, const Color&) override {}
+            void DrawString(const wchar_t*, int, const RECT&, UINT, HFONT, const Color&) override {}
+            void DrawLine(int, int, int, int, const Color&) override {}
+            void PushClip(const RECT&) override {}
+            void PopClip() override {}
+    };
+
+    // Compares every column of the last render with the min/max of the samples it covers, scanned from scratch
+    // all = every sample ever pushed to the series, capacity = its history length
+    int CountBadColumns(const Plot& plot, size_t index, const std::vector<float>& all, size_t capacity) {
+        size_t columns = plot.GetColumnCount();
+        uint64_t spc = plot.GetSamplesPerColumn();
+        uint64_t total = all.size();
+        if(total == 0 || columns == 0) return 0;
+
+        uint64_t oldest = total > capacity ? total - capacity : 0;
+        uint64_t lastColumn = (total - 1) / spc;
+
+        int bad = 0;
+        for(size_t c = 0; c < columns; c++) {
+            uint64_t fromRight = columns - 1 - c;
+            bool inHistory = fromRight <= lastColumn;
+            uint64_t k = inHistory ? lastColumn - fromRight : 0;
+            uint64_t from = std::max(k * spc, oldest), to = std::min((k + 1) * spc, total);
+
+            float min = 0.0f, max = 0.0f;
+            bool has = plot.GetColumnRange(index, c, min, max);
+            if(!inHistory || from >= to) {
+                if(has) bad++;
+                continue;
+            }
+
+            auto range = std::minmax_element(all.begin() + from, all.begin() + to);
+            if(!has || min != *range.first || max != *range.second) bad++;
+        }
+        return bad;
+    }
+}
+
+void TestDecimation() {
+    const size_t Capacities[2] = {5000, 777}; // The second one wraps around a lot, at a non-power-of-two
+    Plot plot;
+    plot.AddSeries(L"a", Color::FromRGB(255, 0, 0), Capacities[0], 20000);
+    plot.AddSeries(L"b", Color::FromRGB(0, 255, 0), Capacities[1], 20000);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+    std::vector<float> pushed[2];
+    std::vector<float> block(12000);
+
+    int bad = 0;
+    for(int round = 0; round < 400; round++) {
+        // Mostly small pushes, now and then more than a whole history
+        for(size_t i = 0; i < 2; i++) {
+            size_t n = rng() % (round % 50 == 0 ? 12000 : 300);
+            for(size_t j = 0; j < n; j++) block[j] = value(rng);
+            CHECK_EQ(plot.Push(i, block.data(), n), n);
+            pushed[i].insert(pushed[i].end(), block.begin(), block.begin() + n);
+        }
+        plot.Poll();
+
+        // Width changes rebuild the cache; a fixed window changes the samples per column
+        plot.SetSize(round % 97 == 0 ? 100 + int(rng() % 400) : 300, 200);
+        if(round == 200) plot.SetVisibleSamples(3000);
+        if(round == 300) plot.SetVisibleSamples(0);
+
+        NullPainter painter;
+        plot.Render(painter);
+        for(size_t i = 0; i < 2; i++) {
+            bad += CountBadColumns(plot, i, pushed[i], Capacities[i]);
+            CHECK_EQ(plot.GetTotalCount(i), pushed[i].size());
+        }
+    }
+    CHECK_EQ(bad, 0);
+
+    // A cleared series has no columns
+    plot.Clear(0);
+    NullPainter painter;
+    plot.Render(painter);
+    float min, max;
+    CHECK_EQ(plot.GetSampleCount(0), 0);
+    CHECK(!plot.GetColumnRange(0, plot.GetColumnCount() - 1, min, max));
+}
+
+void TestSchedulerPolls() {
+    auto root = Root::Create(400, 300);
+    FrameScheduler scheduler(*root);
+    double now = 0.0;
+    scheduler.SetClock([&now] { return now; });
+
+    int renders = 0;
+    auto render = [&renders](Root& r, const RECT&) {
+        NullPainter painter;
+        r.InitRender(painter);
+        renders++;
+    };
+
+    auto plot = std::make_shared<Plot>();
+    plot->SetSize(300, 200);
+    plot->AddSeries(L"s", Color::FromRGB(255, 0, 0), 1000, 100);
+    root->AddChild(plot);
+    plot->AttachScheduler(scheduler);
+
+    now += 1.0;
+    scheduler.RunFrame(render);
+    CHECK(!scheduler.NeedsFrame());
+
+    // Pushed samples ask for a frame, which polls them in and renders
+    const float samples[3] = {1.0f, 2.0f, 3.0f};
+    plot->Push(0, samples, 3);
+    CHECK(plot->HasPendingSamples());
+    CHECK(scheduler.NeedsFrame());
+
+    now += 1.0;
+    renders = 0;
+    CHECK(scheduler.RunFrame(render));
+    CHECK_EQ(renders, 1);
+    CHECK_EQ(plot->GetSampleCount(0), 3);
+    CHECK(!scheduler.NeedsFrame());
+
+    // Detached: pushes no longer drive frames
+    plot->DetachScheduler();
+    plot->Push(0, 4.0f);
+    CHECK(!scheduler.NeedsFrame());
+
+    // A dying plot unregisters itself
+    plot->AttachScheduler(scheduler);
+    CHECK(scheduler.NeedsFrame());
+    root->RemoveChild(plot);
+    plot.reset();
+    now += 1.0;
+    scheduler.RunFrame(render);
+    CHECK(!scheduler.NeedsFrame());
+}
+
+int main() {
+    TestDecimation();
+    TestSchedulerPolls();
+    return CheckResult();
+}
@@ -0,0 +1,139 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "MpscQueue.h"
+#include "PropertyUpdateQueue.h"
+#include "Label.h"
+#include "Check.h"
+
+// Multi-producer stress tests of the cross-thread queues - most useful under -DUI_SANITIZER=thread
+// Producers hammer the queue while the consumer drains concurrently; every value must arrive exactly once,
+// in posting order per producer.
+
+namespace {
+    const int ProducerCount = 4;
+
+    void WaitForStart(const std::atomic<bool>& go) {
+        while(!go.load(std::memory_order_acquire)) std::this_thread::yield();
+    }
+}
+
+void TestMpscQueue() {
+    const uint32_t PerProducer = 50000;
+
+    MpscQueue<uint64_t> queue;
+    std::atomic<bool> go{false};
+    std::atomic<int> running{ProducerCount};
+
+    std::vector<std::thread> producers;
+    for(int p = 0; p < ProducerCount; p++) {
+        producers.emplace_back([&, p] {
+            WaitForStart(go);
+            for(uint32_t i = 0; i < PerProducer; i++) {
+                queue.Push((uint64_t(p) << 32) | i);
+                if(i % 1024 == 0) std::this_thread::yield(); // Interleave producers even on few cores
+            }
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    // Consumer: per producer, values must come in the order they were pushed
+    std::vector<uint32_t> next(ProducerCount, 0);
+    size_t received = 0;
+    bool ordered = true;
+    go.store(true, std::memory_order_release);
+
+    uint64_t value;
+    while(true) {
+        bool finished = running.load(std::memory_order_acquire) == 0;
+        bool any = false;
+        while(queue.Pop(value)) {
+            any = true;
+            uint32_t producer = uint32_t(value >> 32), sequence = uint32_t(value);
+            if(producer >= ProducerCount || sequence != next[producer]) ordered = false;
+            else next[producer]++;
+            received++;
+        }
+        if(finished && queue.IsEmpty()) break; // Everything pushed before the producers finished is visible now
+        if(!any) std::this_thread::yield();
+    }
+    for(std::thread& t : producers) t.join();
+
+    CHECK(ordered);
+    CHECK_EQ(received, size_t(ProducerCount) * PerProducer);
+    for(int p = 0; p < ProducerCount; p++) CHECK_EQ(next[p], PerProducer);
+}
+
+void TestPropertyUpdateQueue() {
+    const int PerProducer = 20000;
+
+    // Every producer updates the text and width of its own label
+    std::vector<std::shared_ptr<Label>> labels;
+    for(int p = 0; p < ProducerCount; p++) {
+        labels.push_back(std::make_shared<Label>(L""));
+    }
+
+    PropertyUpdateQueue queue;
+    std::atomic<bool> go{false};
+    std::atomic<int> running{ProducerCount};
+
+    std::vector<std::thread> producers;
+    for(int p = 0; p < ProducerCount; p++) {
+        producers.emplace_back([&, p] {
+            std::shared_ptr<Widget> target = labels[p];
+            WaitForStart(go);
+            for(int i = 1; i <= PerProducer; i++) {
+                queue.Post(target, PropertyID::Text, std::to_wstring(i));
+                queue.Post(target, PropertyID::Width, float(i));
+                if(i % 512 == 0) std::this_thread::yield();
+            }
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    // Applied values only ever move forward per (widget, property) - coalescing keeps the latest one
+    std::vector<int> lastText(ProducerCount, 0), lastWidth(ProducerCount, 0);
+    bool monotonic = true;
+    size_t applied = 0;
+    auto observe = [&](Widget& w, PropertyID property, const PropertyValue& value) {
+        int p = 0;
+        while(p < ProducerCount && labels[p].get() != &w) p++;
+        if(p == ProducerCount) {
+            monotonic = false;
+            return;
+        }
+
+        int v = property == PropertyID::Text ? std::stoi(std::get<std::wstring>(value)) : int(std::get<float>(value));
+        int& last = property == PropertyID::Text ? lastText[p] : lastWidth[p];
+        if(v <= last) monotonic = false;
+        last = v;
+    };
+    go.store(true, std::memory_order_release);
+
+    while(true) {
+        bool finished = running.load(std::memory_order_acquire) == 0;
+        size_t n = queue.Drain(observe);
+        applied += n;
+        if(finished && !queue.HasPending()) break;
+        if(n == 0) std::this_thread::yield();
+    }
+    for(std::thread& t : producers) t.join();
+
+    CHECK(monotonic);
+    CHECK(applied <= size_t(2 * ProducerCount * PerProducer));
+    for(int p = 0; p < ProducerCount; p++) {
+        CHECK_EQ(lastText[p], PerProducer);
+        CHECK_EQ(lastWidth[p], PerProducer);
+        CHECK(labels[p]->GetText() == std::to_wstring(PerProducer));
+        CHECK_EQ(labels[p]->GetWidth(), PerProducer);
+    }
+}
+
+int main() {
+    TestMpscQueue();
+    TestPropertyUpdateQueue();
+    return CheckResult();
+}
@@ -0,0 +1,232 @@
+#include <set>
+#include <vector>
+
+#include "Root.h"
+#include "Label.h"
+#include "Button.h"
+#include "Selector.h"
+#include "Check.h"
+
+// WidgetIndex and Selector: id/tag lookups following AddChild/RemoveChild, id/tag changes and overlays;
+// selector matching (types, ids, tags, descendant combinators) checked against expected sets and a full walk
+
+namespace {
+    using WidgetSet = std::set<Widget*>;
+
+    struct Scene {
+        std::shared_ptr<Root> root;
+        std::shared_ptr<Container> settings, general, other, popup;
+        std::shared_ptr<Label> l1, l2, l3, l4;
+        std::shared_ptr<Button> b1, b2;
+    };
+
+    // root { settings#settings.panel { general.admin { l1.admin, b1#ok.admin.danger }, l2, b2.danger },
+    //        other.panel { l3.admin } }
+    // popup#popup { l4.admin } - not shown
+    Scene BuildScene() {
+        Scene s;
+        s.root = Root::Create(400, 300);
+        s.settings = std::make_shared<Container>();
+        s.general = std::make_shared<Container>();
+        s.other = std::make_shared<Container>();
+        s.popup = std::make_shared<Container>();
+        s.l1 = std::make_shared<Label>(L"1");
+        s.l2 = std::make_shared<Label>(L"2");
+        s.l3 = std::make_shared<Label>(L"3");
+        s.l4 = std::make_shared<Label>(L"4");
+        s.b1 = std::make_shared<Button>(L"OK");
+        s.b2 = std::make_shared<Button>(L"Delete");
+
+        // Ids and tags set before attaching - indexed with the subtree
+        s.settings->SetId("settings");
+        s.settings->AddTag("panel");
+        s.other->AddTag("panel");
+        s.general->AddTag("admin");
+        s.l1->AddTag("admin");
+        s.b1->SetId("ok");
+        s.b1->SetId(7);
+        s.b1->AddTag("admin");
+        s.b1->AddTag("danger");
+        s.b2->AddTag("danger");
+        s.l3->AddTag("admin");
+        s.popup->SetId("popup");
+        s.popup->SetSize(100, 50);
+        s.l4->AddTag("admin");
+
+        s.general->AddChild(s.l1);
+        s.general->AddChild(s.b1);
+        s.settings->AddChild(s.general);
+        s.settings->AddChild(s.l2);
+        s.settings->AddChild(s.b2);
+        s.other->AddChild(s.l3);
+        s.popup->AddChild(s.l4);
+        s.root->AddChild(s.settings);
+        s.root->AddChild(s.other);
+        return s;
+    }
+
+    WidgetSet Tagged(const Root& root, const std::string& tag) {
+        const std::vector<Widget*>& v = root.GetTagged(tag);
+        return WidgetSet(v.begin(), v.end());
+    }
+
+    WidgetSet Select(Widget& scope, const std::string& selector) {
+        std::vector<Widget*> v = Selector(selector).Select(scope);
+        WidgetSet set(v.begin(), v.end());
+        CHECK_EQ(set.size(), v.size()); // No duplicates
+        return set;
+    }
+
+    void Collect(Widget& w, std::vector<Widget*>& out) {
+        out.push_back(&w);
+        if(auto* c = dynamic_cast<Container*>(&w)) {
+            for(auto& child : c->Children()) Collect(*child, out);
+        }
+    }
+
+    // The indexed query finds exactly the descendants a full walk with Matches finds
+    bool SelectsLikeWalk(Root& root, const std::string& text, const std::vector<Widget*>& extraTops = {}) {
+        Selector selector(text);
+        std::vector<Widget*> all;
+        for(auto& child : root.Children()) Collect(*child, all);
+        for(Widget* top : extraTops) Collect(*top, all);
+
+        WidgetSet expected;
+        for(Widget* w : all) {
+            if(selector.Matches(*w)) expected.insert(w);
+        }
+        return Select(root, text) == expected;
+    }
+}
+
+void TestIndex() {
+    Scene s = BuildScene();
+    Root& root = *s.root;
+    CHECK(root.FindById("ok") == s.b1.get());
+    CHECK(root.FindById(7) == s.b1.get());
+    CHECK(root.FindById("settings") == s.settings.get());
+    CHECK(root.FindById("popup") == nullptr);
+    CHECK(root.FindById("missing") == nullptr);
+    CHECK(Tagged(root, "admin") == WidgetSet({s.general.get(), s.l1.get(), s.b1.get(), s.l3.get()}));
+    CHECK(Tagged(root, "danger") == WidgetSet({s.b1.get(), s.b2.get()}));
+    CHECK(Tagged(root, "unknown").empty());
+
+    // Removing a subtree unindexes all of it
+    s.settings->RemoveChild(s.general);
+    CHECK(root.FindById("ok") == nullptr);
+    CHECK(root.FindById(7) == nullptr);
+    CHECK(Tagged(root, "admin") == WidgetSet({s.l3.get()}));
+    CHECK(Tagged(root, "danger") == WidgetSet({s.b2.get()}));
+
+    // Changes while detached show up once attached elsewhere
+    s.b1->SetId("confirm");
+    s.l1->RemoveTag("admin");
+    s.other->AddChild(s.general);
+    CHECK(root.FindById("ok") == nullptr);
+    CHECK(root.FindById("confirm") == s.b1.get());
+    CHECK(root.FindById(7) == s.b1.get());
+    CHECK(Tagged(root, "admin") == WidgetSet({s.general.get(), s.b1.get(), s.l3.get()}));
+
+    // Changes while attached are re-indexed
+    s.b1->SetId("");
+    s.b1->SetId(0);
+    CHECK(root.FindById("confirm") == nullptr);
+    CHECK(root.FindById(7) == nullptr);
+    s.l2->SetId("ok");
+    CHECK(root.FindById("ok") == s.l2.get());
+    s.l2->AddTag("admin");
+    s.l2->AddTag("admin"); // Once
+    s.b1->RemoveTag("admin");
+    s.b1->RemoveTag("danger");
+    CHECK(Tagged(root, "admin") == WidgetSet({s.general.get(), s.l2.get(), s.l3.get()}));
+    CHECK(Tagged(root, "danger") == WidgetSet({s.b2.get()}));
+
+    // Overlays are indexed while shown
+    root.ShowOverlay(s.popup, OverlayLayer::Popup);
+    CHECK(root.FindById("popup") == s.popup.get());
+    CHECK(Tagged(root, "admin").count(s.l4.get()) == 1);
+    root.ShowOverlay(s.popup, OverlayLayer::Popup, 1); // Moved, not indexed twice
+    CHECK_EQ(root.GetTagged("admin").size(), 4);
+    root.HideOverlay(s.popup);
+    CHECK(root.FindById("popup") == nullptr);
+    CHECK(Tagged(root, "admin").count(s.l4.get()) == 0);
+
+    // Removing from the Root itself
+    root.RemoveChild(s.other);
+    CHECK(Tagged(root, "admin") == WidgetSet({s.l2.get()}));
+    CHECK(root.FindById("ok") == s.l2.get());
+}
+
+void TestSelectors() {
+    Scene s = BuildScene();
+    Root& root = *s.root;
+
+    CHECK(Select(root, "#ok") == WidgetSet({s.b1.get()}));
+    CHECK(Select(root, ".danger") == WidgetSet({s.b1.get(), s.b2.get()}));
+    CHECK(Select(root, "Button.admin.danger") == WidgetSet({s.b1.get()}));
+    CHECK(Select(root, "Label") == WidgetSet({s.l1.get(), s.l2.get(), s.l3.get()}));
+    CHECK(Select(root, "Container.panel") == WidgetSet({s.settings.get(), s.other.get()}));
+
+    // Descendant combinators, at any depth
+    CHECK(Select(root, "#settings Button") == WidgetSet({s.b1.get(), s.b2.get()}));
+    CHECK(Select(root, "#settings .admin Label") == WidgetSet({s.l1.get()}));
+    CHECK(Select(root, ".panel .admin") == WidgetSet({s.general.get(), s.l1.get(), s.b1.get(), s.l3.get()}));
+    CHECK(Select(root, ".panel Container Button") == WidgetSet({s.b1.get()}));
+    CHECK(Select(root, "#settings #ok") == WidgetSet({s.b1.get()}));
+    CHECK(Select(root, "#ok Label").empty());
+    CHECK(Select(root, ".admin .panel").empty());
+    CHECK(Select(root, "Root #settings") == WidgetSet({s.settings.get()}));
+
+    // Scoped queries only see the scope's descendants
+    CHECK(Select(*s.other, ".admin") == WidgetSet({s.l3.get()}));
+    CHECK(Select(*s.settings, "Label") == WidgetSet({s.l1.get(), s.l2.get()}));
+    CHECK(Select(*s.general, "#settings Button") == WidgetSet({s.b1.get()}));
+
+    // Matches looks up the ancestor chain
+    Selector nested("#settings .admin Button");
+    CHECK(nested.Matches(*s.b1));
+    CHECK(!nested.Matches(*s.b2));
+    CHECK(!nested.Matches(*s.l1));
+    CHECK(nested.SelectFirst(root) == s.b1.get());
+    CHECK(Selector("#missing").SelectFirst(root) == nullptr);
+
+    // Index-driven queries agree with a full walk, before and after tree changes and with a shown overlay
+    const char* queries[] = {
+        "*", "Label", ".admin", "#ok", ".panel .admin Label", "Container Button", "#settings *", ".admin .admin",
+        "Container.panel Label.admin", "#popup Label"
+    };
+    for(const char* q : queries) CHECK(SelectsLikeWalk(root, q));
+
+    s.settings->RemoveChild(s.general);
+    s.other->AddChild(s.general);
+    s.l2->AddTag("admin");
+    CHECK(Select(root, "#settings .admin Label").empty()); // l2 is .admin itself, not inside one
+    CHECK(Select(root, "#settings Label.admin") == WidgetSet({s.l2.get()}));
+    CHECK(Select(root, ".panel .admin Label") == WidgetSet({s.l1.get()}));
+    for(const char* q : queries) CHECK(SelectsLikeWalk(root, q));
+
+    root.ShowOverlay(s.popup, OverlayLayer::Popup);
+    CHECK(Select(root, "#popup Label") == WidgetSet({s.l4.get()}));
+    CHECK(Select(root, "Label.admin").count(s.l4.get()) == 1);
+    for(const char* q : queries) CHECK(SelectsLikeWalk(root, q, {s.popup.get()}));
+    root.HideOverlay(s.popup);
+    CHECK(Select(root, "#popup Label").empty());
+
+    // Bulk operations
+    CHECK_EQ(Selector(".panel Label").SetEnabled(root, false), 3);
+    CHECK(!s.l1->IsEnabled() && !s.l3->IsEnabled() && s.b1->IsEnabled());
+
+    // Invalid selectors match nothing
+    for(const char* bad : {"", "#", ".", "Frame", "Button..admin", "#ok >"}) {
+        Selector selector(bad);
+        CHECK(!selector.IsValid());
+        CHECK(selector.Select(root).empty());
+        CHECK(!selector.Matches(*s.b1));
+    }
+}
+
+int main() {
+    TestIndex();
+    TestSelectors();
+    return CheckResult();
+}
@@ -0,0 +1,85 @@
+#include <memory>
+
+#include "Button.h"
+#include "Style.h"
+#include "PropertyUpdateQueue.h"
+#include "Check.h"
+
+// Interned style records: shared between identical looks, freed with their last reference
+
+void TestPrivateLooksAreFreed() {
+    StyleRegistry& registry = StyleRegistry::Get();
+    auto button = std::make_shared<Button>(L"b");
+    size_t baseline = registry.GetInternedCount();
+
+    // Every color gives the button a new private look; the previous one dies with it
+    for(int i = 0; i < 10000; i++) {
+        button->SetBackColor(Color::FromRGB(uint8_t(i), uint8_t(i >> 8), 7));
+    }
+    CHECK(registry.GetInternedCount() <= baseline + 1);
+
+    // Identical looks share a record
+    auto twin = std::make_shared<Button>(L"t");
+    twin->SetBackColor(button->GetBackColor());
+    CHECK(twin->GetStyle() == button->GetStyle());
+
+    twin.reset();
+    CHECK(registry.GetInternedCount() <= baseline + 1);
+    button.reset();
+    CHECK(registry.GetInternedCount() <= baseline);
+}
+
+void TestThemeSwaps() {
+    StyleRegistry& registry = StyleRegistry::Get();
+    StyleClassID id = registry.DefineClass("StyleTests.Themed", StyleDesc{});
+
+    auto a = std::make_shared<Widget>();
+    auto b = std::make_shared<Widget>();
+    a->SetStyleClass(id);
+    b->SetStyleClass(id);
+    size_t baseline = registry.GetInternedCount();
+
+    // Swapping the class style restyles its widgets; the previous class style is freed once nobody uses it
+    for(int i = 0; i < 1000; i++) {
+        StyleDesc desc;
+        desc[StyleState::Normal].background = Color::FromRGB(uint8_t(i), uint8_t(i >> 8), 1);
+        registry.SetClassStyle(id, desc);
+        CHECK(a->GetStyle() == registry.GetClassStyle(id));
+        CHECK(b->GetStyle() == registry.GetClassStyle(id));
+    }
+    CHECK(registry.GetInternedCount() <= baseline + 1);
+
+    // Leaving the class for a private look keeps the class style alive for the other widget
+    StyleDesc own;
+    own[StyleState::Normal].accent = Color::FromRGB(1, 2, 3);
+    a->SetStyle(own);
+    CHECK_EQ(a->GetStyleClass(), NoStyleClass);
+    CHECK(b->GetStyle() == registry.GetClassStyle(id));
+    CHECK(b->GetStyle()->Get(StyleState::Normal).background == Color::FromRGB(231, 3, 1));
+}
+
+void TestTextColorUpdates() {
+    StyleRegistry& registry = StyleRegistry::Get();
+    auto button = std::make_shared<Button>(L"b");
+    StyleClassID buttonClass = button->GetStyleClass();
+    const Style* classStyle = button->GetStyle();
+    size_t baseline = registry.GetInternedCount();
+
+    // Text colors posted from other threads are kept per widget: no style per color, still following the theme
+    PropertyUpdateQueue queue;
+    for(int i = 0; i < 1000; i++) {
+        queue.Post(button, PropertyID::TextColor, Color::FromRGB(uint8_t(i), 0, uint8_t(i >> 8)));
+        queue.Drain();
+    }
+    CHECK(button->GetTextColor() == Color::FromRGB(231, 0, 3));
+    CHECK_EQ(button->GetStyleClass(), buttonClass);
+    CHECK(button->GetStyle() == classStyle);
+    CHECK_EQ(registry.GetInternedCount(), baseline);
+}
+
+int main() {
+    TestPrivateLooksAreFreed();
+    TestThemeSwaps();
+    TestTextColorUpdates();
+    return CheckResult();
+}
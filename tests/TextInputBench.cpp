@@ -0,0 +1,77 @@
+#include <cstdio>
+#include <string>
+
+#include "Root.h"
+#include "TextInput.h"
+#include "RenderSnapshot.h"
+#include "Check.h"
+
+// Typing 100k characters (16 per frame, a line break every 64) into the middle of a 1 MB multi-line TextInput,
+// through Root's input queue, recording the frame after each batch. Edits stay local to the caret, so the cost
+// per keystroke mustn't depend on the buffer size.
+
+int main() {
+    const size_t InitialSize = 1024 * 1024;
+    const int Typed = 100000;
+    const int PerFrame = 16;
+    const int LineEvery = 64;
+
+    // 1 MB of 63-character lines
+    std::wstring initial;
+    initial.reserve(InitialSize);
+    while(initial.size() < InitialSize) {
+        initial += initial.size() % LineEvery == LineEvery - 1 ? L'\n' : wchar_t(L'a' + initial.size() % 26);
+    }
+    size_t initialLines = 1 + InitialSize / LineEvery;
+
+    auto root = Root::Create(800, 600);
+    auto input = std::make_shared<TextInput>(true);
+    input->SetSize(780, 580);
+    root->AddChild(input);
+    root->UpdateInternalLayout();
+    input->SetText(initial);
+    CHECK_EQ(input->GetLength(), InitialSize);
+    CHECK_EQ(input->GetLineCount(), initialLines);
+
+    size_t insertAt = InitialSize / 2;
+    input->SetCaret(insertAt);
+    CHECK(root->GetFocusManager().SetFocus(input.get()));
+
+    std::wstring expected;
+    int newlines = 0;
+    RenderSnapshot snapshot;
+    double ms = MeasureMs(1, [&] {
+        for(int i = 0; i < Typed; i++) {
+            if(i % LineEvery == LineEvery - 1) {
+                root->PostKeyEvent({KeyEventType::Down, VK_RETURN, KeyModifiers::None, false});
+                root->PostKeyEvent({KeyEventType::Up, VK_RETURN, KeyModifiers::None, false});
+                expected += L'\n';
+                newlines++;
+            }
+            else {
+                wchar_t c = wchar_t(L'A' + i % 26);
+                root->PostCharEvent({c});
+                expected += c;
+            }
+
+            if(i % PerFrame == PerFrame - 1) {
+                root->DispatchInput();
+                root->RecordSnapshot(snapshot);
+                root->MarkFrame();
+            }
+        }
+        root->DispatchInput();
+    });
+
+    CHECK_EQ(input->GetLength(), InitialSize + Typed);
+    CHECK_EQ(input->GetLineCount(), initialLines + newlines);
+    CHECK_EQ(input->GetCaret(), insertAt + Typed);
+    std::wstring text = input->GetText();
+    CHECK(text.compare(insertAt, expected.size(), expected) == 0);
+    CHECK(text.compare(0, insertAt, initial, 0, insertAt) == 0);
+    CHECK(text.compare(insertAt + Typed, std::wstring::npos, initial, insertAt, std::wstring::npos) == 0);
+
+    std::printf("%d keystrokes into %zu characters: %.3f ms total, %.2f us per keystroke (incl. %d recorded frames)\n",
+        Typed, InitialSize, ms, ms * 1000.0 / Typed, Typed / PerFrame);
+    return CheckResult();
+}
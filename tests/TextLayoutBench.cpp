@@ -0,0 +1,111 @@
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Root.h"
+#include "Label.h"
+#include "FlexLayout.h"
+#include "TextLayout.h"
+#include "Check.h"
+
+// Word wrapping of 100 KB of text: first measure + break, cached widths, widths that re-break, and a wrapped Label
+// resized inside a layout. Incrementally re-broken lines must match a fresh break at the same width.
+
+namespace {
+    std::wstring MakeText(size_t size) {
+        std::mt19937 rng(40);
+        std::uniform_int_distribution<int> wordLength(1, 12), letter(0, 25), breakEvery(0, 60);
+        std::wstring text;
+        text.reserve(size + 16);
+        while(text.size() < size) {
+            int n = wordLength(rng);
+            for(int i = 0; i < n; i++) text += wchar_t(L'a' + letter(rng));
+            text += breakEvery(rng) == 0 ? L'\n' : L' ';
+        }
+        text.resize(size);
+        return text;
+    }
+
+    bool SameLines(const std::vector<TextLayout::Line>& a, const std::vector<TextLayout::Line>& b) {
+        if(a.size() != b.size()) return false;
+        for(size_t i = 0; i < a.size(); i++) {
+            if(a[i].start != b[i].start || a[i].end != b[i].end || a[i].next != b[i].next || a[i].width != b[i].width) return false;
+        }
+        return true;
+    }
+
+    // Lines chain through the whole text, fit the width, and couldn't take one more word
+    bool IsGreedyBreak(const std::vector<TextLayout::Line>& lines, int width, int length) {
+        int pos = 0;
+        for(const TextLayout::Line& l : lines) {
+            if(l.start != pos || l.width > width || l.overflowWidth <= width) return false;
+            pos = l.next;
+        }
+        return pos >= length;
+    }
+}
+
+int main() {
+    const int Runs = 50;
+    std::wstring text = MakeText(100 * 1024);
+    int length = static_cast<int>(text.size());
+
+    TextLayout layout;
+    layout.SetText(text.c_str(), length);
+    size_t lineCount = 0;
+    double firstMs = MeasureMs(1, [&] { lineCount = layout.BreakLines(600).size(); });
+    CHECK(IsGreedyBreak(layout.BreakLines(600), 600, length));
+
+    // Alternating between cached widths is a lookup
+    double cachedMs = MeasureMs(Runs, [&] {
+        layout.BreakLines(600);
+        layout.BreakLines(601);
+    });
+
+    // A new width every run: lines before the first moved break are kept
+    int width = 400;
+    double rebreakMs = MeasureMs(Runs, [&] {
+        width += 7;
+        layout.BreakLines(width);
+    });
+
+    // Whatever the history, the result is the fresh greedy break
+    for(int w : {601, width, 250, 600, 1000}) {
+        TextLayout fresh;
+        fresh.SetText(text.c_str(), length);
+        CHECK(SameLines(layout.BreakLines(w), fresh.BreakLines(w)));
+        CHECK(IsGreedyBreak(fresh.BreakLines(w), w, length));
+    }
+
+    // A wrapped label in a column, narrowed every run: height-for-width follows the width
+    auto root = Root::Create(2000, 100000);
+    auto column = std::make_shared<Container>();
+    column->SetSize(800, 100000);
+    auto flex = std::make_unique<FlexLayout>(FlexDirection::Column);
+    flex->SetAlign(AlignItems::Stretch); // The label takes the column width
+    column->SetLayout(std::move(flex));
+    auto label = std::make_shared<Label>(text);
+    label->SetWordWrap(true);
+    label->SetAutoWidth(false);
+    label->SetFlexShrink(0); // Taller than the column
+    column->AddChild(label);
+    root->AddChild(column);
+    root->UpdateInternalLayout();
+
+    int columnWidth = 800;
+    double labelMs = MeasureMs(Runs, [&] {
+        columnWidth -= 3;
+        column->SetSize(columnWidth, 100000);
+        root->UpdateInternalLayout();
+    });
+    RECT r = label->EffectiveRect();
+    CHECK_EQ(r.right - r.left, columnWidth);
+    TextLayout check;
+    check.SetText(label->GetText().c_str(), length);
+    CHECK_EQ(r.bottom - r.top, check.MeasureHeight(r.right - r.left));
+
+    std::printf("%d characters, %zu lines at 600 px: first break %.3f ms, cached %.4f ms, re-break %.3f ms, wrapped label resize %.3f ms\n",
+        length, lineCount, firstMs, cachedMs / 2, rebreakMs, labelMs);
+    return CheckResult();
+}
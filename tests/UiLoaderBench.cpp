@@ -0,0 +1,141 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <typeinfo>
+
+#include "Root.h"
+#include "Label.h"
+#include "Button.h"
+#include "Slider.h"
+#include "Checkbox.h"
+#include "FlexLayout.h"
+#include "UiCompiler.h"
+#include "UiLoader.h"
+#include "Check.h"
+
+// Instantiating a 10k-node UI description (one pass, deferred layout) against the same tree built in code,
+// both laid out in a window. The loaded tree must match the built one.
+
+namespace {
+    const int Rows = 100;
+    const int Columns = 99; // 1 + 100 rows + 100 * 99 cells = 10001 nodes
+
+    // Cell kind by position, so the description and the code build the same tree
+    int Kind(int row, int column) { return (row * 7 + column) % 4; }
+
+    std::string MakeSource() {
+        std::string s = "Container id=grid layout=column gap=2 padding=4 size=1900,0 autoHeight=true {\n";
+        for(int r = 0; r < Rows; r++) {
+            s += "    Container layout=row gap=2 align=center {\n";
+            for(int c = 0; c < Columns; c++) {
+                std::string id = "cell" + std::to_string(r) + "_" + std::to_string(c);
+                switch(Kind(r, c)) {
+                    case 0: s += "        Label id=" + id + " text=\"Item " + std::to_string(c) + "\"\n"; break;
+                    case 1: s += "        Button id=" + id + " text=\"Go\" size=16,12\n"; break;
+                    case 2: s += "        Checkbox id=" + id + " text=\"On\" checked=true size=16,12\n"; break;
+                    case 3: s += "        Slider id=" + id + " range=0,10,1 value=5 size=16,12\n"; break;
+                }
+            }
+            s += "    }\n";
+        }
+        s += "}\n";
+        return s;
+    }
+
+    std::shared_ptr<Container> BuildImperative() {
+        auto grid = std::make_shared<Container>();
+        grid->SetId("grid");
+        grid->SetLayout(std::make_unique<FlexLayout>(FlexDirection::Column, 2));
+        grid->SetPadding(4);
+        grid->SetSize(1900, 0);
+        grid->SetAutoHeight(true);
+        for(int r = 0; r < Rows; r++) {
+            auto row = std::make_shared<Container>();
+            auto flex = std::make_unique<FlexLayout>(FlexDirection::Row, 2);
+            flex->SetAlign(AlignItems::Center);
+            row->SetLayout(std::move(flex));
+            for(int c = 0; c < Columns; c++) {
+                std::shared_ptr<Widget> cell;
+                switch(Kind(r, c)) {
+                    case 0: cell = std::make_shared<Label>(L"Item " + std::to_wstring(c)); break;
+                    case 1: cell = std::make_shared<Button>(L"Go"); cell->SetSize(16, 12); break;
+                    case 2: {
+                        auto checkbox = std::make_shared<Checkbox>(L"On");
+                        checkbox->SetChecked(true);
+                        checkbox->SetSize(16, 12);
+                        cell = checkbox;
+                        break;
+                    }
+                    case 3: cell = std::make_shared<Slider>(L"", 0.0f, 10.0f, 1.0f, 5.0f); cell->SetSize(16, 12); break;
+                }
+                cell->SetId("cell" + std::to_string(r) + "_" + std::to_string(c));
+                row->AddChild(cell);
+            }
+            grid->AddChild(row);
+        }
+        return grid;
+    }
+
+    bool SameRect(const RECT& a, const RECT& b) {
+        return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+    }
+
+    // Same types, geometry and child structure; counts the nodes
+    bool SameTree(const Widget& a, const Widget& b, size_t& nodes) {
+        nodes++;
+        if(typeid(a) != typeid(b) || !SameRect(a.EffectiveRect(), b.EffectiveRect())) return false;
+        auto* ca = dynamic_cast<const Container*>(&a);
+        auto* cb = dynamic_cast<const Container*>(&b);
+        if(!ca) return true;
+        if(ca->Children().size() != cb->Children().size()) return false;
+        for(size_t i = 0; i < ca->Children().size(); i++) {
+            if(!SameTree(*ca->Children()[i], *cb->Children()[i], nodes)) return false;
+        }
+        return true;
+    }
+}
+
+int main() {
+    const int Runs = 5;
+    std::string source = MakeSource();
+
+    UiCompiler compiler;
+    std::vector<uint8_t> blob;
+    bool compiled = false;
+    double compileMs = MeasureMs(1, [&] { compiled = compiler.Compile(source, blob); });
+    CHECK(compiled);
+    if(!compiled) {
+        std::fprintf(stderr, "%s\n", compiler.GetError().c_str());
+        return CheckResult();
+    }
+
+    // Instantiate + lay out in a window, from the blob and in code
+    UiLoader loader;
+    UiInstance ui;
+    std::shared_ptr<Root> loadedWindow;
+    double loadMs = MeasureMs(Runs, [&] {
+        CHECK(loader.Load(blob.data(), blob.size(), ui));
+        loadedWindow = Root::Create(1920, 1080);
+        loadedWindow->AddChild(ui.root);
+        loadedWindow->UpdateInternalLayout();
+    });
+
+    std::shared_ptr<Container> built;
+    std::shared_ptr<Root> builtWindow;
+    double buildMs = MeasureMs(Runs, [&] {
+        built = BuildImperative();
+        builtWindow = Root::Create(1920, 1080);
+        builtWindow->AddChild(built);
+        builtWindow->UpdateInternalLayout();
+    });
+
+    size_t nodes = 0;
+    CHECK(ui.root && SameTree(*ui.root, *built, nodes));
+    CHECK_EQ(nodes, 1 + Rows + Rows * Columns);
+    CHECK_EQ(ui.ids.size(), 1 + Rows * Columns);
+    CHECK(ui.Find<Slider>("cell99_98") != nullptr);
+
+    std::printf("%zu nodes, %zu byte blob (%zu byte source): compile %.2f ms, load + layout %.2f ms, built in code %.2f ms\n",
+        nodes, blob.size(), source.size(), compileMs, loadMs, buildMs);
+    return CheckResult();
+}
@@ -0,0 +1,232 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <typeinfo>
+
+#include "Root.h"
+#include "Label.h"
+#include "Button.h"
+#include "Slider.h"
+#include "Checkbox.h"
+#include "TextInput.h"
+#include "FlexLayout.h"
+#include "UiCompiler.h"
+#include "UiLoader.h"
+#include "Check.h"
+
+// Compiled UI descriptions: source -> blob -> widgets (from memory and from a mapped file) must match the same tree
+// built in code, and bad sources/blobs must fail cleanly
+
+namespace {
+    const char* Source = R"(
+        // Settings panel
+        Container id=settings layout=column gap=4 padding=8 size=300,0 autoHeight=true align=stretch {
+            Label id=title text="Lautstärke \"main\"" textColor=#FFC8C8C8 wordWrap=true
+            Slider id=volume range=0,100,1 value=50 size=200,20
+            Checkbox id=mute text="Mute" checked=true size=100,20
+            TextInput id=name text="Player" size=200,24 margin=2,4
+            Container id=buttons layout=row justify=end gap=6 grow=1 minSize=0,30 {
+                Button id=cancel text="Cancel" size=80,24 class=UiMarkupTests.Accent
+                Button id=ok text="OK" size=80,24 background=#FF204080 enabled=false
+            }
+        }
+    )";
+
+    // The same tree, built in code
+    std::shared_ptr<Container> BuildImperative(StyleClassID accent) {
+        auto settings = std::make_shared<Container>();
+        auto column = std::make_unique<FlexLayout>(FlexDirection::Column, 4);
+        column->SetAlign(AlignItems::Stretch);
+        settings->SetLayout(std::move(column));
+        settings->SetPadding(8, 8, 8, 8);
+        settings->SetSize(300, 0);
+        settings->SetAutoHeight(true);
+
+        auto title = std::make_shared<Label>(L"Lautstärke \"main\"");
+        title->SetTextColor(Color::FromARGB(0xFF, 0xC8, 0xC8, 0xC8));
+        title->SetWordWrap(true);
+        settings->AddChild(title);
+
+        auto volume = std::make_shared<Slider>(L"", 0.0f, 100.0f, 1.0f, 50.0f);
+        volume->SetSize(200, 20);
+        settings->AddChild(volume);
+
+        auto mute = std::make_shared<Checkbox>(L"Mute");
+        mute->SetChecked(true);
+        mute->SetSize(100, 20);
+        settings->AddChild(mute);
+
+        auto name = std::make_shared<TextInput>();
+        name->SetText(L"Player");
+        name->SetSize(200, 24);
+        name->SetMargin(2, 4);
+        settings->AddChild(name);
+
+        auto buttons = std::make_shared<Container>();
+        auto row = std::make_unique<FlexLayout>(FlexDirection::Row, 6);
+        row->SetJustify(JustifyContent::End);
+        buttons->SetLayout(std::move(row));
+        buttons->SetFlexGrowFactor(1.0f);
+        buttons->SetMinSize(0, 30);
+        settings->AddChild(buttons);
+
+        auto cancel = std::make_shared<Button>(L"Cancel");
+        cancel->SetSize(80, 24);
+        cancel->SetStyleClass(accent);
+        buttons->AddChild(cancel);
+
+        auto ok = std::make_shared<Button>(L"OK");
+        ok->SetSize(80, 24);
+        ok->SetBackgroundColor(Color::FromARGB(0xFF, 0x20, 0x40, 0x80));
+        ok->SetEnabled(false);
+        buttons->AddChild(ok);
+        return settings;
+    }
+
+    bool SameRect(const RECT& a, const RECT& b) {
+        return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+    }
+
+    // Same types, geometry, flags and child structure, recursively
+    bool SameTree(const Widget& a, const Widget& b) {
+        if(typeid(a) != typeid(b)) return false;
+        if(!SameRect(a.EffectiveRect(), b.EffectiveRect())) return false;
+        if(a.IsEnabled() != b.IsEnabled() || a.GetStyleClass() != b.GetStyleClass()) return false;
+
+        auto* ca = dynamic_cast<const Container*>(&a);
+        auto* cb = dynamic_cast<const Container*>(&b);
+        if(!ca) return true;
+        if(ca->Children().size() != cb->Children().size()) return false;
+        for(size_t i = 0; i < ca->Children().size(); i++) {
+            if(!SameTree(*ca->Children()[i], *cb->Children()[i])) return false;
+        }
+        return true;
+    }
+
+    // Lays the tree out in a window of its own (kept alive with the tree)
+    std::shared_ptr<Root> Attach(const std::shared_ptr<Widget>& tree) {
+        auto root = Root::Create(400, 300);
+        root->AddChild(tree);
+        root->UpdateInternalLayout();
+        return root;
+    }
+}
+
+void TestRoundTrip(StyleClassID accent) {
+    UiCompiler compiler;
+    std::vector<uint8_t> blob;
+    CHECK(compiler.Compile(Source, blob));
+    CHECK(compiler.GetError().empty());
+
+    // Compiling is deterministic
+    std::vector<uint8_t> again;
+    CHECK(compiler.Compile(Source, again));
+    CHECK(again == blob);
+
+    UiLoader loader;
+    UiInstance ui;
+    CHECK(loader.Load(blob.data(), blob.size(), ui));
+    if(!ui.root) return;
+
+    // Ids, typed lookups and the properties that don't show in the geometry
+    CHECK_EQ(ui.ids.size(), 8);
+    CHECK(ui.Find("settings") == ui.root);
+    CHECK(ui.Find<Button>("title") == nullptr);
+    CHECK(ui.Find("missing") == nullptr);
+    auto title = ui.Find<Label>("title");
+    CHECK(title && title->GetText() == L"Lautstärke \"main\"");
+    CHECK(title && title->GetTextColor().r == 0xC8);
+    auto volume = ui.Find<Slider>("volume");
+    CHECK(volume && volume->GetMinValue() == 0.0f && volume->GetMaxValue() == 100.0f && volume->GetValue() == 50.0f);
+    auto mute = ui.Find<Checkbox>("mute");
+    CHECK(mute && mute->IsChecked() && mute->GetText() == L"Mute");
+    auto name = ui.Find<TextInput>("name");
+    CHECK(name && name->GetText() == L"Player");
+    auto ok = ui.Find<Button>("ok");
+    CHECK(ok && ok->GetText() == L"OK" && !ok->IsEnabled() && ok->GetBackgroundColor().b == 0x80);
+    CHECK(ui.Find("cancel") && ui.Find("cancel")->GetStyleClass() == accent);
+    CHECK(ui.root->GetStringId() == "settings");
+
+    // Same layout as the tree built in code
+    auto imperative = BuildImperative(accent);
+    auto window = Attach(ui.root);
+    auto imperativeWindow = Attach(imperative);
+    CHECK(SameTree(*ui.root, *imperative));
+    RECT settings = ui.root->EffectiveRect(), buttons = ui.Find("buttons")->EffectiveRect(), okRect = ok->EffectiveRect();
+    CHECK(settings.bottom > settings.top);                          // Auto height
+    CHECK_EQ(buttons.bottom - buttons.top, 30);                     // Min size
+    CHECK_EQ(okRect.right, settings.right - 8);                     // Stretched row, justified to the end
+
+    // The same blob through a memory-mapped file
+    const char* path = "UiMarkupTests.uib";
+    FILE* file = std::fopen(path, "wb");
+    CHECK(file != nullptr);
+    if(!file) return;
+    std::fwrite(blob.data(), 1, blob.size(), file);
+    std::fclose(file);
+
+    UiInstance mapped;
+    CHECK(loader.LoadFile(L"UiMarkupTests.uib", mapped));
+    std::remove(path);
+    if(!mapped.root) return;
+    auto mappedWindow = Attach(mapped.root);
+    CHECK(SameTree(*mapped.root, *ui.root));
+    CHECK_EQ(mapped.ids.size(), 8);
+}
+
+void TestCompileErrors() {
+    UiCompiler compiler;
+    std::vector<uint8_t> blob = {1, 2, 3};
+    const char* bad[] = {
+        "Container id=a { Label id=a }",                // Duplicate id
+        "Container { Label colour=#FF0000 }",           // Unknown attribute
+        "Container { Frame }",                          // Unknown type
+        "Label text=\"open",                            // Unterminated string
+        "Container { Label }\nContainer",               // Two roots
+        "Label { Label }",                              // Children of a non-container
+        "Container cell=0,300",                         // Grid line out of range
+        "Slider value=abc",                             // Bad number
+    };
+    for(const char* source : bad) {
+        CHECK(!compiler.Compile(source, blob));
+        CHECK(compiler.GetError().compare(0, 5, "line ") == 0);
+        CHECK(blob == std::vector<uint8_t>({1, 2, 3}));
+    }
+}
+
+void TestMalformedBlobs() {
+    UiCompiler compiler;
+    std::vector<uint8_t> blob;
+    CHECK(compiler.Compile(Source, blob));
+
+    // Every truncation fails cleanly and leaves the instance empty
+    UiLoader loader;
+    UiInstance ui;
+    for(size_t size = 0; size < blob.size(); size++) {
+        std::vector<uint8_t> cut(blob.begin(), blob.begin() + size);
+        CHECK(!loader.Load(cut.data(), cut.size(), ui));
+        CHECK(!ui.root && ui.ids.empty());
+        CHECK(!loader.GetError().empty());
+    }
+    CHECK(!loader.Load(nullptr, 0, ui));
+
+    // Wrong magic
+    std::vector<uint8_t> corrupt = blob;
+    corrupt[0] ^= 0xFF;
+    CHECK(!loader.Load(corrupt.data(), corrupt.size(), ui));
+    CHECK(!ui.root);
+
+    // Undefined style classes are reported by name
+    CHECK(compiler.Compile("Container { Button class=UiMarkupTests.Undefined }", blob));
+    CHECK(!loader.Load(blob.data(), blob.size(), ui));
+    CHECK(loader.GetError().find("UiMarkupTests.Undefined") != std::string::npos);
+    CHECK(!ui.root);
+}
+
+int main() {
+    StyleClassID accent = StyleRegistry::Get().DefineClass("UiMarkupTests.Accent", Button::DefaultStyle());
+    TestRoundTrip(accent);
+    TestCompileErrors();
+    TestMalformedBlobs();
+    return CheckResult();
+}
@@ -0,0 +1,190 @@
+#include <map>
+#include <string>
+#include <cstdarg>
+#include <cstdlib>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "windows.h"
+
+// Fixed text metrics: every character is CharWidth wide, lines are LineHeight tall
+// Fonts from CreateFontW scale them with their height (the handle is the line height)
+namespace {
+    const int CharWidth = 7;
+    const int LineHeight = 16;
+
+    HGDIOBJ selectedFont = nullptr; // nullptr = default font
+
+    TEXTMETRICW SelectedMetrics() {
+        int height = selectedFont ? static_cast<int>(reinterpret_cast<intptr_t>(selectedFont)) : LineHeight;
+        int charWidth = std::max(1, height * CharWidth / LineHeight);
+        int ascent = height * 13 / LineHeight;
+        return {height, ascent, height - ascent, 0, 0, charWidth, 2 * charWidth};
+    }
+
+    std::string Narrow(const wchar_t* text) {
+        std::string out;
+        for(; *text; text++) out += static_cast<char>(*text);
+        return out;
+    }
+
+    // File handles are file descriptors + 1 (0 stays "no handle")
+    int Descriptor(HANDLE handle) { return static_cast<int>(reinterpret_cast<intptr_t>(handle)) - 1; }
+
+    std::map<const void*, size_t> views; // Mapped view => length
+}
+
+// --- GDI ---
+BOOL DeleteObject(HGDIOBJ) { return 1; }
+HGDIOBJ SelectObject(HDC, HGDIOBJ object) {
+    // Pens and brushes are nullptr as well - selecting one falls back to the default font
+    HGDIOBJ previous = selectedFont;
+    selectedFont = object;
+    return previous;
+}
+HGDIOBJ GetStockObject(int) { return nullptr; }
+HFONT CreateFontW(int height, int, int, int, int, DWORD, DWORD, DWORD, DWORD, DWORD, DWORD, DWORD, DWORD, LPCWSTR) {
+    height = std::abs(height);
+    return height > 0 && height < 256 ? reinterpret_cast<HFONT>(static_cast<intptr_t>(height)) : nullptr;
+}
+int GetObjectW(HANDLE, int, void*) { return 0; }
+HPEN CreatePen(int, int, COLORREF) { return nullptr; }
+HBRUSH CreateSolidBrush(COLORREF) { return nullptr; }
+
+HDC GetDC(HWND) { return reinterpret_cast<HDC>(1); }
+int ReleaseDC(HWND, HDC) { return 1; }
+HDC CreateCompatibleDC(HDC) { return reinterpret_cast<HDC>(1); }
+BOOL DeleteDC(HDC) { return 1; }
+int SaveDC(HDC) { return 1; }
+BOOL RestoreDC(HDC, int) { return 1; }
+int IntersectClipRect(HDC, int, int, int, int) { return 1; }
+
+int FillRect(HDC, const RECT*, HBRUSH) { return 1; }
+BOOL MoveToEx(HDC, int, int, POINT*) { return 1; }
+BOOL LineTo(HDC, int, int) { return 1; }
+BOOL Polyline(HDC, const POINT*, int) { return 1; }
+
+int SetBkMode(HDC, int) { return 0; }
+COLORREF SetTextColor(HDC, COLORREF) { return 0; }
+
+int DrawTextW(HDC, LPCWSTR text, int length, LPRECT rect, UINT format) {
+    TEXTMETRICW metrics = SelectedMetrics();
+    if(format & DT_CALCRECT) {
+        int count = length < 0 ? static_cast<int>(wcslen(text)) : length;
+        rect->right = rect->left + metrics.tmAveCharWidth * count;
+        rect->bottom = rect->top + metrics.tmHeight;
+    }
+    return metrics.tmHeight;
+}
+
+BOOL TextOutW(HDC, int, int, LPCWSTR, int) { return 1; }
+
+BOOL GetTextExtentPoint32W(HDC, LPCWSTR, int length, SIZE* size) {
+    TEXTMETRICW metrics = SelectedMetrics();
+    *size = {metrics.tmAveCharWidth * length, metrics.tmHeight};
+    return 1;
+}
+
+BOOL GetTextExtentExPointW(HDC, LPCWSTR, int length, int, int*, int* extents, SIZE* size) {
+    TEXTMETRICW metrics = SelectedMetrics();
+    if(extents) {
+        for(int i = 0; i < length; i++) extents[i] = metrics.tmAveCharWidth * (i + 1);
+    }
+    if(size) *size = {metrics.tmAveCharWidth * length, metrics.tmHeight};
+    return 1;
+}
+
+BOOL GetTextMetrics(HDC, TEXTMETRIC* metrics) { *metrics = SelectedMetrics(); return 1; }
+BOOL GetTextMetricsW(HDC, TEXTMETRICW* metrics) { *metrics = SelectedMetrics(); return 1; }
+
+BOOL IsRectEmpty(const RECT* rect) {
+    return rect->right <= rect->left || rect->bottom <= rect->top;
+}
+
+BOOL PtInRect(const RECT* rect, POINT p) {
+    return p.x >= rect->left && p.x < rect->right && p.y >= rect->top && p.y < rect->bottom;
+}
+
+BOOL IntersectRect(RECT* out, const RECT* a, const RECT* b) {
+    *out = {std::max(a->left, b->left), std::max(a->top, b->top), std::min(a->right, b->right), std::min(a->bottom, b->bottom)};
+    if(IsRectEmpty(out)) {
+        *out = {0, 0, 0, 0};
+        return 0;
+    }
+    return 1;
+}
+
+BOOL UnionRect(RECT* out, const RECT* a, const RECT* b) {
+    *out = {std::min(a->left, b->left), std::min(a->top, b->top), std::max(a->right, b->right), std::max(a->bottom, b->bottom)};
+    return 1;
+}
+
+BOOL OffsetRect(RECT* rect, int dx, int dy) {
+    rect->left += dx;
+    rect->right += dx;
+    rect->top += dy;
+    rect->bottom += dy;
+    return 1;
+}
+
+// --- Files ---
+HANDLE CreateFileW(LPCWSTR path, DWORD, DWORD, void*, DWORD, DWORD, HANDLE) {
+    int fd = open(Narrow(path).c_str(), O_RDONLY);
+    if(fd < 0) return INVALID_HANDLE_VALUE;
+    return reinterpret_cast<HANDLE>(static_cast<intptr_t>(fd) + 1);
+}
+
+BOOL CloseHandle(HANDLE handle) {
+    if(handle != INVALID_HANDLE_VALUE && Descriptor(handle) >= 0) close(Descriptor(handle));
+    return 1;
+}
+
+BOOL GetFileSizeEx(HANDLE file, LARGE_INTEGER* size) {
+    struct stat st;
+    if(fstat(Descriptor(file), &st) != 0) return 0;
+    size->QuadPart = st.st_size;
+    return 1;
+}
+
+// Mappings are duplicated descriptors (closing the mapping and the file closes each once); views are mmapped from them
+HANDLE CreateFileMappingW(HANDLE file, void*, DWORD, DWORD, DWORD, LPCWSTR) {
+    return reinterpret_cast<HANDLE>(static_cast<intptr_t>(dup(Descriptor(file))) + 1);
+}
+
+void* MapViewOfFile(HANDLE mapping, DWORD, DWORD, DWORD, size_t) {
+    struct stat st;
+    if(fstat(Descriptor(mapping), &st) != 0) return nullptr;
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, Descriptor(mapping), 0);
+    if(view == MAP_FAILED) return nullptr;
+    views[view] = static_cast<size_t>(st.st_size);
+    return view;
+}
+
+BOOL UnmapViewOfFile(const void* view) {
+    auto it = views.find(view);
+    if(it == views.end()) return 0;
+    munmap(const_cast<void*>(view), it->second);
+    views.erase(it);
+    return 1;
+}
+
+FILE* _wfopen(const wchar_t* path, const wchar_t* mode) {
+    return std::fopen(Narrow(path).c_str(), Narrow(mode).c_str());
+}
+
+// --- Misc ---
+void OutputDebugStringA(const char* text) {
+    std::fputs(text, stderr);
+}
+
+int swprintf_s(wchar_t* buffer, size_t size, const wchar_t* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = std::vswprintf(buffer, size, format, args);
+    va_end(args);
+    return written;
+}
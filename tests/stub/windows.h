@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <cwchar>
+
+// Minimal stand-in for <windows.h> so the library builds and runs its tests on non-Windows hosts
+// Only the types, constants and functions the library uses. GDI calls don't draw anything; text is measured
+// with fixed metrics (see GdiStub.cpp) so layout results are deterministic.
+
+typedef unsigned char BYTE;
+typedef unsigned long DWORD;
+typedef unsigned int UINT;
+typedef int BOOL;
+typedef long LONG;
+typedef DWORD COLORREF;
+typedef void* HANDLE;
+typedef wchar_t WCHAR;
+typedef const wchar_t* LPCWSTR;
+typedef wchar_t* LPWSTR;
+
+typedef struct HDC__* HDC;
+typedef struct HFONT__* HFONT;
+typedef struct HPEN__* HPEN;
+typedef struct HBRUSH__* HBRUSH;
+typedef struct HWND__* HWND;
+typedef void* HGDIOBJ;
+
+struct RECT { LONG left, top, right, bottom; };
+struct POINT { LONG x, y; };
+struct SIZE { LONG cx, cy; };
+typedef RECT* LPRECT;
+
+struct TEXTMETRICW {
+    LONG tmHeight, tmAscent, tmDescent, tmInternalLeading, tmExternalLeading, tmAveCharWidth, tmMaxCharWidth;
+};
+typedef TEXTMETRICW TEXTMETRIC;
+
+struct LOGFONTW {
+    LONG lfHeight, lfWidth, lfEscapement, lfOrientation, lfWeight;
+    BYTE lfItalic, lfUnderline, lfStrikeOut, lfCharSet;
+    WCHAR lfFaceName[32];
+};
+
+typedef union {
+    struct { DWORD LowPart; LONG HighPart; };
+    long long QuadPart;
+} LARGE_INTEGER;
+
+#define RGB(r, g, b) ((COLORREF)(((BYTE)(r) | ((DWORD)((BYTE)(g)) << 8)) | (((DWORD)(BYTE)(b)) << 16)))
+#define GetRValue(c) ((BYTE)(c))
+
+// --- GDI ---
+#define TRANSPARENT 1
+#define PS_SOLID 0
+#define DEFAULT_GUI_FONT 17
+#define HGDI_ERROR ((HGDIOBJ)-1)
+
+#define DT_TOP 0
+#define DT_LEFT 0
+#define DT_CENTER 1
+#define DT_RIGHT 2
+#define DT_VCENTER 4
+#define DT_BOTTOM 8
+#define DT_WORDBREAK 0x10
+#define DT_SINGLELINE 0x20
+#define DT_NOCLIP 0x100
+#define DT_CALCRECT 0x400
+#define DT_NOPREFIX 0x800
+#define DT_END_ELLIPSIS 0x8000
+
+BOOL DeleteObject(HGDIOBJ object);
+HGDIOBJ SelectObject(HDC dc, HGDIOBJ object);
+HGDIOBJ GetStockObject(int index);
+HFONT CreateFontW(int height, int width, int escapement, int orientation, int weight, DWORD italic, DWORD underline,
+    DWORD strikeOut, DWORD charSet, DWORD outPrecision, DWORD clipPrecision, DWORD quality, DWORD pitchAndFamily, LPCWSTR face);
+int GetObjectW(HANDLE object, int size, void* out);
+HPEN CreatePen(int style, int width, COLORREF color);
+HBRUSH CreateSolidBrush(COLORREF color);
+
+HDC GetDC(HWND window);
+int ReleaseDC(HWND window, HDC dc);
+HDC CreateCompatibleDC(HDC dc);
+BOOL DeleteDC(HDC dc);
+int SaveDC(HDC dc);
+BOOL RestoreDC(HDC dc, int saved);
+int IntersectClipRect(HDC dc, int left, int top, int right, int bottom);
+
+int FillRect(HDC dc, const RECT* rect, HBRUSH brush);
+BOOL MoveToEx(HDC dc, int x, int y, POINT* previous);
+BOOL LineTo(HDC dc, int x, int y);
+BOOL Polyline(HDC dc, const POINT* points, int count);
+
+int SetBkMode(HDC dc, int mode);
+COLORREF SetTextColor(HDC dc, COLORREF color);
+int DrawTextW(HDC dc, LPCWSTR text, int length, LPRECT rect, UINT format);
+BOOL TextOutW(HDC dc, int x, int y, LPCWSTR text, int length);
+BOOL GetTextExtentPoint32W(HDC dc, LPCWSTR text, int length, SIZE* size);
+BOOL GetTextExtentExPointW(HDC dc, LPCWSTR text, int length, int maxExtent, int* fit, int* extents, SIZE* size);
+BOOL GetTextMetrics(HDC dc, TEXTMETRIC* metrics);
+BOOL GetTextMetricsW(HDC dc, TEXTMETRICW* metrics);
+
+BOOL IsRectEmpty(const RECT* rect);
+BOOL PtInRect(const RECT* rect, POINT p);
+BOOL IntersectRect(RECT* out, const RECT* a, const RECT* b);
+BOOL UnionRect(RECT* out, const RECT* a, const RECT* b);
+BOOL OffsetRect(RECT* rect, int dx, int dy);
+
+// --- Keyboard ---
+#define VK_BACK 0x08
+#define VK_TAB 0x09
+#define VK_RETURN 0x0D
+#define VK_SHIFT 0x10
+#define VK_CONTROL 0x11
+#define VK_MENU 0x12
+#define VK_ESCAPE 0x1B
+#define VK_SPACE 0x20
+#define VK_PRIOR 0x21
+#define VK_NEXT 0x22
+#define VK_END 0x23
+#define VK_HOME 0x24
+#define VK_LEFT 0x25
+#define VK_UP 0x26
+#define VK_RIGHT 0x27
+#define VK_DOWN 0x28
+#define VK_DELETE 0x2E
+
+// --- Files ---
+#define MAX_PATH 260
+#define GENERIC_READ 0x80000000
+#define FILE_SHARE_READ 1
+#define OPEN_EXISTING 3
+#define FILE_ATTRIBUTE_NORMAL 0x80
+#define INVALID_HANDLE_VALUE ((HANDLE)(intptr_t)-1)
+#define PAGE_READONLY 2
+#define FILE_MAP_READ 4
+
+HANDLE CreateFileW(LPCWSTR path, DWORD access, DWORD share, void* security, DWORD disposition, DWORD flags, HANDLE tmpl);
+BOOL CloseHandle(HANDLE handle);
+BOOL GetFileSizeEx(HANDLE file, LARGE_INTEGER* size);
+HANDLE CreateFileMappingW(HANDLE file, void* security, DWORD protect, DWORD sizeHigh, DWORD sizeLow, LPCWSTR name);
+void* MapViewOfFile(HANDLE mapping, DWORD access, DWORD offsetHigh, DWORD offsetLow, size_t size);
+BOOL UnmapViewOfFile(const void* view);
+
+// CRT wide-path extension
+FILE* _wfopen(const wchar_t* path, const wchar_t* mode);
+
+// --- Misc ---
+void OutputDebugStringA(const char* text);
+
+int swprintf_s(wchar_t* buffer, size_t size, const wchar_t* format, ...);